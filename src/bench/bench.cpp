@@ -0,0 +1,223 @@
+// Copyright (c) 2015-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include <univalue.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace benchmark {
+
+double gettimedouble()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BenchRunner::BenchmarkMap& BenchRunner::benchmarks()
+{
+    static BenchmarkMap benchmarks_map;
+    return benchmarks_map;
+}
+
+BenchRunner::BenchRunner(const std::string& name, BenchFunction func)
+{
+    benchmarks().insert(std::make_pair(name, func));
+}
+
+void BenchRunner::RunAll(double elapsedTimeForOne, const std::string& strFilter)
+{
+    BenchOptions options;
+    options.elapsedTimeForOne = elapsedTimeForOne;
+    options.strFilter = strFilter;
+    std::vector<BenchResult> vResults;
+    RunAll(options, vResults);
+}
+
+bool BenchRunner::RunAll(const BenchOptions& options, std::vector<BenchResult>& vResults)
+{
+    if (options.nCpu >= 0 && !PinToCpu(options.nCpu)) {
+        std::cerr << "Error: cannot pin to CPU " << options.nCpu << "\n";
+        return false;
+    }
+
+    std::cout << "#Benchmark" << "," << "count" << "," << "min" << ","
+              << "max" << "," << "average" << "\n";
+
+    vResults.clear();
+    for (const auto& entry : benchmarks()) {
+        if (!options.strFilter.empty() && entry.first.find(options.strFilter) == std::string::npos)
+            continue;
+
+        if (options.warmupTime > 0) {
+            State warmup(entry.first, options.warmupTime);
+            entry.second(warmup);
+        }
+
+        State state(entry.first, options.elapsedTimeForOne);
+        entry.second(state);
+
+        const BenchResult& result = state.GetResult();
+        std::cout << std::fixed << std::setprecision(15) << result.name << "," << result.count << ","
+                  << result.minTime << "," << result.maxTime << "," << result.average << "\n";
+        vResults.push_back(result);
+    }
+
+    if (!options.strJsonPath.empty() && !WriteResultsJson(options.strJsonPath, options, vResults)) {
+        std::cerr << "Error: cannot write " << options.strJsonPath << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool PinToCpu(int nCpu)
+{
+#ifdef __linux__
+    if (nCpu < 0 || nCpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(nCpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+bool WriteResultsJson(const std::string& strPath, const BenchOptions& options,
+                      const std::vector<BenchResult>& vResults)
+{
+    UniValue benchmarks(UniValue::VARR);
+    for (const BenchResult& result : vResults) {
+        UniValue entry(UniValue::VOBJ);
+        entry.push_back(Pair("name", result.name));
+        entry.push_back(Pair("count", (uint64_t)result.count));
+        entry.push_back(Pair("min", result.minTime));
+        entry.push_back(Pair("max", result.maxTime));
+        entry.push_back(Pair("average", result.average));
+        benchmarks.push_back(entry);
+    }
+
+    UniValue root(UniValue::VOBJ);
+    root.push_back(Pair("seconds", options.elapsedTimeForOne));
+    root.push_back(Pair("warmup", options.warmupTime));
+    root.push_back(Pair("cpu", options.nCpu));
+    root.push_back(Pair("benchmarks", benchmarks));
+
+    std::ofstream file(strPath.c_str());
+    file << root.write(2) << "\n";
+    return file.good();
+}
+
+bool ReadResultsJson(const std::string& strPath, std::vector<BenchResult>& vResults)
+{
+    std::ifstream file(strPath.c_str());
+    if (!file)
+        return false;
+    std::stringstream ss;
+    ss << file.rdbuf();
+
+    UniValue root;
+    if (!root.read(ss.str()) || !root.isObject() || !root["benchmarks"].isArray())
+        return false;
+
+    vResults.clear();
+    const UniValue& benchmarks = root["benchmarks"];
+    for (size_t i = 0; i < benchmarks.size(); i++) {
+        const UniValue& entry = benchmarks[i];
+        if (!entry["name"].isStr() || !entry["average"].isNum())
+            return false;
+        BenchResult result;
+        result.name = entry["name"].get_str();
+        result.count = entry["count"].isNum() ? entry["count"].get_int64() : 0;
+        result.minTime = entry["min"].isNum() ? entry["min"].get_real() : 0;
+        result.maxTime = entry["max"].isNum() ? entry["max"].get_real() : 0;
+        result.average = entry["average"].get_real();
+        vResults.push_back(result);
+    }
+    return true;
+}
+
+int CompareResults(const std::vector<BenchResult>& vOld, const std::vector<BenchResult>& vNew,
+                   double thresholdPct)
+{
+    std::map<std::string, const BenchResult*> mapOld;
+    for (const BenchResult& result : vOld)
+        mapOld[result.name] = &result;
+
+    int nRegressions = 0;
+    std::cout << "#Benchmark" << "," << "old" << "," << "new" << "," << "change%" << "," << "status" << "\n";
+    for (const BenchResult& result : vNew) {
+        auto it = mapOld.find(result.name);
+        if (it == mapOld.end() || it->second->average <= 0)
+            continue;
+        double change = (result.average - it->second->average) / it->second->average * 100.0;
+        bool fRegressed = change > thresholdPct;
+        if (fRegressed)
+            nRegressions++;
+        std::cout << std::fixed << std::setprecision(15) << result.name << "," << it->second->average << ","
+                  << result.average << "," << std::setprecision(2) << change << ","
+                  << (fRegressed ? "REGRESSION" : "ok") << "\n";
+    }
+    return nRegressions;
+}
+
+bool State::KeepRunning()
+{
+    if (count & countMask) {
+        ++count;
+        return true;
+    }
+
+    double now;
+    bool fGrow = false;
+    if (count == 0) {
+        lastTime = beginTime = now = gettimedouble();
+    } else {
+        now = gettimedouble();
+        double elapsed = now - lastTime;
+        double elapsedOne = elapsed / (countMask + 1);
+        if (elapsedOne < minTime) minTime = elapsedOne;
+        if (elapsedOne > maxTime) maxTime = elapsedOne;
+
+        // Aim for roughly 1ms between clock reads
+        fGrow = elapsed * 128 < maxElapsed;
+    }
+    lastTime = now;
+    ++count;
+
+    if (now - beginTime < maxElapsed) {
+        if (fGrow) {
+            countMask = ((countMask << 1) | 1) & ((1LL << 60) - 1);
+            // Restart the min/max window at the new granularity; a run
+            // that ends here reports the window just closed
+            minTime = std::numeric_limits<double>::max();
+            maxTime = 0;
+        }
+        return true; // Keep going
+    }
+
+    --count;
+
+    result.name = name;
+    result.count = count;
+    result.minTime = minTime;
+    result.maxTime = maxTime;
+    result.average = (now - beginTime) / count;
+
+    return false;
+}
+
+} // namespace benchmark
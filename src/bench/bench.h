@@ -0,0 +1,163 @@
+// Copyright (c) 2015-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_BENCH_BENCH_H
+#define AFRICOIN_BENCH_BENCH_H
+
+#include <stdint.h>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @file bench.h
+ * @brief Minimal micro-benchmark framework for Africoin
+ *
+ * Modelled on Bitcoin Core's bench framework so that benchmarks can be
+ * moved between the trees unchanged. Usage:
+ *
+ *   static void CODE_TO_TIME(benchmark::State& state)
+ *   {
+ *       ... do any setup needed...
+ *       while (state.KeepRunning()) {
+ *           ... do stuff you want to time...
+ *       }
+ *       ... do any cleanup needed...
+ *   }
+ *
+ *   BENCHMARK(CODE_TO_TIME);
+ *
+ * Each benchmark is run once untimed for a short warm-up (caches, page
+ * faults, CPU frequency) and then measured. Results are printed as CSV
+ * and can also be written as JSON; two JSON runs can be compared with
+ * CompareResults() to catch regressions.
+ */
+
+namespace benchmark {
+
+/**
+ * @struct BenchResult
+ * @brief Timings of one benchmark, in seconds per iteration
+ */
+struct BenchResult {
+    std::string name;
+    uint64_t count;
+    double minTime;
+    double maxTime;
+    double average;
+
+    BenchResult() : count(0), minTime(0), maxTime(0), average(0) {}
+};
+
+/**
+ * @class State
+ * @brief Iteration controller handed to each benchmark function
+ *
+ * KeepRunning() is called once per iteration. Timing checks are only
+ * performed every countMask+1 iterations so the clock read does not
+ * dominate very cheap benchmarks.
+ */
+class State {
+    std::string name;
+    double maxElapsed;
+    double beginTime;
+    double lastTime, minTime, maxTime;
+    uint64_t count;
+    uint64_t countMask;
+    BenchResult result;
+public:
+    State(const std::string& _name, double _maxElapsed)
+        : name(_name), maxElapsed(_maxElapsed), beginTime(0), lastTime(0),
+          minTime(std::numeric_limits<double>::max()), maxTime(0), count(0), countMask(0) {}
+
+    bool KeepRunning();
+
+    /** Name of the running benchmark */
+    const std::string& GetName() const { return name; }
+
+    /** Timings, filled in once KeepRunning() has returned false */
+    const BenchResult& GetResult() const { return result; }
+};
+
+typedef std::function<void(State&)> BenchFunction;
+
+/**
+ * @struct BenchOptions
+ * @brief How RunAll() runs and reports the benchmarks
+ */
+struct BenchOptions {
+    double elapsedTimeForOne;   //!< Measured wall-clock seconds per benchmark
+    double warmupTime;          //!< Untimed seconds per benchmark first (0: none)
+    std::string strFilter;      //!< Substring filter (empty runs everything)
+    int nCpu;                   //!< Pin to this CPU (-1: no pinning)
+    std::string strJsonPath;    //!< Also write results here as JSON (empty: don't)
+
+    BenchOptions() : elapsedTimeForOne(1.0), warmupTime(0.1), nCpu(-1) {}
+};
+
+/**
+ * @class BenchRunner
+ * @brief Static registry of all benchmarks in the binary
+ */
+class BenchRunner {
+    typedef std::map<std::string, BenchFunction> BenchmarkMap;
+    static BenchmarkMap& benchmarks();
+
+public:
+    BenchRunner(const std::string& name, BenchFunction func);
+
+    /**
+     * @brief Run every registered benchmark whose name contains strFilter
+     *
+     * @param elapsedTimeForOne Wall-clock seconds to spend on each benchmark
+     * @param strFilter Substring filter (empty runs everything)
+     */
+    static void RunAll(double elapsedTimeForOne = 1.0, const std::string& strFilter = "");
+
+    /**
+     * @brief Run the benchmarks selected by options
+     *
+     * Pinning applies to the calling thread before anything runs, so
+     * worker threads started by the benchmarks inherit it.
+     *
+     * @return false if pinning or writing the JSON file failed
+     */
+    static bool RunAll(const BenchOptions& options, std::vector<BenchResult>& vResults);
+};
+
+/** @brief Pin the calling thread (and threads it starts later) to one CPU */
+bool PinToCpu(int nCpu);
+
+/** @brief Write results as {"benchmarks": [{name, count, min, max, average}, ...]} */
+bool WriteResultsJson(const std::string& strPath, const BenchOptions& options,
+                      const std::vector<BenchResult>& vResults);
+
+/** @brief Read results written by WriteResultsJson */
+bool ReadResultsJson(const std::string& strPath, std::vector<BenchResult>& vResults);
+
+/**
+ * @brief Print old vs new average times for benchmarks present in both runs
+ *
+ * @param thresholdPct A benchmark regresses if its average grew by more
+ *                     than this many percent
+ * @return Number of regressed benchmarks
+ */
+int CompareResults(const std::vector<BenchResult>& vOld, const std::vector<BenchResult>& vNew,
+                   double thresholdPct);
+
+/** @brief Monotonic wall clock in seconds */
+double gettimedouble();
+
+} // namespace benchmark
+
+// BENCHMARK(foo) expands to:  benchmark::BenchRunner bench_11foo("foo", foo);
+#define BENCHMARK_CAT2(a, b) a##b
+#define BENCHMARK_CAT(a, b) BENCHMARK_CAT2(a, b)
+#define BENCHMARK(n) \
+    benchmark::BenchRunner BENCHMARK_CAT(bench_, BENCHMARK_CAT(__LINE__, n))(#n, n);
+
+#endif // AFRICOIN_BENCH_BENCH_H
@@ -0,0 +1,91 @@
+// Copyright (c) 2015-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "chainparams.h"
+#include "chainparamsbase.h"
+#include "crypto/sha256_dispatch.h"
+#include "util.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const double DEFAULT_BENCH_SECONDS = 1.0;
+static const double DEFAULT_BENCH_WARMUP = 0.1;
+static const double DEFAULT_BENCH_THRESHOLD = 5.0;
+
+static void PrintUsage()
+{
+    std::cout << "Usage: africoin-bench [options]\n"
+              << "  -filter=<str>          Only run benchmarks whose name contains <str>\n"
+              << "  -seconds=<n>           Measured seconds per benchmark (default: " << DEFAULT_BENCH_SECONDS << ")\n"
+              << "  -warmup=<n>            Untimed warm-up seconds per benchmark, 0 to disable (default: " << DEFAULT_BENCH_WARMUP << ")\n"
+              << "  -cpu=<n>               Pin the benchmarks to CPU <n>\n"
+              << "  -json=<file>           Also write the results to <file> as JSON\n"
+              << "  -compare=<old>,<new>   Compare two JSON result files instead of running\n"
+              << "  -threshold=<pct>       Slowdown that counts as a regression in -compare (default: " << DEFAULT_BENCH_THRESHOLD << ")\n";
+}
+
+/** -compare: exit status 2 on a regression, so CI can gate on it */
+static int CompareMain(const std::string& strFiles)
+{
+    size_t nComma = strFiles.find(',');
+    if (nComma == std::string::npos) {
+        std::cerr << "Error: -compare expects <old.json>,<new.json>\n";
+        return 1;
+    }
+
+    std::vector<benchmark::BenchResult> vOld, vNew;
+    std::string strOld = strFiles.substr(0, nComma), strNew = strFiles.substr(nComma + 1);
+    if (!benchmark::ReadResultsJson(strOld, vOld) || !benchmark::ReadResultsJson(strNew, vNew)) {
+        std::cerr << "Error: cannot read " << strOld << " or " << strNew << "\n";
+        return 1;
+    }
+
+    double nThreshold = std::atof(GetArg("-threshold", std::to_string(DEFAULT_BENCH_THRESHOLD)).c_str());
+    int nRegressions = benchmark::CompareResults(vOld, vNew, nThreshold);
+    if (nRegressions > 0) {
+        std::cerr << nRegressions << " benchmark(s) regressed by more than " << nThreshold << "%\n";
+        return 2;
+    }
+    return 0;
+}
+
+/**
+ * africoin-bench entry point
+ */
+int main(int argc, char** argv)
+{
+    ParseParameters(argc, argv);
+
+    if (IsArgSet("-?") || IsArgSet("-h") || IsArgSet("-help")) {
+        PrintUsage();
+        return 0;
+    }
+
+    if (IsArgSet("-compare"))
+        return CompareMain(GetArg("-compare", ""));
+
+    benchmark::BenchOptions options;
+    options.strFilter = GetArg("-filter", "");
+    options.elapsedTimeForOne = std::atof(GetArg("-seconds", std::to_string(DEFAULT_BENCH_SECONDS)).c_str());
+    if (options.elapsedTimeForOne <= 0)
+        options.elapsedTimeForOne = DEFAULT_BENCH_SECONDS;
+    options.warmupTime = std::atof(GetArg("-warmup", std::to_string(DEFAULT_BENCH_WARMUP)).c_str());
+    options.nCpu = GetArg("-cpu", (int64_t)-1);
+    options.strJsonPath = GetArg("-json", "");
+
+    // Block files are written with the main network message start
+    SelectParams(CBaseChainParams::MAIN);
+
+    // As node startup: the fastest SHA-256 backend that passes its self-test
+    std::cerr << "Using the " << Africoin::SHA256AutoDetect() << " SHA-256 implementation\n";
+
+    std::vector<benchmark::BenchResult> vResults;
+    return benchmark::BenchRunner::RunAll(options, vResults) ? 0 : 1;
+}
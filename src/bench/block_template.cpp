@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "arith_uint256.h"
+#include "rpc/mining.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using Africoin::BlockTemplateAssembler;
+using Africoin::TemplateTxInfo;
+
+// A mempool somewhat larger than one block so eviction paths are exercised
+static const unsigned int BENCH_MEMPOOL_TXS = 8000;
+
+static std::vector<TemplateTxInfo> MakeMempool(unsigned int nCount, uint32_t nSeed)
+{
+    std::mt19937 rng(nSeed);
+    std::uniform_int_distribution<unsigned int> sizeDist(200, 600);
+    std::uniform_int_distribution<CAmount> feeDist(1000, 200000);
+
+    std::vector<TemplateTxInfo> vTx(nCount);
+    for (unsigned int i = 0; i < nCount; i++) {
+        vTx[i].txid = ArithToUint256(arith_uint256(i + 1));
+        vTx[i].nSize = sizeDist(rng);
+        vTx[i].nFee = feeDist(rng);
+        // Every tenth transaction spends an earlier unconfirmed one
+        if (i > 0 && i % 10 == 0)
+            vTx[i].vParents.push_back(vTx[i - 1].txid);
+    }
+    return vTx;
+}
+
+static void FillAssembler(BlockTemplateAssembler& assembler, const std::vector<TemplateTxInfo>& vTx)
+{
+    assembler.UpdateTip(nullptr);
+    for (const TemplateTxInfo& info : vTx)
+        assembler.TransactionAdded(info);
+}
+
+/** getblocktemplate polling against an already maintained template */
+static void BlockTemplateIncrementalGet(benchmark::State& state)
+{
+    BlockTemplateAssembler assembler(Africoin::DEFAULT_TEMPLATE_MAX_SIZE);
+    FillAssembler(assembler, MakeMempool(BENCH_MEMPOOL_TXS, 1));
+
+    while (state.KeepRunning()) {
+        Africoin::BlockTemplateSnapshot snapshot = assembler.GetTemplate();
+        (void)snapshot;
+    }
+}
+
+/** One mempool eviction plus one arrival, as seen between two polls */
+static void BlockTemplateIncrementalChurn(benchmark::State& state)
+{
+    BlockTemplateAssembler assembler(Africoin::DEFAULT_TEMPLATE_MAX_SIZE);
+    std::vector<TemplateTxInfo> vTx = MakeMempool(BENCH_MEMPOOL_TXS, 2);
+    FillAssembler(assembler, vTx);
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        const TemplateTxInfo& info = vTx[n++ % vTx.size()];
+        assembler.TransactionRemoved(info.txid);
+        assembler.TransactionAdded(info);
+    }
+}
+
+/** Baseline: rebuild the template from the whole mempool on each poll */
+static void BlockTemplateFullRebuild(benchmark::State& state)
+{
+    std::vector<TemplateTxInfo> vTx = MakeMempool(BENCH_MEMPOOL_TXS, 1);
+
+    while (state.KeepRunning()) {
+        BlockTemplateAssembler assembler(Africoin::DEFAULT_TEMPLATE_MAX_SIZE);
+        FillAssembler(assembler, vTx);
+        Africoin::BlockTemplateSnapshot snapshot = assembler.GetTemplate();
+        (void)snapshot;
+    }
+}
+
+BENCHMARK(BlockTemplateIncrementalGet);
+BENCHMARK(BlockTemplateIncrementalChurn);
+BENCHMARK(BlockTemplateFullRebuild);
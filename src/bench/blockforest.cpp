@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "arith_uint256.h"
+#include "chain.h"
+#include "consensus/blockforest.h"
+#include "storage/blockindexfile.h"
+
+#include <boost/filesystem.hpp>
+
+#include <assert.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Africoin::BlockRef;
+using Africoin::CBlockForest;
+
+static const uint32_t BENCH_FOREST_BLOCKS = 5000000;
+
+/** A 5M block chain with a short fork every 1000 blocks, built once */
+static const CBlockForest& GetBenchForest(BlockRef& tip)
+{
+    static CBlockForest forest;
+    static BlockRef tipMain = Africoin::NULL_BLOCK_REF;
+
+    if (forest.Size() == 0) {
+        forest.Reserve(BENCH_FOREST_BLOCKS + BENCH_FOREST_BLOCKS / 100);
+        uint32_t nHash = 1;
+        for (uint32_t i = 0; i < BENCH_FOREST_BLOCKS; i++) {
+            uint32_t nFlags = (i % 3 ? (uint32_t)Africoin::FOREST_PROOF_OF_STAKE : 0) |
+                              (i % 32 == 0 ? (uint32_t)Africoin::FOREST_STAKE_MODIFIER : 0);
+            tipMain = forest.Add(ArithToUint256(arith_uint256(nHash++)), tipMain, 1500000000 + i * 150, 0x1e0fffff, nFlags);
+            if (i % 1000 == 999) {
+                BlockRef fork = tipMain;
+                for (int j = 0; j < 10; j++)
+                    fork = forest.Add(ArithToUint256(arith_uint256(nHash++)), fork, 0, 0, 0);
+            }
+        }
+
+        fprintf(stderr, "BlockForest: %u entries, %.1f bytes/entry (hot %u, cold %u); CBlockIndex alone is %u bytes\n",
+                (unsigned int)forest.Size(), (double)forest.DynamicMemoryUsage() / forest.Size(),
+                (unsigned int)sizeof(Africoin::CBlockForestHot), (unsigned int)sizeof(Africoin::CBlockForestCold),
+                (unsigned int)sizeof(CBlockIndex));
+    }
+
+    tip = tipMain;
+    return forest;
+}
+
+/** Random GetAncestor queries from random main-chain blocks */
+static void BlockForestGetAncestor(benchmark::State& state)
+{
+    BlockRef tip;
+    const CBlockForest& forest = GetBenchForest(tip);
+
+    std::mt19937 rng(7);
+    std::vector<BlockRef> vFrom;
+    std::vector<int> vHeight;
+    for (int i = 0; i < 4096; i++) {
+        int nFrom = rng() % BENCH_FOREST_BLOCKS;
+        vFrom.push_back(forest.GetAncestor(tip, nFrom));
+        vHeight.push_back(rng() % (nFrom + 1));
+    }
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        BlockRef ref = forest.GetAncestor(vFrom[n & 4095], vHeight[n & 4095]);
+        (void)ref;
+        n++;
+    }
+}
+
+/** The stake modifier walk: parent links back to the last modifier block */
+static void BlockForestModifierWalk(benchmark::State& state)
+{
+    BlockRef tip;
+    const CBlockForest& forest = GetBenchForest(tip);
+
+    std::mt19937 rng(8);
+    std::vector<BlockRef> vFrom;
+    for (int i = 0; i < 4096; i++)
+        vFrom.push_back(forest.GetAncestor(tip, rng() % BENCH_FOREST_BLOCKS));
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        BlockRef ref = forest.GetLastModifierBlock(vFrom[n++ & 4095]);
+        (void)ref;
+    }
+}
+
+/** Fork point between the tip and a random stale branch */
+static void BlockForestFindFork(benchmark::State& state)
+{
+    BlockRef tip;
+    const CBlockForest& forest = GetBenchForest(tip);
+
+    std::mt19937 rng(9);
+    std::vector<BlockRef> vStale;
+    for (int i = 0; i < 4096; i++)
+        vStale.push_back(rng() % forest.Size());
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        BlockRef ref = forest.FindFork(tip, vStale[n++ & 4095]);
+        (void)ref;
+    }
+}
+
+/** Startup: the whole forest mapped from its index file and loaded on every hardware thread */
+static void BlockForestLoadFile(benchmark::State& state)
+{
+    BlockRef tip;
+    const CBlockForest& forest = GetBenchForest(tip);
+    const boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+                                         boost::filesystem::unique_path("africoin-bench-forest-%%%%%%%%.dat");
+    bool fWritten = Africoin::WriteBlockIndexFile(path, forest);
+    assert(fWritten);
+    const unsigned int nThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    Africoin::CBlockIndexLoadStats stats;
+    while (state.KeepRunning()) {
+        Africoin::CBlockIndexFile file;
+        CBlockForest loaded;
+        bool fLoaded = file.Open(path) && Africoin::LoadBlockIndex(file, loaded, nThreads, stats);
+        assert(fLoaded);
+    }
+    boost::filesystem::remove(path);
+    fprintf(stderr, "BlockForest load: %s\n", stats.ToString().c_str());
+}
+
+BENCHMARK(BlockForestGetAncestor);
+BENCHMARK(BlockForestModifierWalk);
+BENCHMARK(BlockForestFindFork);
+BENCHMARK(BlockForestLoadFile);
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "amount.h"
+#include "arith_uint256.h"
+#include "primitives/block.h"
+#include "storage/blockstore.h"
+
+#include <boost/filesystem.hpp>
+
+#include <assert.h>
+#include <random>
+#include <vector>
+
+using Africoin::CBlockStore;
+using Africoin::CStakeTxPrev;
+
+// ~200 MiB over two block files, well beyond the L3 cache
+static const unsigned int BENCH_BLOCKS = 2000;
+static const unsigned int BENCH_TXS_PER_BLOCK = 250;
+static const unsigned int BENCH_LOOKUPS = 4096;
+
+struct StakeLookup {
+    CDiskTxPos pos;
+    uint32_t nOut;
+};
+
+/** Block files shared by both benchmarks, written once per process */
+class BenchBlockFiles {
+public:
+    boost::filesystem::path dir;
+    std::vector<StakeLookup> vLookups;
+
+    BenchBlockFiles()
+    {
+        dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("africoin-bench-%%%%%%%%");
+        std::mt19937 rng(42);
+        std::vector<uint256> vTxid;
+
+        {
+            CBlockStore store(dir);
+            bool fOpen = store.Open();
+            assert(fOpen);
+            for (unsigned int nBlock = 0; nBlock < BENCH_BLOCKS; nBlock++) {
+                CBlock block;
+                block.nTime = 1500000000 + nBlock * 64;
+                for (unsigned int i = 0; i < BENCH_TXS_PER_BLOCK; i++) {
+                    CMutableTransaction tx;
+                    tx.nTime = block.nTime;
+                    tx.vin.resize(1 + rng() % 3);
+                    for (CTxIn& txin : tx.vin) {
+                        txin.prevout = COutPoint(ArithToUint256(arith_uint256(rng())), rng() % 4);
+                        txin.scriptSig = CScript() << std::vector<unsigned char>(105, 0x51);
+                    }
+                    tx.vout.resize(1 + rng() % 4);
+                    for (CTxOut& txout : tx.vout) {
+                        txout.nValue = rng() % (1000 * COIN);
+                        txout.scriptPubKey = CScript() << std::vector<unsigned char>(24, 0x76);
+                    }
+                    block.vtx.push_back(MakeTransactionRef(std::move(tx)));
+                    vTxid.push_back(block.vtx.back()->GetHash());
+                }
+                CDiskBlockPos pos;
+                bool fWritten = store.WriteBlock(block, pos);
+                assert(fWritten);
+            }
+
+            std::uniform_int_distribution<size_t> txDist(0, vTxid.size() - 1);
+            for (unsigned int i = 0; i < BENCH_LOOKUPS; i++) {
+                StakeLookup lookup;
+                bool fFound = store.FindTx(vTxid[txDist(rng)], lookup.pos);
+                assert(fFound);
+                lookup.nOut = 0;
+                vLookups.push_back(lookup);
+            }
+        }
+    }
+
+    ~BenchBlockFiles()
+    {
+        boost::filesystem::remove_all(dir);
+    }
+};
+
+static const BenchBlockFiles& GetBenchBlockFiles()
+{
+    static BenchBlockFiles files;
+    return files;
+}
+
+static void ReadRandomTxPrev(benchmark::State& state, bool fMmap)
+{
+    const BenchBlockFiles& files = GetBenchBlockFiles();
+    CBlockStore store(files.dir, fMmap);
+    bool fOpen = store.Open();
+    assert(fOpen);
+
+    size_t n = 0;
+    CAmount nSum = 0;
+    while (state.KeepRunning()) {
+        const StakeLookup& lookup = files.vLookups[n++ % files.vLookups.size()];
+        CStakeTxPrev txPrev;
+        bool fRead = store.ReadStakeTxPrev(lookup.pos, lookup.nOut, txPrev);
+        assert(fRead);
+        nSum += txPrev.nValue;
+    }
+    (void)nSum;
+}
+
+/** txPrev.nTime and value parsed in place from the mapped block file */
+static void BlockStoreTxPrevMmap(benchmark::State& state) { ReadRandomTxPrev(state, true); }
+/** Same lookups through pread() into a scratch buffer */
+static void BlockStoreTxPrevPread(benchmark::State& state) { ReadRandomTxPrev(state, false); }
+
+BENCHMARK(BlockStoreTxPrevMmap);
+BENCHMARK(BlockStoreTxPrevPread);
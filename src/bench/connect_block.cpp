@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "coins.h"
+#include "consensus/scriptcheck.h"
+#include "key.h"
+#include "pubkey.h"
+#include "script/interpreter.h"
+#include "script/standard.h"
+#include "validation.h"
+
+#include <assert.h>
+#include <memory>
+#include <vector>
+
+using Africoin::CVerifyBatch;
+using Africoin::CVerifyPool;
+
+// Roughly a full block of single-input P2PKH spends
+static const unsigned int BENCH_BLOCK_TXS = 2000;
+
+/** Signed transactions and a coins view holding the outputs they spend */
+struct BenchBlockInputs {
+    CCoinsView viewDummy;
+    CCoinsViewCache view;
+    std::vector<CTransaction> vTx;
+    std::vector<std::unique_ptr<PrecomputedTransactionData>> vTxData;
+
+    BenchBlockInputs() : view(&viewDummy) {}
+};
+
+static void BuildBlockInputs(BenchBlockInputs& inputs, unsigned int nCount)
+{
+    CKey key;
+    key.MakeNewKey(true);
+    CPubKey pubkey = key.GetPubKey();
+    CScript scriptPubKey = GetScriptForDestination(pubkey.GetID());
+    const CAmount nValue = 1 * COIN;
+
+    // Script checks keep pointers to the transactions: no reallocation
+    inputs.vTx.reserve(nCount);
+    for (unsigned int i = 0; i < nCount; i++) {
+        CMutableTransaction txFund;
+        txFund.vout.resize(1);
+        txFund.vout[0].nValue = nValue;
+        txFund.vout[0].scriptPubKey = scriptPubKey;
+        txFund.nLockTime = i;
+        COutPoint prevout(txFund.GetHash(), 0);
+        inputs.view.AddCoin(prevout, Coin(txFund.vout[0], 1, false, false, 0), false);
+
+        CMutableTransaction tx;
+        tx.vin.resize(1);
+        tx.vin[0].prevout = prevout;
+        tx.vout.resize(1);
+        tx.vout[0].nValue = nValue - 1000;
+        tx.vout[0].scriptPubKey = scriptPubKey;
+
+        uint256 hash = SignatureHash(scriptPubKey, tx, 0, SIGHASH_ALL, nValue, SIGVERSION_BASE);
+        std::vector<unsigned char> vchSig;
+        key.Sign(hash, vchSig);
+        vchSig.push_back((unsigned char)SIGHASH_ALL);
+        tx.vin[0].scriptSig << vchSig << ToByteVector(pubkey);
+        inputs.vTx.emplace_back(tx);
+    }
+
+    for (const CTransaction& tx : inputs.vTx)
+        inputs.vTxData.emplace_back(new PrecomputedTransactionData(tx));
+}
+
+/** Verify every input of a block-sized batch on nThreads workers */
+static void VerifyBlockInputs(benchmark::State& state, int nThreads)
+{
+    ECC_Start();
+    {
+        BenchBlockInputs inputs;
+        BuildBlockInputs(inputs, BENCH_BLOCK_TXS);
+
+        // The connecting thread helps drain the queue, so spawn one fewer
+        std::unique_ptr<CVerifyPool> pool;
+        if (nThreads > 1) {
+            pool.reset(new CVerifyPool());
+            pool->Start(nThreads - 1);
+        }
+
+        const std::vector<CTransaction>& vTx = inputs.vTx;
+        while (state.KeepRunning()) {
+            CVerifyBatch batch(pool.get());
+            CValidationState valState;
+            for (size_t i = 0; i < vTx.size(); i++)
+                Africoin::CheckInputScripts(vTx[i], valState, inputs.view, STANDARD_SCRIPT_VERIFY_FLAGS,
+                                            false, *inputs.vTxData[i], &batch);
+            bool fOk = batch.Wait();
+            assert(fOk);
+        }
+    }
+    ECC_Stop();
+}
+
+static void ConnectBlockVerify1Thread(benchmark::State& state) { VerifyBlockInputs(state, 1); }
+static void ConnectBlockVerify2Threads(benchmark::State& state) { VerifyBlockInputs(state, 2); }
+static void ConnectBlockVerify4Threads(benchmark::State& state) { VerifyBlockInputs(state, 4); }
+static void ConnectBlockVerify8Threads(benchmark::State& state) { VerifyBlockInputs(state, 8); }
+
+BENCHMARK(ConnectBlockVerify1Thread);
+BENCHMARK(ConnectBlockVerify2Threads);
+BENCHMARK(ConnectBlockVerify4Threads);
+BENCHMARK(ConnectBlockVerify8Threads);
@@ -0,0 +1,373 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "arith_uint256.h"
+#include "chain.h"
+#include "consensus/blockforest.h"
+#include "security/checkpoints.h"
+#include "security/kernel.h"
+#include "security/stakemodifier.h"
+#include "staking/hybrid_difficulty.h"
+#include "staking/hybrid_staking.h"
+#include "staking/minter.h"
+#include "test/chaingen.h"
+#include "test/diffsim.h"
+
+#include <boost/filesystem.hpp>
+
+#include <assert.h>
+#include <stdio.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+using Africoin::BlockRef;
+using Africoin::CGenBlock;
+using PeerCoin::Kernel;
+
+static const uint32_t BENCH_CHAIN_BLOCKS = 200000;
+static const unsigned int BENCH_SAMPLES = 4096;
+/** Consecutive timestamps a staker probes per output in the scan benchmarks */
+static const unsigned int BENCH_SCAN_SECONDS = 64;
+
+/**
+ * One generated hybrid chain shared by every consensus benchmark, loaded
+ * from a fixture in the temp directory so repeated runs (and -compare
+ * baselines) measure exactly the same blocks. The chain is also loaded
+ * into a block forest and a CBlockIndex chain for the code that walks
+ * either.
+ */
+class BenchConsensusChain {
+public:
+    Africoin::CGeneratedChain chain;
+    Africoin::CBlockForest forest;
+    std::vector<BlockRef> vRefs;
+    std::unique_ptr<CBlockIndex[]> pIndex;
+    std::vector<uint32_t> vStakes;   //!< Heights of PoS and hybrid blocks
+
+    BenchConsensusChain()
+    {
+        Africoin::CChainGenParams params;
+        params.nBlocks = BENCH_CHAIN_BLOCKS;
+        boost::filesystem::path path = boost::filesystem::temp_directory_path() / "africoin-bench-chain.bin";
+        bool fLoaded = Africoin::LoadOrGenerateChain(path.string(), params, chain);
+        assert(fLoaded);
+
+        Africoin::BuildBlockForest(chain, forest);
+        for (uint32_t h = 0; h < chain.vBlocks.size(); h++)
+            vRefs.push_back(forest.GetAncestor(forest.Find(chain.vBlocks.back().hashBlock), h));
+
+        pIndex.reset(new CBlockIndex[chain.vBlocks.size()]);
+        for (uint32_t h = 0; h < chain.vBlocks.size(); h++) {
+            const CGenBlock& block = chain.vBlocks[h];
+            CBlockIndex& index = pIndex[h];
+            index.phashBlock = &block.hashBlock;
+            index.pprev = h > 0 ? &pIndex[h - 1] : nullptr;
+            index.nHeight = h;
+            index.nTime = block.nTime;
+            index.nBits = block.nBits;
+            if (block.IsProofOfStake()) {
+                index.SetProofOfStake();
+                vStakes.push_back(h);
+            }
+            index.SetStakeModifier(block.nStakeModifier, block.fGeneratedModifier);
+            index.BuildSkip();
+        }
+
+        fprintf(stderr, "Consensus benchmarks: %u blocks (%u PoS/hybrid) from %s\n",
+                (unsigned int)chain.vBlocks.size(), (unsigned int)vStakes.size(), path.string().c_str());
+    }
+
+    /** BENCH_SAMPLES random stake heights, the same on every run */
+    std::vector<uint32_t> SampleStakes(unsigned int nSeed) const
+    {
+        std::mt19937 rng(nSeed);
+        std::vector<uint32_t> vSample;
+        for (unsigned int i = 0; i < BENCH_SAMPLES; i++)
+            vSample.push_back(vStakes[rng() % vStakes.size()]);
+        return vSample;
+    }
+};
+
+static const BenchConsensusChain& GetBenchChain()
+{
+    static BenchConsensusChain chain;
+    return chain;
+}
+
+/** Kernel hash and coin-day target check for the stake input of a real block */
+static void KernelHash(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(1);
+
+    size_t n = 0, nHits = 0;
+    while (state.KeepRunning()) {
+        const CGenBlock& block = bench.chain.vBlocks[vSample[n++ % BENCH_SAMPLES]];
+        const CGenBlock& blockFrom = bench.chain.vBlocks[block.nBlockFromHeight];
+        uint256 hashProof = Kernel::ComputeKernelHash(blockFrom.nStakeModifier, blockFrom.nTime, block.nTxPrevOffset,
+                                                      block.nTxPrevTime, block.nPrevoutN, block.nTime);
+        nHits += Kernel::CheckKernelHashTarget(hashProof, block.nBits, block.nStakeValue,
+                                               block.nTxPrevTime, block.nTime);
+    }
+    (void)nHits;
+}
+
+/** Kernel hashes of one output over consecutive timestamps, serializing every field each time */
+static void KernelScanFull(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(6);
+
+    size_t n = 0;
+    uint64_t nSum = 0;
+    while (state.KeepRunning()) {
+        const CGenBlock& block = bench.chain.vBlocks[vSample[n++ % BENCH_SAMPLES]];
+        const CGenBlock& blockFrom = bench.chain.vBlocks[block.nBlockFromHeight];
+        for (unsigned int i = 0; i < BENCH_SCAN_SECONDS; i++)
+            nSum += Kernel::ComputeKernelHash(blockFrom.nStakeModifier, blockFrom.nTime, block.nTxPrevOffset,
+                                              block.nTxPrevTime, block.nPrevoutN, block.nTime + i).GetCheapHash();
+    }
+    (void)nSum;
+}
+
+/** The same scan finished from each output's cached kernel prefix midstate */
+static void KernelScanMidstate(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(6);
+
+    Africoin::CStakeMinter minter;
+    for (uint32_t nHeight : vSample) {
+        const CGenBlock& block = bench.chain.vBlocks[nHeight];
+        Africoin::CStakeCandidate candidate;
+        candidate.prevout = COutPoint(block.hashBlock, block.nPrevoutN);
+        candidate.hashBlockFrom = bench.chain.vBlocks[block.nBlockFromHeight].hashBlock;
+        candidate.nTimeBlockFrom = bench.chain.vBlocks[block.nBlockFromHeight].nTime;
+        candidate.nTxPrevOffset = block.nTxPrevOffset;
+        candidate.nTimeTxPrev = block.nTxPrevTime;
+        candidate.nValue = block.nStakeValue;
+        minter.AddCandidate(candidate);
+    }
+
+    size_t n = 0;
+    uint64_t nSum = 0;
+    while (state.KeepRunning()) {
+        const CGenBlock& block = bench.chain.vBlocks[vSample[n++ % BENCH_SAMPLES]];
+        const CGenBlock& blockFrom = bench.chain.vBlocks[block.nBlockFromHeight];
+        const Africoin::CKernelMidstate* pmidstate =
+            minter.GetMidstate(COutPoint(block.hashBlock, block.nPrevoutN), blockFrom.nStakeModifier);
+        for (unsigned int i = 0; i < BENCH_SCAN_SECONDS; i++)
+            nSum += pmidstate->Hash(block.nTime + i).GetCheapHash();
+    }
+    (void)nSum;
+}
+
+/** Time weight and coin-day weight of a stake input */
+static void KernelCoinAge(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(2);
+
+    size_t n = 0;
+    arith_uint256 bnTotal;
+    while (state.KeepRunning()) {
+        const CGenBlock& block = bench.chain.vBlocks[vSample[n++ % BENCH_SAMPLES]];
+        int64_t nWeight = Kernel::GetWeight(block.nTxPrevTime, block.nTime);
+        bnTotal += arith_uint256(block.nStakeValue) * arith_uint256(nWeight) / arith_uint256(COIN) / arith_uint256(24 * 60 * 60);
+    }
+}
+
+/** Find the modifier in effect for a blockFrom: forest walk plus the selection section */
+static void StakeModifierLookup(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(3);
+
+    size_t n = 0;
+    uint64_t nModifiers = 0;
+    while (state.KeepRunning()) {
+        const CGenBlock& block = bench.chain.vBlocks[vSample[n++ % BENCH_SAMPLES]];
+        BlockRef ref = bench.forest.GetLastModifierBlock(bench.vRefs[block.nBlockFromHeight]);
+        nModifiers ^= bench.forest.Cold(ref).nStakeModifier;
+        nModifiers += PeerCoin::StakeModifier::GetStakeModifierSelectionIntervalSection(n % PeerCoin::nStakeModifierSections);
+    }
+    (void)nModifiers;
+}
+
+/** Modifier of each block in chain order, as reindex computes it: v0.3 interval selection */
+static void StakeModifierCompute(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+
+    size_t n = 0;
+    uint64_t nSum = 0;
+    while (state.KeepRunning()) {
+        uint64_t nModifier = 0;
+        bool fGenerated = false;
+        BlockRef ref = bench.vRefs[1 + n++ % (bench.vRefs.size() - 1)];
+        PeerCoin::StakeModifier::ComputeNextStakeModifier(bench.forest, ref, nModifier, fGenerated);
+        nSum += nModifier;
+    }
+    (void)nSum;
+}
+
+/** The same chain moved past the v0.4 switch: one hash per block */
+static void StakeModifierComputeV04(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    static Africoin::CBlockForest forest;
+    static std::vector<BlockRef> vRefs;
+    if (vRefs.empty()) {
+        const int64_t nShift = PeerCoin::GetStakeModifierParams().nV04SwitchTime - bench.chain.vBlocks[0].nTime;
+        BlockRef prev = Africoin::NULL_BLOCK_REF;
+        for (BlockRef ref : bench.vRefs) {
+            prev = forest.Add(bench.forest.GetBlockHash(ref), prev, bench.forest.Hot(ref).nTime + nShift,
+                              bench.forest.Hot(ref).nBits, bench.forest.Hot(ref).nFlags);
+            forest.Cold(prev).nStakeModifier = bench.forest.Cold(ref).nStakeModifier;
+            vRefs.push_back(prev);
+        }
+    }
+
+    size_t n = 0;
+    uint64_t nSum = 0;
+    while (state.KeepRunning()) {
+        uint64_t nModifier = 0;
+        bool fGenerated = false;
+        PeerCoin::StakeModifier::ComputeNextStakeModifier(forest, vRefs[1 + n++ % (vRefs.size() - 1)], nModifier, fGenerated);
+        nSum += nModifier;
+    }
+    (void)nSum;
+}
+
+/** Per-type difficulty retarget after a random block, from the forest entry's state */
+static void HybridRetarget(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(5);
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        uint32_t nHeight = vSample[n % BENCH_SAMPLES];
+        Africoin::BlockType type = (Africoin::BlockType)bench.chain.vBlocks[nHeight].nType;
+        unsigned int nBits = Africoin::GetNextHybridTarget(bench.forest.Cold(bench.vRefs[nHeight - 1]).difficulty,
+                                                           type, nHeight);
+        (void)nBits;
+        n++;
+    }
+}
+
+/** The same retarget, finding the last blocks of each type by walking back */
+static void HybridRetargetWalk(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+    std::vector<uint32_t> vSample = bench.SampleStakes(5);
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        uint32_t nHeight = vSample[n % BENCH_SAMPLES];
+        Africoin::BlockType type = (Africoin::BlockType)bench.chain.vBlocks[nHeight].nType;
+        unsigned int nBits = Africoin::GetNextHybridTarget(Africoin::GetDifficultyStateByWalk(&bench.pIndex[nHeight - 1]),
+                                                           type, nHeight);
+        (void)nBits;
+        n++;
+    }
+}
+
+/** Print how long each track takes to absorb the standard shocks, once per run */
+static void ReportDifficultyShocks()
+{
+    static const struct {
+        const char* pszName;
+        double nHashFactor;
+        double nStakeFactor;
+    } shocks[] = {
+        {"10x hash", 10, 1},
+        {"0.1x hash", 0.1, 1},
+        {"10x stake", 1, 10},
+        {"0.1x stake", 1, 0.1},
+    };
+    static const int64_t nTimespans[] = {Africoin::nHybridTargetTimespan / 4, Africoin::nHybridTargetTimespan,
+                                         Africoin::nHybridTargetTimespan * 4};
+
+    fprintf(stderr, "Hybrid difficulty shocks (blocks / hours until expected spacing is within 10%%):\n");
+    for (int64_t nTimespan : nTimespans) {
+        for (const auto& shockDef : shocks) {
+            Africoin::CDiffSimParams params;
+            params.nTimespan = nTimespan;
+            Africoin::CDiffSimShock shock;
+            shock.nHashFactor = shockDef.nHashFactor;
+            shock.nStakeFactor = shockDef.nStakeFactor;
+            Africoin::CDiffSimResult result = Africoin::SimulateDifficultyShock(params, shock);
+            fprintf(stderr, "  timespan %3lldh %-10s PoW %5d / %5.1f  PoS %5d / %5.1f\n",
+                    (long long)(nTimespan / 3600), shockDef.pszName,
+                    result.pow.nBlocks, result.pow.nSeconds / 3600.0, result.pos.nBlocks, result.pos.nSeconds / 3600.0);
+        }
+    }
+}
+
+/** Simulated tenfold hashrate jump, warm-up included */
+static void HybridDifficultyShock(benchmark::State& state)
+{
+    static bool fReported = false;
+    if (!fReported) {
+        ReportDifficultyShocks();
+        fReported = true;
+    }
+
+    Africoin::CDiffSimParams params;
+    params.nWarmupBlocks = 2000;
+    params.nMaxBlocks = 2000;
+    Africoin::CDiffSimShock shock;
+    shock.nHashFactor = 10;
+
+    while (state.KeepRunning()) {
+        Africoin::CDiffSimResult result = Africoin::SimulateDifficultyShock(params, shock);
+        (void)result;
+        params.nSeed++;
+    }
+}
+
+/** Hardened checkpoint check and lookup for every block in turn */
+static void CheckpointCheck(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+
+    size_t n = 0, nPassed = 0;
+    while (state.KeepRunning()) {
+        const uint32_t nHeight = n++ % bench.chain.vBlocks.size();
+        nPassed += PeerCoin::Checkpoints::CheckHardened(nHeight, bench.chain.vBlocks[nHeight].hashBlock);
+        nPassed += PeerCoin::Checkpoints::GetCheckpointHash(nHeight).IsNull();
+    }
+    (void)nPassed;
+}
+
+/** Block reward (halvings and hybrid bonus) along the chain */
+static void BlockReward(benchmark::State& state)
+{
+    const BenchConsensusChain& bench = GetBenchChain();
+
+    size_t n = 0;
+    int64_t nTotal = 0;
+    while (state.KeepRunning()) {
+        const uint32_t nHeight = n++ % bench.chain.vBlocks.size();
+        nTotal += Africoin::HybridStaking::CalculateBlockReward(nHeight, (Africoin::BlockType)bench.chain.vBlocks[nHeight].nType);
+    }
+    (void)nTotal;
+}
+
+BENCHMARK(KernelHash);
+BENCHMARK(KernelScanFull);
+BENCHMARK(KernelScanMidstate);
+BENCHMARK(KernelCoinAge);
+BENCHMARK(StakeModifierLookup);
+BENCHMARK(StakeModifierCompute);
+BENCHMARK(StakeModifierComputeV04);
+BENCHMARK(HybridRetarget);
+BENCHMARK(HybridRetargetWalk);
+BENCHMARK(HybridDifficultyShock);
+BENCHMARK(CheckpointCheck);
+BENCHMARK(BlockReward);
@@ -0,0 +1,141 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "amount.h"
+#include "storage/flatcoins.h"
+#include "utiltime.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+using Africoin::CFlatCoinMeta;
+using Africoin::CFlatCoinsCache;
+
+// Roughly the UTXO set of a mature chain
+static const uint32_t BENCH_FLAT_COINS = 10 * 1000 * 1000;
+static const size_t BENCH_FLAT_LOOKUPS = 1 << 16;
+
+/** Coins database that drops what it is given: the flush cost is the cache's alone */
+class SinkCoinsView : public CCoinsView {
+public:
+    uint64_t nWritten = 0;
+
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock) override
+    {
+        nWritten += mapCoins.size();
+        mapCoins.clear();
+        return true;
+    }
+};
+
+static COutPoint BenchOutpoint(uint32_t i)
+{
+    uint256 hash;
+    uint64_t n = i * 0x9e3779b97f4a7c15ULL;
+    memcpy(hash.begin(), &n, 8);
+    memcpy(hash.begin() + 8, &i, 4);
+    return COutPoint(hash, i % 3);
+}
+
+/** A cache of BENCH_FLAT_COINS P2PKH-sized coins shared by the benchmarks, built once per process */
+static CFlatCoinsCache& GetBenchFlatCoins()
+{
+    static SinkCoinsView sink;
+    static CFlatCoinsCache cache(&sink, (size_t)4 << 30);
+
+    if (cache.GetCacheSize() == 0) {
+        std::mt19937 rng(49);
+        const CScript script = CScript() << std::vector<unsigned char>(25, 0x76);
+        cache.Reserve(BENCH_FLAT_COINS);
+        for (uint32_t i = 0; i < BENCH_FLAT_COINS; i++)
+            cache.AddCoin(BenchOutpoint(i), Coin(CTxOut(rng() % (1000 * COIN), script), i / 200, i % 200 == 0,
+                                                 i % 7 == 0, 1500000000 + i / 200 * 64), false);
+
+        int64_t nStart = GetTimeMicros();
+        bool fSynced = cache.Sync();
+        assert(fSynced);
+        int64_t nSyncMicros = GetTimeMicros() - nStart;
+
+        Africoin::CFlatCoinsStats stats = cache.GetStats();
+        fprintf(stderr, "FlatCoins: %u coins, %.1f bytes/coin; %u dirty coins written in %.0f ms\n",
+                (unsigned int)stats.nEntries, (double)cache.DynamicMemoryUsage() / stats.nEntries,
+                (unsigned int)sink.nWritten, nSyncMicros / 1000.0);
+    }
+    return cache;
+}
+
+static std::vector<COutPoint> BenchLookups()
+{
+    std::mt19937 rng(50);
+    std::vector<COutPoint> vLookups;
+    for (size_t i = 0; i < BENCH_FLAT_LOOKUPS; i++)
+        vLookups.push_back(BenchOutpoint(rng() % BENCH_FLAT_COINS));
+    return vLookups;
+}
+
+static void ReportLookups(benchmark::State& state, const char* strWhat)
+{
+    const benchmark::BenchResult& result = state.GetResult();
+    if (result.count && result.average > 0)
+        fprintf(stderr, "%s: %.1f M lookups/s\n", strWhat, 1 / result.average / 1e6);
+}
+
+/** Random hits, copying the script out as GetCoin does */
+static void FlatCoinsLookup(benchmark::State& state)
+{
+    const CFlatCoinsCache& cache = GetBenchFlatCoins();
+    const std::vector<COutPoint> vLookups = BenchLookups();
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        Coin coin;
+        bool fFound = cache.GetCoin(vLookups[n++ & (BENCH_FLAT_LOOKUPS - 1)], coin);
+        assert(fFound);
+    }
+    ReportLookups(state, "FlatCoins GetCoin");
+}
+
+/** Random hits for value, height and time only, as the kernel check reads them */
+static void FlatCoinsLookupMeta(benchmark::State& state)
+{
+    const CFlatCoinsCache& cache = GetBenchFlatCoins();
+    const std::vector<COutPoint> vLookups = BenchLookups();
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        CFlatCoinMeta meta;
+        bool fFound = cache.GetCoinMeta(vLookups[n++ & (BENCH_FLAT_LOOKUPS - 1)], meta);
+        assert(fFound);
+    }
+    ReportLookups(state, "FlatCoins GetCoinMeta");
+}
+
+/**
+ * A block's worth of coins spent and recreated, then a sync that writes
+ * only those. The same outpoints come back so the shared cache keeps
+ * every coin for the lookup benchmarks.
+ */
+static void FlatCoinsBlockSync(benchmark::State& state)
+{
+    CFlatCoinsCache& cache = GetBenchFlatCoins();
+    std::mt19937 rng(51);
+    while (state.KeepRunning()) {
+        for (int i = 0; i < 2000; i++) {
+            const COutPoint outpoint = BenchOutpoint(rng() % BENCH_FLAT_COINS);
+            Coin coin;
+            bool fSpent = cache.SpendCoin(outpoint, &coin);
+            assert(fSpent);
+            cache.AddCoin(outpoint, std::move(coin), false);
+        }
+        bool fSynced = cache.Sync();
+        assert(fSynced);
+    }
+}
+
+BENCHMARK(FlatCoinsLookup);
+BENCHMARK(FlatCoinsLookupMeta);
+BENCHMARK(FlatCoinsBlockSync);
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+
+using Africoin::Metrics::CCounter;
+using Africoin::Metrics::CHistogram;
+using Africoin::Metrics::CScopedTimer;
+
+static CCounter benchCounter("africoin_bench_events_total", "Benchmark events");
+static CHistogram benchHistogram("africoin_bench_latency_seconds", "Benchmark latency");
+
+/** One sharded counter increment */
+static void MetricsCounterAdd(benchmark::State& state)
+{
+    while (state.KeepRunning())
+        benchCounter.Add();
+}
+
+/** One histogram sample: bucket index plus three relaxed adds */
+static void MetricsHistogramRecord(benchmark::State& state)
+{
+    uint64_t nValue = 0;
+    while (state.KeepRunning())
+        benchHistogram.Record(nValue += 977);
+}
+
+/**
+ * A complete scoped timer (two clock reads and a sample). This is the
+ * whole cost added to each instrumented call; compare it with the
+ * KernelHash and StakeModifier benchmarks for the relative overhead.
+ */
+static void MetricsScopedTimer(benchmark::State& state)
+{
+    while (state.KeepRunning()) {
+        CScopedTimer timer(benchHistogram);
+    }
+}
+
+/** One recorded trace span: two clock reads and a ring buffer append */
+static void TraceSpan(benchmark::State& state)
+{
+    Africoin::Trace::g_fTraceEnabled = true;
+    while (state.KeepRunning()) {
+        Africoin::Trace::CTraceSpan span("BenchSpan", "bench");
+    }
+}
+
+/** A span while tracing is switched off: one relaxed load */
+static void TraceSpanDisabled(benchmark::State& state)
+{
+    Africoin::Trace::g_fTraceEnabled = false;
+    while (state.KeepRunning()) {
+        Africoin::Trace::CTraceSpan span("BenchSpan", "bench");
+    }
+    Africoin::Trace::g_fTraceEnabled = Africoin::Trace::DEFAULT_TRACE;
+}
+
+BENCHMARK(MetricsCounterAdd);
+BENCHMARK(MetricsHistogramRecord);
+BENCHMARK(MetricsScopedTimer);
+BENCHMARK(TraceSpan);
+BENCHMARK(TraceSpanDisabled);
@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "security/kernel.h"
+#include "staking/minter.h"
+
+#include <random>
+
+static const uint32_t BENCH_WALLET_OUTPUTS = 1000;
+static const uint32_t BENCH_ROUND_SECONDS = 16;
+/** Hard enough that rounds almost never hit, so every round does the full work */
+static const unsigned int BENCH_ROUND_BITS = 0x1c0fffff;
+
+/**
+ * A railway node's wallet: a few large allocations and many small
+ * outputs from recent payouts, most of them short of a whole coin-day.
+ */
+static void FillBenchWallet(Africoin::CStakeMinter& minter, uint32_t nNow)
+{
+    std::mt19937 rng(1);
+    for (uint32_t i = 0; i < BENCH_WALLET_OUTPUTS; i++) {
+        Africoin::CStakeCandidate candidate;
+        candidate.prevout = COutPoint(uint256(), i);
+        candidate.nTimeBlockFrom = nNow - PeerCoin::nStakeMaxAge + i;
+        candidate.nTxPrevOffset = 81 + i;
+        if (i % 20 == 0) {
+            candidate.nTimeTxPrev = nNow - PeerCoin::nStakeMinAge - rng() % PeerCoin::nStakeMaxAge;
+            candidate.nValue = (4000 + rng() % 2000) * COIN;
+        } else {
+            candidate.nTimeTxPrev = nNow - PeerCoin::nStakeMinAge - rng() % (6 * 60 * 60);
+            candidate.nValue = (1 + rng() % 20) * COIN;
+        }
+        minter.AddCandidate(candidate);
+    }
+}
+
+static bool BenchModifier(const Africoin::CStakeCandidate& candidate, uint64_t& nStakeModifier)
+{
+    nStakeModifier = candidate.nTimeBlockFrom;
+    return true;
+}
+
+/** Every output probed at every second of the round */
+static void StakeRoundNaive(benchmark::State& state)
+{
+    const uint32_t nNow = 1600000000;
+    Africoin::CStakeMinter minter;
+    FillBenchWallet(minter, nNow);
+
+    uint32_t nTime = nNow;
+    size_t nHits = 0;
+    while (state.KeepRunning()) {
+        for (uint32_t i = 0; i < BENCH_WALLET_OUTPUTS; i++) {
+            const Africoin::CStakeCandidate& candidate = *minter.GetCandidate(COutPoint(uint256(), i));
+            uint64_t nStakeModifier;
+            BenchModifier(candidate, nStakeModifier);
+            uint32_t nTimeTx;
+            uint256 hashProof;
+            nHits += minter.SearchKernel(candidate.prevout, nStakeModifier, BENCH_ROUND_BITS,
+                                         nTime, nTime + BENCH_ROUND_SECONDS - 1, nTimeTx, hashProof);
+        }
+        nTime += BENCH_ROUND_SECONDS;
+    }
+    (void)nHits;
+}
+
+/** The same rounds, skipping outputs until their first whole coin-day */
+static void StakeRoundScheduled(benchmark::State& state)
+{
+    const uint32_t nNow = 1600000000;
+    Africoin::CStakeMinter minter;
+    FillBenchWallet(minter, nNow);
+
+    uint32_t nTime = nNow;
+    size_t nHits = 0;
+    while (state.KeepRunning()) {
+        Africoin::CStakeHit hit;
+        Africoin::CStakeRoundStats stats;
+        nHits += minter.FindStake(BENCH_ROUND_BITS, nTime, nTime + BENCH_ROUND_SECONDS - 1, 0, BenchModifier, hit, stats);
+        nTime += BENCH_ROUND_SECONDS;
+    }
+    (void)nHits;
+}
+
+BENCHMARK(StakeRoundNaive);
+BENCHMARK(StakeRoundScheduled);
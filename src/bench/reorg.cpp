@@ -0,0 +1,175 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "arith_uint256.h"
+#include "chain.h"
+#include "coins.h"
+#include "consensus/blockforest.h"
+#include "consensus/reorg.h"
+#include "primitives/block.h"
+#include "undo.h"
+#include "validation.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+using namespace Africoin;
+
+/** Transactions per block besides the coinbase, each spending one from the parent block */
+static const int BENCH_REORG_TXS = 20;
+
+/** Chainstate held in memory, so the benchmark times the reorg rather than the database */
+class BenchCoinsView : public CCoinsView {
+public:
+    std::unordered_map<COutPoint, Coin, SaltedOutpointHasher> mapCoins;
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override
+    {
+        auto it = mapCoins.find(outpoint);
+        if (it == mapCoins.end())
+            return false;
+        coin = it->second;
+        return true;
+    }
+
+    bool BatchWrite(CCoinsMap& mapBatch, const uint256& hashBlock) override
+    {
+        for (auto& entry : mapBatch) {
+            if (!(entry.second.flags & CCoinsCacheEntry::DIRTY))
+                continue;
+            if (entry.second.coin.IsSpent())
+                mapCoins.erase(entry.first);
+            else
+                mapCoins[entry.first] = entry.second.coin;
+        }
+        mapBatch.clear();
+        return true;
+    }
+};
+
+/** Two branches of nDepth and nDepth + 1 blocks above a shared base, with stored blocks and undo data */
+struct BenchReorgChain {
+    CBlockForest forest;
+    std::vector<CBlock> vBlocks;              //!< By BlockRef
+    std::map<BlockRef, CBlockUndo> mapUndo;
+    CChainSlices slices;
+    CChainSlices::RailwayNodeMap mapNodes;
+    BlockRef tipA;
+    BlockRef tipB;
+
+    explicit BenchReorgChain(int nDepth)
+    {
+        mapNodes["TZR"].code = "TZR";
+        BlockRef fork = Extend(NULL_BLOCK_REF, 10, 0);
+        tipA = Extend(fork, nDepth, 1);
+        tipB = Extend(fork, nDepth + 1, 2);
+    }
+
+    BlockRef Extend(BlockRef prev, int n, uint32_t nBranch)
+    {
+        for (int i = 0; i < n; i++) {
+            int nHeight = prev == NULL_BLOCK_REF ? 0 : forest.Hot(prev).nHeight + 1;
+            uint32_t nTime = 1500000000 + nHeight * 64;
+            CBlock block;
+            block.nTime = nTime;
+            for (int t = 0; t <= BENCH_REORG_TXS; t++) {
+                CMutableTransaction tx;
+                tx.nTime = nTime;
+                tx.vin.resize(1);
+                if (t == 0 || prev == NULL_BLOCK_REF)
+                    tx.vin[0].scriptSig = CScript() << (int64_t)nHeight << (int64_t)nBranch << (int64_t)t;
+                else
+                    tx.vin[0].prevout = COutPoint(vBlocks[prev].vtx[t]->GetHash(), 0);
+                tx.vout.resize(2);
+                for (CTxOut& txout : tx.vout) {
+                    txout.nValue = 1000 + t;
+                    txout.scriptPubKey = CScript() << std::vector<unsigned char>(24, 0x76);
+                }
+                block.vtx.push_back(MakeTransactionRef(std::move(tx)));
+            }
+            BlockRef ref = forest.Add(ArithToUint256(arith_uint256((uint64_t)nBranch << 32 | nHeight)), prev, nTime,
+                                      0x1e0fffff, FOREST_PROOF_OF_STAKE);
+            vBlocks.resize(forest.Size());
+            vBlocks[ref] = block;
+            prev = ref;
+        }
+        return prev;
+    }
+
+    CReorgOptions Options()
+    {
+        CReorgOptions options;
+        options.fnReadUndo = [this](BlockRef ref, CBlock& block, CBlockUndo& blockundo, CFeeBurnUndo& burnundo) {
+            block = vBlocks[ref];
+            blockundo = mapUndo[ref];
+            return true;
+        };
+        options.fnReadBlock = [this](BlockRef ref, CBlock& block) {
+            block = vBlocks[ref];
+            return true;
+        };
+        options.fnConnect = [this](BlockRef ref, const CBlock& block, CCoinsViewCache& view, CValidationState& state) {
+            const CBlockForestHot& hot = forest.Hot(ref);
+            slices.RecordRailwayStake(mapNodes["TZR"], hot.nTime);
+            CBlockUndo& blockundo = mapUndo[ref];
+            blockundo.vtxundo.clear();
+            for (const CTransactionRef& tx : block.vtx) {
+                if (!tx->IsCoinBase()) {
+                    blockundo.vtxundo.emplace_back();
+                    Coin coin;
+                    if (!view.SpendCoin(tx->vin[0].prevout, &coin))
+                        return false;
+                    blockundo.vtxundo.back().vprevout.push_back(coin);
+                }
+                for (size_t i = 0; i < tx->vout.size(); i++)
+                    view.AddCoin(COutPoint(tx->GetHash(), i), Coin(tx->vout[i], hot.nHeight, tx->IsCoinBase(), false, tx->nTime), false);
+            }
+            return true;
+        };
+        options.pSlices = &slices;
+        options.pRailwayNodes = &mapNodes;
+        return options;
+    }
+};
+
+/** Switch between two branches of nDepth blocks and back; two reorgs per iteration */
+static void ReorgBlocks(benchmark::State& state, int nDepth)
+{
+    BenchReorgChain chain(nDepth);
+    CReorgOptions options = chain.Options();
+    BenchCoinsView base;
+    CValidationState validationState;
+    CReorgStats stats;
+
+    // Genesis coins straight into the chainstate, then everything up to branch A's tip
+    const CBlock& genesis = chain.vBlocks[0];
+    for (const CTransactionRef& tx : genesis.vtx)
+        for (size_t i = 0; i < tx->vout.size(); i++)
+            base.mapCoins[COutPoint(tx->GetHash(), i)] = Coin(tx->vout[i], 0, true, false, tx->nTime);
+    chain.slices.Reset(0);
+    BlockRef tip = 0;
+    bool fConnected = ReorganizeChain(chain.forest, tip, chain.tipA, base, options, validationState, stats);
+    assert(fConnected);
+
+    while (state.KeepRunning()) {
+        stats = CReorgStats();
+        bool fOk = ReorganizeChain(chain.forest, tip, chain.tipB, base, options, validationState, stats);
+        fOk &= ReorganizeChain(chain.forest, tip, chain.tipA, base, options, validationState, stats);
+        assert(fOk);
+    }
+    fprintf(stderr, "Reorg %d, last iteration: %s\n", nDepth, stats.ToString().c_str());
+}
+
+static void Reorg10(benchmark::State& state) { ReorgBlocks(state, 10); }
+static void Reorg100(benchmark::State& state) { ReorgBlocks(state, 100); }
+static void Reorg1000(benchmark::State& state) { ReorgBlocks(state, 1000); }
+
+BENCHMARK(Reorg10);
+BENCHMARK(Reorg100);
+BENCHMARK(Reorg1000);
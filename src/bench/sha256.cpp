@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "crypto/sha256_dispatch.h"
+
+#include <stdio.h>
+#include <vector>
+
+using namespace Africoin;
+
+static const size_t BENCH_SHA256_BUFFER = 1000 * 1000;
+/** Kernels or merkle pairs per iteration; a multiple of every backend's lane count */
+static const size_t BENCH_SHA256_MESSAGES = 1024;
+/** Serialized kernel: modifier, four kernel fields and nTimeTx */
+static const size_t BENCH_KERNEL_SIZE = 8 + 5 * 4;
+
+/**
+ * Run fn on a backend and report its throughput; bytes and hashes are per
+ * iteration. Backends this build or CPU lacks run an empty loop.
+ */
+template <typename Fn>
+static void SHA256BenchBackend(benchmark::State& state, SHA256Backend backend, const char* strWhat,
+                               size_t nBytes, size_t nHashes, Fn fn)
+{
+    const SHA256Backend previous = SHA256GetBackend();
+    if (!SHA256SetBackend(backend)) {
+        fprintf(stderr, "%s: %s not available here\n", strWhat, SHA256BackendName(backend));
+        while (state.KeepRunning()) {
+        }
+        return;
+    }
+    while (state.KeepRunning())
+        fn();
+    SHA256SetBackend(previous);
+
+    const benchmark::BenchResult& result = state.GetResult();
+    if (result.count && result.average > 0)
+        fprintf(stderr, "%s %s: %.1f MB/s, %.0f hashes/s\n", strWhat, SHA256BackendName(backend),
+                nBytes / result.average / 1e6, nHashes / result.average);
+}
+
+/** One 1 MB message: raw compression throughput */
+static void SHA256Buffer(benchmark::State& state, SHA256Backend backend)
+{
+    std::vector<unsigned char> vData(BENCH_SHA256_BUFFER, 0x5a);
+    unsigned char hash[SHA256_OUTPUT_SIZE];
+    SHA256BenchBackend(state, backend, "SHA256 1MB", vData.size(), 1, [&] {
+        SHA256Single(hash, vData.data(), vData.size());
+    });
+}
+
+/** Kernel hashes of consecutive timestamps, as the minter probes them */
+static void SHA256Kernels(benchmark::State& state, SHA256Backend backend)
+{
+    std::vector<unsigned char> vKernels(BENCH_SHA256_MESSAGES * BENCH_KERNEL_SIZE, 0x5a);
+    std::vector<unsigned char> vHashes(BENCH_SHA256_MESSAGES * SHA256_OUTPUT_SIZE);
+    SHA256BenchBackend(state, backend, "SHA256d kernels", vKernels.size(), BENCH_SHA256_MESSAGES, [&] {
+        SHA256dMany(vHashes.data(), vKernels.data(), BENCH_KERNEL_SIZE, BENCH_SHA256_MESSAGES);
+    });
+}
+
+/** One merkle tree level of hash pairs */
+static void SHA256MerkleLevel(benchmark::State& state, SHA256Backend backend)
+{
+    std::vector<unsigned char> vPairs(BENCH_SHA256_MESSAGES * 64, 0x5a);
+    std::vector<unsigned char> vHashes(BENCH_SHA256_MESSAGES * SHA256_OUTPUT_SIZE);
+    SHA256BenchBackend(state, backend, "SHA256D64", vPairs.size(), BENCH_SHA256_MESSAGES, [&] {
+        SHA256D64(vHashes.data(), vPairs.data(), BENCH_SHA256_MESSAGES);
+    });
+}
+
+static void SHA256BufferPortable(benchmark::State& state) { SHA256Buffer(state, SHA256_PORTABLE); }
+static void SHA256BufferSSE41(benchmark::State& state) { SHA256Buffer(state, SHA256_SSE41); }
+static void SHA256BufferAVX2(benchmark::State& state) { SHA256Buffer(state, SHA256_AVX2); }
+static void SHA256BufferSHANI(benchmark::State& state) { SHA256Buffer(state, SHA256_SHANI); }
+static void SHA256KernelsPortable(benchmark::State& state) { SHA256Kernels(state, SHA256_PORTABLE); }
+static void SHA256KernelsSSE41(benchmark::State& state) { SHA256Kernels(state, SHA256_SSE41); }
+static void SHA256KernelsAVX2(benchmark::State& state) { SHA256Kernels(state, SHA256_AVX2); }
+static void SHA256KernelsSHANI(benchmark::State& state) { SHA256Kernels(state, SHA256_SHANI); }
+static void SHA256D64Portable(benchmark::State& state) { SHA256MerkleLevel(state, SHA256_PORTABLE); }
+static void SHA256D64SSE41(benchmark::State& state) { SHA256MerkleLevel(state, SHA256_SSE41); }
+static void SHA256D64AVX2(benchmark::State& state) { SHA256MerkleLevel(state, SHA256_AVX2); }
+static void SHA256D64SHANI(benchmark::State& state) { SHA256MerkleLevel(state, SHA256_SHANI); }
+
+BENCHMARK(SHA256BufferPortable);
+BENCHMARK(SHA256BufferSSE41);
+BENCHMARK(SHA256BufferAVX2);
+BENCHMARK(SHA256BufferSHANI);
+BENCHMARK(SHA256KernelsPortable);
+BENCHMARK(SHA256KernelsSSE41);
+BENCHMARK(SHA256KernelsAVX2);
+BENCHMARK(SHA256KernelsSHANI);
+BENCHMARK(SHA256D64Portable);
+BENCHMARK(SHA256D64SSE41);
+BENCHMARK(SHA256D64AVX2);
+BENCHMARK(SHA256D64SHANI);
@@ -0,0 +1,104 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "consensus/stakeseen.h"
+#include "primitives/block.h"
+#include "streams.h"
+#include "version.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+using Africoin::CStakeId;
+using Africoin::CStakeSeenIndex;
+
+static uint256 BenchHash(std::mt19937_64& rng)
+{
+    uint256 hash;
+    for (int i = 0; i < 4; i++) {
+        uint64_t n = rng();
+        memcpy(hash.begin() + 8 * i, &n, 8);
+    }
+    return hash;
+}
+
+/** An index holding the stakes of a full DEFAULT_STAKE_SEEN_DEPTH window */
+static void FillStakeSeen(CStakeSeenIndex& index, std::mt19937_64& rng)
+{
+    for (int nHeight = 0; nHeight < Africoin::DEFAULT_STAKE_SEEN_DEPTH; nHeight++)
+        index.AddBlockStake(CStakeId(COutPoint(BenchHash(rng), rng() % 4), 1500000000 + nHeight * 64), nHeight);
+}
+
+/**
+ * Flood of PoS blocks reusing a stake already in the index: the cost per
+ * rejected block is deserializing it from the wire and one lookup
+ */
+static void StakeSeenFloodReject(benchmark::State& state)
+{
+    std::mt19937_64 rng(42);
+    CStakeSeenIndex index;
+    FillStakeSeen(index, rng);
+
+    // A PoS block with a coinstake and 50 ordinary transactions
+    CBlock block;
+    block.nTime = 1500000000;
+    for (int i = 0; i < 52; i++) {
+        CMutableTransaction tx;
+        tx.vin.resize(i == 0 ? 1 : 2);
+        for (CTxIn& txin : tx.vin) {
+            txin.prevout = COutPoint(BenchHash(rng), 0);
+            txin.scriptSig = CScript() << std::vector<unsigned char>(72, 0x30) << std::vector<unsigned char>(33, 0x02);
+        }
+        tx.vout.resize(2);
+        for (CTxOut& txout : tx.vout) {
+            txout.nValue = 1000;
+            txout.scriptPubKey = CScript() << std::vector<unsigned char>(25, 0x76);
+        }
+        block.vtx.push_back(MakeTransactionRef(std::move(tx)));
+    }
+    index.AddBlockStake(Africoin::GetBlockStake(block), Africoin::DEFAULT_STAKE_SEEN_DEPTH);
+
+    CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
+    ssBlock << block;
+    const std::vector<char> vMessage(ssBlock.begin(), ssBlock.end());
+
+    while (state.KeepRunning()) {
+        CDataStream ss(vMessage.data(), vMessage.data() + vMessage.size(), SER_NETWORK, PROTOCOL_VERSION);
+        CBlock received;
+        ss >> received;
+        bool fAccepted = index.CheckBlockStake(Africoin::GetBlockStake(received), false);
+        assert(!fAccepted);
+    }
+
+    Africoin::CStakeSeenStats stats = index.GetStats();
+    fprintf(stderr, "StakeSeen: %u-byte block, %u stakes, %.2f filter bytes/stake, %llu rejected\n",
+            (unsigned int)vMessage.size(), (unsigned int)stats.nStakes, (double)stats.nFilterBytes / stats.nStakes,
+            (unsigned long long)stats.nRejected);
+}
+
+/** Lookup of stakes not in the index, the normal case, answered by the filter */
+static void StakeSeenLookupNew(benchmark::State& state)
+{
+    std::mt19937_64 rng(43);
+    CStakeSeenIndex index;
+    FillStakeSeen(index, rng);
+
+    std::vector<CStakeId> vStakes;
+    for (int i = 0; i < 4096; i++)
+        vStakes.push_back(CStakeId(COutPoint(BenchHash(rng), 0), 1600000000 + i * 16));
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        bool fAccepted = index.CheckBlockStake(vStakes[n++ & 4095], false);
+        (void)fAccepted;
+    }
+}
+
+BENCHMARK(StakeSeenFloodReject);
+BENCHMARK(StakeSeenLookupNew);
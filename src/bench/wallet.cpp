@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench/bench.h"
+
+#include "wallet/staking.h"
+#include "wallet/wallet.h"
+
+#include <stdio.h>
+#include <random>
+
+static const uint32_t BENCH_WALLET_COINS = 100000;
+static const uint32_t BENCH_WALLET_NOW = 1600000000;
+
+/** A railway wallet: 100k small outputs spread over twice the maximum stake age */
+static void FillCoinStore(Africoin::CWalletCoinStore& store)
+{
+    std::mt19937 rng(1);
+    for (uint32_t i = 0; i < BENCH_WALLET_COINS; i++) {
+        uint32_t nTime = BENCH_WALLET_NOW - rng() % (2 * PeerCoin::nStakeMaxAge);
+        store.AddCoin(Africoin::CWalletCoin(COutPoint(uint256(), i), (1 + rng() % 100) * COIN, nTime, 81));
+    }
+    store.AdvanceTime(BENCH_WALLET_NOW);
+}
+
+/** getstakinginfo totals by walking every coin */
+static void StakingInfoScan(benchmark::State& state)
+{
+    Africoin::CWalletCoinStore store;
+    FillCoinStore(store);
+
+    uint32_t nNow = BENCH_WALLET_NOW;
+    uint64_t nWeight = 0;
+    while (state.KeepRunning())
+        nWeight += store.GetStakingInfoByScan(nNow++).nStakeWeight;
+    (void)nWeight;
+}
+
+/** getstakinginfo totals from the running aggregates, one second later each time */
+static void StakingInfoIncremental(benchmark::State& state)
+{
+    Africoin::CWalletCoinStore store;
+    FillCoinStore(store);
+
+    uint32_t nNow = BENCH_WALLET_NOW;
+    uint64_t nWeight = 0;
+    while (state.KeepRunning())
+        nWeight += store.GetStakingInfo(nNow++).nStakeWeight;
+    (void)nWeight;
+}
+
+/** Spend one coin and receive one, as a staking node does every block */
+static void WalletCoinChurn(benchmark::State& state)
+{
+    Africoin::CWalletCoinStore store;
+    FillCoinStore(store);
+
+    uint32_t n = 0;
+    while (state.KeepRunning()) {
+        store.SpendCoin(COutPoint(uint256(), n));
+        store.AddCoin(Africoin::CWalletCoin(COutPoint(uint256(), BENCH_WALLET_COINS + n), COIN, BENCH_WALLET_NOW, 81));
+        n++;
+    }
+}
+
+/** Dry-run output plan for the railway wallet, capped at 10k outputs, with a year simulated both ways */
+static void StakeOutputPlan(benchmark::State& state)
+{
+    Africoin::CWalletCoinStore store;
+    FillCoinStore(store);
+
+    Africoin::CStakeSimParams params;
+    params.nBits = 0x1c15fd7f;
+    params.nStartTime = BENCH_WALLET_NOW;
+    params.nReward = 10 * COIN;
+
+    static bool fReported = false;
+    while (state.KeepRunning()) {
+        Africoin::CStakeOutputPlan plan = Africoin::PlanStakeOutputs(store, params, 0.9, 10000);
+        if (!fReported) {
+            printf("%s", Africoin::FormatStakeOutputPlan(plan, params).c_str());
+            fReported = true;
+        }
+        params.nSeed++;
+    }
+}
+
+BENCHMARK(StakingInfoScan);
+BENCHMARK(StakingInfoIncremental);
+BENCHMARK(WalletCoinChurn);
+BENCHMARK(StakeOutputPlan);
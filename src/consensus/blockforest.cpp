@@ -0,0 +1,251 @@
+// Copyright (c) 2009-2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file blockforest.cpp
+ * @brief Arena-allocated block index with 32-bit parent and skip links
+ */
+
+#include "consensus/blockforest.h"
+
+#include "memusage.h"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace Africoin {
+
+CBlockForest g_blockForest;
+
+/** Turn the lowest '1' bit in the binary representation of a number into a '0'. */
+static inline int InvertLowestOne(int n) { return n & (n - 1); }
+
+/** Compute what height to jump back to with the skip link (same as CBlockIndex). */
+int GetSkipHeight(int height)
+{
+    if (height < 2)
+        return 0;
+
+    // Determine which height to jump back to. Any number strictly lower than height is acceptable,
+    // but the following expression seems to perform well in simulations (max 110 steps to go back
+    // up to 2**18 blocks).
+    return (height & 1) ? InvertLowestOne(InvertLowestOne(height - 1)) + 1 : InvertLowestOne(height);
+}
+
+arith_uint256 GetTargetTrust(uint32_t nBits)
+{
+    arith_uint256 bnTarget;
+    bool fNegative;
+    bool fOverflow;
+    bnTarget.SetCompact(nBits, &fNegative, &fOverflow);
+    if (fNegative || fOverflow || bnTarget == 0)
+        return 0;
+    // We need to compute 2**256 / (bnTarget+1), but we can't represent 2**256
+    // as it's too large for an arith_uint256. However, as 2**256 is at least as large
+    // as bnTarget+1, it is equal to ((2**256 - bnTarget - 1) / (bnTarget+1)) + 1,
+    // or ~bnTarget / (bnTarget+1) + 1.
+    return (~bnTarget / (bnTarget + 1)) + 1;
+}
+
+arith_uint256 GetBlockTrust(const CBlockForestHot& hot, const CHybridDifficultyState& statePrev)
+{
+    arith_uint256 bnTrust = GetTargetTrust(hot.nBits);
+    if (!(hot.nFlags & FOREST_HYBRID))
+        return bnTrust;
+
+    // One proof per track, neither worth more than a regular block of that track
+    arith_uint256 bnPoW = GetTargetTrust(GetNextHybridTarget(statePrev, BLOCK_TYPE_POW, hot.nHeight));
+    arith_uint256 bnPoS = GetTargetTrust(GetNextHybridTarget(statePrev, BLOCK_TYPE_POS, hot.nHeight));
+    return std::min(bnTrust, bnPoW) + std::min(bnTrust, bnPoS);
+}
+
+CBlockForest::CBlockForest() : nSize(0), setCandidates(CandidateOrder{this}), nCandidateSequence(0)
+{
+}
+
+BlockRef CBlockForest::Add(const uint256& hash, BlockRef nPrev, uint32_t nTime, uint32_t nBits, uint32_t nFlags)
+{
+    auto it = mapRefs.find(hash);
+    if (it != mapRefs.end())
+        return it->second;
+
+    assert(nSize < NULL_BLOCK_REF);
+    assert(nPrev == NULL_BLOCK_REF || nPrev < nSize);
+
+    if ((nSize & CHUNK_MASK) == 0) {
+        vHot.emplace_back(new CBlockForestHot[CHUNK_SIZE]);
+        vCold.emplace_back(new CBlockForestCold[CHUNK_SIZE]);
+    }
+
+    BlockRef ref = nSize++;
+    CBlockForestHot& hot = Hot(ref);
+    hot.nPrev = nPrev;
+    hot.nHeight = nPrev == NULL_BLOCK_REF ? 0 : Hot(nPrev).nHeight + 1;
+    hot.nSkip = nPrev == NULL_BLOCK_REF ? NULL_BLOCK_REF : GetAncestor(nPrev, GetSkipHeight(hot.nHeight));
+    hot.nTime = nTime;
+    hot.nBits = nBits;
+    hot.nFlags = nFlags;
+
+    CBlockForestCold& cold = Cold(ref);
+    cold = CBlockForestCold();
+    cold.hashBlock = hash;
+    if (nPrev != NULL_BLOCK_REF)
+        cold.difficulty = Cold(nPrev).difficulty;
+    cold.nChainTrust = (nPrev == NULL_BLOCK_REF ? arith_uint256(0) : Cold(nPrev).nChainTrust) +
+                       GetBlockTrust(hot, cold.difficulty);
+    cold.difficulty.Advance(nFlags & FOREST_PROOF_OF_STAKE, nBits, nTime);
+
+    mapRefs.emplace(hash, ref);
+    return ref;
+}
+
+BlockRef CBlockForest::Find(const uint256& hash) const
+{
+    auto it = mapRefs.find(hash);
+    return it == mapRefs.end() ? NULL_BLOCK_REF : it->second;
+}
+
+void CBlockForest::Resize(uint32_t nBlocks)
+{
+    assert(nSize == 0 && nBlocks < NULL_BLOCK_REF);
+    for (uint32_t nChunk = 0; nChunk < (nBlocks + CHUNK_MASK) >> CHUNK_BITS; nChunk++) {
+        vHot.emplace_back(new CBlockForestHot[CHUNK_SIZE]);
+        vCold.emplace_back(new CBlockForestCold[CHUNK_SIZE]);
+    }
+    nSize = nBlocks;
+}
+
+bool CBlockForest::IndexBlock(const uint256& hash, BlockRef ref)
+{
+    assert(ref < nSize);
+    return mapRefs.emplace(hash, ref).second;
+}
+
+void CBlockForest::Clear()
+{
+    setCandidates.clear();
+    mapRefs.clear();
+    vHot.clear();
+    vCold.clear();
+    nSize = 0;
+    nCandidateSequence = 0;
+}
+
+BlockRef CBlockForest::GetAncestor(BlockRef ref, int nHeight) const
+{
+    if (ref == NULL_BLOCK_REF || nHeight > Hot(ref).nHeight || nHeight < 0)
+        return NULL_BLOCK_REF;
+
+    BlockRef walk = ref;
+    int nHeightWalk = Hot(ref).nHeight;
+    while (nHeightWalk > nHeight) {
+        const CBlockForestHot& hot = Hot(walk);
+        int nHeightSkip = GetSkipHeight(nHeightWalk);
+        int nHeightSkipPrev = GetSkipHeight(nHeightWalk - 1);
+        if (hot.nSkip != NULL_BLOCK_REF &&
+            (nHeightSkip == nHeight ||
+             (nHeightSkip > nHeight && !(nHeightSkipPrev < nHeightSkip - 2 &&
+                                         nHeightSkipPrev >= nHeight)))) {
+            // Only follow skip if prev->skip isn't better than skip->prev.
+            walk = hot.nSkip;
+            nHeightWalk = nHeightSkip;
+        } else {
+            assert(hot.nPrev != NULL_BLOCK_REF);
+            walk = hot.nPrev;
+            nHeightWalk--;
+        }
+    }
+    return walk;
+}
+
+BlockRef CBlockForest::GetLastModifierBlock(BlockRef ref) const
+{
+    while (ref != NULL_BLOCK_REF && !Hot(ref).GeneratedStakeModifier())
+        ref = Hot(ref).nPrev;
+    return ref;
+}
+
+BlockRef CBlockForest::FindFork(BlockRef a, BlockRef b) const
+{
+    if (a == NULL_BLOCK_REF || b == NULL_BLOCK_REF)
+        return NULL_BLOCK_REF;
+
+    if (Hot(a).nHeight > Hot(b).nHeight)
+        a = GetAncestor(a, Hot(b).nHeight);
+    else if (Hot(b).nHeight > Hot(a).nHeight)
+        b = GetAncestor(b, Hot(a).nHeight);
+
+    // Skip heights depend only on the height, so both skip links land at
+    // the same height. If they differ the fork is below it and both can
+    // jump; otherwise it is between there and here, so step back one.
+    while (a != b && a != NULL_BLOCK_REF && b != NULL_BLOCK_REF) {
+        const CBlockForestHot& hotA = Hot(a);
+        const CBlockForestHot& hotB = Hot(b);
+        if (hotA.nSkip != hotB.nSkip && hotA.nSkip != NULL_BLOCK_REF && hotB.nSkip != NULL_BLOCK_REF) {
+            a = hotA.nSkip;
+            b = hotB.nSkip;
+        } else {
+            a = hotA.nPrev;
+            b = hotB.nPrev;
+        }
+    }
+    return a == b ? a : NULL_BLOCK_REF;
+}
+
+bool CBlockForest::CandidateOrder::operator()(BlockRef a, BlockRef b) const
+{
+    const CBlockForestCold& coldA = forest->Cold(a);
+    const CBlockForestCold& coldB = forest->Cold(b);
+    if (coldA.nChainTrust != coldB.nChainTrust)
+        return coldA.nChainTrust > coldB.nChainTrust;
+    if (coldA.nSequenceId != coldB.nSequenceId)
+        return coldA.nSequenceId < coldB.nSequenceId;
+    return a < b;
+}
+
+void CBlockForest::AddCandidate(BlockRef ref)
+{
+    // The sequence number is part of the ordering: never change it while in the set
+    if (setCandidates.count(ref))
+        return;
+    if (Cold(ref).nSequenceId == 0)
+        Cold(ref).nSequenceId = ++nCandidateSequence;
+    else
+        nCandidateSequence = std::max(nCandidateSequence, Cold(ref).nSequenceId);
+    setCandidates.insert(ref);
+}
+
+void CBlockForest::RemoveCandidate(BlockRef ref)
+{
+    setCandidates.erase(ref);
+}
+
+BlockRef CBlockForest::GetBestCandidate() const
+{
+    return setCandidates.empty() ? NULL_BLOCK_REF : *setCandidates.begin();
+}
+
+void CBlockForest::PruneCandidates(BlockRef tip)
+{
+    // Everything ordered after the tip can never become the tip again
+    auto it = setCandidates.upper_bound(tip);
+    setCandidates.erase(it, setCandidates.end());
+}
+
+size_t CBlockForest::DynamicMemoryUsage() const
+{
+    size_t nChunk = memusage::MallocUsage(sizeof(CBlockForestHot) * CHUNK_SIZE) +
+                    memusage::MallocUsage(sizeof(CBlockForestCold) * CHUNK_SIZE);
+    return vHot.size() * nChunk + memusage::DynamicUsage(vHot) + memusage::DynamicUsage(vCold) +
+           memusage::DynamicUsage(mapRefs) + memusage::DynamicUsage(setCandidates);
+}
+
+void CBlockForest::Reserve(size_t nBlocks)
+{
+    mapRefs.reserve(nBlocks);
+}
+
+} // namespace Africoin
@@ -0,0 +1,251 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_BLOCKFOREST_H
+#define AFRICOIN_CONSENSUS_BLOCKFOREST_H
+
+#include "arith_uint256.h"
+#include "staking/hybrid_difficulty.h"
+#include "uint256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file blockforest.h
+ * @brief Arena-allocated block index with 32-bit parent and skip links
+ *
+ * The stake modifier, block type selection, hybrid modifier and checkpoint
+ * code all walk backwards through the block index. With heap-allocated
+ * CBlockIndex objects every step is a pointer into a random cache line of
+ * a ~200 byte object of which only the parent, height, time and flags are
+ * read.
+ *
+ * The forest keeps every entry in two parallel arenas addressed by a
+ * 32-bit BlockRef:
+ *
+ * - Hot entries (24 bytes): parent, skip link, height, time, bits and
+ *   flags. Chain walks only ever touch these, so two or three entries
+ *   share a cache line and a whole 5M-block chain is ~120 MB.
+ * - Cold entries: block hash, PoS proof hash, stake modifier and its
+ *   checksum, per-type difficulty state, validation status and disk
+ *   positions. Read once at the end of a walk, or when a block is
+ *   connected.
+ *
+ * The arenas grow in fixed-size chunks, so references and entry addresses
+ * stay valid while blocks are added. Entries are never removed; like
+ * mapBlockIndex, the forest is protected by cs_main.
+ *
+ * Skip links use the same deterministic skip heights as CBlockIndex, so
+ * GetAncestor and FindFork are O(log n).
+ *
+ * Chain trust is accumulated on Add from the parent's, and blocks whose
+ * data is available are kept in a set of tip candidates ordered by trust,
+ * so the best tip is found in O(log n) without comparing forks.
+ */
+
+namespace Africoin {
+
+/** Index of an entry in the forest arenas */
+typedef uint32_t BlockRef;
+static const BlockRef NULL_BLOCK_REF = 0xffffffff;
+
+/** Entry flags; values match the PoS flags of CBlockIndex */
+enum BlockForestFlags : uint32_t {
+    FOREST_PROOF_OF_STAKE = (1 << 0),   //!< Is a proof-of-stake block
+    FOREST_STAKE_ENTROPY = (1 << 1),    //!< Entropy bit for the stake modifier
+    FOREST_STAKE_MODIFIER = (1 << 2),   //!< Regenerated the stake modifier
+    FOREST_HYBRID = (1 << 3),           //!< Passed both PoW and PoS validation
+};
+
+/**
+ * @struct CBlockForestHot
+ * @brief Fields read while walking the chain
+ */
+struct CBlockForestHot {
+    BlockRef nPrev;
+    BlockRef nSkip;
+    int32_t nHeight;
+    uint32_t nTime;
+    uint32_t nBits;
+    uint32_t nFlags;
+
+    bool IsProofOfStake() const { return nFlags & FOREST_PROOF_OF_STAKE; }
+    bool GeneratedStakeModifier() const { return nFlags & FOREST_STAKE_MODIFIER; }
+    unsigned int GetStakeEntropyBit() const { return (nFlags & FOREST_STAKE_ENTROPY) ? 1 : 0; }
+};
+
+/**
+ * @struct CBlockForestCold
+ * @brief Fields read once per block rather than once per walk step
+ */
+struct CBlockForestCold {
+    uint256 hashBlock;
+    uint256 hashProof;
+    uint64_t nStakeModifier;
+    uint32_t nStakeModifierChecksum;
+    uint32_t nStatus;
+    int32_t nFile;
+    uint32_t nDataPos;
+    uint32_t nUndoPos;
+    CHybridDifficultyState difficulty;   //!< As of this block, derived from the parent's on Add
+    arith_uint256 nChainTrust;           //!< Total trust up to and including this block
+    uint32_t nSequenceId;                //!< Order in which it became a tip candidate (0: never)
+
+    CBlockForestCold()
+        : nStakeModifier(0), nStakeModifierChecksum(0), nStatus(0), nFile(-1), nDataPos(0), nUndoPos(0),
+          nSequenceId(0) {}
+};
+
+/** @brief 2^256 / (target + 1) for nBits; 0 for an invalid or zero target */
+arith_uint256 GetTargetTrust(uint32_t nBits);
+
+/**
+ * @brief Trust a block adds to its chain
+ *
+ * A PoW or PoS block adds GetTargetTrust(nBits): the expected number of
+ * hashes for PoW, of kernel hashes per coin-day for PoS. The two are
+ * added 1:1 without rescaling, as in BlackCoin. Each type retargets on
+ * its own track to its share of the blocks (hybrid_difficulty.h), so
+ * per unit of time each track adds trust in proportion to its own
+ * difficulty.
+ *
+ * A hybrid block carries one proof on each track, both checked against
+ * its nBits, which is the easier of the two track targets. Each proof is
+ * credited with the trust of nBits, capped at the trust of its own
+ * track's target (GetNextHybridTarget from statePrev). The proof on the
+ * harder track therefore only earns the easier target's trust, and a
+ * hybrid block never adds more than one regular block of each type.
+ *
+ * @param statePrev Difficulty state of the parent (empty for genesis)
+ */
+arith_uint256 GetBlockTrust(const CBlockForestHot& hot, const CHybridDifficultyState& statePrev);
+
+/** @brief Height the skip link of a block at nHeight points to (as CBlockIndex) */
+int GetSkipHeight(int nHeight);
+
+/**
+ * @class CBlockForest
+ * @brief All known block headers, as a forest of arena entries
+ */
+class CBlockForest {
+public:
+    CBlockForest();
+
+    CBlockForest(const CBlockForest&) = delete;
+    CBlockForest& operator=(const CBlockForest&) = delete;
+
+    /**
+     * @brief Add a block whose parent is already in the forest
+     *
+     * @param hash   Block hash
+     * @param nPrev  Parent entry, or NULL_BLOCK_REF for the genesis block
+     * @return The new entry, or the existing one if hash is already known
+     */
+    BlockRef Add(const uint256& hash, BlockRef nPrev, uint32_t nTime, uint32_t nBits, uint32_t nFlags);
+
+    /** @brief Look up a block by hash (NULL_BLOCK_REF if unknown) */
+    BlockRef Find(const uint256& hash) const;
+
+    /**
+     * @brief Make room for nBlocks entries in an empty forest
+     *
+     * For loading a saved forest: the caller fills every entry in through
+     * Hot() and Cold(), from several threads if it likes, and registers
+     * each hash with IndexBlock. Nothing is derived from the parent.
+     */
+    void Resize(uint32_t nBlocks);
+
+    /** @brief Register the hash of an entry filled in after Resize; false if already known */
+    bool IndexBlock(const uint256& hash, BlockRef ref);
+
+    /** @brief Drop every entry, e.g. after a failed load */
+    void Clear();
+
+    const CBlockForestHot& Hot(BlockRef ref) const { return vHot[ref >> CHUNK_BITS][ref & CHUNK_MASK]; }
+    CBlockForestHot& Hot(BlockRef ref) { return vHot[ref >> CHUNK_BITS][ref & CHUNK_MASK]; }
+    const CBlockForestCold& Cold(BlockRef ref) const { return vCold[ref >> CHUNK_BITS][ref & CHUNK_MASK]; }
+    CBlockForestCold& Cold(BlockRef ref) { return vCold[ref >> CHUNK_BITS][ref & CHUNK_MASK]; }
+
+    BlockRef GetPrev(BlockRef ref) const { return Hot(ref).nPrev; }
+    const uint256& GetBlockHash(BlockRef ref) const { return Cold(ref).hashBlock; }
+
+    /** @brief Ancestor of ref at nHeight, following skip links */
+    BlockRef GetAncestor(BlockRef ref, int nHeight) const;
+
+    /** @brief Last ancestor (or ref itself) that generated a stake modifier */
+    BlockRef GetLastModifierBlock(BlockRef ref) const;
+
+    /** @brief Most recent common ancestor of two entries, following skip links */
+    BlockRef FindFork(BlockRef a, BlockRef b) const;
+
+    /**
+     * @brief Make a block a tip candidate
+     *
+     * For blocks whose data, and all of whose ancestors' data, is
+     * available. A block keeps the sequence number of its first addition,
+     * so among equal trust the one received first stays ahead.
+     */
+    void AddCandidate(BlockRef ref);
+
+    void RemoveCandidate(BlockRef ref);
+
+    bool IsCandidate(BlockRef ref) const { return setCandidates.count(ref); }
+
+    /** @brief Candidate with the most chain trust (NULL_BLOCK_REF if none) */
+    BlockRef GetBestCandidate() const;
+
+    /**
+     * @brief Drop candidates ranked below tip, once tip is connected
+     *
+     * Called by ReorganizeChain after the chainstate at the new tip is
+     * written. A dropped block becomes a candidate again when a
+     * descendant is added, or when it is added back explicitly.
+     */
+    void PruneCandidates(BlockRef tip);
+
+    size_t GetCandidateCount() const { return setCandidates.size(); }
+
+    size_t Size() const { return nSize; }
+
+    /** @brief Arena and hash map memory, for -dbcache accounting and benchmarks */
+    size_t DynamicMemoryUsage() const;
+
+    /** @brief Pre-size the hash lookup for an expected number of blocks */
+    void Reserve(size_t nBlocks);
+
+private:
+    static const unsigned int CHUNK_BITS = 16;
+    static const uint32_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static const uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+    struct RefHasher {
+        size_t operator()(const uint256& hash) const { return hash.GetCheapHash(); }
+    };
+
+    /** Most trust first, then first received */
+    struct CandidateOrder {
+        const CBlockForest* forest;
+
+        bool operator()(BlockRef a, BlockRef b) const;
+    };
+
+    std::vector<std::unique_ptr<CBlockForestHot[]>> vHot;
+    std::vector<std::unique_ptr<CBlockForestCold[]>> vCold;
+    uint32_t nSize;
+    std::unordered_map<uint256, BlockRef, RefHasher> mapRefs;
+    std::set<BlockRef, CandidateOrder> setCandidates;
+    uint32_t nCandidateSequence;
+};
+
+/** Block index of the running node, guarded by cs_main */
+extern CBlockForest g_blockForest;
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_BLOCKFOREST_H
@@ -1 +1,141 @@
-// fee_burner.cpp: Logic for transaction fee burning and management.
\ No newline at end of file
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file fee_burner.cpp
+ * @brief Streaming fee-burn accounting implementation
+ */
+
+#include "consensus/fee_burner.h"
+
+#include "util.h"
+
+#include <algorithm>
+
+namespace Africoin {
+
+FeeBurnLedger g_feeBurnLedger;
+
+CAmount FeeBurnLedger::GetBurnAmount(int nHeight, BlockType blockType, CAmount nFees, CAmount nValueCreated)
+{
+    if (nFees <= 0)
+        return 0;
+    CAmount nClaimed = nValueCreated - HybridStaking::CalculateBlockReward(nHeight, blockType);
+    return nFees - std::min(std::max(nClaimed, (CAmount)0), nFees);
+}
+
+CAmount FeeBurnLedger::GetMintAmount(int nHeight, BlockType blockType, CAmount nValueCreated)
+{
+    return std::min(std::max(nValueCreated, (CAmount)0), (CAmount)HybridStaking::CalculateBlockReward(nHeight, blockType));
+}
+
+bool FeeBurnLedger::ConnectBlock(int nHeight, CAmount nFees, CAmount nValueCreated, BlockType blockType,
+                                 CFeeBurnUndo& undo)
+{
+    if (nHeight != GetHeight() + 1)
+        return error("%s: height %d does not extend ledger tip %d", __func__, nHeight, GetHeight());
+
+    undo.nHeight = nHeight;
+    undo.nBurned = GetBurnAmount(nHeight, blockType, nFees, nValueCreated);
+    undo.nMinted = GetMintAmount(nHeight, blockType, nValueCreated);
+
+    CAmount nBurnedPrev = vBurnedPrefix.empty() ? 0 : vBurnedPrefix.back();
+    CAmount nMintedPrev = vMintedPrefix.empty() ? 0 : vMintedPrefix.back();
+    vBurnedPrefix.push_back(nBurnedPrev + undo.nBurned);
+    vMintedPrefix.push_back(nMintedPrev + undo.nMinted);
+
+    return true;
+}
+
+bool FeeBurnLedger::CheckUndo(const CFeeBurnUndo& undo, int nTip) const
+{
+    if (undo.nHeight != nTip || nTip < 0)
+        return error("%s: undo height %d does not match ledger tip %d", __func__, undo.nHeight, nTip);
+
+    // The undo record must agree with what was applied, otherwise the
+    // undo data and the ledger have diverged.
+    CAmount nBurnedBefore = nTip > 0 ? vBurnedPrefix[nTip - 1] : 0;
+    CAmount nMintedBefore = nTip > 0 ? vMintedPrefix[nTip - 1] : 0;
+    if (vBurnedPrefix[nTip] - nBurnedBefore != undo.nBurned ||
+        vMintedPrefix[nTip] - nMintedBefore != undo.nMinted)
+        return error("%s: undo record mismatch at height %d", __func__, nTip);
+    return true;
+}
+
+bool FeeBurnLedger::DisconnectBlock(const CFeeBurnUndo& undo)
+{
+    if (!CheckUndo(undo, GetHeight()))
+        return false;
+
+    vBurnedPrefix.pop_back();
+    vMintedPrefix.pop_back();
+    return true;
+}
+
+bool FeeBurnLedger::DisconnectBlocks(const std::vector<CFeeBurnUndo>& vUndo)
+{
+    int nTip = GetHeight();
+    for (const CFeeBurnUndo& undo : vUndo) {
+        if (!CheckUndo(undo, nTip))
+            return false;
+        nTip--;
+    }
+
+    vBurnedPrefix.resize(nTip + 1);
+    vMintedPrefix.resize(nTip + 1);
+    return true;
+}
+
+void FeeBurnLedger::RestoreBlocks(int nHeight, const std::vector<CFeeBurnUndo>& vUndo)
+{
+    size_t nSize = std::min<size_t>(std::max(nHeight + 1, 0), vBurnedPrefix.size());
+    vBurnedPrefix.resize(nSize);
+    vMintedPrefix.resize(nSize);
+    for (std::vector<CFeeBurnUndo>::const_reverse_iterator it = vUndo.rbegin(); it != vUndo.rend(); ++it) {
+        vBurnedPrefix.push_back((vBurnedPrefix.empty() ? 0 : vBurnedPrefix.back()) + it->nBurned);
+        vMintedPrefix.push_back((vMintedPrefix.empty() ? 0 : vMintedPrefix.back()) + it->nMinted);
+    }
+}
+
+CAmount FeeBurnLedger::RangeSum(const std::vector<CAmount>& vPrefix, int nHeightBegin, int nHeightEnd)
+{
+    if (vPrefix.empty())
+        return 0;
+    nHeightBegin = std::max(nHeightBegin, 0);
+    nHeightEnd = std::min(nHeightEnd, (int)vPrefix.size() - 1);
+    if (nHeightBegin > nHeightEnd)
+        return 0;
+    return vPrefix[nHeightEnd] - (nHeightBegin > 0 ? vPrefix[nHeightBegin - 1] : 0);
+}
+
+CAmount FeeBurnLedger::GetBurned(int nHeightBegin, int nHeightEnd) const
+{
+    return RangeSum(vBurnedPrefix, nHeightBegin, nHeightEnd);
+}
+
+CAmount FeeBurnLedger::GetMinted(int nHeightBegin, int nHeightEnd) const
+{
+    return RangeSum(vMintedPrefix, nHeightBegin, nHeightEnd);
+}
+
+CAmount FeeBurnLedger::GetBurnedInEpoch(int nEpoch) const
+{
+    if (nEpoch < 0)
+        return 0;
+    int nBegin = nEpoch * FEE_BURN_EPOCH_BLOCKS;
+    return GetBurned(nBegin, nBegin + FEE_BURN_EPOCH_BLOCKS - 1);
+}
+
+CAmount FeeBurnLedger::GetCirculatingSupply(int nHeight) const
+{
+    return GetMinted(0, nHeight) - GetBurned(0, nHeight);
+}
+
+void FeeBurnLedger::Clear()
+{
+    vBurnedPrefix.clear();
+    vMintedPrefix.clear();
+}
+
+} // namespace Africoin
@@ -0,0 +1,165 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_FEE_BURNER_H
+#define AFRICOIN_CONSENSUS_FEE_BURNER_H
+
+#include "amount.h"
+#include "serialize.h"
+#include "staking/hybrid_staking.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file fee_burner.h
+ * @brief Streaming fee-burn accounting
+ *
+ * Fees a block's coinbase and coinstake leave unclaimed are destroyed:
+ * no output holds them. The burn is computed inline while the block is
+ * connected, from its fees and its payout (the value its coinbase and
+ * coinstake create), and recorded in a per-height prefix sum together
+ * with a prefix sum of newly minted coins (the part of the payout up to
+ * HybridStaking::CalculateBlockReward). Range totals and circulating
+ * supply are then O(1) lookups. How much a block may pay out is left to
+ * block validation; the ledger only records what it did.
+ *
+ * Each connected block produces a CFeeBurnUndo record that is stored with
+ * the block's undo data, so disconnecting a block during a reorg only pops
+ * the tip of the prefix sums instead of recomputing anything.
+ *
+ * The ledger serializes as its two prefix vectors, so a chainstate
+ * snapshot can carry it instead of replaying every block's fees.
+ */
+
+namespace Africoin {
+
+/** Blocks per supply-reporting epoch (one week of 2.5 minute blocks) */
+static const int FEE_BURN_EPOCH_BLOCKS = 4032;
+
+/**
+ * @struct CFeeBurnUndo
+ * @brief Per-block burn record kept with the block undo data
+ */
+struct CFeeBurnUndo {
+    int nHeight;
+    CAmount nBurned;
+    CAmount nMinted;
+
+    CFeeBurnUndo() : nHeight(-1), nBurned(0), nMinted(0) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(nHeight);
+        READWRITE(nBurned);
+        READWRITE(nMinted);
+    }
+};
+
+/**
+ * @class FeeBurnLedger
+ * @brief Prefix-summed burned and minted supply per height
+ *
+ * Entry h of each prefix vector holds the running total for heights 0..h
+ * of the active chain. Blocks must be connected and disconnected strictly
+ * at the tip, which is how the chainstate applies them.
+ *
+ * Not internally synchronised: callers hold cs_main, as for the rest of
+ * the chainstate.
+ */
+class FeeBurnLedger {
+public:
+    /**
+     * @brief Fees the payout leaves unclaimed
+     *
+     * nFees minus what nValueCreated claims beyond the subsidy for the
+     * block type, between 0 and nFees.
+     */
+    static CAmount GetBurnAmount(int nHeight, BlockType blockType, CAmount nFees, CAmount nValueCreated);
+
+    /** @brief New coins in the payout: nValueCreated up to the subsidy for the block type */
+    static CAmount GetMintAmount(int nHeight, BlockType blockType, CAmount nValueCreated);
+
+    /**
+     * @brief Record a block connected at the tip
+     *
+     * @param nHeight Height of the block; must be GetHeight() + 1
+     * @param nFees Total transaction fees in the block
+     * @param nValueCreated Value created by the coinbase and coinstake
+     * @param blockType Block type used for the subsidy
+     * @param undo Output: record to store with the block undo data
+     * @return false if nHeight is not the next height
+     */
+    bool ConnectBlock(int nHeight, CAmount nFees, CAmount nValueCreated, BlockType blockType, CFeeBurnUndo& undo);
+
+    /**
+     * @brief Remove the tip block using its undo record
+     *
+     * @return false if the record does not describe the current tip
+     */
+    bool DisconnectBlock(const CFeeBurnUndo& undo);
+
+    /**
+     * @brief Remove several blocks at the tip, tip first, or none of them
+     *
+     * Every record is checked before anything is removed, so a mismatch
+     * leaves the ledger as it was.
+     *
+     * @return false if the records do not describe the blocks at the tip
+     */
+    bool DisconnectBlocks(const std::vector<CFeeBurnUndo>& vUndo);
+
+    /**
+     * @brief Put back blocks removed by DisconnectBlocks
+     *
+     * For a reorg that could not be written: drops the heights above
+     * nHeight, where DisconnectBlocks(vUndo) left the tip, and re-appends
+     * the blocks of vUndo.
+     */
+    void RestoreBlocks(int nHeight, const std::vector<CFeeBurnUndo>& vUndo);
+
+    /** @brief Fees burned in heights nHeightBegin..nHeightEnd (inclusive) */
+    CAmount GetBurned(int nHeightBegin, int nHeightEnd) const;
+
+    /** @brief Coins minted in heights nHeightBegin..nHeightEnd (inclusive) */
+    CAmount GetMinted(int nHeightBegin, int nHeightEnd) const;
+
+    /** @brief Fees burned during a reporting epoch (partial for the current one) */
+    CAmount GetBurnedInEpoch(int nEpoch) const;
+
+    /** @brief Minted minus burned supply up to and including nHeight */
+    CAmount GetCirculatingSupply(int nHeight) const;
+
+    /** @brief Height of the last connected block, -1 when empty */
+    int GetHeight() const { return (int)vBurnedPrefix.size() - 1; }
+
+    void Clear();
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(vBurnedPrefix);
+        READWRITE(vMintedPrefix);
+    }
+
+    /** @brief Both prefix sums cover the same heights (after deserializing) */
+    bool IsConsistent() const { return vBurnedPrefix.size() == vMintedPrefix.size(); }
+
+private:
+    bool CheckUndo(const CFeeBurnUndo& undo, int nTip) const;
+    static CAmount RangeSum(const std::vector<CAmount>& vPrefix, int nHeightBegin, int nHeightEnd);
+
+    std::vector<CAmount> vBurnedPrefix;
+    std::vector<CAmount> vMintedPrefix;
+};
+
+/** Ledger for the active chain (guarded by cs_main) */
+extern FeeBurnLedger g_feeBurnLedger;
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_FEE_BURNER_H
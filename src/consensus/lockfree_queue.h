@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_LOCKFREE_QUEUE_H
+#define AFRICOIN_CONSENSUS_LOCKFREE_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+/**
+ * @file lockfree_queue.h
+ * @brief Bounded multi-producer/multi-consumer lock-free queue
+ *
+ * Array-based queue with a per-cell sequence number (D. Vyukov's bounded
+ * MPMC design). Push and Pop are a single CAS on the fast path and never
+ * block; a full queue makes Push fail so the producer can run the work
+ * itself instead of waiting.
+ *
+ * T must be cheap to copy (the verification pool stores pointers).
+ */
+
+namespace Africoin {
+
+template <typename T>
+class CLockFreeQueue {
+public:
+    /** @param nCapacityIn Rounded up to the next power of two */
+    explicit CLockFreeQueue(size_t nCapacityIn)
+    {
+        size_t nCapacity = 2;
+        while (nCapacity < nCapacityIn)
+            nCapacity <<= 1;
+        nMask = nCapacity - 1;
+        cells.reset(new Cell[nCapacity]);
+        for (size_t i = 0; i < nCapacity; i++)
+            cells[i].nSequence.store(i, std::memory_order_relaxed);
+        nEnqueuePos.store(0, std::memory_order_relaxed);
+        nDequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    CLockFreeQueue(const CLockFreeQueue&) = delete;
+    CLockFreeQueue& operator=(const CLockFreeQueue&) = delete;
+
+    /** @return false if the queue is full */
+    bool Push(const T& value)
+    {
+        Cell* cell;
+        size_t nPos = nEnqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[nPos & nMask];
+            size_t nSeq = cell->nSequence.load(std::memory_order_acquire);
+            intptr_t nDiff = (intptr_t)nSeq - (intptr_t)nPos;
+            if (nDiff == 0) {
+                if (nEnqueuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (nDiff < 0) {
+                return false;
+            } else {
+                nPos = nEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->nSequence.store(nPos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @return false if the queue is empty */
+    bool Pop(T& value)
+    {
+        Cell* cell;
+        size_t nPos = nDequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[nPos & nMask];
+            size_t nSeq = cell->nSequence.load(std::memory_order_acquire);
+            intptr_t nDiff = (intptr_t)nSeq - (intptr_t)(nPos + 1);
+            if (nDiff == 0) {
+                if (nDequeuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (nDiff < 0) {
+                return false;
+            } else {
+                nPos = nDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->value;
+        cell->nSequence.store(nPos + nMask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Approximate number of queued items (racy, for heuristics only) */
+    size_t SizeApprox() const
+    {
+        size_t nEnq = nEnqueuePos.load(std::memory_order_relaxed);
+        size_t nDeq = nDequeuePos.load(std::memory_order_relaxed);
+        return nEnq > nDeq ? nEnq - nDeq : 0;
+    }
+
+    size_t Capacity() const { return nMask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> nSequence;
+        T value;
+    };
+
+    static const size_t CACHELINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    size_t nMask;
+    alignas(CACHELINE_SIZE) std::atomic<size_t> nEnqueuePos;
+    alignas(CACHELINE_SIZE) std::atomic<size_t> nDequeuePos;
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_LOCKFREE_QUEUE_H
@@ -0,0 +1,384 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file reorg.cpp
+ * @brief Chain reorganization with one coins write and per-height state slices
+ */
+
+#include "consensus/reorg.h"
+
+#include "chain.h"
+#include "coins.h"
+#include "consensus/fee_burner.h"
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+#include "primitives/block.h"
+#include "security/checkpoints.h"
+#include "security/stakemodifier.h"
+#include "storage/blockstore.h"
+#include "storage/reindex.h"
+#include "tinyformat.h"
+#include "undo.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace Africoin {
+
+METRIC_COUNTER(counterReorgs, "africoin_reorgs_total", "Chain reorganizations");
+METRIC_COUNTER(counterReorgDisconnected, "africoin_reorg_disconnected_blocks_total",
+               "Blocks disconnected by chain reorganizations");
+METRIC_HISTOGRAM(histReorg, "africoin_reorg_seconds", "Chain reorganization latency");
+
+CChainSlices::CChainSlices(size_t nDepthIn)
+    : nDepth(std::max<size_t>(nDepthIn, 1)), nFirstHeight(0), fJournal(false), nJournalFirstHeight(0),
+      nJournalLowHeight(0)
+{
+}
+
+bool CChainSlices::CanRewind(int nHeight) const
+{
+    return nHeight >= nFirstHeight - 1 && nHeight <= GetHeight();
+}
+
+const CChainSlice* CChainSlices::Get(int nHeight) const
+{
+    if (nHeight < nFirstHeight || nHeight > GetHeight())
+        return nullptr;
+    return &vSlices[nHeight - nFirstHeight];
+}
+
+void CChainSlices::RecordRailwayStake(RailwayStakingNode& node, int64_t nBlockTime)
+{
+    vPending.push_back(CRailwayStakeUndo{node.code, node.lastStakeTime, node.totalStakes});
+    node.lastStakeTime = nBlockTime;
+    node.totalStakes++;
+}
+
+void CChainSlices::Connect(BlockRef ref, uint64_t nStakeModifier, uint32_t nStakeModifierChecksum)
+{
+    vSlices.push_back(CChainSlice{ref, nStakeModifier, nStakeModifierChecksum, std::move(vPending)});
+    vPending.clear();
+    if (vSlices.size() > nDepth) {
+        // Slices connected since Begin are not part of the state to go back to
+        if (fJournal && nFirstHeight <= nJournalLowHeight)
+            vDropped.push_back(std::move(vSlices.front()));
+        vSlices.pop_front();
+        nFirstHeight++;
+    }
+}
+
+void CChainSlices::Restore(const CRailwayStakeUndo& undo, RailwayNodeMap& mapNodes)
+{
+    RailwayNodeMap::iterator it = mapNodes.find(undo.code);
+    if (it == mapNodes.end())
+        return;
+    it->second.lastStakeTime = undo.nLastStakeTime;
+    it->second.totalStakes = undo.nTotalStakes;
+}
+
+void CChainSlices::DiscardPending(RailwayNodeMap& mapNodes)
+{
+    for (std::vector<CRailwayStakeUndo>::reverse_iterator it = vPending.rbegin(); it != vPending.rend(); ++it)
+        Restore(*it, mapNodes);
+    vPending.clear();
+}
+
+bool CChainSlices::Rewind(int nHeight, RailwayNodeMap& mapNodes)
+{
+    if (!CanRewind(nHeight))
+        return false;
+    DiscardPending(mapNodes);
+    while (GetHeight() > nHeight) {
+        const std::vector<CRailwayStakeUndo>& vUndo = vSlices.back().vRailwayUndo;
+        for (std::vector<CRailwayStakeUndo>::const_reverse_iterator it = vUndo.rbegin(); it != vUndo.rend(); ++it)
+            Restore(*it, mapNodes);
+        if (fJournal && GetHeight() <= nJournalLowHeight)
+            vRewound.push_back(std::move(vSlices.back()));
+        vSlices.pop_back();
+    }
+    if (fJournal)
+        nJournalLowHeight = std::min(nJournalLowHeight, nHeight);
+    return true;
+}
+
+void CChainSlices::Reset(int nHeight)
+{
+    vSlices.clear();
+    vPending.clear();
+    nFirstHeight = nHeight + 1;
+}
+
+void CChainSlices::Begin(const RailwayNodeMap& mapNodes)
+{
+    Commit();
+    fJournal = true;
+    nJournalFirstHeight = nFirstHeight;
+    nJournalLowHeight = GetHeight();
+    mapJournalNodes = mapNodes;
+}
+
+void CChainSlices::Commit()
+{
+    fJournal = false;
+    vRewound.clear();
+    vDropped.clear();
+    mapJournalNodes.clear();
+}
+
+void CChainSlices::Rollback(RailwayNodeMap& mapNodes)
+{
+    if (!fJournal)
+        return;
+    vPending.clear();
+    // What is above the lowest height rewound to was connected since Begin
+    while (!vSlices.empty() && GetHeight() > nJournalLowHeight)
+        vSlices.pop_back();
+    for (std::vector<CChainSlice>::reverse_iterator it = vDropped.rbegin(); it != vDropped.rend(); ++it)
+        vSlices.push_front(std::move(*it));
+    for (std::vector<CChainSlice>::reverse_iterator it = vRewound.rbegin(); it != vRewound.rend(); ++it)
+        vSlices.push_back(std::move(*it));
+    nFirstHeight = nJournalFirstHeight;
+    mapNodes = mapJournalNodes;
+    Commit();
+}
+
+std::string CReorgStats::ToString() const
+{
+    return strprintf("fork at %d, %u disconnected, %u connected, %u coins flushed: "
+                     "read %.2fms, disconnect %.2fms, connect %.2fms, flush %.2fms",
+                     nForkHeight, nDisconnected, nConnected, nCoinsFlushed, 0.001 * nReadMicros,
+                     0.001 * nDisconnectMicros, 0.001 * nConnectMicros, 0.001 * nFlushMicros);
+}
+
+bool DisconnectBlockCoins(const CBlock& block, int nHeight, const CBlockUndo& blockundo, CCoinsViewCache& view, bool& fClean)
+{
+    fClean = true;
+    if (blockundo.vtxundo.size() + 1 != block.vtx.size())
+        return error("%s: block and undo data inconsistent", __func__);
+
+    for (int i = block.vtx.size() - 1; i >= 0; i--) {
+        const CTransaction& tx = *(block.vtx[i]);
+        const uint256& txid = tx.GetHash();
+        bool fCoinBase = tx.IsCoinBase();
+        bool fCoinStake = tx.IsCoinStake();
+
+        // The outputs must all be there, exactly as the block created them
+        for (size_t o = 0; o < tx.vout.size(); o++) {
+            if (tx.vout[o].scriptPubKey.IsUnspendable())
+                continue;
+            Coin coin;
+            bool fSpent = view.SpendCoin(COutPoint(txid, o), &coin);
+            if (!fSpent || tx.vout[o] != coin.out || (int)coin.nHeight != nHeight ||
+                coin.IsCoinBase() != fCoinBase || coin.IsCoinStake() != fCoinStake)
+                fClean = false;
+        }
+
+        if (i == 0)
+            continue;
+        const CTxUndo& txundo = blockundo.vtxundo[i - 1];
+        if (txundo.vprevout.size() != tx.vin.size())
+            return error("%s: transaction and undo data inconsistent", __func__);
+        for (size_t j = tx.vin.size(); j-- > 0;) {
+            const COutPoint& prevout = tx.vin[j].prevout;
+            const Coin& undo = txundo.vprevout[j];
+            if (undo.IsSpent())
+                return error("%s: undo data for %s missing", __func__, prevout.ToString());
+            // Overwriting an unspent coin means the view was not at this block
+            bool fOverwrite = view.HaveCoin(prevout);
+            if (fOverwrite)
+                fClean = false;
+            view.AddCoin(prevout, Coin(undo), fOverwrite);
+        }
+    }
+    return true;
+}
+
+/** The failed block and its descendants up to newTip are no longer tip candidates */
+static void InvalidateBranch(CBlockForest& forest, BlockRef failed, BlockRef newTip)
+{
+    forest.Cold(failed).nStatus |= BLOCK_FAILED_VALID;
+    for (BlockRef ref = newTip; ref != failed; ref = forest.GetPrev(ref)) {
+        forest.Cold(ref).nStatus |= BLOCK_FAILED_CHILD;
+        forest.RemoveCandidate(ref);
+    }
+    forest.RemoveCandidate(failed);
+}
+
+bool ReorganizeChain(CBlockForest& forest, BlockRef& tip, BlockRef newTip, CCoinsView& base,
+                     const CReorgOptions& options, CValidationState& state, CReorgStats& stats)
+{
+    TRACE_SPAN("ReorganizeChain", "validation");
+    METRIC_SCOPED_TIMER(histReorg);
+    CChainSlices* pslices = options.pSlices;
+    if (pslices && !options.pRailwayNodes)
+        return state.Error("chain slices without railway nodes");
+
+    // --- Plan: nothing is modified until the disconnected blocks are read ---
+    BlockRef fork = forest.FindFork(tip, newTip);
+    if (fork == NULL_BLOCK_REF)
+        return state.Error("reorg to a block of another genesis");
+    const int nTipHeight = forest.Hot(tip).nHeight;
+    const int nForkHeight = forest.Hot(fork).nHeight;
+    stats.nForkHeight = nForkHeight;
+
+    const int nCheckpointHeight = PeerCoin::Checkpoints::GetLastCheckpointHeight();
+    if (nForkHeight < nCheckpointHeight && nTipHeight >= nCheckpointHeight)
+        return state.DoS(100, error("%s: reorg from %d to fork at %d crosses the last checkpoint", __func__,
+                                    nTipHeight, nForkHeight),
+                         REJECT_CHECKPOINT, "bad-fork-prior-to-checkpoint");
+    if (pslices && pslices->GetHeight() != nTipHeight)
+        return state.Error(strprintf("chain slices at height %d, tip at %d", pslices->GetHeight(), nTipHeight));
+    if (pslices && !pslices->CanRewind(nForkHeight))
+        return state.Error(strprintf("reorg of %d blocks deeper than the retained chain slices", nTipHeight - nForkHeight));
+
+    std::vector<BlockRef> vConnect;
+    for (BlockRef ref = newTip; ref != fork; ref = forest.GetPrev(ref))
+        vConnect.push_back(ref);
+    std::reverse(vConnect.begin(), vConnect.end());
+    for (BlockRef ref : vConnect) {
+        if (!PeerCoin::Checkpoints::CheckHardened(forest.Hot(ref).nHeight, forest.GetBlockHash(ref)))
+            return state.DoS(100, error("%s: block %s rejected by checkpoint", __func__,
+                                        forest.GetBlockHash(ref).ToString()),
+                             REJECT_CHECKPOINT, "checkpoint mismatch");
+    }
+
+    // --- Read everything to disconnect, tip first ---
+    int64_t nTimeStart = GetTimeMicros();
+    struct DisconnectItem {
+        BlockRef ref;
+        CBlock block;
+        CBlockUndo blockundo;
+    };
+    std::vector<DisconnectItem> vDisconnect(nTipHeight - nForkHeight);
+    std::vector<CFeeBurnUndo> vBurnUndo(vDisconnect.size());
+    BlockRef ref = tip;
+    for (size_t i = 0; i < vDisconnect.size(); i++) {
+        DisconnectItem& item = vDisconnect[i];
+        item.ref = ref;
+        if (!options.fnReadUndo(ref, item.block, item.blockundo, vBurnUndo[i]))
+            return state.Error(strprintf("failed to read block or undo data of %s", forest.GetBlockHash(ref).ToString()));
+        ref = forest.GetPrev(ref);
+    }
+    int64_t nTimeRead = GetTimeMicros();
+    stats.nReadMicros += nTimeRead - nTimeStart;
+
+    // --- Disconnect into one cache; a failure here still leaves everything untouched ---
+    CCoinsViewCache view(&base);
+    for (const DisconnectItem& item : vDisconnect) {
+        bool fClean;
+        if (!DisconnectBlockCoins(item.block, forest.Hot(item.ref).nHeight, item.blockundo, view, fClean))
+            return state.Error(strprintf("failed to disconnect block %s", forest.GetBlockHash(item.ref).ToString()));
+        if (!fClean)
+            LogPrintf("%s: block %s disconnected uncleanly\n", __func__, forest.GetBlockHash(item.ref).ToString());
+    }
+    if (options.pFeeBurnLedger && !options.pFeeBurnLedger->DisconnectBlocks(vBurnUndo))
+        return state.Error("fee burn ledger out of sync");
+    // Undone again if the chainstate write fails
+    if (pslices) {
+        pslices->Begin(*options.pRailwayNodes);
+        pslices->Rewind(nForkHeight, *options.pRailwayNodes);
+    }
+    view.SetBestBlock(forest.GetBlockHash(fork));
+    const BlockRef tipOld = tip;
+    tip = fork;
+    const unsigned int nDisconnected = vDisconnect.size();
+    stats.nDisconnected += nDisconnected;
+    // Kept for the transaction index, which only follows a successful write
+    std::vector<std::pair<BlockRef, CBlock>> vIndexDisconnect, vIndexConnect;
+    if (options.pBlockStore) {
+        for (DisconnectItem& item : vDisconnect)
+            vIndexDisconnect.emplace_back(item.ref, std::move(item.block));
+    }
+    vDisconnect.clear();
+    int64_t nTimeDisconnect = GetTimeMicros();
+    stats.nDisconnectMicros += nTimeDisconnect - nTimeRead;
+
+    // --- Reconnect, fork first, through the normal pipeline ---
+    for (BlockRef refConnect : vConnect) {
+        CBlockForestHot& hot = forest.Hot(refConnect);
+        CBlockForestCold& cold = forest.Cold(refConnect);
+        const uint256& hash = cold.hashBlock;
+
+        if (options.fnModifier) {
+            uint64_t nStakeModifier = cold.nStakeModifier;
+            bool fGenerated = hot.GeneratedStakeModifier();
+            if (!options.fnModifier(refConnect, nStakeModifier, fGenerated)) {
+                state.Error(strprintf("failed to compute the stake modifier of %s", hash.ToString()));
+                break;
+            }
+            cold.nStakeModifier = nStakeModifier;
+            hot.nFlags = fGenerated ? (hot.nFlags | FOREST_STAKE_MODIFIER) : (hot.nFlags & ~FOREST_STAKE_MODIFIER);
+        }
+        cold.nStakeModifierChecksum = GetForestModifierChecksum(forest, refConnect);
+        if (!PeerCoin::StakeModifier::CheckStakeModifierCheckpoints(hot.nHeight, cold.nStakeModifierChecksum)) {
+            state.DoS(100, false, REJECT_CHECKPOINT, "bad-modifier-checksum");
+            InvalidateBranch(forest, refConnect, newTip);
+            break;
+        }
+
+        CBlock block;
+        if (!options.fnReadBlock(refConnect, block)) {
+            state.Error(strprintf("failed to read block %s", hash.ToString()));
+            break;
+        }
+
+        // A child cache, so an invalid block leaves no trace in view
+        CCoinsViewCache viewBlock(&view);
+        if (!options.fnConnect(refConnect, block, viewBlock, state)) {
+            if (pslices)
+                pslices->DiscardPending(*options.pRailwayNodes);
+            if (state.IsInvalid())
+                InvalidateBranch(forest, refConnect, newTip);
+            LogPrintf("%s: block %s failed to connect: %s\n", __func__, hash.ToString(), FormatStateMessage(state));
+            break;
+        }
+        viewBlock.SetBestBlock(hash);
+        viewBlock.Flush();
+        if (pslices)
+            pslices->Connect(refConnect, cold.nStakeModifier, cold.nStakeModifierChecksum);
+        if (options.pBlockStore)
+            vIndexConnect.emplace_back(refConnect, std::move(block));
+        tip = refConnect;
+        stats.nConnected++;
+    }
+    int64_t nTimeConnect = GetTimeMicros();
+    stats.nConnectMicros += nTimeConnect - nTimeDisconnect;
+
+    // --- One write for the whole reorg ---
+    stats.nCoinsFlushed += view.GetCacheSize();
+    if (!view.Flush()) {
+        // The chainstate is still at the old tip, so is everything else
+        if (pslices)
+            pslices->Rollback(*options.pRailwayNodes);
+        if (options.pFeeBurnLedger)
+            options.pFeeBurnLedger->RestoreBlocks(nForkHeight, vBurnUndo);
+        tip = tipOld;
+        return state.Error("failed to write the chainstate");
+    }
+    if (pslices)
+        pslices->Commit();
+    for (const auto& item : vIndexDisconnect)
+        options.pBlockStore->DisconnectBlock(item.second, CDiskBlockPos(forest.Cold(item.first).nFile,
+                                                                        forest.Cold(item.first).nDataPos));
+    for (const auto& item : vIndexConnect)
+        options.pBlockStore->ConnectBlock(item.second, CDiskBlockPos(forest.Cold(item.first).nFile,
+                                                                     forest.Cold(item.first).nDataPos));
+    forest.PruneCandidates(tip);
+    stats.nFlushMicros += GetTimeMicros() - nTimeConnect;
+
+    METRIC_INC(counterReorgs);
+    METRIC_ADD(counterReorgDisconnected, nDisconnected);
+    LogPrint("bench", "ReorganizeChain: %s\n", stats.ToString());
+    if (nDisconnected > 0)
+        LogPrintf("REORGANIZE: disconnected %u blocks to %s, tip now %s\n", nDisconnected,
+                  forest.GetBlockHash(fork).ToString(), forest.GetBlockHash(tip).ToString());
+    return tip == newTip;
+}
+
+} // namespace Africoin
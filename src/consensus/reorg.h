@@ -0,0 +1,250 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_REORG_H
+#define AFRICOIN_CONSENSUS_REORG_H
+
+#include "consensus/blockforest.h"
+#include "railway/railway_staking.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @file reorg.h
+ * @brief Chain reorganization with one coins write and per-height state slices
+ *
+ * Switching the active chain from tip to a block on another branch of the
+ * block forest:
+ *
+ * 1. Plan: find the fork point with CBlockForest::FindFork (O(log n) over
+ *    skip links), refuse to cross the last hardened checkpoint or to go
+ *    deeper than the retained state slices, and check the new branch
+ *    against the hardened checkpoints. Nothing has changed yet.
+ * 2. Read: every block to disconnect and its undo data, before anything
+ *    is modified, so a missing undo file aborts a clean state.
+ * 3. Disconnect, tip first: undo each block's coins into one coins cache
+ *    over the chainstate, then remove the blocks' records from the fee
+ *    burn ledger (all or none) and rewind the chain slices to the fork.
+ * 4. Reconnect, fork first: recompute each block's stake modifier and its
+ *    checksum, check the modifier checkpoints and connect it through the
+ *    normal pipeline (fnConnect, i.e. ConnectBlock) into a per-block child
+ *    cache that is merged only if the block is valid.
+ * 5. Flush: the disconnected and reconnected coins reach the chainstate
+ *    in a single BatchWrite. If that fails, the fee burn ledger, chain
+ *    slices and railway nodes are put back as they were at the old tip,
+ *    so they only ever move together with the chainstate. Once it has
+ *    succeeded the block store's transaction index follows: the
+ *    disconnected blocks' entries are dropped and the connected blocks'
+ *    copies indexed, and tip candidates ranked below the new tip are
+ *    dropped (CBlockForest::PruneCandidates).
+ *
+ * If a block on the new branch is invalid, the blocks before it stay
+ * connected and the new tip is its parent; its trust is then normally
+ * below the old tip's, which is still a tip candidate, and the next
+ * activation reorganizes back.
+ *
+ * Stake modifiers and their checksums are stored per block in the forest,
+ * so a disconnected branch keeps its own and nothing there needs undoing.
+ * What is per height of the active chain is kept in CChainSlices: the
+ * modifier and checksum at each height, and the railway node state
+ * (lastStakeTime, totalStakes) before each block changed it.
+ */
+
+class CBlock;
+class CBlockUndo;
+class CCoinsView;
+class CCoinsViewCache;
+class CValidationState;
+
+namespace Africoin {
+
+class CBlockStore;
+class FeeBurnLedger;
+struct CFeeBurnUndo;
+
+/** Heights of active-chain state kept for rewinding; also the deepest reorg */
+static const int DEFAULT_REORG_SLICE_DEPTH = 5000;
+
+/**
+ * @struct CRailwayStakeUndo
+ * @brief A railway node's chain state before a block changed it
+ */
+struct CRailwayStakeUndo {
+    std::string code;
+    int64_t nLastStakeTime;
+    int64_t nTotalStakes;
+};
+
+/**
+ * @struct CChainSlice
+ * @brief State of the active chain at one height
+ */
+struct CChainSlice {
+    BlockRef ref;
+    uint64_t nStakeModifier;
+    uint32_t nStakeModifierChecksum;
+    std::vector<CRailwayStakeUndo> vRailwayUndo;   //!< In the order the block made the changes
+};
+
+/**
+ * @class CChainSlices
+ * @brief The last nDepth heights of per-height active-chain state
+ *
+ * A window of slices ending at the tip. Connecting a block appends its
+ * slice and drops the oldest; rewinding to a height pops the slices above
+ * it and restores the railway nodes they changed, newest first.
+ *
+ * Railway stakes are recorded while their block is being connected and
+ * only become part of a slice when the block is; a block that fails to
+ * connect has its pending changes rolled back with DiscardPending.
+ */
+class CChainSlices {
+public:
+    typedef std::map<std::string, RailwayStakingNode> RailwayNodeMap;
+
+    explicit CChainSlices(size_t nDepthIn = DEFAULT_REORG_SLICE_DEPTH);
+
+    /** @brief Height of the newest slice (-1 when empty) */
+    int GetHeight() const { return nFirstHeight + (int)vSlices.size() - 1; }
+
+    /** @brief Whether the state as of nHeight can still be restored */
+    bool CanRewind(int nHeight) const;
+
+    /** @brief Slice at nHeight, nullptr if outside the window */
+    const CChainSlice* Get(int nHeight) const;
+
+    /** @brief Stake a block at GetHeight() + 1 credits to a railway node */
+    void RecordRailwayStake(RailwayStakingNode& node, int64_t nBlockTime);
+
+    /** @brief Append the slice of the block just connected; takes the pending railway stakes */
+    void Connect(BlockRef ref, uint64_t nStakeModifier, uint32_t nStakeModifierChecksum);
+
+    /** @brief Roll back the railway stakes recorded for a block that failed to connect */
+    void DiscardPending(RailwayNodeMap& mapNodes);
+
+    /** @brief Pop slices above nHeight and restore the railway nodes they changed */
+    bool Rewind(int nHeight, RailwayNodeMap& mapNodes);
+
+    /** @brief Start an empty window after a block connected some other way */
+    void Reset(int nHeight);
+
+    /**
+     * @brief Start changes that Rollback can undo
+     *
+     * Until Commit, slices popped by Rewind or dropped by Connect are kept
+     * aside and the railway nodes as of now are copied, so a reorg whose
+     * chainstate write fails can put both back.
+     */
+    void Begin(const RailwayNodeMap& mapNodes);
+
+    /** @brief Keep the changes made since Begin */
+    void Commit();
+
+    /** @brief Undo the changes made since Begin, railway nodes included */
+    void Rollback(RailwayNodeMap& mapNodes);
+
+private:
+    static void Restore(const CRailwayStakeUndo& undo, RailwayNodeMap& mapNodes);
+
+    size_t nDepth;
+    int nFirstHeight;
+    std::deque<CChainSlice> vSlices;
+    std::vector<CRailwayStakeUndo> vPending;
+
+    bool fJournal;
+    int nJournalFirstHeight;
+    int nJournalLowHeight;              //!< Lowest height rewound to since Begin
+    std::vector<CChainSlice> vRewound;  //!< Popped by Rewind, newest first
+    std::vector<CChainSlice> vDropped;  //!< Dropped by Connect, oldest first
+    RailwayNodeMap mapJournalNodes;
+};
+
+/**
+ * @struct CReorgStats
+ * @brief What reorganizations did and where the time went
+ *
+ * ReorganizeChain adds to the counters, so one instance can total a run.
+ */
+struct CReorgStats {
+    int nForkHeight;
+    unsigned int nDisconnected;
+    unsigned int nConnected;
+    size_t nCoinsFlushed;     //!< Cache entries in the single write
+    int64_t nReadMicros;
+    int64_t nDisconnectMicros;
+    int64_t nConnectMicros;
+    int64_t nFlushMicros;
+
+    CReorgStats()
+        : nForkHeight(-1), nDisconnected(0), nConnected(0), nCoinsFlushed(0), nReadMicros(0),
+          nDisconnectMicros(0), nConnectMicros(0), nFlushMicros(0) {}
+
+    std::string ToString() const;
+};
+
+/** Read a block of the active chain with its undo data */
+typedef std::function<bool(BlockRef ref, CBlock& block, CBlockUndo& blockundo, CFeeBurnUndo& burnundo)> ReorgReadUndoFn;
+/** Read a block of the new branch */
+typedef std::function<bool(BlockRef ref, CBlock& block)> ReorgReadBlockFn;
+/**
+ * Connect a block to the view through the normal pipeline and store its
+ * undo data; railway stakes go through CChainSlices::RecordRailwayStake
+ */
+typedef std::function<bool(BlockRef ref, const CBlock& block, CCoinsViewCache& view, CValidationState& state)> ReorgConnectFn;
+/** As ReindexModifierFn: recompute a block's stake modifier from its parent's */
+typedef std::function<bool(BlockRef ref, uint64_t& nStakeModifier, bool& fGeneratedStakeModifier)> ReorgModifierFn;
+
+/**
+ * @struct CReorgOptions
+ * @brief Where blocks, undo data and the per-height state come from
+ */
+struct CReorgOptions {
+    ReorgReadUndoFn fnReadUndo;
+    ReorgReadBlockFn fnReadBlock;
+    ReorgConnectFn fnConnect;
+    ReorgModifierFn fnModifier;               //!< Empty: keep the modifiers stored in the index
+    FeeBurnLedger* pFeeBurnLedger;            //!< Disconnected blocks are removed from it (nullptr: none)
+    CChainSlices* pSlices;                    //!< nullptr: no per-height state, no depth limit
+    CChainSlices::RailwayNodeMap* pRailwayNodes;
+    CBlockStore* pBlockStore;                 //!< Transaction index to keep on the active chain (nullptr: none)
+
+    CReorgOptions() : pFeeBurnLedger(nullptr), pSlices(nullptr), pRailwayNodes(nullptr), pBlockStore(nullptr) {}
+};
+
+/**
+ * @brief Undo a block's coins from the view
+ *
+ * Spends the outputs the block created and restores the ones it spent
+ * from the undo data, transactions in reverse order.
+ *
+ * @param fClean Output: false if the view did not hold exactly the block's outputs
+ * @return false if the undo data does not match the block
+ */
+bool DisconnectBlockCoins(const CBlock& block, int nHeight, const CBlockUndo& blockundo, CCoinsViewCache& view, bool& fClean);
+
+/**
+ * @brief Make newTip the tip of the active chain
+ *
+ * Caller must hold cs_main. tip is updated to the block actually reached:
+ * newTip, or the last valid block before an invalid one on its branch.
+ * The first invalid block is reported in state and has its tip candidacy
+ * removed.
+ *
+ * @param base Chainstate to write to; its best block must be tip
+ * @return false if the reorg was refused or aborted before modifying
+ *         anything, the chainstate write failed (tip and the per-height
+ *         state are then unchanged too), or a block failed to connect
+ */
+bool ReorganizeChain(CBlockForest& forest, BlockRef& tip, BlockRef newTip, CCoinsView& base,
+                     const CReorgOptions& options, CValidationState& state, CReorgStats& stats);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_REORG_H
@@ -0,0 +1,205 @@
+// Copyright (c) 2009-2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_SCRIPTCHECK_H
+#define AFRICOIN_CONSENSUS_SCRIPTCHECK_H
+
+#include "amount.h"
+#include "consensus/lockfree_queue.h"
+#include "primitives/transaction.h"
+#include "script/interpreter.h"
+#include "script/script_error.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class CBlock;
+class CBlockIndex;
+class CBlockUndo;
+class CCoinsViewCache;
+class CValidationState;
+
+/**
+ * @file scriptcheck.h
+ * @brief Parallel input script verification for block connection
+ *
+ * Input scripts are verified by a pool of worker threads fed through a
+ * lock-free queue. Each block gets a CVerifyBatch: checks are submitted
+ * as soon as a transaction's inputs are known, the connecting thread keeps
+ * applying UTXO updates, and at the end it helps drain the queue until
+ * every check of its batch has finished.
+ *
+ * Transactions already verified at mempool acceptance are found in the
+ * salted script execution cache (sigcache.h) and produce no checks at all.
+ * The PoS block signature is verified as one more job of the same batch,
+ * so it overlaps with input verification instead of running afterwards.
+ */
+
+namespace Africoin {
+
+struct CFeeBurnUndo;
+class CVerifyBatch;
+
+/** -par default: 0 = one worker per core, minus the connecting thread */
+static const int DEFAULT_SCRIPTCHECK_THREADS = 0;
+/** Maximum number of script-checking threads allowed */
+static const int MAX_SCRIPTCHECK_THREADS = 16;
+/** Capacity of the shared verification queue */
+static const size_t DEFAULT_VERIFY_QUEUE_SIZE = 1 << 14;
+
+/**
+ * @class CScriptCheck
+ * @brief Closure representing one input script verification
+ *
+ * Holds a copy of the spent output so that the coins view can be updated
+ * while checks are still pending.
+ */
+class CScriptCheck {
+private:
+    CScript scriptPubKey;
+    CAmount amount;
+    const CTransaction* ptxTo;
+    unsigned int nIn;
+    unsigned int nFlags;
+    bool cacheStore;
+    ScriptError error;
+    const PrecomputedTransactionData* txdata;
+
+public:
+    CScriptCheck()
+        : amount(0), ptxTo(nullptr), nIn(0), nFlags(0), cacheStore(false),
+          error(SCRIPT_ERR_UNKNOWN_ERROR), txdata(nullptr) {}
+
+    CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, unsigned int nInIn,
+                 unsigned int nFlagsIn, bool cacheIn, const PrecomputedTransactionData* txdataIn)
+        : scriptPubKey(outIn.scriptPubKey), amount(outIn.nValue), ptxTo(&txToIn), nIn(nInIn),
+          nFlags(nFlagsIn), cacheStore(cacheIn), error(SCRIPT_ERR_UNKNOWN_ERROR), txdata(txdataIn) {}
+
+    bool operator()();
+
+    ScriptError GetScriptError() const { return error; }
+};
+
+/**
+ * @struct CVerifyJob
+ * @brief Unit of work on the verification queue
+ *
+ * Either an input script check or, when pblockSig is set, the signature
+ * of a proof-of-stake block.
+ */
+struct CVerifyJob {
+    CScriptCheck check;
+    const CBlock* pblockSig;
+    CVerifyBatch* pbatch;
+
+    CVerifyJob() : pblockSig(nullptr), pbatch(nullptr) {}
+
+    bool operator()();
+};
+
+/**
+ * @class CVerifyPool
+ * @brief Worker threads draining a shared lock-free job queue
+ *
+ * Idle workers sleep on an atomic wait; producers only issue a wake-up
+ * when somebody is actually sleeping.
+ */
+class CVerifyPool {
+public:
+    explicit CVerifyPool(size_t nQueueCapacity = DEFAULT_VERIFY_QUEUE_SIZE);
+    ~CVerifyPool();
+
+    void Start(int nThreads);
+    void Stop();
+    int GetThreadCount() const { return (int)vThreads.size(); }
+
+    /** @return false if the queue is full; the caller then runs the job itself */
+    bool Submit(CVerifyJob* job);
+
+    /** @brief Pop and execute one job; false if the queue was empty */
+    bool RunOne();
+
+private:
+    void ThreadVerify();
+
+    CLockFreeQueue<CVerifyJob*> queue;
+    std::vector<std::thread> vThreads;
+    std::atomic<bool> fStop;
+    std::atomic<uint32_t> nWakeSeq;
+    std::atomic<int> nSleepers;
+};
+
+/**
+ * @class CVerifyBatch
+ * @brief All verification work belonging to one block
+ *
+ * Jobs live in a deque so their addresses stay valid while queued. Once a
+ * job fails, remaining jobs of the batch are skipped.
+ */
+class CVerifyBatch {
+public:
+    /** @param poolIn Worker pool, or nullptr to verify inline */
+    explicit CVerifyBatch(CVerifyPool* poolIn);
+    ~CVerifyBatch();
+
+    CVerifyBatch(const CVerifyBatch&) = delete;
+    CVerifyBatch& operator=(const CVerifyBatch&) = delete;
+
+    void Add(std::vector<CScriptCheck>& vChecks);
+    void AddBlockSignature(const CBlock& block);
+
+    /** @brief Help drain the queue until this batch is done */
+    bool Wait();
+
+    bool IsOk() const { return fOk.load(std::memory_order_relaxed); }
+    void Complete(bool fResult);
+
+private:
+    void Enqueue(CVerifyJob& job);
+
+    CVerifyPool* pool;
+    std::deque<CVerifyJob> jobs;
+    std::atomic<int64_t> nPending;
+    std::atomic<bool> fOk;
+};
+
+/** Pool used by ConnectBlock (nullptr when -par=1) */
+extern std::unique_ptr<CVerifyPool> g_verifyPool;
+
+/** @brief Start the script verification workers from -par */
+void StartScriptCheckThreads();
+void StopScriptCheckThreads();
+
+/**
+ * @brief Verify all input scripts of a transaction
+ *
+ * Consults the script execution cache first. With pbatch set the checks
+ * are queued and the result is only known after pbatch->Wait(); without
+ * it they run inline and, if cacheStore is set, a full success is added
+ * to the execution cache (mempool acceptance).
+ */
+bool CheckInputScripts(const CTransaction& tx, CValidationState& state, const CCoinsViewCache& inputs,
+                       unsigned int flags, bool cacheStore, const PrecomputedTransactionData& txdata,
+                       CVerifyBatch* pbatch);
+
+/**
+ * @brief Apply a block to the coins view with parallel script checks
+ *
+ * Computes fees and the value the coinbase and coinstake create and,
+ * unless fJustCheck, records the fees they leave unclaimed in
+ * g_feeBurnLedger.
+ */
+bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex,
+                  CCoinsViewCache& view, CBlockUndo& blockundo, CFeeBurnUndo& burnundo,
+                  unsigned int flags, bool fJustCheck = false);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_SCRIPTCHECK_H
@@ -0,0 +1,130 @@
+// Copyright (c) 2009-2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file sigcache.cpp
+ * @brief Salted signature and script execution caches
+ */
+
+#include "consensus/sigcache.h"
+
+#include "pubkey.h"
+#include "random.h"
+#include "util.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace Africoin {
+
+CSaltedHashCache g_signatureCache;
+CSaltedHashCache g_scriptExecutionCache;
+
+CSaltedHashCache::CSaltedHashCache(size_t nMaxEntries)
+{
+    SetMaxEntries(nMaxEntries);
+}
+
+void CSaltedHashCache::Salt()
+{
+    std::call_once(saltOnce, [this] {
+        uint256 nonce = GetRandHash();
+        hasherSalted.Write(nonce.begin(), 32);
+        hasherSalted.Write(nonce.begin(), 32);
+    });
+}
+
+void CSaltedHashCache::SetMaxEntries(size_t nMaxEntries)
+{
+    nMaxPerShard = (nMaxEntries + SHARDS - 1) / SHARDS;
+}
+
+bool CSaltedHashCache::Contains(const uint256& entry, bool fErase)
+{
+    Shard& shard = ShardFor(entry);
+    if (!fErase) {
+        std::shared_lock<std::shared_timed_mutex> lock(shard.cs);
+        return shard.setEntries.count(entry) != 0;
+    }
+    std::unique_lock<std::shared_timed_mutex> lock(shard.cs);
+    return shard.setEntries.erase(entry) != 0;
+}
+
+void CSaltedHashCache::Insert(const uint256& entry)
+{
+    Shard& shard = ShardFor(entry);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.cs);
+    if (nMaxPerShard == 0)
+        return;
+
+    while (shard.setEntries.size() >= nMaxPerShard) {
+        // Evict from a random non-empty bucket
+        size_t nBuckets = shard.setEntries.bucket_count();
+        size_t nBucket = GetRand(nBuckets);
+        for (size_t i = 0; i < nBuckets; i++) {
+            size_t b = (nBucket + i) % nBuckets;
+            if (shard.setEntries.bucket_size(b) > 0) {
+                shard.setEntries.erase(*shard.setEntries.begin(b));
+                break;
+            }
+        }
+    }
+    shard.setEntries.insert(entry);
+}
+
+size_t CSaltedHashCache::Size() const
+{
+    size_t nSize = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_timed_mutex> lock(shard.cs);
+        nSize += shard.setEntries.size();
+    }
+    return nSize;
+}
+
+void InitSignatureCaches()
+{
+    // Split the budget evenly between the two caches
+    size_t nMaxBytes = std::max((int64_t)0, GetArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_SIZE)) * ((size_t)1 << 20);
+    size_t nEntries = nMaxBytes / 2 / SIG_CACHE_BYTES_PER_ENTRY;
+    g_signatureCache.Salt();
+    g_scriptExecutionCache.Salt();
+    g_signatureCache.SetMaxEntries(nEntries);
+    g_scriptExecutionCache.SetMaxEntries(nEntries);
+    LogPrintf("Using %zu MiB for signature and script execution caches (%zu entries each)\n",
+              nMaxBytes >> 20, nEntries);
+}
+
+uint256 GetScriptExecutionCacheEntry(const uint256& wtxid, unsigned int nFlags)
+{
+    uint256 entry;
+    CSHA256 hasher = g_scriptExecutionCache.GetSaltedHasher();
+    hasher.Write(wtxid.begin(), 32).Write((const unsigned char*)&nFlags, sizeof(nFlags)).Finalize(entry.begin());
+    return entry;
+}
+
+uint256 GetSignatureCacheEntry(const uint256& sighash, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey)
+{
+    uint256 entry;
+    CSHA256 hasher = g_signatureCache.GetSaltedHasher();
+    hasher.Write(sighash.begin(), 32).Write(&pubkey[0], pubkey.size()).Write(vchSig.data(), vchSig.size()).Finalize(entry.begin());
+    return entry;
+}
+
+bool CachingTransactionSignatureChecker::VerifySignature(const std::vector<unsigned char>& vchSig,
+                                                         const CPubKey& pubkey, const uint256& sighash) const
+{
+    uint256 entry = GetSignatureCacheEntry(sighash, vchSig, pubkey);
+    if (g_signatureCache.Contains(entry, !fStore))
+        return true;
+    if (!TransactionSignatureChecker::VerifySignature(vchSig, pubkey, sighash))
+        return false;
+    if (fStore)
+        g_signatureCache.Insert(entry);
+    return true;
+}
+
+} // namespace Africoin
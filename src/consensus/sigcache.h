@@ -0,0 +1,153 @@
+// Copyright (c) 2009-2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_SIGCACHE_H
+#define AFRICOIN_CONSENSUS_SIGCACHE_H
+
+#include "crypto/sha256.h"
+#include "script/interpreter.h"
+#include "uint256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+class CPubKey;
+
+/**
+ * @file sigcache.h
+ * @brief Salted verification caches shared by mempool and block connect
+ *
+ * Two caches sit in front of script verification:
+ *
+ * 1. The signature cache remembers individual (sighash, pubkey, signature)
+ *    triples that verified successfully.
+ * 2. The script execution cache remembers whole transactions (by wtxid and
+ *    script flags) whose inputs all verified.
+ *
+ * Both are populated at mempool acceptance. When the same transaction later
+ * arrives in a block, ConnectBlock finds it in the execution cache and
+ * skips creating script checks entirely; transactions that only partially
+ * hit (e.g. flags changed) still benefit from the signature cache.
+ *
+ * Keys are SHA256(nonce || data) with a per-process random nonce so a peer
+ * cannot construct entries that collide in our cache. The nonce is drawn
+ * on first use rather than at static initialization, when the random
+ * number generator is not seeded yet.
+ */
+
+namespace Africoin {
+
+/** Default total memory for both caches in MiB (-maxsigcachesize) */
+static const unsigned int DEFAULT_MAX_SIG_CACHE_SIZE = 32;
+/** Approximate memory per cached entry including hash table overhead */
+static const size_t SIG_CACHE_BYTES_PER_ENTRY = 64;
+/** Entries per cache for the default size, half the budget each */
+static const size_t DEFAULT_SIG_CACHE_ENTRIES = ((size_t)DEFAULT_MAX_SIG_CACHE_SIZE << 20) / 2 / SIG_CACHE_BYTES_PER_ENTRY;
+
+/**
+ * @class CSaltedHashCache
+ * @brief Sharded, size-bounded set of salted 256-bit entries
+ *
+ * Entries are uniformly distributed hashes, so the shard is chosen from
+ * the entry itself and each shard has its own reader/writer lock. When a
+ * shard is full a random entry is evicted.
+ */
+class CSaltedHashCache {
+public:
+    explicit CSaltedHashCache(size_t nMaxEntries = DEFAULT_SIG_CACHE_ENTRIES);
+
+    /** @brief Draw the random nonce if that has not happened yet */
+    void Salt();
+
+    /** @brief Salted hasher; callers copy it and append their data */
+    const CSHA256& GetSaltedHasher()
+    {
+        Salt();
+        return hasherSalted;
+    }
+
+    /**
+     * @brief Look up an entry
+     * @param fErase Remove the entry on a hit (used by block connect,
+     *               where the entry will not be needed again)
+     */
+    bool Contains(const uint256& entry, bool fErase);
+
+    void Insert(const uint256& entry);
+
+    void SetMaxEntries(size_t nMaxEntries);
+    size_t Size() const;
+
+private:
+    static const unsigned int SHARDS = 16;
+
+    struct EntryHasher {
+        size_t operator()(const uint256& entry) const { return entry.GetCheapHash(); }
+    };
+
+    struct Shard {
+        mutable std::shared_timed_mutex cs;
+        std::unordered_set<uint256, EntryHasher> setEntries;
+    };
+
+    Shard& ShardFor(const uint256& entry) { return shards[entry.begin()[31] % SHARDS]; }
+
+    std::once_flag saltOnce;
+    CSHA256 hasherSalted;
+    size_t nMaxPerShard;
+    Shard shards[SHARDS];
+};
+
+/** @brief Signature triples that verified successfully */
+extern CSaltedHashCache g_signatureCache;
+
+/** @brief Transactions (wtxid + flags) whose input scripts all verified */
+extern CSaltedHashCache g_scriptExecutionCache;
+
+/**
+ * @brief Salt both caches and size them from -maxsigcachesize
+ *
+ * Called by AppInitMain once the random number generator is seeded (see
+ * init.cpp). Until then the caches hold DEFAULT_SIG_CACHE_ENTRIES each and
+ * salt themselves on first use.
+ */
+void InitSignatureCaches();
+
+/** @brief Execution cache key for a transaction under a set of flags */
+uint256 GetScriptExecutionCacheEntry(const uint256& wtxid, unsigned int nFlags);
+
+/** @brief Signature cache key for a (sighash, pubkey, signature) triple */
+uint256 GetSignatureCacheEntry(const uint256& sighash, const std::vector<unsigned char>& vchSig, const CPubKey& pubkey);
+
+/**
+ * @class CachingTransactionSignatureChecker
+ * @brief Signature checker that consults the salted signature cache
+ *
+ * With fStore set (mempool acceptance) successful signatures are added to
+ * the cache. Without it (block connect) hits are erased since the entry
+ * will not be looked up again.
+ */
+class CachingTransactionSignatureChecker : public TransactionSignatureChecker {
+private:
+    bool fStore;
+
+public:
+    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn,
+                                       const CAmount& amountIn, bool fStoreIn,
+                                       const PrecomputedTransactionData& txdataIn)
+        : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn), fStore(fStoreIn) {}
+
+    bool VerifySignature(const std::vector<unsigned char>& vchSig, const CPubKey& vchPubKey,
+                         const uint256& sighash) const override;
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_SIGCACHE_H
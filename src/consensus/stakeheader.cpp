@@ -0,0 +1,111 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file stakeheader.cpp
+ * @brief Proof-of-stake checks on a stake header, before the block is requested
+ */
+
+#include "consensus/stakeheader.h"
+
+#include "chain.h"
+#include "chainparams.h"
+#include "consensus/merkle.h"
+#include "consensus/stakeseen.h"
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+#include "pow.h"
+#include "security/kernel.h"
+#include "staking/hybrid_difficulty.h"
+#include "storage/blockstore.h"
+#include "util.h"
+#include "validation.h"
+
+namespace Africoin {
+
+METRIC_COUNTER(counterStakeHeaderInvalid, "africoin_stake_header_invalid_total",
+               "Stake headers rejected before their block was requested");
+METRIC_COUNTER(counterStakeHeaderDeferred, "africoin_stake_header_deferred_total",
+               "Stake headers whose kernel could not be checked from local data");
+
+static StakeHeaderResult Deferred(const char* pszReason, const uint256& hash)
+{
+    LogPrint("stake", "CheckStakeHeader: %s deferred: %s\n", hash.ToString(), pszReason);
+    METRIC_INC(counterStakeHeaderDeferred);
+    return STAKE_HEADER_DEFERRED;
+}
+
+static StakeHeaderResult Invalid(CValidationState& state, int nDoS, const std::string& strReason, unsigned char nCode = REJECT_INVALID)
+{
+    METRIC_INC(counterStakeHeaderInvalid);
+    state.DoS(nDoS, false, nCode, strReason);
+    return STAKE_HEADER_INVALID;
+}
+
+StakeHeaderResult CheckStakeHeader(const CStakeHeader& stakeHeader, const CBlockIndex* pindexPrev,
+                                   CValidationState& state, uint256& hashProofOfStake)
+{
+    TRACE_SPAN("CheckStakeHeader", "validation");
+    const CBlockHeader& header = stakeHeader.header;
+    const CTransactionRef& txCoinStake = stakeHeader.txCoinStake;
+
+    // Shape of the message: a coinstake stamped with the block time
+    if (!txCoinStake || !txCoinStake->IsCoinStake())
+        return Invalid(state, 100, "bad-stakehdr-coinstake");
+    if (txCoinStake->nTime != header.nTime)
+        return Invalid(state, 100, "bad-stakehdr-time");
+    if (stakeHeader.vMerkleBranch.size() > MAX_STAKE_HEADER_BRANCH)
+        return Invalid(state, 100, "bad-stakehdr-branch");
+
+    // A stake already used by an indexed block; not the sender's fault if it relays a competing one
+    const COutPoint& prevout = txCoinStake->vin[0].prevout;
+    if (!g_stakeSeen.CheckBlockStake(CStakeId(prevout, header.nTime), false))
+        return Invalid(state, 0, "dup-stake", REJECT_DUPLICATE);
+
+    // Next PoS target; a hybrid block also meets its PoW target and gets the easier of the two
+    if (header.nBits != GetNextHybridTarget(pindexPrev, BLOCK_TYPE_POS) &&
+        !(header.nBits == GetNextHybridTarget(pindexPrev, BLOCK_TYPE_HYBRID) &&
+          CheckProofOfWork(header.GetHash(), header.nBits, Params().GetConsensus())))
+        return Invalid(state, 100, "bad-diffbits");
+
+    // The coinstake must be the vtx[1] the header commits to
+    if (ComputeMerkleRootFromBranch(txCoinStake->GetHash(), stakeHeader.vMerkleBranch, 1) != header.hashMerkleRoot)
+        return Invalid(state, 100, "bad-stakehdr-merkle");
+
+    // Kernel inputs from local data only
+    BlockMap::const_iterator mi = mapBlockIndex.find(stakeHeader.hashBlockFrom);
+    if (mi == mapBlockIndex.end())
+        return Deferred("blockFrom unknown", header.GetHash());
+    const CBlockIndex* pindexFrom = mi->second;
+    if (pindexPrev->GetAncestor(pindexFrom->nHeight) != pindexFrom)
+        return Invalid(state, 100, "bad-stakehdr-blockfrom");
+
+    CDiskTxPos posTxPrev;
+    if (!g_blockStore || !g_blockStore->FindTx(prevout.hash, posTxPrev))
+        return Deferred("txPrev not in block store", header.GetHash());
+
+    switch (PeerCoin::Kernel::CheckStakeKernel(header.nBits, pindexFrom, posTxPrev, prevout, header.nTime,
+                                               hashProofOfStake)) {
+    case PeerCoin::KERNEL_VALID:
+        break;
+    case PeerCoin::KERNEL_BAD_TXPREV:
+        return Invalid(state, 100, "bad-stakehdr-prevout");
+    case PeerCoin::KERNEL_BAD_BLOCKFROM:
+        // The store may hold the copy of txPrev in a fork block until blockFrom is connected again
+        return Deferred("txPrev not stored in blockFrom", header.GetHash());
+    case PeerCoin::KERNEL_BAD_TIME:
+        return Invalid(state, 100, "bad-stakehdr-prevtime");
+    case PeerCoin::KERNEL_BAD_MIN_AGE:
+        return Invalid(state, 100, "bad-stakehdr-minage");
+    case PeerCoin::KERNEL_NO_MODIFIER:
+        return Deferred("stake modifier unavailable", header.GetHash());
+    case PeerCoin::KERNEL_BAD_TARGET:
+        // As PeerCoin: may be our view of the chain, so only a small penalty
+        return Invalid(state, 1, "bad-stakehdr-kernel");
+    }
+
+    return STAKE_HEADER_VALID;
+}
+
+} // namespace Africoin
@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_STAKEHEADER_H
+#define AFRICOIN_CONSENSUS_STAKEHEADER_H
+
+#include "net/protocol.h"
+
+class CBlockIndex;
+class CValidationState;
+class uint256;
+
+/**
+ * @file stakeheader.h
+ * @brief Proof-of-stake checks on a stake header, before the block is requested
+ *
+ * Everything that makes a PoS block's stake valid can be checked from a
+ * CStakeHeader: the stake is not a duplicate, nBits is the next PoS (or
+ * hybrid) target, the coinstake is the block's vtx[1], and its kernel
+ * meets that target. The kernel inputs (blockFrom's time, txPrev's
+ * offset, time and value) come from the block index and the block store,
+ * so a peer announcing an invalid stake costs a few hundred bytes and one
+ * kernel hash instead of a full block download and deserialization.
+ *
+ * The checks run cheapest first. When blockFrom, txPrev or the stake
+ * modifier is not available locally (we are behind, or blockFrom is on a
+ * fork we have not downloaded) the result is deferred and the block is
+ * fetched and validated in full as before.
+ *
+ * Passing is not final: the block signature and every other transaction
+ * are only checked once the block arrives, and a block whose vtx[1] does
+ * not match the announced coinstake fails its merkle root check.
+ */
+
+namespace Africoin {
+
+enum StakeHeaderResult {
+    STAKE_HEADER_VALID = 0,      //!< Stake checked; fetch the block
+    STAKE_HEADER_INVALID,        //!< Rejected; state holds the reason and DoS score
+    STAKE_HEADER_DEFERRED,       //!< Could not be checked here; fetch and validate in full
+};
+
+/**
+ * @brief Check the stake of a PoS header that connects to pindexPrev
+ *
+ * Headers already in mapBlockIndex must be skipped by the caller: their
+ * stake is in g_stakeSeen and would be reported as a duplicate.
+ * Caller must hold cs_main.
+ *
+ * @param stakeHeader Header, coinstake and merkle branch received
+ * @param pindexPrev Index entry of header.hashPrevBlock
+ * @param state Reject reason and DoS score when invalid
+ * @param hashProofOfStake Output: the kernel hash when valid
+ */
+StakeHeaderResult CheckStakeHeader(const CStakeHeader& stakeHeader, const CBlockIndex* pindexPrev,
+                                   CValidationState& state, uint256& hashProofOfStake);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_STAKEHEADER_H
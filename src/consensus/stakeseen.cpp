@@ -0,0 +1,277 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "consensus/stakeseen.h"
+
+#include "hash.h"
+#include "metrics/metrics.h"
+#include "primitives/block.h"
+#include "random.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Africoin {
+
+METRIC_COUNTER(counterStakeSeenRejected, "africoin_stake_seen_rejected_total",
+               "PoS blocks and orphans rejected for reusing a stake already seen");
+
+CStakeSeenIndex g_stakeSeen;
+
+CStakeId GetBlockStake(const CBlock& block)
+{
+    return CStakeId(block.vtx[1]->vin[0].prevout, block.nTime);
+}
+
+CStakeFilter::CStakeFilter(size_t nCapacity) : nEntries(0), nKickState(GetRand(std::numeric_limits<uint64_t>::max()))
+{
+    // Power-of-two bucket count, at most 95% full at nCapacity
+    size_t nBuckets = 16;
+    while (nBuckets * SLOTS * 19 / 20 < nCapacity)
+        nBuckets <<= 1;
+    vBuckets.assign(nBuckets, Bucket());
+    for (Bucket& bucket : vBuckets)
+        std::fill(bucket.vSlots, bucket.vSlots + SLOTS, 0);
+    nMask = nBuckets - 1;
+}
+
+uint16_t CStakeFilter::Fingerprint(uint64_t nHash)
+{
+    // Top bits, so independent of the bucket index; 0 marks an empty slot
+    uint16_t nFingerprint = nHash >> 48;
+    return nFingerprint ? nFingerprint : 1;
+}
+
+size_t CStakeFilter::AltIndex(size_t nIndex, uint16_t nFingerprint) const
+{
+    return (nIndex ^ ((size_t)nFingerprint * 0x5bd1e995)) & nMask;
+}
+
+bool CStakeFilter::AddTo(size_t nIndex, uint16_t nFingerprint)
+{
+    for (uint16_t& nSlot : vBuckets[nIndex].vSlots) {
+        if (nSlot == 0) {
+            nSlot = nFingerprint;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CStakeFilter::Contains(uint64_t nHash) const
+{
+    const uint16_t nFingerprint = Fingerprint(nHash);
+    const size_t i1 = nHash & nMask;
+    const Bucket& b1 = vBuckets[i1];
+    const Bucket& b2 = vBuckets[AltIndex(i1, nFingerprint)];
+    for (unsigned int i = 0; i < SLOTS; i++)
+        if (b1.vSlots[i] == nFingerprint || b2.vSlots[i] == nFingerprint)
+            return true;
+    return false;
+}
+
+bool CStakeFilter::Insert(uint64_t nHash)
+{
+    uint16_t nFingerprint = Fingerprint(nHash);
+    size_t nIndex = nHash & nMask;
+    if (AddTo(nIndex, nFingerprint) || AddTo(AltIndex(nIndex, nFingerprint), nFingerprint)) {
+        nEntries++;
+        return true;
+    }
+
+    // Both buckets full: move a random resident to its other bucket, and so on
+    for (unsigned int nKick = 0; nKick < MAX_KICKS; nKick++) {
+        nKickState = nKickState * 6364136223846793005ULL + 1442695040888963407ULL;
+        std::swap(nFingerprint, vBuckets[nIndex].vSlots[nKickState >> 62]);
+        nIndex = AltIndex(nIndex, nFingerprint);
+        if (AddTo(nIndex, nFingerprint)) {
+            nEntries++;
+            return true;
+        }
+    }
+    // One fingerprint is left homeless; the caller rebuilds the filter
+    return false;
+}
+
+bool CStakeFilter::Erase(uint64_t nHash)
+{
+    const uint16_t nFingerprint = Fingerprint(nHash);
+    const size_t i1 = nHash & nMask;
+    for (size_t nIndex : {i1, AltIndex(i1, nFingerprint)}) {
+        for (uint16_t& nSlot : vBuckets[nIndex].vSlots) {
+            if (nSlot == nFingerprint) {
+                nSlot = 0;
+                nEntries--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+size_t CStakeSeenSet::SaltedStakeHasher::operator()(const CStakeId& stake) const
+{
+    return CSipHasher(k0, k1)
+        .Write(stake.prevout.hash.GetUint64(0))
+        .Write(stake.prevout.hash.GetUint64(1))
+        .Write(stake.prevout.hash.GetUint64(2))
+        .Write(stake.prevout.hash.GetUint64(3))
+        .Write(((uint64_t)stake.prevout.n << 32) | stake.nTime)
+        .Finalize();
+}
+
+CStakeSeenSet::CStakeSeenSet(uint64_t nKey0, uint64_t nKey1)
+    : hasher(nKey0, nKey1), mapStakes(0, hasher), nFilterMisses(0), nFalsePositives(0)
+{
+}
+
+bool CStakeSeenSet::Contains(const CStakeId& stake)
+{
+    if (!filter.Contains(hasher(stake))) {
+        nFilterMisses++;
+        return false;
+    }
+    if (mapStakes.count(stake))
+        return true;
+    nFalsePositives++;
+    return false;
+}
+
+void CStakeSeenSet::GrowFilter()
+{
+    // Sized for the current slot count at 95% load, so twice the buckets
+    size_t nCapacity = std::max(filter.GetCapacity(), mapStakes.size());
+    while (true) {
+        CStakeFilter grown(nCapacity);
+        bool fComplete = true;
+        for (const auto& entry : mapStakes) {
+            if (!grown.Insert(hasher(entry.first))) {
+                fComplete = false;
+                break;
+            }
+        }
+        if (fComplete) {
+            filter = std::move(grown);
+            return;
+        }
+        nCapacity *= 2;
+    }
+}
+
+bool CStakeSeenSet::Insert(const CStakeId& stake, int nHeight)
+{
+    if (!mapStakes.emplace(stake, nHeight).second)
+        return false;
+    mapByHeight[nHeight].push_back(stake);
+
+    // The rebuild covers the new stake, which is already in mapStakes
+    if (filter.Size() >= filter.GetCapacity() * 19 / 20 || !filter.Insert(hasher(stake)))
+        GrowFilter();
+    return true;
+}
+
+bool CStakeSeenSet::Erase(const CStakeId& stake)
+{
+    auto it = mapStakes.find(stake);
+    if (it == mapStakes.end())
+        return false;
+
+    auto itHeight = mapByHeight.find(it->second);
+    std::vector<CStakeId>& vStakes = itHeight->second;
+    vStakes.erase(std::find(vStakes.begin(), vStakes.end(), stake));
+    if (vStakes.empty())
+        mapByHeight.erase(itHeight);
+
+    filter.Erase(hasher(stake));
+    mapStakes.erase(it);
+    return true;
+}
+
+size_t CStakeSeenSet::PruneBelow(int nHeight)
+{
+    size_t nRemoved = 0;
+    while (!mapByHeight.empty() && mapByHeight.begin()->first < nHeight) {
+        for (const CStakeId& stake : mapByHeight.begin()->second) {
+            filter.Erase(hasher(stake));
+            mapStakes.erase(stake);
+            nRemoved++;
+        }
+        mapByHeight.erase(mapByHeight.begin());
+    }
+    return nRemoved;
+}
+
+int CStakeSeenSet::GetMinHeight() const
+{
+    return mapByHeight.empty() ? INT_MAX : mapByHeight.begin()->first;
+}
+
+CStakeSeenIndex::CStakeSeenIndex(int nDepthIn, size_t nMaxOrphansIn)
+    : nDepth(nDepthIn), nMaxOrphans(nMaxOrphansIn),
+      seen(GetRand(std::numeric_limits<uint64_t>::max()), GetRand(std::numeric_limits<uint64_t>::max())),
+      orphans(GetRand(std::numeric_limits<uint64_t>::max()), GetRand(std::numeric_limits<uint64_t>::max())),
+      nOrphanSequence(0), nRejected(0)
+{
+}
+
+bool CStakeSeenIndex::CheckBlockStake(const CStakeId& stake, bool fWantedByOrphan)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    if (seen.Contains(stake) && !fWantedByOrphan) {
+        nRejected++;
+        METRIC_INC(counterStakeSeenRejected);
+        return false;
+    }
+    return true;
+}
+
+void CStakeSeenIndex::AddBlockStake(const CStakeId& stake, int nHeight)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    seen.Insert(stake, nHeight);
+}
+
+bool CStakeSeenIndex::CheckOrphanStake(const CStakeId& stake, bool fWantedByOrphan)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    if (orphans.Contains(stake)) {
+        if (fWantedByOrphan)
+            return true;
+        nRejected++;
+        METRIC_INC(counterStakeSeenRejected);
+        return false;
+    }
+
+    orphans.Insert(stake, nOrphanSequence++);
+    while (orphans.Size() > nMaxOrphans)
+        orphans.PruneBelow(orphans.GetMinHeight() + 1);
+    return true;
+}
+
+void CStakeSeenIndex::RemoveOrphanStake(const CStakeId& stake)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    orphans.Erase(stake);
+}
+
+void CStakeSeenIndex::Prune(int nTipHeight)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    seen.PruneBelow(nTipHeight - nDepth);
+}
+
+CStakeSeenStats CStakeSeenIndex::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    CStakeSeenStats stats;
+    stats.nStakes = seen.Size();
+    stats.nOrphanStakes = orphans.Size();
+    stats.nFilterBytes = seen.GetFilterMemoryUsage() + orphans.GetFilterMemoryUsage();
+    stats.nFilterMisses = seen.GetFilterMisses() + orphans.GetFilterMisses();
+    stats.nFalsePositives = seen.GetFalsePositives() + orphans.GetFalsePositives();
+    stats.nRejected = nRejected;
+    return stats;
+}
+
+} // namespace Africoin
@@ -0,0 +1,237 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CONSENSUS_STAKESEEN_H
+#define AFRICOIN_CONSENSUS_STAKESEEN_H
+
+#include "primitives/transaction.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class CBlock;
+
+/**
+ * @file stakeseen.h
+ * @brief Duplicate-stake index: PeerCoin's setStakeSeen with a cuckoo pre-filter
+ *
+ * A PoS block is identified by its stake: the kernel prevout and the
+ * block time. A valid stake can only appear in one block per chain, but
+ * nothing stops a peer from sending the same stake in any number of
+ * blocks with different contents. Each of them would otherwise be
+ * deserialized, have its kernel read and hashed and its signature
+ * verified before being found invalid.
+ *
+ * As in PeerCoin, stakes of blocks added to the index are remembered, and
+ * a PoS block whose stake is already known is rejected unless it is
+ * wanted as the parent of an orphan. Orphans are checked against a
+ * separate, size-bounded set since their height is not known yet.
+ *
+ * Each set is an exact hash map behind a cuckoo filter of 16-bit
+ * fingerprints (2 to 4 bytes per entry). New stakes, the normal case,
+ * are answered by the filter from two cache lines; the exact map is only
+ * consulted on a filter hit, which is either a real duplicate or a
+ * ~1/8000 false positive. Stakes of blocks more than nDepth below the
+ * tip are pruned: reusing one needs a fork that deep, which the
+ * checkpoint checks reject before any stake work.
+ *
+ * Keys are hashed with SipHash under a per-process random key, so a peer
+ * cannot aim stakes at one bucket.
+ */
+
+namespace Africoin {
+
+/** Blocks below the tip whose stakes are remembered */
+static const int DEFAULT_STAKE_SEEN_DEPTH = 5000;
+/** Orphan stakes remembered (PeerCoin's DEFAULT_MAX_ORPHAN_BLOCKS) */
+static const size_t DEFAULT_MAX_ORPHAN_STAKES = 750;
+
+/**
+ * @struct CStakeId
+ * @brief The stake a PoS block claims: kernel prevout and block time
+ */
+struct CStakeId {
+    COutPoint prevout;
+    uint32_t nTime;
+
+    CStakeId() : nTime(0) {}
+    CStakeId(const COutPoint& prevoutIn, uint32_t nTimeIn) : prevout(prevoutIn), nTime(nTimeIn) {}
+
+    friend bool operator==(const CStakeId& a, const CStakeId& b) { return a.prevout == b.prevout && a.nTime == b.nTime; }
+};
+
+/** @brief Stake of a PoS block (vtx[1]'s first input and the block time) */
+CStakeId GetBlockStake(const CBlock& block);
+
+/**
+ * @class CStakeFilter
+ * @brief Cuckoo filter over 64-bit hashes
+ *
+ * Buckets of four 16-bit fingerprints; an entry lives in one of two
+ * buckets, the second derived from the first and the fingerprint, so
+ * entries can be moved and erased without the original key.
+ */
+class CStakeFilter {
+public:
+    /** @param nCapacity Entries the filter must hold at 95% load */
+    explicit CStakeFilter(size_t nCapacity = 0);
+
+    bool Contains(uint64_t nHash) const;
+
+    /** @brief false if the filter is too full (the entry is then not added) */
+    bool Insert(uint64_t nHash);
+
+    /** @brief Remove one copy of an inserted hash */
+    bool Erase(uint64_t nHash);
+
+    size_t Size() const { return nEntries; }
+    size_t GetCapacity() const { return vBuckets.size() * SLOTS; }
+    size_t DynamicMemoryUsage() const { return vBuckets.size() * sizeof(Bucket); }
+
+private:
+    static const unsigned int SLOTS = 4;
+    static const unsigned int MAX_KICKS = 500;
+
+    struct Bucket {
+        uint16_t vSlots[SLOTS];
+    };
+
+    static uint16_t Fingerprint(uint64_t nHash);
+    size_t AltIndex(size_t nIndex, uint16_t nFingerprint) const;
+    bool AddTo(size_t nIndex, uint16_t nFingerprint);
+
+    std::vector<Bucket> vBuckets;
+    size_t nMask;
+    size_t nEntries;
+    uint64_t nKickState;
+};
+
+/**
+ * @class CStakeSeenSet
+ * @brief Stakes with a height, behind a cuckoo filter
+ *
+ * Not thread-safe; CStakeSeenIndex locks around it.
+ */
+class CStakeSeenSet {
+public:
+    CStakeSeenSet(uint64_t nKey0, uint64_t nKey1);
+
+    bool Contains(const CStakeId& stake);
+
+    /** @brief false if already present */
+    bool Insert(const CStakeId& stake, int nHeight);
+
+    bool Erase(const CStakeId& stake);
+
+    /** @brief Remove every stake below nHeight; returns the number removed */
+    size_t PruneBelow(int nHeight);
+
+    /** @brief Lowest height present (INT_MAX when empty) */
+    int GetMinHeight() const;
+
+    size_t Size() const { return mapStakes.size(); }
+    size_t GetFilterMemoryUsage() const { return filter.DynamicMemoryUsage(); }
+    uint64_t GetFilterMisses() const { return nFilterMisses; }
+    uint64_t GetFalsePositives() const { return nFalsePositives; }
+
+private:
+    /** SipHash of the stake under the set's key */
+    struct SaltedStakeHasher {
+        uint64_t k0, k1;
+
+        SaltedStakeHasher(uint64_t k0In, uint64_t k1In) : k0(k0In), k1(k1In) {}
+        size_t operator()(const CStakeId& stake) const;
+    };
+
+    void GrowFilter();
+
+    const SaltedStakeHasher hasher;
+    CStakeFilter filter;
+    std::unordered_map<CStakeId, int, SaltedStakeHasher> mapStakes;
+    std::map<int, std::vector<CStakeId>> mapByHeight;
+    uint64_t nFilterMisses;
+    uint64_t nFalsePositives;
+};
+
+/**
+ * @struct CStakeSeenStats
+ * @brief Sizes and hit counters, for getmetrics and the benchmarks
+ */
+struct CStakeSeenStats {
+    size_t nStakes;
+    size_t nOrphanStakes;
+    size_t nFilterBytes;
+    uint64_t nFilterMisses;      //!< Lookups answered by the filter alone
+    uint64_t nFalsePositives;    //!< Filter hits the exact set did not confirm
+    uint64_t nRejected;          //!< Blocks and orphans rejected as duplicates
+
+    CStakeSeenStats() : nStakes(0), nOrphanStakes(0), nFilterBytes(0), nFilterMisses(0), nFalsePositives(0), nRejected(0) {}
+};
+
+/**
+ * @class CStakeSeenIndex
+ * @brief Stakes of indexed blocks and of orphans
+ *
+ * Call order for an incoming PoS block, before it is deserialized any
+ * further than its coinstake input or checked in any other way:
+ *
+ * - parent known: CheckBlockStake, and AddBlockStake once the block is in
+ *   the block index;
+ * - parent unknown: CheckOrphanStake, which also records the stake, and
+ *   RemoveOrphanStake when the orphan is connected or dropped.
+ *
+ * Prune is called with the new tip height whenever the tip moves.
+ */
+class CStakeSeenIndex {
+public:
+    explicit CStakeSeenIndex(int nDepthIn = DEFAULT_STAKE_SEEN_DEPTH, size_t nMaxOrphansIn = DEFAULT_MAX_ORPHAN_STAKES);
+
+    CStakeSeenIndex(const CStakeSeenIndex&) = delete;
+    CStakeSeenIndex& operator=(const CStakeSeenIndex&) = delete;
+
+    /**
+     * @brief false if the stake was already seen in an indexed block
+     * @param fWantedByOrphan The block is the missing parent of an orphan,
+     *                        so a duplicate stake is allowed
+     */
+    bool CheckBlockStake(const CStakeId& stake, bool fWantedByOrphan);
+
+    /** @brief Record the stake of a block added to the block index */
+    void AddBlockStake(const CStakeId& stake, int nHeight);
+
+    /**
+     * @brief false if another orphan already claimed the stake; otherwise
+     * record it, evicting the oldest orphan stake when full
+     */
+    bool CheckOrphanStake(const CStakeId& stake, bool fWantedByOrphan);
+
+    void RemoveOrphanStake(const CStakeId& stake);
+
+    /** @brief Forget stakes more than nDepth below nTipHeight */
+    void Prune(int nTipHeight);
+
+    CStakeSeenStats GetStats() const;
+
+private:
+    const int nDepth;
+    const size_t nMaxOrphans;
+
+    mutable std::mutex cs;
+    CStakeSeenSet seen;
+    CStakeSeenSet orphans;       //!< Height is the arrival sequence number
+    int nOrphanSequence;
+    uint64_t nRejected;
+};
+
+/** Stakes seen by the running node */
+extern CStakeSeenIndex g_stakeSeen;
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CONSENSUS_STAKESEEN_H
@@ -1 +1,334 @@
-// validation.cpp: Blockchain and transaction validation logic.
\ No newline at end of file
+// Copyright (c) 2009-2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file validation.cpp
+ * @brief Parallel input script verification and block connection
+ */
+
+#include "consensus/scriptcheck.h"
+
+#include "chain.h"
+#include "coins.h"
+#include "consensus/consensus.h"
+#include "consensus/fee_burner.h"
+#include "consensus/sigcache.h"
+#include "metrics/trace.h"
+#include "primitives/block.h"
+#include "security/checkpointsync.h"
+#include "staking/hybrid_staking.h"
+#include "undo.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <algorithm>
+
+namespace Africoin {
+
+std::unique_ptr<CVerifyPool> g_verifyPool;
+
+bool CScriptCheck::operator()()
+{
+    const CScript& scriptSig = ptxTo->vin[nIn].scriptSig;
+    const CScriptWitness* witness = &ptxTo->vin[nIn].scriptWitness;
+    return VerifyScript(scriptSig, scriptPubKey, witness, nFlags,
+                        CachingTransactionSignatureChecker(ptxTo, nIn, amount, cacheStore, *txdata), &error);
+}
+
+bool CVerifyJob::operator()()
+{
+    if (pblockSig) {
+        TRACE_SPAN("CheckBlockSignature", "verify");
+        return CheckBlockSignature(*pblockSig);
+    }
+    TRACE_SPAN("CScriptCheck", "verify");
+    return check();
+}
+
+static void ExecuteJob(CVerifyJob* job)
+{
+    CVerifyBatch* pbatch = job->pbatch;
+    // Once a batch has failed the block is invalid; skip the rest
+    bool fResult = pbatch->IsOk() ? (*job)() : false;
+    pbatch->Complete(fResult);
+}
+
+CVerifyPool::CVerifyPool(size_t nQueueCapacity)
+    : queue(nQueueCapacity), fStop(false), nWakeSeq(0), nSleepers(0)
+{
+}
+
+CVerifyPool::~CVerifyPool()
+{
+    Stop();
+}
+
+void CVerifyPool::Start(int nThreads)
+{
+    fStop = false;
+    for (int i = 0; i < nThreads; i++)
+        vThreads.emplace_back(&CVerifyPool::ThreadVerify, this);
+}
+
+void CVerifyPool::Stop()
+{
+    fStop = true;
+    nWakeSeq.fetch_add(1);
+    nWakeSeq.notify_all();
+    for (std::thread& thread : vThreads)
+        thread.join();
+    vThreads.clear();
+}
+
+bool CVerifyPool::Submit(CVerifyJob* job)
+{
+    if (!queue.Push(job))
+        return false;
+    if (nSleepers.load(std::memory_order_acquire) > 0) {
+        nWakeSeq.fetch_add(1, std::memory_order_release);
+        nWakeSeq.notify_one();
+    }
+    return true;
+}
+
+bool CVerifyPool::RunOne()
+{
+    CVerifyJob* job;
+    if (!queue.Pop(job))
+        return false;
+    ExecuteJob(job);
+    return true;
+}
+
+void CVerifyPool::ThreadVerify()
+{
+    RenameThread("africoin-scriptch");
+
+    while (!fStop.load(std::memory_order_relaxed)) {
+        if (RunOne())
+            continue;
+
+        // Register as a sleeper, then re-check the queue so a job pushed
+        // between the failed pop and the registration is not missed.
+        uint32_t nSeq = nWakeSeq.load(std::memory_order_acquire);
+        nSleepers.fetch_add(1, std::memory_order_acq_rel);
+        if (!RunOne() && !fStop.load(std::memory_order_relaxed))
+            nWakeSeq.wait(nSeq, std::memory_order_acquire);
+        nSleepers.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+CVerifyBatch::CVerifyBatch(CVerifyPool* poolIn)
+    : pool(poolIn), nPending(0), fOk(true)
+{
+}
+
+CVerifyBatch::~CVerifyBatch()
+{
+    // Jobs reference this batch; never let it go away while queued
+    Wait();
+}
+
+void CVerifyBatch::Complete(bool fResult)
+{
+    if (!fResult)
+        fOk.store(false, std::memory_order_relaxed);
+    nPending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void CVerifyBatch::Enqueue(CVerifyJob& job)
+{
+    job.pbatch = this;
+    nPending.fetch_add(1, std::memory_order_acq_rel);
+    if (!pool || !pool->Submit(&job))
+        ExecuteJob(&job);
+}
+
+void CVerifyBatch::Add(std::vector<CScriptCheck>& vChecks)
+{
+    for (CScriptCheck& check : vChecks) {
+        jobs.emplace_back();
+        std::swap(jobs.back().check, check);
+        Enqueue(jobs.back());
+    }
+    vChecks.clear();
+}
+
+void CVerifyBatch::AddBlockSignature(const CBlock& block)
+{
+    jobs.emplace_back();
+    jobs.back().pblockSig = &block;
+    Enqueue(jobs.back());
+}
+
+bool CVerifyBatch::Wait()
+{
+    while (nPending.load(std::memory_order_acquire) > 0) {
+        if (!pool || !pool->RunOne())
+            std::this_thread::yield();
+    }
+    return fOk.load(std::memory_order_relaxed);
+}
+
+void StartScriptCheckThreads()
+{
+    int nThreads = GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
+    if (nThreads <= 0)
+        nThreads += std::thread::hardware_concurrency();
+    // The connecting thread verifies too, so it is not counted
+    nThreads = std::max(0, std::min(nThreads - 1, MAX_SCRIPTCHECK_THREADS));
+
+    if (nThreads == 0) {
+        g_verifyPool.reset();
+        return;
+    }
+
+    LogPrintf("Using %d threads for script verification\n", nThreads);
+    g_verifyPool.reset(new CVerifyPool());
+    g_verifyPool->Start(nThreads);
+}
+
+void StopScriptCheckThreads()
+{
+    g_verifyPool.reset();
+}
+
+bool CheckInputScripts(const CTransaction& tx, CValidationState& state, const CCoinsViewCache& inputs,
+                       unsigned int flags, bool cacheStore, const PrecomputedTransactionData& txdata,
+                       CVerifyBatch* pbatch)
+{
+    if (tx.IsCoinBase())
+        return true;
+
+    // Verified at mempool acceptance under the same flags: nothing to do
+    uint256 entry = GetScriptExecutionCacheEntry(tx.GetWitnessHash(), flags);
+    if (g_scriptExecutionCache.Contains(entry, !cacheStore))
+        return true;
+
+    std::vector<CScriptCheck> vChecks;
+    vChecks.reserve(tx.vin.size());
+    for (unsigned int i = 0; i < tx.vin.size(); i++) {
+        const Coin& coin = inputs.AccessCoin(tx.vin[i].prevout);
+        if (coin.IsSpent())
+            return state.Invalid(false, REJECT_INVALID, "bad-txns-inputs-missingorspent");
+        vChecks.emplace_back(coin.out, tx, i, flags, cacheStore, &txdata);
+    }
+
+    if (pbatch) {
+        pbatch->Add(vChecks);
+        return true;
+    }
+
+    for (CScriptCheck& check : vChecks) {
+        if (!check())
+            return state.DoS(100, false, REJECT_INVALID,
+                             strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(check.GetScriptError())));
+    }
+
+    if (cacheStore)
+        g_scriptExecutionCache.Insert(entry);
+    return true;
+}
+
+bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex,
+                  CCoinsViewCache& view, CBlockUndo& blockundo, CFeeBurnUndo& burnundo,
+                  unsigned int flags, bool fJustCheck)
+{
+    TRACE_SPAN("ConnectBlock", "validation");
+    int64_t nTimeStart = GetTimeMicros();
+
+    // Queued checks point into the precomputed sighash data, so it is
+    // declared first: every early return destroys the batch (which waits
+    // for the workers) before the data it reads
+    std::vector<PrecomputedTransactionData> vTxData;
+    vTxData.reserve(block.vtx.size());
+    CVerifyBatch batch(g_verifyPool.get());
+    BlockType blockType = HybridStaking::GetBlockType(block);
+
+    // Blocks on the chain up to the signed sync checkpoint are assumed to have valid scripts
+    const bool fScriptChecks = !PeerCoin::g_syncCheckpoints.IsAssumedValid(pindex);
+
+    // Start the signature check first so it overlaps with everything else
+    if (block.IsProofOfStake())
+        batch.AddBlockSignature(block);
+
+    blockundo.vtxundo.reserve(block.vtx.size() - 1);
+
+    CAmount nFees = 0;
+    CAmount nValueCreated = 0;
+    int nInputs = 0;
+
+    for (unsigned int i = 0; i < block.vtx.size(); i++) {
+        const CTransaction& tx = *(block.vtx[i]);
+        nInputs += tx.vin.size();
+
+        if (!tx.IsCoinBase()) {
+            if (!view.HaveInputs(tx))
+                return state.DoS(100, error("%s: inputs missing/spent", __func__),
+                                 REJECT_INVALID, "bad-txns-inputs-missingorspent");
+
+            CAmount nValueIn = 0;
+            for (const CTxIn& txin : tx.vin) {
+                const Coin& coin = view.AccessCoin(txin.prevout);
+                if ((coin.IsCoinBase() || coin.IsCoinStake()) &&
+                    pindex->nHeight - coin.nHeight < COINBASE_MATURITY)
+                    return state.Invalid(false, REJECT_INVALID, "bad-txns-premature-spend-of-coinbase");
+                nValueIn += coin.out.nValue;
+            }
+
+            CAmount nValueOut = tx.GetValueOut();
+            if (tx.IsCoinStake()) {
+                nValueCreated += nValueOut - nValueIn;
+            } else {
+                if (nValueIn < nValueOut)
+                    return state.DoS(100, false, REJECT_INVALID, "bad-txns-in-belowout");
+                nFees += nValueIn - nValueOut;
+            }
+
+            if (fScriptChecks) {
+                vTxData.emplace_back(tx);
+                if (!CheckInputScripts(tx, state, view, flags, false, vTxData.back(), &batch))
+                    return error("%s: CheckInputScripts on %s failed: %s", __func__,
+                                 tx.GetHash().ToString(), FormatStateMessage(state));
+            }
+        } else {
+            nValueCreated += tx.GetValueOut();
+        }
+
+        CTxUndo undoDummy;
+        if (i > 0)
+            blockundo.vtxundo.push_back(CTxUndo());
+        UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
+    }
+
+    int64_t nTimeQueued = GetTimeMicros();
+
+    {
+        // Time the connecting thread waits on (and helps with) the script checks
+        TRACE_SPAN("ConnectBlock:wait", "validation");
+        if (!batch.Wait())
+            return state.DoS(100, error("%s: script or block signature verification failed", __func__),
+                             REJECT_INVALID, "block-validation-failed");
+    }
+
+    int64_t nTimeVerified = GetTimeMicros();
+    LogPrint("bench", "    - Verify %u txins: %.2fms queued, %.2fms total (%.3fms/txin, %d workers)\n",
+             nInputs, 0.001 * (nTimeQueued - nTimeStart), 0.001 * (nTimeVerified - nTimeStart),
+             nInputs <= 1 ? 0 : 0.001 * (nTimeVerified - nTimeStart) / (nInputs - 1),
+             g_verifyPool ? g_verifyPool->GetThreadCount() : 0);
+
+    if (fJustCheck)
+        return true;
+
+    // Fee burn is accounted inline with the connection itself
+    if (!g_feeBurnLedger.ConnectBlock(pindex->nHeight, nFees, nValueCreated, blockType, burnundo))
+        return state.Error("fee burn ledger out of sync");
+
+    return true;
+}
+
+} // namespace Africoin
@@ -0,0 +1,457 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file sha256_dispatch.cpp
+ * @brief Portable SHA-256, CPU detection and the message padding shared by all backends
+ */
+
+#include "crypto/sha256_dispatch.h"
+
+#include "crypto/common.h"
+
+#include <string.h>
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__)) && defined(__GNUC__) && \
+    (defined(ENABLE_SSE41) || defined(ENABLE_AVX2) || defined(ENABLE_SHANI))
+#define AFRICOIN_SHA256_X86 1
+#include <cpuid.h>
+#endif
+
+namespace Africoin {
+
+/** Compress one 64-byte block per lane; state word w of lane l is s[w * lanes + l] */
+typedef void (*SHA256LanesFn)(uint32_t* s, const unsigned char* const* chunks);
+/** Compress blocks consecutive 64-byte blocks of one message */
+typedef void (*SHA256TransformFn)(uint32_t* s, const unsigned char* chunk, size_t blocks);
+
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_SSE41)
+namespace sha256_sse41 {
+void Transform4(uint32_t* s, const unsigned char* const* chunks);
+}
+#endif
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_AVX2)
+namespace sha256_avx2 {
+void Transform8(uint32_t* s, const unsigned char* const* chunks);
+}
+#endif
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_SHANI)
+namespace sha256_shani {
+void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
+}
+#endif
+
+namespace {
+
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+/** Most lanes any backend computes at once */
+const size_t SHA256_MAX_LANES = 8;
+
+namespace sha256_portable {
+
+inline uint32_t Ror(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+inline uint32_t Ch(uint32_t x, uint32_t y, uint32_t z) { return z ^ (x & (y ^ z)); }
+inline uint32_t Maj(uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (z & (x | y)); }
+inline uint32_t Sigma0(uint32_t x) { return Ror(x, 2) ^ Ror(x, 13) ^ Ror(x, 22); }
+inline uint32_t Sigma1(uint32_t x) { return Ror(x, 6) ^ Ror(x, 11) ^ Ror(x, 25); }
+inline uint32_t sigma0(uint32_t x) { return Ror(x, 7) ^ Ror(x, 18) ^ (x >> 3); }
+inline uint32_t sigma1(uint32_t x) { return Ror(x, 17) ^ Ror(x, 19) ^ (x >> 10); }
+
+void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks)
+{
+    while (blocks--) {
+        uint32_t w[16];
+        for (int i = 0; i < 16; i++)
+            w[i] = ReadBE32(chunk + 4 * i);
+
+        uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        for (int r = 0; r < 64; r++) {
+            if (r >= 16)
+                w[r & 15] += sigma1(w[(r - 2) & 15]) + w[(r - 7) & 15] + sigma0(w[(r - 15) & 15]);
+            uint32_t t1 = h + Sigma1(e) + Ch(e, f, g) + SHA256_K[r] + w[r & 15];
+            uint32_t t2 = Sigma0(a) + Maj(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        s[0] += a;
+        s[1] += b;
+        s[2] += c;
+        s[3] += d;
+        s[4] += e;
+        s[5] += f;
+        s[6] += g;
+        s[7] += h;
+        chunk += 64;
+    }
+}
+
+} // namespace sha256_portable
+
+/**
+ * What the selected backend computes with. Set at startup by
+ * SHA256AutoDetect (or by tests through SHA256SetBackend), read-only after.
+ */
+struct CSHA256Implementation {
+    SHA256Backend backend;
+    SHA256TransformFn transform;
+    SHA256LanesFn transformLanes;      //!< nullptr: single-lane backend, messages go one by one
+    size_t nLanes;
+};
+
+CSHA256Implementation g_sha256 = {SHA256_PORTABLE, sha256_portable::Transform, nullptr, 1};
+
+/**
+ * Block b of the padded message: message bytes, the 0x80 terminator,
+ * zeros and the bit length in the last eight bytes of the last block
+ */
+void PadBlock(unsigned char* block, const unsigned char* msg, size_t len, size_t b, size_t nBlocks)
+{
+    const size_t nOffset = b * 64;
+    memset(block, 0, 64);
+    if (nOffset < len)
+        memcpy(block, msg + nOffset, std::min<size_t>(64, len - nOffset));
+    if (len >= nOffset && len < nOffset + 64)
+        block[len - nOffset] = 0x80;
+    if (b == nBlocks - 1)
+        WriteBE64(block + 56, (uint64_t)len << 3);
+}
+
+size_t PaddedBlocks(size_t len) { return (len + 8) / 64 + 1; }
+
+void SHA256With(SHA256TransformFn transform, unsigned char* out, const unsigned char* data, size_t len)
+{
+    uint32_t s[8];
+    memcpy(s, SHA256_IV, sizeof(s));
+
+    // Whole blocks straight from the input, then the one or two padded ones
+    const size_t nBlocks = PaddedBlocks(len);
+    const size_t nDirect = len / 64;
+    if (nDirect)
+        transform(s, data, nDirect);
+    unsigned char block[64];
+    for (size_t b = nDirect; b < nBlocks; b++) {
+        PadBlock(block, data, len, b, nBlocks);
+        transform(s, block, 1);
+    }
+    for (int i = 0; i < 8; i++)
+        WriteBE32(out + 4 * i, s[i]);
+}
+
+/** Digest of the first hash padded into the single block of the second */
+void PadDigestBlock(unsigned char* block, const uint32_t* s, size_t nStride)
+{
+    for (int i = 0; i < 8; i++)
+        WriteBE32(block + 4 * i, s[i * nStride]);
+    memset(block + 32, 0, 32);
+    block[32] = 0x80;
+    WriteBE64(block + 56, 256);
+}
+
+/** Up to nLanes messages side by side; unused lanes hash a copy of the last message */
+void SHA256dLanes(const CSHA256Implementation& impl, unsigned char* out, const unsigned char* in, size_t len, size_t n)
+{
+    const size_t nLanes = impl.nLanes;
+    const size_t nBlocks = PaddedBlocks(len);
+    uint32_t s[8 * SHA256_MAX_LANES];
+    unsigned char vchBlocks[SHA256_MAX_LANES][64];
+    const unsigned char* chunks[SHA256_MAX_LANES];
+
+    for (size_t w = 0; w < 8; w++)
+        for (size_t l = 0; l < nLanes; l++)
+            s[w * nLanes + l] = SHA256_IV[w];
+
+    for (size_t b = 0; b < nBlocks; b++) {
+        for (size_t l = 0; l < nLanes; l++) {
+            const unsigned char* msg = in + std::min(l, n - 1) * len;
+            if ((b + 1) * 64 <= len) {
+                chunks[l] = msg + b * 64;
+            } else {
+                PadBlock(vchBlocks[l], msg, len, b, nBlocks);
+                chunks[l] = vchBlocks[l];
+            }
+        }
+        impl.transformLanes(s, chunks);
+    }
+
+    // Second hash: every lane hashes its 32-byte digest in one block
+    for (size_t l = 0; l < nLanes; l++) {
+        PadDigestBlock(vchBlocks[l], s + l, nLanes);
+        chunks[l] = vchBlocks[l];
+    }
+    for (size_t w = 0; w < 8; w++)
+        for (size_t l = 0; l < nLanes; l++)
+            s[w * nLanes + l] = SHA256_IV[w];
+    impl.transformLanes(s, chunks);
+
+    for (size_t l = 0; l < n; l++)
+        for (size_t w = 0; w < 8; w++)
+            WriteBE32(out + l * 32 + w * 4, s[w * nLanes + l]);
+}
+
+void SHA256dManyWith(const CSHA256Implementation& impl, unsigned char* out, const unsigned char* in, size_t len, size_t n)
+{
+    if (!impl.transformLanes) {
+        unsigned char vchInner[SHA256_OUTPUT_SIZE];
+        for (size_t i = 0; i < n; i++) {
+            SHA256With(impl.transform, vchInner, in + i * len, len);
+            SHA256With(impl.transform, out + i * 32, vchInner, sizeof(vchInner));
+        }
+        return;
+    }
+    // Each group reads its input before writing its output, which only
+    // ever lands at or before the input: in-place D64 is safe
+    for (size_t i = 0; i < n; i += impl.nLanes)
+        SHA256dLanes(impl, out + i * 32, in + i * len, len, std::min(impl.nLanes, n - i));
+}
+
+#if defined(AFRICOIN_SHA256_X86)
+struct CCPUFeatures {
+    bool fSSE41;
+    bool fAVX2;
+    bool fSHA;
+};
+
+CCPUFeatures GetCPUFeatures()
+{
+    CCPUFeatures features = {false, false, false};
+    uint32_t eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) < 7)
+        return features;
+    __cpuid_count(1, 0, eax, ebx, ecx, edx);
+    const bool fSSSE3 = (ecx >> 9) & 1;
+    features.fSSE41 = fSSSE3 && ((ecx >> 19) & 1);
+    const bool fOSXSAVE = (ecx >> 27) & 1;
+    const bool fAVX = (ecx >> 28) & 1;
+    bool fYMMSaved = false;
+    if (fOSXSAVE && fAVX) {
+        // The OS must save the upper halves of the YMM registers too
+        uint32_t a, d;
+        __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+        fYMMSaved = (a & 6) == 6;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    features.fAVX2 = fYMMSaved && ((ebx >> 5) & 1);
+    features.fSHA = features.fSSE41 && ((ebx >> 29) & 1);
+    return features;
+}
+#endif
+
+bool MakeImplementation(SHA256Backend backend, CSHA256Implementation& impl)
+{
+    if (!SHA256BackendAvailable(backend))
+        return false;
+    impl.backend = backend;
+    impl.transform = sha256_portable::Transform;
+    impl.transformLanes = nullptr;
+    impl.nLanes = 1;
+    switch (backend) {
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_SSE41)
+    case SHA256_SSE41:
+        impl.transformLanes = sha256_sse41::Transform4;
+        impl.nLanes = 4;
+        break;
+#endif
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_AVX2)
+    case SHA256_AVX2:
+        impl.transformLanes = sha256_avx2::Transform8;
+        impl.nLanes = 8;
+        break;
+#endif
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_SHANI)
+    case SHA256_SHANI:
+        impl.transform = sha256_shani::Transform;
+        break;
+#endif
+    default:
+        break;
+    }
+    return true;
+}
+
+bool SelfTest(const CSHA256Implementation& impl)
+{
+    // FIPS 180-2 vectors: one block, empty, and a message whose padding spills into a second block
+    static const struct {
+        const char* msg;
+        unsigned char hash[32];
+    } vectors[] = {
+        {"abc",
+         {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+          0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad}},
+        {"",
+         {0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+          0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55}},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+          0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}},
+    };
+    unsigned char hash[SHA256_OUTPUT_SIZE];
+    for (const auto& vector : vectors) {
+        SHA256With(impl.transform, hash, (const unsigned char*)vector.msg, strlen(vector.msg));
+        if (memcmp(hash, vector.hash, sizeof(hash)) != 0)
+            return false;
+    }
+
+    // Multi-message against the portable code, at the kernel, modifier and
+    // merkle lengths, a two-block length and a lane count that leaves a partial group
+    static const size_t vLengths[] = {28, 40, 64, 100};
+    const size_t n = 2 * SHA256_MAX_LANES + 3;
+    unsigned char in[100 * n];
+    for (size_t i = 0; i < sizeof(in); i++)
+        in[i] = (unsigned char)(i * 7 + 1);
+    unsigned char out[32 * n];
+    unsigned char inner[32];
+    unsigned char expected[32];
+    for (size_t len : vLengths) {
+        SHA256dManyWith(impl, out, in, len, n);
+        for (size_t i = 0; i < n; i++) {
+            SHA256With(sha256_portable::Transform, inner, in + i * len, len);
+            SHA256With(sha256_portable::Transform, expected, inner, sizeof(inner));
+            if (memcmp(out + i * 32, expected, sizeof(expected)) != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool SHA256BackendAvailable(SHA256Backend backend)
+{
+#if defined(AFRICOIN_SHA256_X86)
+    static const CCPUFeatures features = GetCPUFeatures();
+#endif
+    switch (backend) {
+    case SHA256_PORTABLE:
+        return true;
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_SSE41)
+    case SHA256_SSE41:
+        return features.fSSE41;
+#endif
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_AVX2)
+    case SHA256_AVX2:
+        return features.fAVX2;
+#endif
+#if defined(AFRICOIN_SHA256_X86) && defined(ENABLE_SHANI)
+    case SHA256_SHANI:
+        return features.fSHA;
+#endif
+    default:
+        return false;
+    }
+}
+
+std::string SHA256AutoDetect()
+{
+    // SHA-NI beats eight AVX2 lanes even on many messages, and does single ones too
+    static const SHA256Backend vPreference[] = {SHA256_SHANI, SHA256_AVX2, SHA256_SSE41, SHA256_PORTABLE};
+
+    std::string strAvailable;
+    bool fChosen = false;
+    for (SHA256Backend backend : vPreference) {
+        CSHA256Implementation impl;
+        if (!MakeImplementation(backend, impl))
+            continue;
+        strAvailable += strAvailable.empty() ? "" : ", ";
+        strAvailable += SHA256BackendName(backend);
+        if (!fChosen && SelfTest(impl)) {
+            g_sha256 = impl;
+            fChosen = true;
+        }
+    }
+    return std::string(SHA256BackendName(g_sha256.backend)) + " (available: " + strAvailable + ")";
+}
+
+bool SHA256SelfTest()
+{
+    return SelfTest(g_sha256);
+}
+
+bool SHA256SetBackend(SHA256Backend backend)
+{
+    CSHA256Implementation impl;
+    if (!MakeImplementation(backend, impl))
+        return false;
+    g_sha256 = impl;
+    return true;
+}
+
+SHA256Backend SHA256GetBackend()
+{
+    return g_sha256.backend;
+}
+
+const char* SHA256BackendName(SHA256Backend backend)
+{
+    switch (backend) {
+    case SHA256_PORTABLE: return "portable";
+    case SHA256_SSE41: return "sse4.1(4way)";
+    case SHA256_AVX2: return "avx2(8way)";
+    case SHA256_SHANI: return "shani";
+    default: return "unknown";
+    }
+}
+
+void SHA256Single(unsigned char* out, const unsigned char* data, size_t len)
+{
+    SHA256With(g_sha256.transform, out, data, len);
+}
+
+uint256 SHA256d(const unsigned char* data, size_t len)
+{
+    unsigned char vchInner[SHA256_OUTPUT_SIZE];
+    SHA256With(g_sha256.transform, vchInner, data, len);
+    uint256 hash;
+    SHA256With(g_sha256.transform, hash.begin(), vchInner, sizeof(vchInner));
+    return hash;
+}
+
+void SHA256dMany(unsigned char* out, const unsigned char* in, size_t len, size_t n)
+{
+    SHA256dManyWith(g_sha256, out, in, len, n);
+}
+
+void SHA256D64(unsigned char* out, const unsigned char* in, size_t n)
+{
+    SHA256dManyWith(g_sha256, out, in, 64, n);
+}
+
+uint256 SHA256MerkleRoot(std::vector<uint256> vLeaves, bool* pfMutated)
+{
+    bool fMutation = false;
+    while (vLeaves.size() > 1) {
+        for (size_t i = 0; i + 1 < vLeaves.size(); i += 2)
+            if (vLeaves[i] == vLeaves[i + 1])
+                fMutation = true;
+        if (vLeaves.size() & 1)
+            vLeaves.push_back(vLeaves.back());
+        // uint256 is 32 plain bytes, so the level is one contiguous array of 64-byte pairs
+        SHA256D64(vLeaves[0].begin(), vLeaves[0].begin(), vLeaves.size() / 2);
+        vLeaves.resize(vLeaves.size() / 2);
+    }
+    if (pfMutated)
+        *pfMutated = fMutation;
+    return vLeaves.empty() ? uint256() : vLeaves[0];
+}
+
+} // namespace Africoin
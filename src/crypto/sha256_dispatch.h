@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_CRYPTO_SHA256_DISPATCH_H
+#define AFRICOIN_CRYPTO_SHA256_DISPATCH_H
+
+#include "uint256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file sha256_dispatch.h
+ * @brief SHA-256 for the staking hot paths, dispatched on the CPU at runtime
+ *
+ * Kernel hashes, stake modifiers and merkle trees hash short messages of
+ * a fixed length, many at a time. Four backends compute the compression
+ * function:
+ *
+ * - SHA256_PORTABLE: plain C++, one message at a time
+ * - SHA256_SSE41: four messages at a time in 128-bit lanes
+ * - SHA256_AVX2: eight messages at a time in 256-bit lanes
+ * - SHA256_SHANI: the x86 SHA extensions, one message at a time
+ *
+ * SHA256AutoDetect picks the fastest backend the CPU has and checks it
+ * against known answers before using it; until it is called everything
+ * runs on the portable backend. The multi-lane backends only speed up
+ * the multi-message calls (SHA256dMany, SHA256D64); single messages use
+ * the portable compression under them.
+ *
+ * The SIMD backends are only built for x86 with GCC or Clang, each in its
+ * own translation unit compiled for its instruction set, and are never
+ * called on a CPU that lacks it.
+ */
+
+namespace Africoin {
+
+enum SHA256Backend {
+    SHA256_PORTABLE,
+    SHA256_SSE41,
+    SHA256_AVX2,
+    SHA256_SHANI,
+    SHA256_BACKEND_COUNT
+};
+
+/** Size of a SHA-256 digest */
+static const size_t SHA256_OUTPUT_SIZE = 32;
+
+/**
+ * @brief Select the fastest backend this CPU supports
+ *
+ * Call once at startup, before other threads hash. A backend that fails
+ * its self-test is skipped for the next best one.
+ *
+ * @return The backend chosen and the ones available, for the debug log
+ */
+std::string SHA256AutoDetect();
+
+/** @brief Known-answer tests of the current backend, single and multi-message */
+bool SHA256SelfTest();
+
+/** @brief Whether this build and CPU can run a backend */
+bool SHA256BackendAvailable(SHA256Backend backend);
+
+/** @brief Switch to a backend, for tests and benchmarks; false if unavailable */
+bool SHA256SetBackend(SHA256Backend backend);
+
+SHA256Backend SHA256GetBackend();
+const char* SHA256BackendName(SHA256Backend backend);
+
+/** @brief SHA256(data) */
+void SHA256Single(unsigned char* out, const unsigned char* data, size_t len);
+
+/** @brief SHA256(SHA256(data)), as CHashWriter::GetHash */
+uint256 SHA256d(const unsigned char* data, size_t len);
+
+/**
+ * @brief SHA256(SHA256(x)) of n messages of len bytes each
+ *
+ * Message i is in[i * len, (i + 1) * len), its hash goes to
+ * out[i * 32, (i + 1) * 32).
+ */
+void SHA256dMany(unsigned char* out, const unsigned char* in, size_t len, size_t n);
+
+/** @brief SHA256(SHA256(x)) of n 64-byte messages: a merkle tree level */
+void SHA256D64(unsigned char* out, const unsigned char* in, size_t n);
+
+/**
+ * @brief Merkle root of a list of hashes, one SHA256D64 call per level
+ *
+ * Same result as ComputeMerkleRoot in consensus/merkle.h, including the
+ * duplicated last hash of odd levels and the mutation check.
+ *
+ * @param[out] pfMutated  Set if two identical hashes were paired (may be nullptr)
+ */
+uint256 SHA256MerkleRoot(std::vector<uint256> vLeaves, bool* pfMutated = nullptr);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_CRYPTO_SHA256_DISPATCH_H
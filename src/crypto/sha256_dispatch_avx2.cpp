@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file sha256_dispatch_avx2.cpp
+ * @brief SHA-256 compression of eight messages at once in AVX2 lanes
+ *
+ * Compiled with -mavx2; only called after SHA256AutoDetect has seen
+ * the CPU support it.
+ */
+
+#if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__)) && defined(__GNUC__) && defined(ENABLE_AVX2)
+
+#include "crypto/common.h"
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Africoin {
+namespace sha256_avx2 {
+namespace {
+
+const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+inline __m256i Add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+inline __m256i Add(__m256i x, __m256i y, __m256i z) { return Add(Add(x, y), z); }
+inline __m256i Add(__m256i x, __m256i y, __m256i z, __m256i w) { return Add(Add(x, y), Add(z, w)); }
+inline __m256i Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+inline __m256i Xor(__m256i x, __m256i y, __m256i z) { return Xor(Xor(x, y), z); }
+inline __m256i Or(__m256i x, __m256i y) { return _mm256_or_si256(x, y); }
+inline __m256i And(__m256i x, __m256i y) { return _mm256_and_si256(x, y); }
+inline __m256i ShR(__m256i x, int n) { return _mm256_srli_epi32(x, n); }
+inline __m256i ShL(__m256i x, int n) { return _mm256_slli_epi32(x, n); }
+inline __m256i Ror(__m256i x, int n) { return Or(ShR(x, n), ShL(x, 32 - n)); }
+
+inline __m256i Ch(__m256i x, __m256i y, __m256i z) { return Xor(z, And(x, Xor(y, z))); }
+inline __m256i Maj(__m256i x, __m256i y, __m256i z) { return Or(And(x, y), And(z, Or(x, y))); }
+inline __m256i Sigma0(__m256i x) { return Xor(Ror(x, 2), Ror(x, 13), Ror(x, 22)); }
+inline __m256i Sigma1(__m256i x) { return Xor(Ror(x, 6), Ror(x, 11), Ror(x, 25)); }
+inline __m256i sigma0(__m256i x) { return Xor(Ror(x, 7), Ror(x, 18), ShR(x, 3)); }
+inline __m256i sigma1(__m256i x) { return Xor(Ror(x, 17), Ror(x, 19), ShR(x, 10)); }
+
+/** One round; the caller rotates the roles of the eight working variables */
+inline void Round(__m256i a, __m256i b, __m256i c, __m256i& d, __m256i e, __m256i f, __m256i g, __m256i& h, __m256i k)
+{
+    __m256i t1 = Add(h, Sigma1(e), Ch(e, f, g), k);
+    __m256i t2 = Add(Sigma0(a), Maj(a, b, c));
+    d = Add(d, t1);
+    h = Add(t1, t2);
+}
+
+/** Message schedule word r plus its round constant, expanding w in place past the first 16 */
+inline __m256i KW(__m256i* w, int r)
+{
+    if (r >= 16)
+        w[r & 15] = Add(sigma1(w[(r - 2) & 15]), w[(r - 7) & 15], sigma0(w[(r - 15) & 15]), w[r & 15]);
+    return Add(w[r & 15], _mm256_set1_epi32(K[r]));
+}
+
+inline __m256i Read8(const unsigned char* const* chunks, int offset)
+{
+    return _mm256_set_epi32(ReadBE32(chunks[7] + offset), ReadBE32(chunks[6] + offset),
+                            ReadBE32(chunks[5] + offset), ReadBE32(chunks[4] + offset),
+                            ReadBE32(chunks[3] + offset), ReadBE32(chunks[2] + offset),
+                            ReadBE32(chunks[1] + offset), ReadBE32(chunks[0] + offset));
+}
+
+} // namespace
+
+void Transform8(uint32_t* s, const unsigned char* const* chunks)
+{
+    __m256i w[16];
+    for (int i = 0; i < 16; i++)
+        w[i] = Read8(chunks, 4 * i);
+
+    __m256i a = _mm256_loadu_si256((const __m256i*)(s + 0));
+    __m256i b = _mm256_loadu_si256((const __m256i*)(s + 8));
+    __m256i c = _mm256_loadu_si256((const __m256i*)(s + 16));
+    __m256i d = _mm256_loadu_si256((const __m256i*)(s + 24));
+    __m256i e = _mm256_loadu_si256((const __m256i*)(s + 32));
+    __m256i f = _mm256_loadu_si256((const __m256i*)(s + 40));
+    __m256i g = _mm256_loadu_si256((const __m256i*)(s + 48));
+    __m256i h = _mm256_loadu_si256((const __m256i*)(s + 56));
+    const __m256i a0 = a, b0 = b, c0 = c, d0 = d, e0 = e, f0 = f, g0 = g, h0 = h;
+
+    for (int r = 0; r < 64; r += 8) {
+        Round(a, b, c, d, e, f, g, h, KW(w, r));
+        Round(h, a, b, c, d, e, f, g, KW(w, r + 1));
+        Round(g, h, a, b, c, d, e, f, KW(w, r + 2));
+        Round(f, g, h, a, b, c, d, e, KW(w, r + 3));
+        Round(e, f, g, h, a, b, c, d, KW(w, r + 4));
+        Round(d, e, f, g, h, a, b, c, KW(w, r + 5));
+        Round(c, d, e, f, g, h, a, b, KW(w, r + 6));
+        Round(b, c, d, e, f, g, h, a, KW(w, r + 7));
+    }
+
+    _mm256_storeu_si256((__m256i*)(s + 0), Add(a, a0));
+    _mm256_storeu_si256((__m256i*)(s + 8), Add(b, b0));
+    _mm256_storeu_si256((__m256i*)(s + 16), Add(c, c0));
+    _mm256_storeu_si256((__m256i*)(s + 24), Add(d, d0));
+    _mm256_storeu_si256((__m256i*)(s + 32), Add(e, e0));
+    _mm256_storeu_si256((__m256i*)(s + 40), Add(f, f0));
+    _mm256_storeu_si256((__m256i*)(s + 48), Add(g, g0));
+    _mm256_storeu_si256((__m256i*)(s + 56), Add(h, h0));
+}
+
+} // namespace sha256_avx2
+} // namespace Africoin
+
+#endif
@@ -1 +1,43 @@
-// init.cpp: Node startup, shutdown, and initialization routines.
\ No newline at end of file
+// init.cpp: Node startup, shutdown, and initialization routines.
+//
+// Replaced by BlackCoin's init.cpp on integration (see Makefile.am).
+// Nothing else in this tree calls the Africoin hooks listed here, so
+// the merged AppInitMain and Shutdown must call them.
+//
+// AppInitMain, once the scheduler thread is running:
+// - Africoin::Trace::InitTracing(), then
+//   Africoin::Trace::ScheduleTraceDump(scheduler) (metrics/trace.h)
+// - Africoin::Metrics::ScheduleMetricsDump(scheduler) (metrics/metrics.h)
+// - Africoin::RegisterAllAfricoinRPCCommands(tableRPC) (rpc/register.h),
+//   next to Bitcoin's RegisterAllCoreRPCCommands
+//
+// AppInitMain, after the random number generator is seeded and before
+// the first block or transaction is checked:
+// - Africoin::InitSignatureCaches() (consensus/sigcache.h), in place of
+//   Bitcoin's InitSignatureCache and InitScriptExecutionCache
+// - Africoin::StartScriptCheckThreads() (consensus/scriptcheck.h), in
+//   place of the CCheckQueue threads started from -par
+//
+// Shutdown:
+// - Africoin::StopScriptCheckThreads() (consensus/scriptcheck.h)
+//
+// AppInitMain, once LoadBlockIndex has loaded the block index:
+// - PeerCoin::InitSyncCheckpoints(pblocktree.get(), strError)
+//   (security/checkpointsync.h), failing startup with strError if it
+//   returns false. It reloads the checkpoint kept in the block tree DB.
+//
+// AppInitMain, with -loadsnapshot=<file>, once the headers up to the
+// snapshot block are synced and before any block is connected:
+// - under cs_main, Africoin::LoadSnapshot(path, Africoin::g_blockForest,
+//   *pcoinsdbview, <railway node map>, Africoin::g_feeBurnLedger,
+//   metadata, stats) (storage/snapshot.h), failing startup if it
+//   returns false; then, without cs_main,
+//   Africoin::StartSnapshotValidation(metadata, <empty background coins
+//   view>) to check the snapshot against the block history
+// - at every start while that check has not finished, the same
+//   StartSnapshotValidation call with the stored metadata
+//
+// Shutdown, before the coins views are closed:
+// - Africoin::StopSnapshotValidation() (storage/snapshot.h)
+// - if Africoin::IsSnapshotInvalid(), keep the snapshot chainstate
+//   marked bad so that the next start requires -reindex-chainstate
@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file metrics.cpp
+ * @brief Low-overhead counters and latency histograms for consensus hot paths
+ */
+
+#include "metrics/metrics.h"
+
+#include "scheduler.h"
+#include "tinyformat.h"
+#include "util.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <mutex>
+
+namespace Africoin {
+namespace Metrics {
+
+static const int64_t DEFAULT_METRICS_INTERVAL = 60;
+
+/**
+ * Registry of every metric. Metrics are static objects, so registration
+ * happens during static initialization; the function-local statics make
+ * that safe across translation units.
+ */
+static std::mutex& RegistryMutex()
+{
+    static std::mutex cs;
+    return cs;
+}
+
+static std::vector<const CCounter*>& CounterRegistry()
+{
+    static std::vector<const CCounter*> vCounters;
+    return vCounters;
+}
+
+static std::vector<const CHistogram*>& HistogramRegistry()
+{
+    static std::vector<const CHistogram*> vHistograms;
+    return vHistograms;
+}
+
+unsigned int GetThreadShard()
+{
+    static std::atomic<unsigned int> nNextShard(0);
+    thread_local unsigned int nShard = nNextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return nShard;
+}
+
+CCounter::CCounter(const char* pszNameIn, const char* pszHelpIn) : pszName(pszNameIn), pszHelp(pszHelpIn)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    CounterRegistry().push_back(this);
+}
+
+uint64_t CCounter::Get() const
+{
+    uint64_t nTotal = 0;
+    for (const Shard& shard : vShards)
+        nTotal += shard.n.load(std::memory_order_relaxed);
+    return nTotal;
+}
+
+CHistogram::Shard::Shard() : nCount(0), nSum(0)
+{
+    for (std::atomic<uint64_t>& bucket : vBuckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+CHistogram::CHistogram(const char* pszNameIn, const char* pszHelpIn)
+    : pszName(pszNameIn), pszHelp(pszHelpIn), vShards(new Shard[METRIC_SHARDS])
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    HistogramRegistry().push_back(this);
+}
+
+uint64_t CHistogram::BucketLowerBound(unsigned int nIndex)
+{
+    if (nIndex < SUB_BUCKETS)
+        return nIndex;
+    unsigned int nShift = (nIndex >> SUB_BUCKET_BITS) - 1;
+    return (uint64_t)(SUB_BUCKETS | (nIndex & (SUB_BUCKETS - 1))) << nShift;
+}
+
+uint64_t CHistogram::BucketUpperBound(unsigned int nIndex)
+{
+    if (nIndex < SUB_BUCKETS)
+        return nIndex;
+    unsigned int nShift = (nIndex >> SUB_BUCKET_BITS) - 1;
+    return BucketLowerBound(nIndex) + (((uint64_t)1 << nShift) - 1);
+}
+
+void CHistogram::GetSnapshot(Snapshot& snapshot) const
+{
+    snapshot = Snapshot();
+    for (unsigned int i = 0; i < METRIC_SHARDS; i++) {
+        const Shard& shard = vShards[i];
+        snapshot.nCount += shard.nCount.load(std::memory_order_relaxed);
+        snapshot.nSum += shard.nSum.load(std::memory_order_relaxed);
+        for (unsigned int b = 0; b < NUM_BUCKETS; b++)
+            snapshot.vBuckets[b] += shard.vBuckets[b].load(std::memory_order_relaxed);
+    }
+}
+
+uint64_t CHistogram::Snapshot::Quantile(double q) const
+{
+    // Shards are read one at a time, so the bucket total can differ
+    // slightly from nCount; rank against the buckets themselves.
+    uint64_t nTotal = 0;
+    for (uint64_t n : vBuckets)
+        nTotal += n;
+    if (nTotal == 0)
+        return 0;
+
+    uint64_t nRank = q <= 0 ? 1 : q >= 1 ? nTotal : (uint64_t)(q * nTotal + 0.5);
+    if (nRank == 0)
+        nRank = 1;
+    uint64_t nSeen = 0;
+    for (unsigned int b = 0; b < NUM_BUCKETS; b++) {
+        nSeen += vBuckets[b];
+        if (nSeen >= nRank)
+            return BucketUpperBound(b);
+    }
+    return BucketUpperBound(NUM_BUCKETS - 1);
+}
+
+std::vector<const CCounter*> GetCounters()
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    return CounterRegistry();
+}
+
+std::vector<const CHistogram*> GetHistograms()
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    return HistogramRegistry();
+}
+
+bool IsEnabled()
+{
+#ifdef ENABLE_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string FormatPrometheus()
+{
+    static const double QUANTILES[] = {0.5, 0.9, 0.99, 1.0};
+
+    std::string strOut;
+    for (const CCounter* counter : GetCounters()) {
+        strOut += strprintf("# HELP %s %s\n", counter->GetName(), counter->GetHelp());
+        strOut += strprintf("# TYPE %s counter\n", counter->GetName());
+        strOut += strprintf("%s %u\n", counter->GetName(), counter->Get());
+    }
+
+    CHistogram::Snapshot snapshot;
+    for (const CHistogram* hist : GetHistograms()) {
+        hist->GetSnapshot(snapshot);
+        strOut += strprintf("# HELP %s %s\n", hist->GetName(), hist->GetHelp());
+        strOut += strprintf("# TYPE %s summary\n", hist->GetName());
+        for (double q : QUANTILES)
+            strOut += strprintf("%s{quantile=\"%g\"} %.9f\n", hist->GetName(), q, snapshot.Quantile(q) * 1e-9);
+        strOut += strprintf("%s_sum %.9f\n", hist->GetName(), snapshot.nSum * 1e-9);
+        strOut += strprintf("%s_count %u\n", hist->GetName(), snapshot.nCount);
+    }
+    return strOut;
+}
+
+bool WritePrometheusFile(const std::string& strPath)
+{
+    // Write then rename, so a scraper never reads a partial file
+    std::string strTmp = strPath + ".new";
+    FILE* file = fopen(strTmp.c_str(), "w");
+    if (!file)
+        return error("%s: cannot open %s", __func__, strTmp);
+
+    std::string strOut = FormatPrometheus();
+    bool fWritten = fwrite(strOut.data(), 1, strOut.size(), file) == strOut.size();
+    fWritten = fclose(file) == 0 && fWritten;
+    if (!fWritten || rename(strTmp.c_str(), strPath.c_str()) != 0) {
+        remove(strTmp.c_str());
+        return error("%s: cannot write %s", __func__, strPath);
+    }
+    return true;
+}
+
+void ScheduleMetricsDump(CScheduler& scheduler)
+{
+    std::string strPath = GetArg("-metricsfile", "");
+    if (strPath.empty())
+        return;
+
+    int64_t nInterval = std::max((int64_t)1, GetArg("-metricsinterval", DEFAULT_METRICS_INTERVAL));
+    LogPrintf("Writing metrics to %s every %d seconds\n", strPath, nInterval);
+    scheduler.scheduleEvery([strPath] { WritePrometheusFile(strPath); }, nInterval);
+}
+
+} // namespace Metrics
+} // namespace Africoin
@@ -0,0 +1,223 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_METRICS_METRICS_H
+#define AFRICOIN_METRICS_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CScheduler;
+
+/**
+ * @file metrics.h
+ * @brief Low-overhead counters and latency histograms for consensus hot paths
+ *
+ * Metrics are file-scope objects in the code they measure:
+ *
+ *   METRIC_HISTOGRAM(histCheckPoS, "africoin_kernel_check_pos_seconds", "CheckProofOfStake latency");
+ *   METRIC_COUNTER(counterRejected, "africoin_kernel_rejected_total", "Stakes failing the kernel");
+ *
+ *   bool CheckProofOfStake(...)
+ *   {
+ *       METRIC_SCOPED_TIMER(histCheckPoS);
+ *       ...
+ *       METRIC_INC(counterRejected);
+ *   }
+ *
+ * Updates are a relaxed atomic add on a per-thread shard, so script and
+ * kernel checks running on several threads never share a cache line.
+ * Shards are only summed when the metrics are read.
+ *
+ * Histograms are HDR-style: 16 linear sub-buckets per power of two, so
+ * any recorded nanosecond value is kept to within 1/16 (6.25%) from one
+ * nanosecond up to the full 64-bit range, in a fixed 976-bucket array.
+ *
+ * Everything is compiled in with ENABLE_METRICS (the default). Without
+ * it the macros expand to nothing, so instrumented code has no overhead
+ * at all; getmetrics then reports no metrics.
+ */
+
+namespace Africoin {
+namespace Metrics {
+
+/** Number of per-thread shards; threads beyond this share shards */
+static const unsigned int METRIC_SHARDS = 8;
+
+/** Shard of the calling thread, assigned round-robin on first use */
+unsigned int GetThreadShard();
+
+/**
+ * @class CCounter
+ * @brief Monotonic counter, sharded per thread
+ */
+class CCounter {
+public:
+    CCounter(const char* pszNameIn, const char* pszHelpIn);
+
+    CCounter(const CCounter&) = delete;
+    CCounter& operator=(const CCounter&) = delete;
+
+    void Add(uint64_t n = 1) { vShards[GetThreadShard()].n.fetch_add(n, std::memory_order_relaxed); }
+
+    /** Sum over all shards; concurrent updates may or may not be included */
+    uint64_t Get() const;
+
+    const char* GetName() const { return pszName; }
+    const char* GetHelp() const { return pszHelp; }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> n;
+        Shard() : n(0) {}
+    };
+
+    const char* pszName;
+    const char* pszHelp;
+    Shard vShards[METRIC_SHARDS];
+};
+
+/**
+ * @class CHistogram
+ * @brief Latency histogram in nanoseconds, sharded per thread
+ */
+class CHistogram {
+public:
+    static const unsigned int SUB_BUCKET_BITS = 4;
+    static const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const unsigned int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @struct Snapshot
+     * @brief All shards merged at one point in time
+     */
+    struct Snapshot {
+        uint64_t nCount;
+        uint64_t nSum;
+        std::vector<uint64_t> vBuckets;
+
+        Snapshot() : nCount(0), nSum(0), vBuckets(NUM_BUCKETS, 0) {}
+
+        /** Upper bound of the bucket holding the q-quantile (0 <= q <= 1) */
+        uint64_t Quantile(double q) const;
+    };
+
+    CHistogram(const char* pszNameIn, const char* pszHelpIn);
+
+    CHistogram(const CHistogram&) = delete;
+    CHistogram& operator=(const CHistogram&) = delete;
+
+    void Record(uint64_t nValue)
+    {
+        Shard& shard = vShards[GetThreadShard()];
+        shard.vBuckets[BucketIndex(nValue)].fetch_add(1, std::memory_order_relaxed);
+        shard.nCount.fetch_add(1, std::memory_order_relaxed);
+        shard.nSum.fetch_add(nValue, std::memory_order_relaxed);
+    }
+
+    void GetSnapshot(Snapshot& snapshot) const;
+
+    const char* GetName() const { return pszName; }
+    const char* GetHelp() const { return pszHelp; }
+
+    /** Bucket holding nValue */
+    static unsigned int BucketIndex(uint64_t nValue)
+    {
+        if (nValue < SUB_BUCKETS)
+            return (unsigned int)nValue;
+        unsigned int nShift = 63 - __builtin_clzll(nValue) - SUB_BUCKET_BITS;
+        return ((nShift + 1) << SUB_BUCKET_BITS) | ((nValue >> nShift) & (SUB_BUCKETS - 1));
+    }
+
+    /** Smallest and largest values that fall in bucket nIndex */
+    static uint64_t BucketLowerBound(unsigned int nIndex);
+    static uint64_t BucketUpperBound(unsigned int nIndex);
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> nCount;
+        std::atomic<uint64_t> nSum;
+        std::atomic<uint64_t> vBuckets[NUM_BUCKETS];
+        Shard();
+    };
+
+    const char* pszName;
+    const char* pszHelp;
+    std::unique_ptr<Shard[]> vShards;
+};
+
+/**
+ * @class CScopedTimer
+ * @brief Records the lifetime of the scope into a histogram
+ */
+class CScopedTimer {
+public:
+    explicit CScopedTimer(CHistogram& histIn) : hist(histIn), start(std::chrono::steady_clock::now()) {}
+    ~CScopedTimer()
+    {
+        hist.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    CScopedTimer(const CScopedTimer&) = delete;
+    CScopedTimer& operator=(const CScopedTimer&) = delete;
+
+private:
+    CHistogram& hist;
+    const std::chrono::steady_clock::time_point start;
+};
+
+/** All counters and histograms constructed so far, in construction order */
+std::vector<const CCounter*> GetCounters();
+std::vector<const CHistogram*> GetHistograms();
+
+/** True if this binary was built with ENABLE_METRICS */
+bool IsEnabled();
+
+/**
+ * @brief All metrics in the Prometheus text exposition format
+ *
+ * Counters are exported as counters; histograms as summaries in seconds
+ * with the 0.5, 0.9, 0.99 and 1 quantiles.
+ */
+std::string FormatPrometheus();
+
+/** @brief Write FormatPrometheus() to a file, atomically replacing it */
+bool WritePrometheusFile(const std::string& strPath);
+
+/**
+ * @brief Dump metrics to -metricsfile every -metricsinterval seconds
+ *
+ * Does nothing unless -metricsfile is set. The file suits the
+ * node_exporter textfile collector. AppInitMain must call this once
+ * the scheduler runs (see init.cpp).
+ */
+void ScheduleMetricsDump(CScheduler& scheduler);
+
+} // namespace Metrics
+} // namespace Africoin
+
+#define METRIC_CAT2(a, b) a##b
+#define METRIC_CAT(a, b) METRIC_CAT2(a, b)
+
+#ifdef ENABLE_METRICS
+#define METRIC_COUNTER(var, name, help) static Africoin::Metrics::CCounter var(name, help)
+#define METRIC_HISTOGRAM(var, name, help) static Africoin::Metrics::CHistogram var(name, help)
+#define METRIC_INC(var) var.Add(1)
+#define METRIC_ADD(var, n) var.Add(n)
+#define METRIC_SCOPED_TIMER(var) Africoin::Metrics::CScopedTimer METRIC_CAT(metric_timer_, __LINE__)(var)
+#else
+#define METRIC_COUNTER(var, name, help) static_assert(true, "")
+#define METRIC_HISTOGRAM(var, name, help) static_assert(true, "")
+#define METRIC_INC(var) ((void)0)
+#define METRIC_ADD(var, n) ((void)0)
+#define METRIC_SCOPED_TIMER(var) ((void)0)
+#endif
+
+#endif // AFRICOIN_METRICS_METRICS_H
@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file startup.cpp
+ * @brief Time from process start to the first RPC the node can answer
+ */
+
+#include "metrics/startup.h"
+
+#include "metrics/metrics.h"
+#include "tinyformat.h"
+#include "util.h"
+#include "utiltime.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Africoin {
+namespace Startup {
+
+METRIC_HISTOGRAM(histRPCReady, "africoin_startup_rpc_ready_seconds", "Time from startup to RPC ready");
+
+static std::mutex csStartup;
+static int64_t nStartMicros = GetTimeMicros();
+static int64_t nLastPhaseMicros = nStartMicros;
+static int64_t nReadyMicros = -1;
+static std::vector<std::pair<const char*, int64_t>> vPhases;
+
+void Begin()
+{
+    std::lock_guard<std::mutex> lock(csStartup);
+    nStartMicros = nLastPhaseMicros = GetTimeMicros();
+    nReadyMicros = -1;
+    vPhases.clear();
+}
+
+void MarkPhase(const char* pszPhase)
+{
+    std::lock_guard<std::mutex> lock(csStartup);
+    int64_t nNow = GetTimeMicros();
+    vPhases.emplace_back(pszPhase, nNow - nLastPhaseMicros);
+    nLastPhaseMicros = nNow;
+    LogPrint("bench", "Startup: %s in %.3fs\n", pszPhase, vPhases.back().second * 1e-6);
+}
+
+void SetRPCReady()
+{
+    std::lock_guard<std::mutex> lock(csStartup);
+    if (nReadyMicros >= 0)
+        return;
+    nReadyMicros = GetTimeMicros() - nStartMicros;
+
+    std::string strPhases;
+    for (const auto& phase : vPhases)
+        strPhases += strprintf("%s%s %.3fs", strPhases.empty() ? "" : ", ", phase.first, phase.second * 1e-6);
+    LogPrintf("Startup: RPC ready after %.3fs%s\n", nReadyMicros * 1e-6,
+              strPhases.empty() ? "" : " (" + strPhases + ")");
+#ifdef ENABLE_METRICS
+    histRPCReady.Record(nReadyMicros * 1000);
+#endif
+}
+
+int64_t GetRPCReadyMicros()
+{
+    std::lock_guard<std::mutex> lock(csStartup);
+    return nReadyMicros;
+}
+
+} // namespace Startup
+} // namespace Africoin
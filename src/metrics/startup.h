@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_METRICS_STARTUP_H
+#define AFRICOIN_METRICS_STARTUP_H
+
+#include <stdint.h>
+
+/**
+ * @file startup.h
+ * @brief Time from process start to the first RPC the node can answer
+ *
+ * Init marks each startup phase as it finishes and calls SetRPCReady
+ * once RPC leaves warmup:
+ *
+ *   Startup::Begin();
+ *   ...
+ *   LoadNodeBlockIndex();
+ *   Startup::MarkPhase("block index");
+ *   ...
+ *   Startup::SetRPCReady();
+ *
+ * The total and the per-phase breakdown are logged once, and the total
+ * is recorded in the africoin_startup_rpc_ready_seconds histogram.
+ */
+
+namespace Africoin {
+namespace Startup {
+
+/** Restart the clock; it otherwise runs from static initialization */
+void Begin();
+
+/** Note that a phase ended now, logged under -debug=bench. pszPhase must be a literal. */
+void MarkPhase(const char* pszPhase);
+
+/** RPC is ready: log and record the time since Begin. Only the first call counts. */
+void SetRPCReady();
+
+/** Microseconds from Begin to SetRPCReady, or -1 before it */
+int64_t GetRPCReadyMicros();
+
+} // namespace Startup
+} // namespace Africoin
+
+#endif // AFRICOIN_METRICS_STARTUP_H
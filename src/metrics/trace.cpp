@@ -0,0 +1,244 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file trace.cpp
+ * @brief Always-on span tracer with Chrome trace output
+ */
+
+#include "metrics/trace.h"
+
+#include "scheduler.h"
+#include "tinyformat.h"
+#include "util.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace Africoin {
+namespace Trace {
+
+std::atomic<bool> g_fTraceEnabled(DEFAULT_TRACE);
+
+static std::atomic<bool> fDumpRequested(false);
+
+/**
+ * One finished span; fields are atomic so a concurrent dump reads them
+ * safely. nSeq is the span's index + 1 once written and 0 while the owner
+ * is rewriting the slot, so a dump can tell a torn copy from a good one.
+ */
+struct TraceEvent {
+    std::atomic<uint64_t> nSeq{0};
+    std::atomic<const char*> pszName;
+    std::atomic<const char*> pszCategory;
+    std::atomic<uint64_t> nStart;
+    std::atomic<uint64_t> nDuration;
+};
+
+/**
+ * Ring buffer owned by one thread at a time. Buffers outlive their
+ * threads, so a dump still shows what they did, and are handed to the
+ * next new thread once released; that thread's spans then gradually
+ * overwrite them, under the new thread's name.
+ */
+struct TraceBuffer {
+    int nTid;
+    std::string strThreadName;
+    std::atomic<bool> fInUse;
+    std::atomic<uint64_t> nHead;    //!< Spans ever written; slot is nHead % size. Owner writes only
+    std::atomic<uint64_t> nDumpFrom; //!< Spans before this were dropped by ClearTrace
+    std::unique_ptr<TraceEvent[]> vEvents;
+
+    explicit TraceBuffer(int nTidIn)
+        : nTid(nTidIn), fInUse(true), nHead(0), nDumpFrom(0), vEvents(new TraceEvent[TRACE_BUFFER_EVENTS]) {}
+};
+
+static std::mutex csBuffers;
+static std::vector<std::unique_ptr<TraceBuffer>> vBuffers;
+
+static TraceBuffer* AcquireBuffer()
+{
+    std::string strName;
+#ifdef __linux__
+    char buf[32] = {};
+    if (pthread_getname_np(pthread_self(), buf, sizeof(buf)) == 0)
+        strName = buf;
+#endif
+
+    std::lock_guard<std::mutex> lock(csBuffers);
+    for (const std::unique_ptr<TraceBuffer>& buffer : vBuffers) {
+        if (!buffer->fInUse.load(std::memory_order_relaxed)) {
+            buffer->fInUse.store(true, std::memory_order_relaxed);
+            buffer->strThreadName = strName;
+            return buffer.get();
+        }
+    }
+    vBuffers.emplace_back(new TraceBuffer(vBuffers.size() + 1));
+    vBuffers.back()->strThreadName = strName;
+    return vBuffers.back().get();
+}
+
+/** Releases the thread's buffer when the thread exits */
+class ThreadBuffer {
+public:
+    TraceBuffer* pbuffer = nullptr;
+    ~ThreadBuffer()
+    {
+        if (pbuffer)
+            pbuffer->fInUse.store(false, std::memory_order_relaxed);
+    }
+};
+
+static thread_local ThreadBuffer threadBuffer;
+
+uint64_t TraceNow()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // Never 0, which CTraceSpan uses for "not recording"
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() + 1;
+}
+
+void RecordSpan(const char* pszName, const char* pszCategory, uint64_t nStart, uint64_t nEnd)
+{
+    TraceBuffer* pbuffer = threadBuffer.pbuffer;
+    if (!pbuffer)
+        pbuffer = threadBuffer.pbuffer = AcquireBuffer();
+
+    // Only this thread writes the buffer, so a relaxed load of nHead is enough
+    uint64_t nHead = pbuffer->nHead.load(std::memory_order_relaxed);
+    TraceEvent& event = pbuffer->vEvents[nHead % TRACE_BUFFER_EVENTS];
+    event.nSeq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.pszName.store(pszName, std::memory_order_relaxed);
+    event.pszCategory.store(pszCategory, std::memory_order_relaxed);
+    event.nStart.store(nStart, std::memory_order_relaxed);
+    event.nDuration.store(nEnd - nStart, std::memory_order_relaxed);
+    event.nSeq.store(nHead + 1, std::memory_order_release);
+    pbuffer->nHead.store(nHead + 1, std::memory_order_release);
+}
+
+/** Escape a span or thread name for a JSON string */
+static std::string JSONEscape(const char* psz)
+{
+    std::string str;
+    for (; *psz; psz++) {
+        if (*psz == '"' || *psz == '\\')
+            str += '\\';
+        if ((unsigned char)*psz >= 0x20)
+            str += *psz;
+    }
+    return str;
+}
+
+std::string FormatChromeTrace()
+{
+    const int nPid = getpid();
+    std::string strOut = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool fFirst = true;
+    auto Append = [&](const std::string& strEvent) {
+        strOut += fFirst ? "" : ",\n";
+        strOut += strEvent;
+        fFirst = false;
+    };
+
+    std::lock_guard<std::mutex> lock(csBuffers);
+    for (const std::unique_ptr<TraceBuffer>& buffer : vBuffers) {
+        if (!buffer->strThreadName.empty())
+            Append(strprintf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                             nPid, buffer->nTid, JSONEscape(buffer->strThreadName.c_str())));
+
+        // Copy each slot, then keep it only if its sequence number shows
+        // the owner did not start rewriting it during the copy
+        uint64_t nHead = buffer->nHead.load(std::memory_order_acquire);
+        uint64_t nFirst = std::max(nHead > TRACE_BUFFER_EVENTS ? nHead - TRACE_BUFFER_EVENTS : (uint64_t)0,
+                                   buffer->nDumpFrom.load(std::memory_order_relaxed));
+        for (uint64_t i = nFirst; i < nHead; i++) {
+            const TraceEvent& event = buffer->vEvents[i % TRACE_BUFFER_EVENTS];
+            if (event.nSeq.load(std::memory_order_acquire) != i + 1)
+                continue;
+            const char* pszName = event.pszName.load(std::memory_order_relaxed);
+            const char* pszCategory = event.pszCategory.load(std::memory_order_relaxed);
+            uint64_t nStart = event.nStart.load(std::memory_order_relaxed);
+            uint64_t nDuration = event.nDuration.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (event.nSeq.load(std::memory_order_relaxed) != i + 1)
+                continue;
+            Append(strprintf("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                             JSONEscape(pszName), JSONEscape(pszCategory), nPid, buffer->nTid,
+                             nStart * 1e-3, nDuration * 1e-3));
+        }
+    }
+    strOut += "\n]}\n";
+    return strOut;
+}
+
+bool WriteChromeTrace(const std::string& strPath)
+{
+    // Write then rename, so a reader never sees a partial file
+    std::string strTmp = strPath + ".new";
+    FILE* file = fopen(strTmp.c_str(), "w");
+    if (!file)
+        return error("%s: cannot open %s", __func__, strTmp);
+
+    std::string strOut = FormatChromeTrace();
+    bool fWritten = fwrite(strOut.data(), 1, strOut.size(), file) == strOut.size();
+    fWritten = fclose(file) == 0 && fWritten;
+    if (!fWritten || rename(strTmp.c_str(), strPath.c_str()) != 0) {
+        remove(strTmp.c_str());
+        return error("%s: cannot write %s", __func__, strPath);
+    }
+    return true;
+}
+
+void ClearTrace()
+{
+    // Owners keep writing; dumps just start from the current heads
+    std::lock_guard<std::mutex> lock(csBuffers);
+    for (const std::unique_ptr<TraceBuffer>& buffer : vBuffers)
+        buffer->nDumpFrom.store(buffer->nHead.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+#ifndef WIN32
+static void HandleSIGUSR1(int)
+{
+    fDumpRequested.store(true, std::memory_order_relaxed);
+}
+#endif
+
+void InitTracing()
+{
+    g_fTraceEnabled.store(GetBoolArg("-trace", DEFAULT_TRACE), std::memory_order_relaxed);
+
+#ifndef WIN32
+    struct sigaction sa;
+    sa.sa_handler = HandleSIGUSR1;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &sa, nullptr);
+#endif
+}
+
+void ScheduleTraceDump(CScheduler& scheduler)
+{
+    std::string strPath = GetArg("-tracefile", (GetDataDir() / "trace.json").string());
+    scheduler.scheduleEvery([strPath] {
+        if (fDumpRequested.exchange(false, std::memory_order_relaxed)) {
+            if (WriteChromeTrace(strPath))
+                LogPrintf("Wrote trace to %s\n", strPath);
+        }
+    }, 1);
+}
+
+} // namespace Trace
+} // namespace Africoin
@@ -0,0 +1,118 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_METRICS_TRACE_H
+#define AFRICOIN_METRICS_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+class CScheduler;
+
+/**
+ * @file trace.h
+ * @brief Always-on span tracer with Chrome trace output
+ *
+ * Spans mark where time goes during block connection and staking:
+ *
+ *   bool ConnectBlock(...)
+ *   {
+ *       TRACE_SPAN("ConnectBlock", "validation");
+ *       ...
+ *   }
+ *
+ * Each thread appends finished spans to its own fixed-size ring buffer,
+ * so recording never locks or allocates: two clock reads, four relaxed
+ * stores and a release store of the head index. Old spans are
+ * overwritten, so the buffers always hold the most recent activity and
+ * the tracer can stay on in production like a flight recorder.
+ *
+ * On demand (dumptrace RPC, or SIGUSR1 with ScheduleTraceDump running)
+ * every buffer is copied out and written in the Chrome trace event
+ * format, which chrome://tracing and ui.perfetto.dev open directly.
+ * Readers detect spans overwritten while copying and drop them.
+ *
+ * Spans are compiled in with ENABLE_METRICS, like the metrics macros,
+ * and recorded while -trace is set (the default).
+ */
+
+namespace Africoin {
+namespace Trace {
+
+/** Spans kept per thread (40 bytes each) */
+static const size_t TRACE_BUFFER_EVENTS = 1 << 14;
+static const bool DEFAULT_TRACE = true;
+
+/** Whether spans are currently recorded */
+extern std::atomic<bool> g_fTraceEnabled;
+
+/** Nanoseconds on the trace clock (steady, since process start) */
+uint64_t TraceNow();
+
+/** Append a finished span to the calling thread's buffer */
+void RecordSpan(const char* pszName, const char* pszCategory, uint64_t nStart, uint64_t nEnd);
+
+/**
+ * @class CTraceSpan
+ * @brief Records its own lifetime as a span
+ *
+ * Names and categories must be string literals (or otherwise outlive
+ * the process); only the pointers are stored.
+ */
+class CTraceSpan {
+public:
+    CTraceSpan(const char* pszNameIn, const char* pszCategoryIn)
+        : pszName(pszNameIn), pszCategory(pszCategoryIn),
+          nStart(g_fTraceEnabled.load(std::memory_order_relaxed) ? TraceNow() : 0) {}
+    ~CTraceSpan()
+    {
+        if (nStart)
+            RecordSpan(pszName, pszCategory, nStart, TraceNow());
+    }
+
+    CTraceSpan(const CTraceSpan&) = delete;
+    CTraceSpan& operator=(const CTraceSpan&) = delete;
+
+private:
+    const char* const pszName;
+    const char* const pszCategory;
+    const uint64_t nStart;
+};
+
+/** All buffered spans as a Chrome trace JSON document */
+std::string FormatChromeTrace();
+
+/** Write FormatChromeTrace() to a file, atomically replacing it */
+bool WriteChromeTrace(const std::string& strPath);
+
+/** Drop every buffered span */
+void ClearTrace();
+
+/**
+ * @brief Apply -trace and install the SIGUSR1 handler
+ *
+ * The handler only sets a flag; the dump happens on the scheduler
+ * thread started by ScheduleTraceDump.
+ */
+void InitTracing();
+
+/** Poll for SIGUSR1 once a second and dump to -tracefile (default: <datadir>/trace.json) */
+void ScheduleTraceDump(CScheduler& scheduler);
+
+} // namespace Trace
+} // namespace Africoin
+
+#define TRACE_CAT2(a, b) a##b
+#define TRACE_CAT(a, b) TRACE_CAT2(a, b)
+
+#ifdef ENABLE_METRICS
+#define TRACE_SPAN(name, category) \
+    Africoin::Trace::CTraceSpan TRACE_CAT(trace_span_, __LINE__)(name, category)
+#else
+#define TRACE_SPAN(name, category) ((void)0)
+#endif
+
+#endif // AFRICOIN_METRICS_TRACE_H
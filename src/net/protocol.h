@@ -1 +1,88 @@
-// protocol.h: Network protocol declarations and message structures.
\ No newline at end of file
+// protocol.h: Network protocol declarations and message structures.
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_NET_PROTOCOL_H
+#define AFRICOIN_NET_PROTOCOL_H
+
+#include "consensus/merkle.h"
+#include "primitives/block.h"
+#include "primitives/transaction.h"
+#include "serialize.h"
+#include "uint256.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Africoin {
+
+namespace NetMsgType {
+
+/**
+ * The stakeheaders message: a vector of CStakeHeader, sent in place of
+ * headers for PoS blocks to peers at STAKEHEADERS_VERSION or above.
+ */
+static const char* const STAKEHEADERS = "stakeheaders";
+
+/**
+ * The checkpoint message: a CSyncCheckpoint, relayed once accepted and
+ * sent to each peer at SYNC_CHECKPOINT_PROTO_VERSION or above on connect.
+ */
+static const char* const CHECKPOINT = "checkpoint";
+
+} // namespace NetMsgType
+
+/** First protocol version that understands stakeheaders */
+static const int STAKEHEADERS_VERSION = 70016;
+
+/** First protocol version that relays signed sync checkpoints */
+static const int SYNC_CHECKPOINT_PROTO_VERSION = 70017;
+
+/** Stake headers per message, as MAX_HEADERS_RESULTS */
+static const unsigned int MAX_STAKE_HEADERS_RESULTS = 2000;
+
+/** Merkle branch depth allowed in a stake header (2^20 transactions) */
+static const unsigned int MAX_STAKE_HEADER_BRANCH = 20;
+
+/**
+ * @class CStakeHeader
+ * @brief A PoS block header with what is needed to check its kernel
+ *
+ * Besides the header: the coinstake, its merkle branch (it is always
+ * vtx[1]) so it is bound to hashMerkleRoot, and the hash of the block
+ * holding the staked output so the receiver can find blockFrom without a
+ * transaction index. A few hundred bytes in all, against a full block
+ * that would otherwise be downloaded before the stake could be checked.
+ */
+class CStakeHeader {
+public:
+    CBlockHeader header;
+    CTransactionRef txCoinStake;
+    std::vector<uint256> vMerkleBranch;
+    uint256 hashBlockFrom;
+
+    CStakeHeader() {}
+
+    /** @brief Stake header of a PoS block whose staked output is in hashBlockFromIn */
+    CStakeHeader(const CBlock& block, const uint256& hashBlockFromIn)
+        : header(block.GetBlockHeader()), txCoinStake(block.vtx[1]),
+          vMerkleBranch(BlockMerkleBranch(block, 1)), hashBlockFrom(hashBlockFromIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action)
+    {
+        READWRITE(header);
+        READWRITE(txCoinStake);
+        READWRITE(vMerkleBranch);
+        READWRITE(hashBlockFrom);
+    }
+
+    uint256 GetHash() const { return header.GetHash(); }
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_NET_PROTOCOL_H
@@ -1,10 +1,11 @@
 #include "peercoin_security.h"
 #include "arith_uint256.h"
-#include "hash.h"
+#include "crypto/sha256_dispatch.h"
 #include "primitives/transaction.h"
 #include "validation.h"
 #include "util/time.h"
 
+#include <string.h>
 #include <algorithm>
 
 namespace PeerCoinSecurity {
@@ -49,13 +50,16 @@ uint256 ComputeStakeModifier(const CBlockIndex* pindexPrev, const uint256& kerne
     // PeerCoin uses a deterministic selection of past blocks
     // This creates a pseudo-random modifier that cannot be manipulated
     
-    CHashWriter ss(SER_GETHASH, 0);
-    ss << pindexPrev->GetBlockHash() << kernel;
+    // Same bytes as CHashWriter << GetBlockHash() << kernel, on the dispatched SHA-256
+    unsigned char vch[64];
+    const uint256 hashBlock = pindexPrev->GetBlockHash();
+    memcpy(vch, hashBlock.begin(), 32);
+    memcpy(vch + 32, kernel.begin(), 32);
     
     // TODO: Implement full stake modifier v0.3 algorithm
     // This should select blocks deterministically from history
     
-    return ss.GetHash();
+    return Africoin::SHA256d(vch, sizeof(vch));
 }
 
 /**
@@ -3,6 +3,14 @@
 
 #include "railway/railways_staking_manager.h"
 
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+
+METRIC_HISTOGRAM(histProcessRailwayStake, "africoin_railway_process_stake_seconds",
+                 "Time spent processing railway node stakes (ProcessRailwayStake)");
+METRIC_COUNTER(counterRailwayStakesRejected, "africoin_railway_stakes_rejected_total",
+               "Railway node stakes rejected by ValidateRailwayStake");
+
 AfricaRailwaysStakingManager::AfricaRailwaysStakingManager() {
     InitializeRailwayNodes();
 }
@@ -57,8 +65,12 @@ bool AfricaRailwaysStakingManager::ValidateRailwayStake(const RailwayStakingNode
 }
 
 bool AfricaRailwaysStakingManager::ProcessRailwayStake(const RailwayStakingNode& node, const CBlockHeader& block) {
+    METRIC_SCOPED_TIMER(histProcessRailwayStake);
+    TRACE_SPAN("ProcessRailwayStake", "railway");
+
     // Apply enhanced security for railway nodes
     if (!ValidateRailwayStake(node, block)) {
+        METRIC_INC(counterRailwayStakesRejected);
         return false;
     }
 
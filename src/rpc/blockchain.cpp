@@ -0,0 +1,127 @@
+// Copyright (c) 2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file blockchain.cpp
+ * @brief Africoin-specific blockchain RPCs (supply reporting, sync checkpoints)
+ */
+
+#include "amount.h"
+#include "consensus/fee_burner.h"
+#include "rpc/register.h"
+#include "rpc/server.h"
+#include "security/checkpoints.h"
+#include "security/checkpointsync.h"
+#include "sync.h"
+#include "util.h"
+#include "validation.h"
+
+namespace Africoin {
+
+UniValue getburninfo(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() > 2)
+        throw std::runtime_error(
+            "getburninfo ( startheight endheight )\n"
+            "\nReturns burned fees and circulating supply for a height range.\n"
+            "All figures come from per-height prefix sums and cost O(1).\n"
+            "\nArguments:\n"
+            "1. startheight    (numeric, optional, default=0) first height of the range\n"
+            "2. endheight      (numeric, optional, default=tip) last height of the range\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"height\" : n,              (numeric) current tip height\n"
+            "  \"burned\" : x.xxx,          (numeric) fees burned in the range\n"
+            "  \"minted\" : x.xxx,          (numeric) subsidy minted in the range\n"
+            "  \"epoch\" : n,               (numeric) current reporting epoch\n"
+            "  \"epochburned\" : x.xxx,     (numeric) fees burned so far in the current epoch\n"
+            "  \"totalburned\" : x.xxx,     (numeric) fees burned since genesis\n"
+            "  \"circulating\" : x.xxx      (numeric) minted minus burned supply at the tip\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getburninfo", "")
+            + HelpExampleCli("getburninfo", "1000 2000")
+            + HelpExampleRpc("getburninfo", "1000, 2000")
+        );
+
+    LOCK(cs_main);
+
+    int nTip = g_feeBurnLedger.GetHeight();
+    int nStart = request.params.size() > 0 ? request.params[0].get_int() : 0;
+    int nEnd = request.params.size() > 1 ? request.params[1].get_int() : nTip;
+    if (nStart < 0 || nEnd < nStart)
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid height range");
+
+    int nEpoch = nTip < 0 ? 0 : nTip / FEE_BURN_EPOCH_BLOCKS;
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("height", nTip));
+    result.push_back(Pair("burned", ValueFromAmount(g_feeBurnLedger.GetBurned(nStart, nEnd))));
+    result.push_back(Pair("minted", ValueFromAmount(g_feeBurnLedger.GetMinted(nStart, nEnd))));
+    result.push_back(Pair("epoch", nEpoch));
+    result.push_back(Pair("epochburned", ValueFromAmount(g_feeBurnLedger.GetBurnedInEpoch(nEpoch))));
+    result.push_back(Pair("totalburned", ValueFromAmount(g_feeBurnLedger.GetBurned(0, nTip))));
+    result.push_back(Pair("circulating", ValueFromAmount(g_feeBurnLedger.GetCirculatingSupply(nTip))));
+    return result;
+}
+
+UniValue getcheckpoint(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            "getcheckpoint\n"
+            "\nReturns the current signed sync checkpoint.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"enabled\" : true|false,     (boolean) a checkpoint master key is configured\n"
+            "  \"height\" : n,               (numeric) height of the sync checkpoint, -1 if none\n"
+            "  \"hash\" : \"hash\",           (string) block hash of the sync checkpoint\n"
+            "  \"pending\" : \"hash\",        (string, optional) block a signed checkpoint waits for\n"
+            "  \"lastcheckpoint\" : n,       (numeric) highest height fixed by any checkpoint\n"
+            "  \"verified\" : n,             (numeric) checkpoint messages whose signatures were checked\n"
+            "  \"cachehits\" : n,            (numeric) checkpoint messages answered from the cache\n"
+            "  \"accepted\" : n,             (numeric) checkpoints accepted\n"
+            "  \"rejected\" : n              (numeric) checkpoints refused\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getcheckpoint", "")
+            + HelpExampleRpc("getcheckpoint", "")
+        );
+
+    LOCK(cs_main);
+
+    const PeerCoin::CSyncCheckpoint checkpoint = PeerCoin::g_syncCheckpoints.GetCheckpoint();
+    const uint256 hashPending = PeerCoin::g_syncCheckpoints.GetPendingHash();
+    const PeerCoin::CSyncCheckpointStats stats = PeerCoin::g_syncCheckpoints.GetStats();
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("enabled", PeerCoin::Checkpoints::AutoCheckpointsEnabled()));
+    result.push_back(Pair("height", checkpoint.nHeight));
+    result.push_back(Pair("hash", checkpoint.hashCheckpoint.GetHex()));
+    if (!hashPending.IsNull())
+        result.push_back(Pair("pending", hashPending.GetHex()));
+    result.push_back(Pair("lastcheckpoint", PeerCoin::Checkpoints::GetLastCheckpointHeight()));
+    result.push_back(Pair("verified", stats.nVerified));
+    result.push_back(Pair("cachehits", stats.nCacheHits));
+    result.push_back(Pair("accepted", stats.nAccepted));
+    result.push_back(Pair("rejected", stats.nRejected));
+    return result;
+}
+
+static const CRPCCommand commands[] =
+{ //  category              name                      actor (function)         okSafeMode
+  //  --------------------- ------------------------  -----------------------  ----------
+    { "blockchain",         "getburninfo",            &getburninfo,            true,  {"startheight","endheight"} },
+    { "blockchain",         "getcheckpoint",          &getcheckpoint,          true,  {} },
+};
+
+void RegisterBlockchainRPCCommands(CRPCTable& t)
+{
+    for (unsigned int vcidx = 0; vcidx < sizeof(commands) / sizeof(commands[0]); vcidx++)
+        t.appendCommand(commands[vcidx].name, &commands[vcidx]);
+}
+
+} // namespace Africoin
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file metrics.cpp
+ * @brief RPCs exporting the consensus hot-path metrics and span traces
+ */
+
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+#include "rpc/register.h"
+#include "rpc/server.h"
+#include "util.h"
+
+namespace Africoin {
+
+UniValue getmetrics(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() > 0)
+        throw std::runtime_error(
+            "getmetrics\n"
+            "\nReturns the counters and latency histograms of the kernel, stake\n"
+            "modifier, hybrid validation and railway staking code.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"enabled\" : true|false,      (boolean) whether metrics were compiled in\n"
+            "  \"counters\" : {               (json object)\n"
+            "    \"name\" : n,                (numeric) counter value\n"
+            "    ...\n"
+            "  },\n"
+            "  \"histograms\" : {             (json object) latencies in seconds\n"
+            "    \"name\" : {\n"
+            "      \"count\" : n,             (numeric) number of samples\n"
+            "      \"sum\" : x.xxx,           (numeric) total of all samples\n"
+            "      \"p50\" : x.xxx,           (numeric) median\n"
+            "      \"p90\" : x.xxx,           (numeric) 90th percentile\n"
+            "      \"p99\" : x.xxx,           (numeric) 99th percentile\n"
+            "      \"max\" : x.xxx            (numeric) largest sample\n"
+            "    },\n"
+            "    ...\n"
+            "  }\n"
+            "}\n"
+            "\nPercentiles are bucket upper bounds, within 6.25% of the true value.\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getmetrics", "")
+            + HelpExampleRpc("getmetrics", "")
+        );
+
+    UniValue counters(UniValue::VOBJ);
+    for (const Metrics::CCounter* counter : Metrics::GetCounters())
+        counters.push_back(Pair(counter->GetName(), (uint64_t)counter->Get()));
+
+    UniValue histograms(UniValue::VOBJ);
+    Metrics::CHistogram::Snapshot snapshot;
+    for (const Metrics::CHistogram* hist : Metrics::GetHistograms()) {
+        hist->GetSnapshot(snapshot);
+        UniValue entry(UniValue::VOBJ);
+        entry.push_back(Pair("count", (uint64_t)snapshot.nCount));
+        entry.push_back(Pair("sum", snapshot.nSum * 1e-9));
+        entry.push_back(Pair("p50", snapshot.Quantile(0.5) * 1e-9));
+        entry.push_back(Pair("p90", snapshot.Quantile(0.9) * 1e-9));
+        entry.push_back(Pair("p99", snapshot.Quantile(0.99) * 1e-9));
+        entry.push_back(Pair("max", snapshot.Quantile(1.0) * 1e-9));
+        histograms.push_back(Pair(hist->GetName(), entry));
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("enabled", Metrics::IsEnabled()));
+    result.push_back(Pair("counters", counters));
+    result.push_back(Pair("histograms", histograms));
+    return result;
+}
+
+UniValue dumpmetrics(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 1)
+        throw std::runtime_error(
+            "dumpmetrics \"filename\"\n"
+            "\nWrites all metrics to a file in the Prometheus text format.\n"
+            "Use -metricsfile to have the node write it periodically instead.\n"
+            "\nArguments:\n"
+            "1. \"filename\"    (string, required) file to write, replaced atomically\n"
+            "\nExamples:\n"
+            + HelpExampleCli("dumpmetrics", "\"/var/lib/node_exporter/africoin.prom\"")
+            + HelpExampleRpc("dumpmetrics", "\"/var/lib/node_exporter/africoin.prom\"")
+        );
+
+    if (!Metrics::WritePrometheusFile(request.params[0].get_str()))
+        throw JSONRPCError(RPC_MISC_ERROR, "Cannot write " + request.params[0].get_str());
+
+    return NullUniValue;
+}
+
+UniValue dumptrace(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() < 1 || request.params.size() > 2)
+        throw std::runtime_error(
+            "dumptrace \"filename\" ( clear )\n"
+            "\nWrites the spans buffered by the tracer (block connection, script checks,\n"
+            "kernel, modifier, hybrid validation and block I/O) as a Chrome trace.\n"
+            "Open the file in chrome://tracing or ui.perfetto.dev. Sending SIGUSR1\n"
+            "to the node writes the same file to -tracefile.\n"
+            "\nArguments:\n"
+            "1. \"filename\"    (string, required) file to write, replaced atomically\n"
+            "2. clear         (boolean, optional, default=false) drop the buffered spans after writing\n"
+            "\nExamples:\n"
+            + HelpExampleCli("dumptrace", "\"/tmp/africoin-trace.json\"")
+            + HelpExampleRpc("dumptrace", "\"/tmp/africoin-trace.json\", true")
+        );
+
+    if (!Trace::WriteChromeTrace(request.params[0].get_str()))
+        throw JSONRPCError(RPC_MISC_ERROR, "Cannot write " + request.params[0].get_str());
+    if (request.params.size() > 1 && request.params[1].get_bool())
+        Trace::ClearTrace();
+
+    return NullUniValue;
+}
+
+static const CRPCCommand commands[] =
+{ //  category              name                      actor (function)         okSafeMode
+  //  --------------------- ------------------------  -----------------------  ----------
+    { "control",            "getmetrics",             &getmetrics,             true,  {} },
+    { "control",            "dumpmetrics",            &dumpmetrics,            true,  {"filename"} },
+    { "control",            "dumptrace",              &dumptrace,              true,  {"filename","clear"} },
+};
+
+void RegisterMetricsRPCCommands(CRPCTable& t)
+{
+    for (unsigned int vcidx = 0; vcidx < sizeof(commands) / sizeof(commands[0]); vcidx++)
+        t.appendCommand(commands[vcidx].name, &commands[vcidx]);
+}
+
+} // namespace Africoin
@@ -1 +1,498 @@
-// mining.cpp: RPC routines for mining control and status.
\ No newline at end of file
+// Copyright (c) 2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file mining.cpp
+ * @brief Incremental block template assembler and mining RPCs
+ *
+ * The template is maintained from mempool notifications instead of being
+ * rebuilt on every getblocktemplate call. See mining.h for the selection
+ * rules.
+ */
+
+#include "rpc/mining.h"
+
+#include "arith_uint256.h"
+#include "chain.h"
+#include "core_io.h"
+#include "rpc/register.h"
+#include "rpc/server.h"
+#include "txmempool.h"
+#include "util.h"
+#include "utilstrencodings.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <boost/signals2/connection.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace Africoin {
+
+std::unique_ptr<BlockTemplateAssembler> g_blockTemplateAssembler;
+
+static int64_t GetFeeRatePerK(CAmount nFee, unsigned int nSize)
+{
+    if (nSize == 0)
+        return 0;
+    return nFee * 1000 / (int64_t)nSize;
+}
+
+BlockTemplateAssembler::BlockTemplateAssembler(uint64_t nMaxSizeIn, CAmount nFeeDeltaIn)
+    : nMaxSize(nMaxSizeIn), nFeeDelta(nFeeDeltaIn),
+      nSizeSelected(0), nFeesSelected(0), nFeesNotified(0),
+      nSelectSeq(0), nSequence(0), nHeight(0),
+      blockType(BLOCK_TYPE_POW), nBits(0)
+{
+}
+
+void BlockTemplateAssembler::UpdateTip(const CBlockIndex* pindexPrev)
+{
+    std::lock_guard<std::mutex> lock(cs);
+
+    uint256 hashNew = pindexPrev ? pindexPrev->GetBlockHash() : uint256();
+    if (hashNew == hashPrevBlock && nSequence != 0)
+        return;
+
+    // Per-tip work happens once here, never in GetTemplate()
+    hashPrevBlock = hashNew;
+    nHeight = pindexPrev ? pindexPrev->nHeight + 1 : 0;
+    blockType = HybridStaking::SelectNextBlockType(pindexPrev);
+    nBits = HybridStaking::GetHybridDifficulty(pindexPrev, blockType);
+
+    nFeesNotified = nFeesSelected;
+    ++nSequence;
+    cvUpdate.notify_all();
+}
+
+bool BlockTemplateAssembler::ParentsSelected(const Entry& entry) const
+{
+    for (const uint256& hashParent : entry.info.vParents) {
+        EntryMap::const_iterator it = mapTx.find(hashParent);
+        // Parents that are no longer in the pool were confirmed
+        if (it != mapTx.end() && !it->second.fSelected)
+            return false;
+    }
+    return true;
+}
+
+void BlockTemplateAssembler::Select(Entry& entry)
+{
+    setPending.erase(KeyOf(entry));
+    setSelected.insert(KeyOf(entry));
+    entry.fSelected = true;
+    entry.nSelectSeq = ++nSelectSeq;
+    mapSelectedBySeq[entry.nSelectSeq] = entry.info.txid;
+    nSizeSelected += entry.info.nSize;
+    nFeesSelected += entry.info.nFee;
+
+    // Children waiting on this parent may now be eligible
+    for (const uint256& hashChild : entry.vChildren) {
+        EntryMap::iterator it = mapTx.find(hashChild);
+        if (it != mapTx.end() && !it->second.fSelected)
+            TryInsert(it->second);
+    }
+}
+
+void BlockTemplateAssembler::Deselect(Entry& entry, bool fToPending)
+{
+    if (!entry.fSelected)
+        return;
+
+    setSelected.erase(KeyOf(entry));
+    mapSelectedBySeq.erase(entry.nSelectSeq);
+    entry.fSelected = false;
+    nSizeSelected -= entry.info.nSize;
+    nFeesSelected -= entry.info.nFee;
+    if (fToPending)
+        setPending.insert(KeyOf(entry));
+
+    // Descendants cannot stay in the block without their parent
+    for (const uint256& hashChild : entry.vChildren) {
+        EntryMap::iterator it = mapTx.find(hashChild);
+        if (it != mapTx.end())
+            Deselect(it->second, true);
+    }
+}
+
+void BlockTemplateAssembler::TryInsert(Entry& entry)
+{
+    if (!ParentsSelected(entry)) {
+        setPending.insert(KeyOf(entry));
+        return;
+    }
+
+    if (nSizeSelected + entry.info.nSize <= nMaxSize) {
+        Select(entry);
+        return;
+    }
+
+    // Only evict if enough cheaper entries exist to make room; otherwise
+    // the template would shrink without gaining the new transaction.
+    uint64_t nFreed = nMaxSize - nSizeSelected;
+    std::vector<uint256> vEvict;
+    for (std::set<FeeKey>::const_iterator it = setSelected.begin();
+         it != setSelected.end() && nFreed < entry.info.nSize; ++it) {
+        if (it->nFeeRate >= entry.nFeeRate)
+            break;
+        vEvict.push_back(it->txid);
+        nFreed += mapTx.find(it->txid)->second.info.nSize;
+    }
+
+    if (nFreed < entry.info.nSize) {
+        setPending.insert(KeyOf(entry));
+        return;
+    }
+
+    for (const uint256& txid : vEvict) {
+        EntryMap::iterator it = mapTx.find(txid);
+        if (it != mapTx.end())
+            Deselect(it->second, true);
+    }
+
+    // An evicted entry may have been one of our own ancestors
+    if (ParentsSelected(entry) && nSizeSelected + entry.info.nSize <= nMaxSize)
+        Select(entry);
+    else
+        setPending.insert(KeyOf(entry));
+}
+
+void BlockTemplateAssembler::Backfill()
+{
+    // Snapshot the best candidates first: Select() mutates setPending
+    std::vector<uint256> vCandidates;
+    for (std::set<FeeKey>::const_reverse_iterator it = setPending.rbegin();
+         it != setPending.rend() && vCandidates.size() < MAX_TEMPLATE_BACKFILL_SCAN; ++it) {
+        vCandidates.push_back(it->txid);
+    }
+
+    for (const uint256& txid : vCandidates) {
+        if (nSizeSelected >= nMaxSize)
+            break;
+        EntryMap::iterator it = mapTx.find(txid);
+        if (it == mapTx.end() || it->second.fSelected)
+            continue;
+        Entry& entry = it->second;
+        if (nSizeSelected + entry.info.nSize <= nMaxSize && ParentsSelected(entry))
+            Select(entry);
+    }
+}
+
+void BlockTemplateAssembler::MaybeNotify()
+{
+    CAmount nDelta = nFeesSelected - nFeesNotified;
+    if (nDelta < 0)
+        nDelta = -nDelta;
+    if (nDelta < nFeeDelta)
+        return;
+
+    nFeesNotified = nFeesSelected;
+    ++nSequence;
+    cvUpdate.notify_all();
+}
+
+void BlockTemplateAssembler::TransactionAdded(const TemplateTxInfo& info)
+{
+    std::lock_guard<std::mutex> lock(cs);
+
+    std::pair<EntryMap::iterator, bool> ret = mapTx.emplace(info.txid, Entry());
+    if (!ret.second)
+        return;
+
+    Entry& entry = ret.first->second;
+    entry.info = info;
+    entry.nFeeRate = GetFeeRatePerK(info.nFee, info.nSize);
+    entry.fSelected = false;
+    entry.nSelectSeq = 0;
+
+    for (const uint256& hashParent : info.vParents) {
+        EntryMap::iterator it = mapTx.find(hashParent);
+        if (it != mapTx.end())
+            it->second.vChildren.push_back(info.txid);
+    }
+
+    TryInsert(entry);
+    MaybeNotify();
+}
+
+void BlockTemplateAssembler::TransactionRemoved(const uint256& txid)
+{
+    std::lock_guard<std::mutex> lock(cs);
+
+    EntryMap::iterator it = mapTx.find(txid);
+    if (it == mapTx.end())
+        return;
+
+    Entry& entry = it->second;
+    bool fWasSelected = entry.fSelected;
+    if (fWasSelected)
+        Deselect(entry, false);
+    else
+        setPending.erase(KeyOf(entry));
+
+    for (const uint256& hashParent : entry.info.vParents) {
+        EntryMap::iterator itParent = mapTx.find(hashParent);
+        if (itParent == mapTx.end())
+            continue;
+        std::vector<uint256>& vChildren = itParent->second.vChildren;
+        vChildren.erase(std::remove(vChildren.begin(), vChildren.end(), txid), vChildren.end());
+    }
+
+    std::vector<uint256> vChildren;
+    vChildren.swap(entry.vChildren);
+    mapTx.erase(it);
+
+    // Children of a mined parent become eligible; children of an evicted
+    // parent will be removed by their own notification.
+    for (const uint256& hashChild : vChildren) {
+        EntryMap::iterator itChild = mapTx.find(hashChild);
+        if (itChild != mapTx.end() && !itChild->second.fSelected) {
+            setPending.erase(KeyOf(itChild->second));
+            TryInsert(itChild->second);
+        }
+    }
+
+    if (fWasSelected)
+        Backfill();
+    MaybeNotify();
+}
+
+BlockTemplateSnapshot BlockTemplateAssembler::GetTemplate() const
+{
+    int64_t nTimeStart = GetTimeMicros();
+
+    BlockTemplateSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(cs);
+
+    snapshot.hashPrevBlock = hashPrevBlock;
+    snapshot.nHeight = nHeight;
+    snapshot.blockType = blockType;
+    snapshot.nBits = nBits;
+    snapshot.nFees = nFeesSelected;
+    snapshot.nSize = nSizeSelected;
+    snapshot.nSequence = nSequence;
+
+    snapshot.vtx.reserve(mapSelectedBySeq.size());
+    snapshot.vTxFees.reserve(mapSelectedBySeq.size());
+    for (const auto& item : mapSelectedBySeq) {
+        const Entry& entry = mapTx.find(item.second)->second;
+        snapshot.vtx.push_back(entry.info.tx);
+        snapshot.vTxFees.push_back(entry.info.nFee);
+    }
+
+    snapshot.nBuildMicros = GetTimeMicros() - nTimeStart;
+    LogPrint("bench", "%s: %u txs, %d bytes in %.3fms\n", __func__,
+             snapshot.vtx.size(), snapshot.nSize, snapshot.nBuildMicros * 0.001);
+    return snapshot;
+}
+
+uint64_t BlockTemplateAssembler::WaitForUpdate(uint64_t nSequenceIn, int64_t nTimeoutMillis) const
+{
+    std::unique_lock<std::mutex> lock(cs);
+    cvUpdate.wait_for(lock, std::chrono::milliseconds(nTimeoutMillis),
+                      [&] { return nSequence != nSequenceIn; });
+    return nSequence;
+}
+
+uint64_t BlockTemplateAssembler::GetSequence() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return nSequence;
+}
+
+uint256 BlockTemplateAssembler::GetTipHash() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return hashPrevBlock;
+}
+
+size_t BlockTemplateAssembler::GetSelectedCount() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return setSelected.size();
+}
+
+size_t BlockTemplateAssembler::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return setPending.size();
+}
+
+/**
+ * Build the assembler's view of a mempool entry.
+ * Called from mempool signals, so pool.cs is already held.
+ */
+static bool MakeTemplateTxInfo(const CTxMemPool& pool, const CTransactionRef& tx, TemplateTxInfo& info)
+{
+    CTxMemPool::txiter it = pool.mapTx.find(tx->GetHash());
+    if (it == pool.mapTx.end())
+        return false;
+
+    info.tx = tx;
+    info.txid = tx->GetHash();
+    info.nFee = it->GetModifiedFee();
+    info.nSize = it->GetTxSize();
+    for (const CTxIn& txin : tx->vin) {
+        if (pool.exists(txin.prevout.hash))
+            info.vParents.push_back(txin.prevout.hash);
+    }
+    return true;
+}
+
+static boost::signals2::connection connEntryAdded;
+static boost::signals2::connection connEntryRemoved;
+
+void StartBlockTemplateAssembler(CTxMemPool& pool, const CBlockIndex* pindexTip)
+{
+    uint64_t nMaxSize = GetArg("-blockmaxsize", (int64_t)DEFAULT_TEMPLATE_MAX_SIZE);
+    CAmount nFeeDelta = GetArg("-longpollfeedelta", (int64_t)DEFAULT_LONGPOLL_FEE_DELTA);
+    g_blockTemplateAssembler.reset(new BlockTemplateAssembler(nMaxSize, nFeeDelta));
+    g_blockTemplateAssembler->UpdateTip(pindexTip);
+
+    LOCK(pool.cs);
+    connEntryAdded = pool.NotifyEntryAdded.connect([&pool](CTransactionRef tx) {
+        TemplateTxInfo info;
+        if (g_blockTemplateAssembler && MakeTemplateTxInfo(pool, tx, info))
+            g_blockTemplateAssembler->TransactionAdded(info);
+    });
+    connEntryRemoved = pool.NotifyEntryRemoved.connect([](CTransactionRef tx, MemPoolRemovalReason reason) {
+        if (g_blockTemplateAssembler)
+            g_blockTemplateAssembler->TransactionRemoved(tx->GetHash());
+    });
+
+    // mapTx's ancestor_score index yields parents before children
+    for (const CTxMemPoolEntry& entry : pool.mapTx.get<ancestor_score>()) {
+        TemplateTxInfo info;
+        if (MakeTemplateTxInfo(pool, entry.GetSharedTx(), info))
+            g_blockTemplateAssembler->TransactionAdded(info);
+    }
+}
+
+void StopBlockTemplateAssembler(CTxMemPool& pool)
+{
+    connEntryAdded.disconnect();
+    connEntryRemoved.disconnect();
+    g_blockTemplateAssembler.reset();
+}
+
+void BlockTemplateUpdatedTip(const CBlockIndex* pindexNew)
+{
+    if (g_blockTemplateAssembler)
+        g_blockTemplateAssembler->UpdateTip(pindexNew);
+}
+
+static std::string BlockTypeName(BlockType type)
+{
+    switch (type) {
+    case BLOCK_TYPE_POW: return "pow";
+    case BLOCK_TYPE_POS: return "pos";
+    case BLOCK_TYPE_HYBRID: return "hybrid";
+    }
+    return "unknown";
+}
+
+UniValue getblocktemplate(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() > 1)
+        throw std::runtime_error(
+            "getblocktemplate ( TemplateRequest )\n"
+            "\nReturns data needed to construct a proof-of-work block.\n"
+            "The template is maintained incrementally from mempool events, so\n"
+            "polling is cheap. Long-polling callers are only woken on a new tip\n"
+            "or when template fees change by at least -longpollfeedelta.\n"
+            "\nArguments:\n"
+            "1. template_request         (json object, optional)\n"
+            "     {\n"
+            "       \"longpollid\":\"id\"      (string, optional) id of the template to wait on\n"
+            "     }\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"previousblockhash\" : \"xxxx\",  (string) The hash of current highest block\n"
+            "  \"height\" : n,                  (numeric) The height of the next block\n"
+            "  \"blocktype\" : \"xxx\",           (string) pow, pos or hybrid\n"
+            "  \"bits\" : \"xxxxxxxx\",           (string) compressed target of next block\n"
+            "  \"target\" : \"xxxx\",             (string) The hash target\n"
+            "  \"transactions\" : [ ... ],      (array) transactions to include, parents first\n"
+            "  \"coinbasevalue\" : n,           (numeric) maximum coinbase value in satoshis\n"
+            "  \"longpollid\" : \"xxxx\",         (string) id to pass back for long-polling\n"
+            "  \"buildtimeus\" : n              (numeric) microseconds spent copying the template\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getblocktemplate", "")
+            + HelpExampleRpc("getblocktemplate", "")
+        );
+
+    if (!g_blockTemplateAssembler)
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Block template assembler not running");
+
+    if (IsInitialBlockDownload())
+        throw JSONRPCError(RPC_CLIENT_IN_INITIAL_DOWNLOAD, "Africoin is downloading blocks...");
+
+    if (request.params.size() > 0 && request.params[0].isObject()) {
+        const UniValue& lpval = find_value(request.params[0].get_obj(), "longpollid");
+        if (lpval.isStr()) {
+            // Format: <hashBestChain><nSequence>
+            std::string lpstr = lpval.get_str();
+            uint256 hashWatched = uint256S(lpstr.substr(0, 64));
+            uint64_t nSequenceWatched = 0;
+            if (lpstr.size() > 64 && !ParseUInt64(lpstr.substr(64), &nSequenceWatched))
+                throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid longpollid");
+
+            while (g_blockTemplateAssembler->GetTipHash() == hashWatched &&
+                   g_blockTemplateAssembler->GetSequence() == nSequenceWatched) {
+                g_blockTemplateAssembler->WaitForUpdate(nSequenceWatched, 60 * 1000);
+                if (!IsRPCRunning())
+                    throw JSONRPCError(RPC_CLIENT_NOT_CONNECTED, "Shutting down");
+            }
+        }
+    }
+
+    BlockTemplateSnapshot snapshot = g_blockTemplateAssembler->GetTemplate();
+    if (snapshot.blockType == BLOCK_TYPE_POS)
+        throw JSONRPCError(RPC_MISC_ERROR, "Next block must be proof-of-stake");
+
+    UniValue transactions(UniValue::VARR);
+    for (size_t i = 0; i < snapshot.vtx.size(); i++) {
+        UniValue entry(UniValue::VOBJ);
+        entry.push_back(Pair("data", EncodeHexTx(*snapshot.vtx[i])));
+        entry.push_back(Pair("txid", snapshot.vtx[i]->GetHash().GetHex()));
+        entry.push_back(Pair("fee", snapshot.vTxFees[i]));
+        transactions.push_back(entry);
+    }
+
+    arith_uint256 hashTarget = arith_uint256().SetCompact(snapshot.nBits);
+    CAmount nReward = HybridStaking::CalculateBlockReward(snapshot.nHeight, snapshot.blockType);
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("previousblockhash", snapshot.hashPrevBlock.GetHex()));
+    result.push_back(Pair("height", (int64_t)snapshot.nHeight));
+    result.push_back(Pair("blocktype", BlockTypeName(snapshot.blockType)));
+    result.push_back(Pair("bits", strprintf("%08x", snapshot.nBits)));
+    result.push_back(Pair("target", hashTarget.GetHex()));
+    result.push_back(Pair("transactions", transactions));
+    result.push_back(Pair("coinbasevalue", nReward + snapshot.nFees));
+    result.push_back(Pair("curtime", GetAdjustedTime()));
+    result.push_back(Pair("sizelimit", (int64_t)g_blockTemplateAssembler->GetMaxSize()));
+    result.push_back(Pair("longpollid", snapshot.hashPrevBlock.GetHex() + strprintf("%d", snapshot.nSequence)));
+    result.push_back(Pair("buildtimeus", snapshot.nBuildMicros));
+
+    return result;
+}
+
+static const CRPCCommand commands[] =
+{ //  category              name                      actor (function)         okSafeMode
+  //  --------------------- ------------------------  -----------------------  ----------
+    { "mining",             "getblocktemplate",       &getblocktemplate,       true,  {"template_request"} },
+};
+
+void RegisterMiningRPCCommands(CRPCTable& t)
+{
+    for (unsigned int vcidx = 0; vcidx < sizeof(commands) / sizeof(commands[0]); vcidx++)
+        t.appendCommand(commands[vcidx].name, &commands[vcidx]);
+}
+
+} // namespace Africoin
@@ -0,0 +1,218 @@
+// Copyright (c) 2010 Satoshi Nakamoto
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_RPC_MINING_H
+#define AFRICOIN_RPC_MINING_H
+
+#include "amount.h"
+#include "primitives/transaction.h"
+#include "staking/hybrid_staking.h"
+#include "uint256.h"
+
+#include <stdint.h>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class CBlockIndex;
+class CTxMemPool;
+
+/**
+ * @file mining.h
+ * @brief Incrementally maintained block template for getblocktemplate
+ *
+ * PoW miners poll getblocktemplate aggressively. Rebuilding the template
+ * from the whole mempool on every call wastes CPU, so the template is kept
+ * up to date as mempool transactions arrive and are evicted, and each
+ * getblocktemplate call only has to copy the current selection out.
+ *
+ * Per-tip work (block type selection via HybridStaking::SelectNextBlockType
+ * and the target via HybridStaking::GetHybridDifficulty) is done exactly
+ * once when the tip changes.
+ */
+
+namespace Africoin {
+
+/** Default maximum serialized size of the transactions in a template */
+static const uint64_t DEFAULT_TEMPLATE_MAX_SIZE = 1000000 - 1000;
+
+/** Default fee change (in satoshis) that wakes long-polling miners */
+static const CAmount DEFAULT_LONGPOLL_FEE_DELTA = 1000000; // 0.01 AFRC
+
+/** Maximum pending candidates examined when backfilling freed space */
+static const unsigned int MAX_TEMPLATE_BACKFILL_SCAN = 1000;
+
+/**
+ * @struct TemplateTxInfo
+ * @brief Mempool-side view of a transaction offered to the template
+ */
+struct TemplateTxInfo {
+    CTransactionRef tx;
+    uint256 txid;
+    CAmount nFee;
+    unsigned int nSize;
+    std::vector<uint256> vParents; ///< Unconfirmed parents (must be included first)
+
+    TemplateTxInfo() : nFee(0), nSize(0) {}
+};
+
+/**
+ * @struct BlockTemplateSnapshot
+ * @brief Immutable copy of the template handed to the RPC layer
+ */
+struct BlockTemplateSnapshot {
+    uint256 hashPrevBlock;
+    int nHeight;
+    BlockType blockType;
+    unsigned int nBits;
+    std::vector<CTransactionRef> vtx;   ///< Ordered parents-first
+    std::vector<CAmount> vTxFees;
+    CAmount nFees;
+    uint64_t nSize;
+    uint64_t nSequence;                 ///< Long-poll sequence number
+    int64_t nBuildMicros;               ///< Time spent producing this snapshot
+
+    BlockTemplateSnapshot()
+        : nHeight(0), blockType(BLOCK_TYPE_POW), nBits(0), nFees(0),
+          nSize(0), nSequence(0), nBuildMicros(0) {}
+};
+
+/**
+ * @class BlockTemplateAssembler
+ * @brief Greedy fee-rate ordered template kept current by mempool events
+ *
+ * The selected set is ordered by fee rate so the cheapest entry can be
+ * evicted in O(log n) when a better transaction arrives. A transaction is
+ * only selected once all of its unconfirmed parents are selected, and
+ * deselecting a parent moves its selected descendants back to the pending
+ * set. The order in which entries were selected is a valid topological
+ * order, so the snapshot is emitted in selection order.
+ *
+ * Long-polling waiters are only woken when the tip changes or the total
+ * template fees move by at least the configured threshold since the last
+ * notification.
+ *
+ * All public methods are thread-safe.
+ */
+class BlockTemplateAssembler {
+public:
+    explicit BlockTemplateAssembler(uint64_t nMaxSize = DEFAULT_TEMPLATE_MAX_SIZE,
+                                    CAmount nFeeDelta = DEFAULT_LONGPOLL_FEE_DELTA);
+
+    /**
+     * @brief Recompute per-tip state
+     *
+     * Selects the next block type and difficulty for the new tip and wakes
+     * all long-pollers. Mempool removals for confirmed transactions arrive
+     * separately through TransactionRemoved().
+     */
+    void UpdateTip(const CBlockIndex* pindexPrev);
+
+    /** @brief Offer a transaction that entered the mempool */
+    void TransactionAdded(const TemplateTxInfo& info);
+
+    /** @brief Forget a transaction that left the mempool (mined, evicted, replaced) */
+    void TransactionRemoved(const uint256& txid);
+
+    /** @brief Copy out the current template */
+    BlockTemplateSnapshot GetTemplate() const;
+
+    /**
+     * @brief Block until the long-poll sequence moves past nSequence
+     *
+     * @param nSequence Sequence number the caller last saw
+     * @param nTimeoutMillis Maximum time to wait
+     * @return The current sequence number
+     */
+    uint64_t WaitForUpdate(uint64_t nSequence, int64_t nTimeoutMillis) const;
+
+    uint64_t GetSequence() const;
+    uint256 GetTipHash() const;
+    uint64_t GetMaxSize() const { return nMaxSize; }
+    size_t GetSelectedCount() const;
+    size_t GetPendingCount() const;
+
+private:
+    struct Entry {
+        TemplateTxInfo info;
+        int64_t nFeeRate;          ///< Satoshis per 1000 bytes
+        bool fSelected;
+        uint64_t nSelectSeq;
+        std::vector<uint256> vChildren;
+    };
+
+    struct FeeKey {
+        int64_t nFeeRate;
+        uint256 txid;
+        bool operator<(const FeeKey& other) const {
+            if (nFeeRate != other.nFeeRate)
+                return nFeeRate < other.nFeeRate;
+            return txid < other.txid;
+        }
+    };
+
+    struct TxidHasher {
+        size_t operator()(const uint256& txid) const { return txid.GetCheapHash(); }
+    };
+
+    typedef std::unordered_map<uint256, Entry, TxidHasher> EntryMap;
+
+    bool ParentsSelected(const Entry& entry) const;
+    void Select(Entry& entry);
+    void Deselect(Entry& entry, bool fToPending);
+    void TryInsert(Entry& entry);
+    void Backfill();
+    void MaybeNotify();
+
+    static FeeKey KeyOf(const Entry& entry) { return FeeKey{entry.nFeeRate, entry.info.txid}; }
+
+    const uint64_t nMaxSize;
+    const CAmount nFeeDelta;
+
+    mutable std::mutex cs;
+    mutable std::condition_variable cvUpdate;
+
+    EntryMap mapTx;
+    std::set<FeeKey> setSelected;               ///< begin() is the cheapest selected entry
+    std::set<FeeKey> setPending;                ///< rbegin() is the best candidate
+    std::map<uint64_t, uint256> mapSelectedBySeq;
+
+    uint64_t nSizeSelected;
+    CAmount nFeesSelected;
+    CAmount nFeesNotified;
+    uint64_t nSelectSeq;
+    uint64_t nSequence;
+
+    uint256 hashPrevBlock;
+    int nHeight;
+    BlockType blockType;
+    unsigned int nBits;
+};
+
+/** @brief Global assembler fed by mempool and tip notifications */
+extern std::unique_ptr<BlockTemplateAssembler> g_blockTemplateAssembler;
+
+/**
+ * @brief Create the global assembler and subscribe it to mempool events
+ *
+ * Existing mempool contents are offered to the template so the first
+ * getblocktemplate call after startup does not rebuild anything.
+ */
+void StartBlockTemplateAssembler(CTxMemPool& pool, const CBlockIndex* pindexTip);
+
+/** @brief Unsubscribe and destroy the global assembler */
+void StopBlockTemplateAssembler(CTxMemPool& pool);
+
+/** @brief Forward a new active tip to the global assembler */
+void BlockTemplateUpdatedTip(const CBlockIndex* pindexNew);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_RPC_MINING_H
@@ -0,0 +1,32 @@
+// Copyright (c) 2009-2016 The Bitcoin Core developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_RPC_REGISTER_H
+#define AFRICOIN_RPC_REGISTER_H
+
+/** These are in one header file to avoid creating tons of single-function
+ * headers for everything under src/rpc/ */
+class CRPCTable;
+
+namespace Africoin {
+
+/** Register Africoin blockchain RPC commands */
+void RegisterBlockchainRPCCommands(CRPCTable& tableRPC);
+/** Register Africoin mining RPC commands */
+void RegisterMiningRPCCommands(CRPCTable& tableRPC);
+/** Register Africoin metrics RPC commands */
+void RegisterMetricsRPCCommands(CRPCTable& tableRPC);
+
+/** Register every Africoin RPC command; AppInitMain must call this (see init.cpp) */
+static inline void RegisterAllAfricoinRPCCommands(CRPCTable& t)
+{
+    RegisterBlockchainRPCCommands(t);
+    RegisterMiningRPCCommands(t);
+    RegisterMetricsRPCCommands(t);
+}
+
+} // namespace Africoin
+
+#endif // AFRICOIN_RPC_REGISTER_H
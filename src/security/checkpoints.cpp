@@ -14,14 +14,9 @@
  * 
  * PeerCoin Reference: https://github.com/peercoin/peercoin
  * 
- * IMPORTANT: This is a STUB/PLACEHOLDER file. It will NOT compile standalone.
- * Full integration requires:
- * 1. Including actual Africoin headers (uint256, CBlockIndex, etc.)
- * 2. Implementing the TODO-marked functions with PeerCoin code
- * 3. Adding to the build system with proper dependencies
- * 
- * TODO: Replace stub implementations with actual PeerCoin code from:
- *       https://github.com/peercoin/peercoin/blob/master/src/checkpoints.cpp
+ * The hardcoded maps below are overlaid by signed sync checkpoints
+ * (checkpointsync.h) when AutoCheckpointsEnabled(): a block must match
+ * both, and the highest of either bounds reorganizations.
  * 
  * Integration Notes:
  * - Add Africoin-specific checkpoints after mainnet launch
@@ -31,12 +26,14 @@
 
 #include "checkpoints.h"
 
-// TODO: Include actual Africoin headers when integrated
-// #include "chain.h"
-// #include "chainparams.h"
-// #include "uint256.h"
-// #include "util.h"
-// #include "validation.h"
+#include "chain.h"
+#include "chainparams.h"
+#include "chainparamsbase.h"
+#include "security/checkpointsync.h"
+#include "uint256.h"
+#include "util.h"
+
+#include <algorithm>
 
 namespace PeerCoin {
 namespace Checkpoints {
@@ -75,11 +72,25 @@ static MapCheckpoints mapCheckpointsTestnet;
  */
 static MapCheckpoints mapCheckpointsRegtest;
 
+/**
+ * Africoin Assume-UTXO Data
+ * 
+ * TODO: Add entries at checkpoint heights after mainnet launch
+ * Format: { height, { coins_hash, coin_count, state_hash } }
+ * 
+ * Take the values from a snapshot written by a node that synced
+ * and validated the whole chain, and check them against others.
+ */
+static MapAssumeUtxo mapAssumeUtxoMainnet;
+static MapAssumeUtxo mapAssumeUtxoTestnet;
+static MapAssumeUtxo mapAssumeUtxoRegtest;
+
 /**
  * Checkpoint data for each network
  */
 static CheckpointData dataMainnet = {
     mapCheckpointsMainnet,
+    mapAssumeUtxoMainnet,
     0,    // nTimeLastCheckpoint - timestamp of last checkpoint block
     0,    // nTransactionsLastCheckpoint - total transactions at checkpoint
     0.0   // fTransactionsPerDay - estimated transactions per day
@@ -87,6 +98,7 @@ static CheckpointData dataMainnet = {
 
 static CheckpointData dataTestnet = {
     mapCheckpointsTestnet,
+    mapAssumeUtxoTestnet,
     0,
     0,
     0.0
@@ -94,6 +106,7 @@ static CheckpointData dataTestnet = {
 
 static CheckpointData dataRegtest = {
     mapCheckpointsRegtest,
+    mapAssumeUtxoRegtest,
     0,
     0,
     0.0
@@ -111,21 +124,14 @@ static CheckpointData dataRegtest = {
  * - Returns false ONLY if checkpoint exists AND hash doesn't match
  */
 bool CheckHardened(int nHeight, const uint256& hash) {
-    // TODO: Implement PeerCoin's CheckHardened()
-    //
-    // PeerCoin implementation:
-    //
-    // const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
-    // 
-    // MapCheckpoints::const_iterator i = checkpoints.find(nHeight);
-    // if (i == checkpoints.end())
-    //     return true;  // No checkpoint at this height
-    // 
-    // return hash == i->second;  // Hash must match checkpoint
-    
-    // Stub: No checkpoints defined yet, accept all blocks
-    // This should be updated once Africoin mainnet launches
-    return true;
+    const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
+
+    MapCheckpoints::const_iterator i = checkpoints.find(nHeight);
+    if (i != checkpoints.end() && hash != i->second)
+        return false;
+
+    // Signed sync checkpoints fix the chain up to the latest one
+    return !AutoCheckpointsEnabled() || g_syncCheckpoints.CheckHardened(nHeight, hash);
 }
 
 /**
@@ -135,18 +141,12 @@ bool CheckHardened(int nHeight, const uint256& hash) {
  * Returns 0 if no checkpoints are defined.
  */
 int GetTotalBlocksEstimate() {
-    // TODO: Implement PeerCoin's GetTotalBlocksEstimate()
-    //
-    // PeerCoin implementation:
-    //
-    // const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
-    // 
-    // if (checkpoints.empty())
-    //     return 0;
-    // 
-    // return checkpoints.rbegin()->first;  // Height of last checkpoint
-    
-    return 0; // No checkpoints defined yet
+    const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
+
+    int nHeight = checkpoints.empty() ? 0 : checkpoints.rbegin()->first;
+    if (AutoCheckpointsEnabled())
+        nHeight = std::max(nHeight, g_syncCheckpoints.GetHeight());
+    return nHeight;
 }
 
 /**
@@ -156,23 +156,22 @@ int GetTotalBlocksEstimate() {
  * and returns the first one found in mapBlockIndex.
  */
 CBlockIndex* GetLastCheckpoint(const std::map<uint256, CBlockIndex*>& mapBlockIndex) {
-    // TODO: Implement PeerCoin's GetLastCheckpoint()
-    //
-    // PeerCoin implementation:
-    //
-    // const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
-    // 
-    // // Iterate in reverse to find highest checkpoint first
-    // for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it) {
-    //     const uint256& hash = it->second;
-    //     auto blockIt = mapBlockIndex.find(hash);
-    //     if (blockIt != mapBlockIndex.end())
-    //         return blockIt->second;
-    // }
-    // 
-    // return nullptr;  // No checkpoint found in chain
-    
-    return nullptr; // No checkpoints defined yet
+    const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
+
+    if (AutoCheckpointsEnabled()) {
+        auto blockIt = mapBlockIndex.find(g_syncCheckpoints.GetCheckpoint().hashCheckpoint);
+        if (blockIt != mapBlockIndex.end())
+            return blockIt->second;
+    }
+
+    // Iterate in reverse to find highest checkpoint first
+    for (auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it) {
+        auto blockIt = mapBlockIndex.find(it->second);
+        if (blockIt != mapBlockIndex.end())
+            return blockIt->second;
+    }
+
+    return nullptr;
 }
 
 /**
@@ -182,16 +181,8 @@ CBlockIndex* GetLastCheckpoint(const std::map<uint256, CBlockIndex*>& mapBlockIn
  * or 0 if no checkpoints are defined.
  */
 int GetLastCheckpointHeight() {
-    // TODO: Implement using checkpoint data
-    //
-    // const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
-    // 
-    // if (checkpoints.empty())
-    //     return 0;
-    // 
-    // return checkpoints.rbegin()->first;
-    
-    return 0; // No checkpoints defined yet
+    // The same bound as the sync estimate: the highest fixed height
+    return GetTotalBlocksEstimate();
 }
 
 /**
@@ -201,19 +192,31 @@ int GetLastCheckpointHeight() {
  * otherwise returns a null uint256.
  */
 uint256 GetCheckpointHash(int nHeight) {
-    // TODO: Implement checkpoint lookup
-    //
-    // const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
-    // 
-    // auto it = checkpoints.find(nHeight);
-    // if (it != checkpoints.end())
-    //     return it->second;
-    // 
-    // return uint256();  // Null hash if no checkpoint
-    
-    // Stub: Return default-constructed uint256
-    // This is a forward declaration placeholder
-    return uint256();
+    const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
+
+    auto it = checkpoints.find(nHeight);
+    if (it != checkpoints.end())
+        return it->second;
+
+    return AutoCheckpointsEnabled() ? g_syncCheckpoints.GetCheckpointHash(nHeight) : uint256();
+}
+
+/**
+ * GetAssumeUtxo - Get the trusted snapshot commitment at a height
+ * 
+ * The assume-UTXO map of the active network wins; otherwise an
+ * accepted sync checkpoint at the height may carry one.
+ */
+bool GetAssumeUtxo(int nHeight, CAssumeUtxoData& data) {
+    const MapAssumeUtxo& assumeUtxo = GetCheckpointData().mapAssumeUtxo;
+
+    auto it = assumeUtxo.find(nHeight);
+    if (it != assumeUtxo.end()) {
+        data = it->second;
+        return true;
+    }
+
+    return AutoCheckpointsEnabled() && g_syncCheckpoints.GetAssumeUtxo(nHeight, data);
 }
 
 /**
@@ -223,39 +226,26 @@ uint256 GetCheckpointHash(int nHeight) {
  * heights have the expected hash.
  */
 bool VerifyCheckpointsInChain(const CBlockIndex* pindex) {
-    // TODO: Implement chain verification
-    //
-    // const MapCheckpoints& checkpoints = GetCheckpointData().mapCheckpoints;
-    // 
-    // while (pindex) {
-    //     auto it = checkpoints.find(pindex->nHeight);
-    //     if (it != checkpoints.end()) {
-    //         if (pindex->GetBlockHash() != it->second) {
-    //             LogPrintf("Checkpoint verification failed at height %d\n", pindex->nHeight);
-    //             return false;
-    //         }
-    //     }
-    //     pindex = pindex->pprev;
-    // }
-    // 
-    // return true;
-    
-    return true; // No checkpoints to verify yet
+    for (; pindex; pindex = pindex->pprev) {
+        if (!CheckHardened(pindex->nHeight, pindex->GetBlockHash())) {
+            LogPrintf("Checkpoint verification failed at height %d\n", pindex->nHeight);
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /**
  * AutoCheckpointsEnabled - Check if automatic checkpoints are enabled
  * 
- * Automatic checkpoints allow the network to agree on new
- * checkpoint via consensus. This is an advanced feature that
- * requires careful implementation.
- * 
- * Currently disabled for Africoin.
+ * Automatic checkpoints are PeerCoin-style sync checkpoints signed by
+ * the checkpoint master key (see checkpointsync.h). They are enabled
+ * once a master key is configured with -checkpointpubkey, and can be
+ * turned off with -synccheckpoints=0.
  */
 bool AutoCheckpointsEnabled() {
-    // Automatic checkpoints are disabled by default for security
-    // This could be enabled later with proper implementation
-    return false;
+    return g_syncCheckpoints.IsEnabled();
 }
 
 /**
@@ -265,17 +255,12 @@ bool AutoCheckpointsEnabled() {
  * the currently active network (mainnet, testnet, regtest).
  */
 const CheckpointData& GetCheckpointData() {
-    // TODO: Implement network detection and return appropriate data
-    //
-    // if (Params().NetworkIDString() == CBaseChainParams::MAIN)
-    //     return dataMainnet;
-    // else if (Params().NetworkIDString() == CBaseChainParams::TESTNET)
-    //     return dataTestnet;
-    // else
-    //     return dataRegtest;
-    
-    // Default to mainnet
-    return dataMainnet;
+    if (Params().NetworkIDString() == CBaseChainParams::MAIN)
+        return dataMainnet;
+    else if (Params().NetworkIDString() == CBaseChainParams::TESTNET)
+        return dataTestnet;
+    else
+        return dataRegtest;
 }
 
 } // namespace Checkpoints
@@ -7,13 +7,14 @@
 #ifndef AFRICOIN_SECURITY_CHECKPOINTS_H
 #define AFRICOIN_SECURITY_CHECKPOINTS_H
 
+#include "uint256.h"
+
 #include <stdint.h>
 #include <map>
 #include <string>
 
 // Forward declarations for Africoin types
 // These should be replaced with actual includes once integrated
-class uint256;
 class CBlockIndex;
 
 /**
@@ -47,6 +48,32 @@ namespace Checkpoints {
  */
 typedef std::map<int, uint256> MapCheckpoints;
 
+/**
+ * @struct CAssumeUtxoData
+ * @brief What a trusted snapshot at one height contains
+ * 
+ * Together the coins hash and the state hash cover every byte of
+ * a snapshot file after its header (see snapshot.h).
+ */
+struct CAssumeUtxoData {
+    uint256 hashCoins;    //!< GetSnapshotCoinsHash of the chainstate at the block
+    uint64_t nCoins;      //!< Coins in that chainstate
+    uint256 hashState;    //!< CSnapshotMetadata::hashState of the snapshot
+
+    CAssumeUtxoData() : nCoins(0) {}
+    CAssumeUtxoData(const uint256& hashCoinsIn, uint64_t nCoinsIn, const uint256& hashStateIn)
+        : hashCoins(hashCoinsIn), nCoins(nCoinsIn), hashState(hashStateIn) {}
+};
+
+/**
+ * @brief Type definition for the assume-UTXO map
+ * 
+ * Maps a checkpoint height to the snapshot of the chainstate at
+ * that block. Only snapshots matching an entry here, or one
+ * carried by a signed sync checkpoint, can be loaded.
+ */
+typedef std::map<int, CAssumeUtxoData> MapAssumeUtxo;
+
 /**
  * @brief Check if a block passes hardened checkpoint validation
  * 
@@ -113,6 +140,18 @@ int GetLastCheckpointHeight();
  */
 uint256 GetCheckpointHash(int nHeight);
 
+/**
+ * @brief Get the trusted snapshot commitment at a height
+ * 
+ * Looks in the active chain's assume-UTXO map, then in the
+ * accepted sync checkpoints when automatic checkpoints are on.
+ * 
+ * @param nHeight Snapshot block height
+ * @param data Output: expected coins hash, coin count and state hash
+ * @return false if nothing vouches for a snapshot at nHeight
+ */
+bool GetAssumeUtxo(int nHeight, CAssumeUtxoData& data);
+
 /**
  * @brief Verify chain integrity against checkpoints
  * 
@@ -129,14 +168,15 @@ bool VerifyCheckpointsInChain(const CBlockIndex* pindex);
 /**
  * @brief Check if automatic checkpoint updates are allowed
  * 
- * Some implementations allow the network to propose new
- * checkpoints via special transactions. This function
- * checks if that feature is enabled.
+ * Automatic checkpoints are signed sync checkpoints relayed over
+ * P2P (see checkpointsync.h). When enabled they overlay the
+ * hardcoded checkpoints in CheckHardened and the height queries.
  * 
- * @return true if automatic checkpoints are enabled
+ * @return true if a checkpoint master key is configured
  * 
- * Note: This is an advanced feature that requires careful
- * implementation to prevent checkpoint injection attacks.
+ * Note: Only checkpoints signed by the master key (and the
+ * required hub co-signers) are accepted, so a peer cannot
+ * inject one.
  */
 bool AutoCheckpointsEnabled();
 
@@ -148,6 +188,7 @@ bool AutoCheckpointsEnabled();
  */
 struct CheckpointData {
     MapCheckpoints mapCheckpoints;
+    MapAssumeUtxo mapAssumeUtxo;
     int64_t nTimeLastCheckpoint;
     int64_t nTransactionsLastCheckpoint;
     double fTransactionsPerDay;
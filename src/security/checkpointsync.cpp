@@ -0,0 +1,396 @@
+// Copyright (c) 2012-2013 The PPCoin developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file checkpointsync.cpp
+ * @brief Signed sync checkpoints: verification cache, acceptance and overlay
+ */
+
+#include "security/checkpointsync.h"
+
+#include "chain.h"
+#include "dbwrapper.h"
+#include "hash.h"
+#include "key.h"
+#include "streams.h"
+#include "util.h"
+#include "utilstrencodings.h"
+#include "validation.h"
+#include "version.h"
+
+#include <set>
+
+namespace PeerCoin {
+
+CSyncCheckpointManager g_syncCheckpoints;
+
+/** Block tree DB key of the current checkpoint message */
+static const std::string DB_SYNC_CHECKPOINT = "synccheckpoint";
+
+std::string CUnsignedSyncCheckpoint::ToString() const
+{
+    if (nVersion < SYNC_CHECKPOINT_VERSION_SNAPSHOT)
+        return strprintf("CSyncCheckpoint(nVersion=%d, nHeight=%d, hashCheckpoint=%s)",
+                         nVersion, nHeight, hashCheckpoint.ToString());
+    return strprintf("CSyncCheckpoint(nVersion=%d, nHeight=%d, hashCheckpoint=%s, hashSnapshotCoins=%s, nSnapshotCoins=%u, "
+                     "hashSnapshotState=%s)",
+                     nVersion, nHeight, hashCheckpoint.ToString(), hashSnapshotCoins.ToString(), nSnapshotCoins,
+                     hashSnapshotState.ToString());
+}
+
+uint256 CSyncCheckpoint::GetHash() const
+{
+    return Hash(vchMsg.begin(), vchMsg.end());
+}
+
+bool CSyncCheckpoint::Sign(const CKey& keyMaster)
+{
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << static_cast<const CUnsignedSyncCheckpoint&>(*this);
+    vchMsg.assign(ss.begin(), ss.end());
+    vHubSigs.clear();
+    return keyMaster.Sign(GetHash(), vchSig);
+}
+
+bool CSyncCheckpoint::AddHubSignature(const CKey& keyHub, uint32_t nHub)
+{
+    std::vector<unsigned char> vchHubSig;
+    if (!keyHub.Sign(GetHash(), vchHubSig))
+        return false;
+    vHubSigs.emplace_back(nHub, vchHubSig);
+    return true;
+}
+
+bool CSyncCheckpoint::Unpack()
+{
+    try {
+        CDataStream ss(vchMsg, SER_NETWORK, PROTOCOL_VERSION);
+        ss >> static_cast<CUnsignedSyncCheckpoint&>(*this);
+        return ss.empty();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+CSyncCheckpointManager::CSyncCheckpointManager(size_t nMaxCacheIn)
+    : nMaxCache(nMaxCacheIn), nHubSigsRequired(0), fAssumeValid(DEFAULT_ASSUME_VALID_SYNC), pdb(nullptr),
+      pindexCurrent(nullptr)
+{
+}
+
+void CSyncCheckpointManager::SetKeys(const CPubKey& pubkeyMasterIn, const std::vector<CPubKey>& vHubKeysIn,
+                                     unsigned int nHubSigsRequiredIn)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    pubkeyMaster = pubkeyMasterIn;
+    vHubKeys = vHubKeysIn;
+    nHubSigsRequired = nHubSigsRequiredIn;
+
+    mapVerified.clear();
+    vVerifiedOrder.clear();
+    checkpointCurrent.SetNull();
+    pindexCurrent = nullptr;
+    checkpointPending.SetNull();
+    mapAccepted.clear();
+    mapAssumeUtxo.clear();
+    stats = CSyncCheckpointStats();
+}
+
+void CSyncCheckpointManager::SetAssumeValid(bool fAssumeValidIn)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    fAssumeValid = fAssumeValidIn;
+}
+
+void CSyncCheckpointManager::SetDB(CDBWrapper* pdbIn)
+{
+    std::lock_guard<std::mutex> lock(cs);
+    pdb = pdbIn;
+}
+
+bool CSyncCheckpointManager::LoadCheckpoint()
+{
+    CDBWrapper* pdbLoad;
+    {
+        std::lock_guard<std::mutex> lock(cs);
+        pdbLoad = pdb;
+    }
+    if (!pdbLoad || !IsEnabled())
+        return true;
+
+    CSyncCheckpoint checkpoint;
+    try {
+        if (!pdbLoad->Read(DB_SYNC_CHECKPOINT, checkpoint))
+            return true;
+    } catch (const std::exception& e) {
+        return error("%s: Deserialize or I/O error - %s", __func__, e.what());
+    }
+
+    CValidationState state;
+    const SyncCheckpointResult result = ProcessSyncCheckpoint(checkpoint, state);
+    if (result == SYNC_CHECKPOINT_INVALID || result == SYNC_CHECKPOINT_IGNORED)
+        LogPrintf("LoadCheckpoint: dropping the stored sync checkpoint (%s)\n",
+                  result == SYNC_CHECKPOINT_INVALID ? FormatStateMessage(state) : "not newer");
+    return true;
+}
+
+bool CSyncCheckpointManager::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return pubkeyMaster.IsFullyValid();
+}
+
+bool CSyncCheckpointManager::VerifySignatures(const CSyncCheckpoint& checkpoint) const
+{
+    const uint256 hash = checkpoint.GetHash();
+    if (!pubkeyMaster.Verify(hash, checkpoint.vchSig))
+        return false;
+
+    // Only a message the master signed is worth the hub checks
+    std::set<uint32_t> setHubs;
+    for (const CHubSignature& hubSig : checkpoint.vHubSigs) {
+        if (hubSig.nHub >= vHubKeys.size() || !setHubs.insert(hubSig.nHub).second)
+            return false;
+        if (!vHubKeys[hubSig.nHub].Verify(hash, hubSig.vchSig))
+            return false;
+    }
+    return setHubs.size() >= nHubSigsRequired;
+}
+
+bool CSyncCheckpointManager::CheckSignatures(const CSyncCheckpoint& checkpoint)
+{
+    // Keyed by the whole message: the same checkpoint with other hub signatures is checked anew
+    const uint256 hashMessage = SerializeHash(checkpoint);
+    std::lock_guard<std::mutex> lock(cs);
+    std::map<uint256, bool>::const_iterator it = mapVerified.find(hashMessage);
+    if (it != mapVerified.end()) {
+        stats.nCacheHits++;
+        return it->second;
+    }
+
+    const bool fValid = VerifySignatures(checkpoint);
+    stats.nVerified++;
+    if (nMaxCache == 0)
+        return fValid;
+    while (mapVerified.size() >= nMaxCache) {
+        mapVerified.erase(vVerifiedOrder.front());
+        vVerifiedOrder.pop_front();
+    }
+    mapVerified.emplace(hashMessage, fValid);
+    vVerifiedOrder.push_back(hashMessage);
+    return fValid;
+}
+
+SyncCheckpointResult CSyncCheckpointManager::ProcessSyncCheckpoint(const CSyncCheckpoint& checkpointIn,
+                                                                   CValidationState& state)
+{
+    if (!IsEnabled())
+        return SYNC_CHECKPOINT_IGNORED;
+
+    CSyncCheckpoint checkpoint(checkpointIn);
+    if (checkpoint.vchSig.size() > MAX_SYNC_CHECKPOINT_SIG_SIZE ||
+        checkpoint.vHubSigs.size() > MAX_SYNC_CHECKPOINT_HUB_SIGS) {
+        state.DoS(100, false, REJECT_INVALID, "bad-checkpoint-size");
+        return SYNC_CHECKPOINT_INVALID;
+    }
+    if (!checkpoint.Unpack() || checkpoint.nHeight < 0 || checkpoint.hashCheckpoint.IsNull()) {
+        state.DoS(100, false, REJECT_INVALID, "bad-checkpoint-msg");
+        return SYNC_CHECKPOINT_INVALID;
+    }
+    if (!CheckSignatures(checkpoint)) {
+        std::lock_guard<std::mutex> lock(cs);
+        stats.nRejected++;
+        state.DoS(100, false, REJECT_INVALID, "bad-checkpoint-sig");
+        return SYNC_CHECKPOINT_INVALID;
+    }
+
+    std::lock_guard<std::mutex> lock(cs);
+    if (checkpoint.nHeight <= checkpointCurrent.nHeight)
+        return SYNC_CHECKPOINT_IGNORED;
+
+    BlockMap::const_iterator mi = mapBlockIndex.find(checkpoint.hashCheckpoint);
+    if (mi == mapBlockIndex.end()) {
+        if (checkpoint.nHeight <= checkpointPending.nHeight)
+            return SYNC_CHECKPOINT_IGNORED;
+        LogPrint("checkpoint", "ProcessSyncCheckpoint: pending for block %s at height %d\n",
+                 checkpoint.hashCheckpoint.ToString(), checkpoint.nHeight);
+        checkpointPending = checkpoint;
+        return SYNC_CHECKPOINT_PENDING;
+    }
+    return Accept(checkpoint, mi->second, state);
+}
+
+bool CSyncCheckpointManager::AcceptPendingSyncCheckpoint()
+{
+    std::lock_guard<std::mutex> lock(cs);
+    if (checkpointPending.IsNull())
+        return false;
+    BlockMap::const_iterator mi = mapBlockIndex.find(checkpointPending.hashCheckpoint);
+    if (mi == mapBlockIndex.end())
+        return false;
+
+    const CSyncCheckpoint checkpoint(checkpointPending);
+    checkpointPending.SetNull();
+    if (checkpoint.nHeight <= checkpointCurrent.nHeight)
+        return false;
+    CValidationState state;
+    return Accept(checkpoint, mi->second, state) == SYNC_CHECKPOINT_ACCEPTED;
+}
+
+SyncCheckpointResult CSyncCheckpointManager::Accept(const CSyncCheckpoint& checkpoint, const CBlockIndex* pindex,
+                                                    CValidationState& state)
+{
+    // Properly signed, so the sender relayed it in good faith: refuse it without a DoS score
+    if (pindex->nHeight != checkpoint.nHeight) {
+        stats.nRejected++;
+        state.Invalid(error("%s: %s is at height %d", __func__, checkpoint.ToString(), pindex->nHeight),
+                      REJECT_INVALID, "checkpoint-height-mismatch");
+        return SYNC_CHECKPOINT_INVALID;
+    }
+    if (pindexCurrent && pindex->GetAncestor(pindexCurrent->nHeight) != pindexCurrent) {
+        stats.nRejected++;
+        state.Invalid(error("%s: %s conflicts with the checkpoint at height %d", __func__, checkpoint.ToString(),
+                            pindexCurrent->nHeight),
+                      REJECT_CHECKPOINT, "checkpoint-conflict");
+        return SYNC_CHECKPOINT_INVALID;
+    }
+
+    checkpointCurrent = checkpoint;
+    pindexCurrent = pindex;
+    mapAccepted[checkpoint.nHeight] = checkpoint.hashCheckpoint;
+    if (!checkpoint.hashSnapshotCoins.IsNull())
+        mapAssumeUtxo[checkpoint.nHeight] = Checkpoints::CAssumeUtxoData(checkpoint.hashSnapshotCoins, checkpoint.nSnapshotCoins,
+                                                                         checkpoint.hashSnapshotState);
+    if (checkpointPending.nHeight <= checkpoint.nHeight)
+        checkpointPending.SetNull();
+    if (pdb && !pdb->Write(DB_SYNC_CHECKPOINT, checkpoint, true))
+        error("%s: failed to write %s to the block tree DB", __func__, checkpoint.ToString());
+    stats.nAccepted++;
+    LogPrintf("ProcessSyncCheckpoint: sync checkpoint at height %d %s\n", checkpoint.nHeight,
+              checkpoint.hashCheckpoint.ToString());
+    return SYNC_CHECKPOINT_ACCEPTED;
+}
+
+bool CSyncCheckpointManager::CheckHardened(int nHeight, const uint256& hash) const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    if (!pindexCurrent || nHeight > pindexCurrent->nHeight)
+        return true;
+    const CBlockIndex* pindex = pindexCurrent->GetAncestor(nHeight);
+    return pindex && pindex->GetBlockHash() == hash;
+}
+
+int CSyncCheckpointManager::GetHeight() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return checkpointCurrent.nHeight;
+}
+
+uint256 CSyncCheckpointManager::GetCheckpointHash(int nHeight) const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    std::map<int, uint256>::const_iterator it = mapAccepted.find(nHeight);
+    return it == mapAccepted.end() ? uint256() : it->second;
+}
+
+bool CSyncCheckpointManager::GetAssumeUtxo(int nHeight, Checkpoints::CAssumeUtxoData& data) const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    Checkpoints::MapAssumeUtxo::const_iterator it = mapAssumeUtxo.find(nHeight);
+    if (it == mapAssumeUtxo.end())
+        return false;
+    data = it->second;
+    return true;
+}
+
+bool CSyncCheckpointManager::IsAssumedValid(const CBlockIndex* pindex) const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    if (!fAssumeValid || !pindexCurrent || pindex->nHeight > pindexCurrent->nHeight)
+        return false;
+    return pindexCurrent->GetAncestor(pindex->nHeight) == pindex;
+}
+
+CSyncCheckpoint CSyncCheckpointManager::GetCheckpoint() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return checkpointCurrent;
+}
+
+uint256 CSyncCheckpointManager::GetPendingHash() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return checkpointPending.hashCheckpoint;
+}
+
+CSyncCheckpointStats CSyncCheckpointManager::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(cs);
+    return stats;
+}
+
+static bool ParsePubKey(const std::string& strHex, CPubKey& pubkey)
+{
+    if (!IsHex(strHex))
+        return false;
+    pubkey = CPubKey(ParseHex(strHex));
+    return pubkey.IsFullyValid();
+}
+
+bool InitSyncCheckpoints(CDBWrapper* pdb, std::string& strError)
+{
+    g_syncCheckpoints.SetDB(pdb);
+    g_syncCheckpoints.SetAssumeValid(GetBoolArg("-assumevalidsync", DEFAULT_ASSUME_VALID_SYNC));
+
+    const std::string strMaster = GetArg("-checkpointpubkey", "");
+    if (!GetBoolArg("-synccheckpoints", DEFAULT_SYNC_CHECKPOINTS) || strMaster.empty()) {
+        g_syncCheckpoints.SetKeys(CPubKey(), std::vector<CPubKey>(), 0);
+        LogPrintf("Sync checkpoints disabled\n");
+        return true;
+    }
+
+    CPubKey pubkeyMaster;
+    if (!ParsePubKey(strMaster, pubkeyMaster)) {
+        strError = strprintf("Invalid -checkpointpubkey: '%s'", strMaster);
+        return false;
+    }
+
+    // Comma-separated, in the order hub signatures index them
+    std::vector<CPubKey> vHubKeys;
+    const std::string strHubs = GetArg("-checkpointhubkeys", "");
+    for (size_t nStart = 0; nStart < strHubs.size();) {
+        size_t nEnd = strHubs.find(',', nStart);
+        if (nEnd == std::string::npos)
+            nEnd = strHubs.size();
+        const std::string strHub = strHubs.substr(nStart, nEnd - nStart);
+        CPubKey pubkeyHub;
+        if (!ParsePubKey(strHub, pubkeyHub)) {
+            strError = strprintf("Invalid key in -checkpointhubkeys: '%s'", strHub);
+            return false;
+        }
+        vHubKeys.push_back(pubkeyHub);
+        nStart = nEnd + 1;
+    }
+
+    const int64_t nHubSigs = GetArg("-checkpointhubsigs", (int64_t)vHubKeys.size());
+    if (nHubSigs < 0 || nHubSigs > (int64_t)vHubKeys.size()) {
+        strError = strprintf("-checkpointhubsigs must be between 0 and the %u hub keys", vHubKeys.size());
+        return false;
+    }
+
+    g_syncCheckpoints.SetKeys(pubkeyMaster, vHubKeys, (unsigned int)nHubSigs);
+    LogPrintf("Sync checkpoints enabled, %d of %u hub co-signatures required\n", nHubSigs, vHubKeys.size());
+
+    LOCK(cs_main);
+    if (!g_syncCheckpoints.LoadCheckpoint()) {
+        strError = "Error reading the sync checkpoint from the block tree database";
+        return false;
+    }
+    if (g_syncCheckpoints.GetHeight() >= 0)
+        LogPrintf("Loaded sync checkpoint at height %d\n", g_syncCheckpoints.GetHeight());
+    return true;
+}
+
+} // namespace PeerCoin
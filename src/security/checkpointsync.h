@@ -0,0 +1,325 @@
+// Copyright (c) 2012-2013 The PPCoin developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_SECURITY_CHECKPOINTSYNC_H
+#define AFRICOIN_SECURITY_CHECKPOINTSYNC_H
+
+#include "pubkey.h"
+#include "security/checkpoints.h"
+#include "serialize.h"
+#include "uint256.h"
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class CBlockIndex;
+class CDBWrapper;
+class CKey;
+class CValidationState;
+
+/**
+ * @file checkpointsync.h
+ * @brief PeerCoin-style signed sync checkpoints relayed over P2P
+ *
+ * A sync checkpoint is a (height, block hash) pair signed by the checkpoint
+ * master key and, where the network requires it, co-signed by a threshold
+ * of railway hub keys. Nodes relay the newest checkpoint they accepted.
+ * Each distinct message is verified once and the result cached, so a
+ * checkpoint arriving from every peer costs one set of ECDSA checks.
+ *
+ * Accepted checkpoints overlay the static maps of checkpoints.cpp through
+ * Checkpoints::CheckHardened, and blocks on the chain up to the current
+ * one are connected without script checks (assume-valid). A new node thus
+ * syncs fast up to a recent height instead of to the last checkpoint a
+ * software release happened to ship. The current checkpoint is kept in
+ * the block tree DB, so a restarted node resumes from it.
+ *
+ * From SYNC_CHECKPOINT_VERSION_SNAPSHOT a checkpoint may also commit to
+ * the coins hash and count and the state hash of a chainstate snapshot
+ * of its block (storage/snapshot.h), which is what lets a node trust a
+ * snapshot file it was handed by a peer.
+ */
+
+namespace PeerCoin {
+
+static const int SYNC_CHECKPOINT_VERSION = 1;
+/** First version carrying a snapshot commitment */
+static const int SYNC_CHECKPOINT_VERSION_SNAPSHOT = 2;
+/** Default for -synccheckpoints */
+static const bool DEFAULT_SYNC_CHECKPOINTS = true;
+/** Default for -assumevalidsync */
+static const bool DEFAULT_ASSUME_VALID_SYNC = true;
+/** Hub co-signatures one checkpoint may carry */
+static const unsigned int MAX_SYNC_CHECKPOINT_HUB_SIGS = 32;
+/** A DER-encoded ECDSA signature is at most 72 bytes */
+static const unsigned int MAX_SYNC_CHECKPOINT_SIG_SIZE = 72;
+/** Verification results remembered, by message */
+static const size_t DEFAULT_SYNC_CHECKPOINT_CACHE = 1024;
+
+/**
+ * @class CUnsignedSyncCheckpoint
+ * @brief The signed part of a sync checkpoint
+ */
+class CUnsignedSyncCheckpoint {
+public:
+    int nVersion;
+    int nHeight;
+    uint256 hashCheckpoint;      //!< Block the chain must contain at nHeight
+    uint256 hashSnapshotCoins;   //!< GetSnapshotCoinsHash of the chainstate at the block, null if none
+    uint64_t nSnapshotCoins;     //!< Coins in that chainstate
+    uint256 hashSnapshotState;   //!< State section hash of the snapshot file
+
+    CUnsignedSyncCheckpoint() { SetNull(); }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action)
+    {
+        READWRITE(this->nVersion);
+        READWRITE(nHeight);
+        READWRITE(hashCheckpoint);
+        if (this->nVersion >= SYNC_CHECKPOINT_VERSION_SNAPSHOT) {
+            READWRITE(hashSnapshotCoins);
+            READWRITE(nSnapshotCoins);
+            READWRITE(hashSnapshotState);
+        }
+    }
+
+    void SetNull()
+    {
+        nVersion = SYNC_CHECKPOINT_VERSION;
+        nHeight = -1;
+        hashCheckpoint.SetNull();
+        hashSnapshotCoins.SetNull();
+        nSnapshotCoins = 0;
+        hashSnapshotState.SetNull();
+    }
+
+    std::string ToString() const;
+};
+
+/**
+ * @class CHubSignature
+ * @brief A railway hub's co-signature of a checkpoint
+ */
+class CHubSignature {
+public:
+    uint32_t nHub;               //!< Index into the configured hub keys
+    std::vector<unsigned char> vchSig;
+
+    CHubSignature() : nHub(0) {}
+    CHubSignature(uint32_t nHubIn, const std::vector<unsigned char>& vchSigIn) : nHub(nHubIn), vchSig(vchSigIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action)
+    {
+        READWRITE(nHub);
+        READWRITE(vchSig);
+    }
+};
+
+/**
+ * @class CSyncCheckpoint
+ * @brief The checkpoint message: the serialized checkpoint and its signatures
+ *
+ * The master and every hub sign Hash(vchMsg). Hub signatures are not
+ * covered by the master signature, so a hub can co-sign a checkpoint that
+ * is already being relayed.
+ */
+class CSyncCheckpoint : public CUnsignedSyncCheckpoint {
+public:
+    std::vector<unsigned char> vchMsg;
+    std::vector<unsigned char> vchSig;
+    std::vector<CHubSignature> vHubSigs;
+
+    CSyncCheckpoint() { SetNull(); }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action)
+    {
+        READWRITE(vchMsg);
+        READWRITE(vchSig);
+        READWRITE(vHubSigs);
+    }
+
+    void SetNull()
+    {
+        CUnsignedSyncCheckpoint::SetNull();
+        vchMsg.clear();
+        vchSig.clear();
+        vHubSigs.clear();
+    }
+
+    bool IsNull() const { return hashCheckpoint.IsNull(); }
+
+    /** @brief What the master and the hubs sign */
+    uint256 GetHash() const;
+
+    /** @brief Serialize the unsigned fields into vchMsg and sign it with the master key */
+    bool Sign(const CKey& keyMaster);
+
+    /** @brief Append the co-signature of hub nHub */
+    bool AddHubSignature(const CKey& keyHub, uint32_t nHub);
+
+    /** @brief Fill the unsigned fields from vchMsg; false if it does not parse */
+    bool Unpack();
+};
+
+/** Outcome of ProcessSyncCheckpoint */
+enum SyncCheckpointResult {
+    SYNC_CHECKPOINT_ACCEPTED,    //!< New current checkpoint: relay it
+    SYNC_CHECKPOINT_PENDING,     //!< Signed, but its block is unknown: request the block
+    SYNC_CHECKPOINT_IGNORED,     //!< Disabled, or not newer than the current checkpoint
+    SYNC_CHECKPOINT_INVALID,     //!< See the validation state
+};
+
+/** Counters for getcheckpoint and the tests */
+struct CSyncCheckpointStats {
+    uint64_t nVerified;          //!< Messages whose signatures were checked
+    uint64_t nCacheHits;         //!< Messages answered from the verification cache
+    uint64_t nAccepted;
+    uint64_t nRejected;
+
+    CSyncCheckpointStats() : nVerified(0), nCacheHits(0), nAccepted(0), nRejected(0) {}
+};
+
+/**
+ * @class CSyncCheckpointManager
+ * @brief The current sync checkpoint, its signers and the overlay it feeds
+ *
+ * ProcessSyncCheckpoint and AcceptPendingSyncCheckpoint look blocks up in
+ * mapBlockIndex, so cs_main must be held around them. Every checkpoint
+ * accepted descends from the previous one; a conflicting one means the
+ * signers disagree with themselves and is refused.
+ */
+class CSyncCheckpointManager {
+public:
+    explicit CSyncCheckpointManager(size_t nMaxCacheIn = DEFAULT_SYNC_CHECKPOINT_CACHE);
+
+    CSyncCheckpointManager(const CSyncCheckpointManager&) = delete;
+    CSyncCheckpointManager& operator=(const CSyncCheckpointManager&) = delete;
+
+    /**
+     * @brief Keys allowed to sign, forgetting all checkpoints and cached results
+     * @param nHubSigsRequiredIn Distinct hub co-signatures a checkpoint needs
+     *                           besides the master's; 0 for master only
+     *
+     * An invalid master key disables sync checkpoints.
+     */
+    void SetKeys(const CPubKey& pubkeyMasterIn, const std::vector<CPubKey>& vHubKeysIn, unsigned int nHubSigsRequiredIn);
+
+    void SetAssumeValid(bool fAssumeValidIn);
+
+    /**
+     * @brief Database the current checkpoint is kept in, nullptr for none
+     *
+     * The node passes its block tree DB. Every accepted checkpoint is
+     * written to it, replacing the previous one, like PeerCoin's
+     * WriteSyncCheckpoint.
+     */
+    void SetDB(CDBWrapper* pdbIn);
+
+    /**
+     * @brief Accept the checkpoint kept in the database again (cs_main held)
+     *
+     * Its signatures are checked against the configured keys, so one made
+     * with keys no longer configured is dropped. Only the current
+     * checkpoint is kept; earlier ones are still enforced as its ancestors
+     * but GetCheckpointHash no longer knows their heights.
+     * @return false on a database error
+     */
+    bool LoadCheckpoint();
+
+    bool IsEnabled() const;
+
+    /** @brief Master, then hub signatures; each distinct message is verified once */
+    bool CheckSignatures(const CSyncCheckpoint& checkpoint);
+
+    /** @brief Handle a checkpoint message from a peer (cs_main held) */
+    SyncCheckpointResult ProcessSyncCheckpoint(const CSyncCheckpoint& checkpoint, CValidationState& state);
+
+    /** @brief Accept the pending checkpoint if its block is now indexed (cs_main held) */
+    bool AcceptPendingSyncCheckpoint();
+
+    /**
+     * @brief false if hash is not the current checkpoint's block or
+     * ancestor at nHeight; true above the checkpoint or when disabled
+     */
+    bool CheckHardened(int nHeight, const uint256& hash) const;
+
+    /** @brief Height of the current checkpoint, -1 if none */
+    int GetHeight() const;
+
+    /** @brief Block of an accepted checkpoint at nHeight, null if none */
+    uint256 GetCheckpointHash(int nHeight) const;
+
+    /**
+     * @brief Snapshot commitment of an accepted checkpoint at nHeight
+     * @return false if there is none
+     */
+    bool GetAssumeUtxo(int nHeight, Checkpoints::CAssumeUtxoData& data) const;
+
+    /** @brief Script checks may be skipped: pindex is on the chain up to the current checkpoint */
+    bool IsAssumedValid(const CBlockIndex* pindex) const;
+
+    /** @brief The current checkpoint, relayed to peers as they connect */
+    CSyncCheckpoint GetCheckpoint() const;
+
+    /** @brief Block wanted by the pending checkpoint, null if none */
+    uint256 GetPendingHash() const;
+
+    CSyncCheckpointStats GetStats() const;
+
+private:
+    /** Caller holds cs */
+    SyncCheckpointResult Accept(const CSyncCheckpoint& checkpoint, const CBlockIndex* pindex, CValidationState& state);
+    bool VerifySignatures(const CSyncCheckpoint& checkpoint) const;
+
+    const size_t nMaxCache;
+
+    mutable std::mutex cs;
+    CPubKey pubkeyMaster;
+    std::vector<CPubKey> vHubKeys;
+    unsigned int nHubSigsRequired;
+    bool fAssumeValid;
+    CDBWrapper* pdb;                         //!< Where the current checkpoint is kept (not owned)
+
+    std::map<uint256, bool> mapVerified;     //!< Result by message hash
+    std::deque<uint256> vVerifiedOrder;      //!< Insertion order, for eviction
+
+    CSyncCheckpoint checkpointCurrent;
+    const CBlockIndex* pindexCurrent;
+    CSyncCheckpoint checkpointPending;
+    std::map<int, uint256> mapAccepted;      //!< Every checkpoint accepted, by height
+    Checkpoints::MapAssumeUtxo mapAssumeUtxo; //!< Their snapshot commitments, by height
+
+    CSyncCheckpointStats stats;
+};
+
+/** Sync checkpoints of the running node */
+extern CSyncCheckpointManager g_syncCheckpoints;
+
+/**
+ * @brief Configure g_syncCheckpoints from -checkpointpubkey,
+ * -checkpointhubkeys, -checkpointhubsigs, -synccheckpoints and -assumevalidsync
+ *
+ * AppInitMain calls this once the block index is loaded, passing the
+ * block tree DB, and fails startup with strError if it returns false.
+ * The checkpoint kept in the DB is accepted again (LoadCheckpoint).
+ */
+bool InitSyncCheckpoints(CDBWrapper* pdb, std::string& strError);
+
+} // namespace PeerCoin
+
+#endif // AFRICOIN_SECURITY_CHECKPOINTSYNC_H
@@ -30,6 +30,16 @@
 
 #include "kernel.h"
 
+#include "arith_uint256.h"
+#include "chain.h"
+#include "crypto/common.h"
+#include "crypto/sha256_dispatch.h"
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+#include "primitives/transaction.h"
+#include "storage/blockstore.h"
+#include "util.h"
+
 // TODO: Include actual Africoin headers when integrated
 // #include "chain.h"
 // #include "chainparams.h"
@@ -45,6 +55,9 @@
 
 namespace PeerCoin {
 
+METRIC_HISTOGRAM(histCheckProofOfStake, "africoin_kernel_check_pos_seconds",
+                 "Time spent verifying coinstake kernels (Kernel::CheckProofOfStake)");
+
 /**
  * CheckProofOfStake - Verify proof-of-stake for a coinstake transaction
  * 
@@ -62,6 +75,9 @@ namespace PeerCoin {
  */
 bool Kernel::CheckProofOfStake(const CTransaction& tx, unsigned int nBits, 
                                uint256& hashProofOfStake, uint256& targetProofOfStake) {
+    METRIC_SCOPED_TIMER(histCheckProofOfStake);
+    TRACE_SPAN("CheckProofOfStake", "kernel");
+
     // TODO: Implement PeerCoin's CheckProofOfStake()
     // 
     // Pseudocode from PeerCoin implementation:
@@ -197,6 +213,114 @@ bool Kernel::CheckStakeKernelHash(unsigned int nBits, const CBlock& blockFrom,
     return false; // Stub - not implemented
 }
 
+/**
+ * CheckStakeKernelHash - Kernel hash check against the block store
+ * 
+ * Everything the kernel needs from txPrev (its offset in the block, its
+ * nTime and the staked value) is parsed in place from the mapped blk file,
+ * and blockFrom's time comes from its index entry. Nothing is deserialized,
+ * which keeps this cheap enough for the staking loop and for validating
+ * PoS headers before their blocks arrive.
+ */
+bool Kernel::CheckStakeKernelHash(unsigned int nBits, const CBlockIndex* pindexFrom,
+                                  const CDiskTxPos& posTxPrev, const COutPoint& prevout,
+                                  unsigned int nTimeTx, uint256& hashProofOfStake,
+                                  bool fPrintProofOfStake) {
+    TRACE_SPAN("CheckStakeKernelHash", "kernel");
+    if (!Africoin::g_blockStore)
+        return error("%s: block store not open", __func__);
+
+    switch (CheckStakeKernel(nBits, pindexFrom, posTxPrev, prevout, nTimeTx, hashProofOfStake, fPrintProofOfStake)) {
+    case KERNEL_VALID:
+        return true;
+    case KERNEL_BAD_TXPREV:
+        return error("%s: read txPrev at %s failed", __func__, posTxPrev.ToString());
+    case KERNEL_BAD_BLOCKFROM:
+        return error("%s: txPrev at %s is not in blockFrom %s", __func__, posTxPrev.ToString(),
+                     pindexFrom->GetBlockHash().ToString());
+    case KERNEL_BAD_TIME:
+        return error("%s: nTime violation", __func__);
+    case KERNEL_BAD_MIN_AGE:
+        return error("%s: min age violation", __func__);
+    default:
+        return false;
+    }
+}
+
+/**
+ * CheckStakeKernel - The kernel checks, reporting which one failed
+ */
+KernelResult Kernel::CheckStakeKernel(unsigned int nBits, const CBlockIndex* pindexFrom,
+                                      const CDiskTxPos& posTxPrev, const COutPoint& prevout,
+                                      unsigned int nTimeTx, uint256& hashProofOfStake,
+                                      bool fPrintProofOfStake) {
+    // The offset and times below are blockFrom's only if txPrev is read from it
+    if (!(pindexFrom->nStatus & BLOCK_HAVE_DATA) || posTxPrev.nFile != pindexFrom->nFile ||
+        posTxPrev.nPos != pindexFrom->nDataPos)
+        return KERNEL_BAD_BLOCKFROM;
+
+    Africoin::CStakeTxPrev txPrev;
+    if (!Africoin::g_blockStore || !Africoin::g_blockStore->ReadStakeTxPrev(posTxPrev, prevout.n, txPrev))
+        return KERNEL_BAD_TXPREV;
+
+    if (nTimeTx < txPrev.nTime)
+        return KERNEL_BAD_TIME;
+    if (pindexFrom->GetBlockTime() + nStakeMinAge > nTimeTx)
+        return KERNEL_BAD_MIN_AGE;
+
+    uint64_t nStakeModifier = 0;
+    if (!GetKernelStakeModifier(pindexFrom->GetBlockHash(), nStakeModifier))
+        return KERNEL_NO_MODIFIER;
+
+    hashProofOfStake = ComputeKernelHash(nStakeModifier, pindexFrom->nTime, txPrev.nTxOffset,
+                                         txPrev.nTime, prevout.n, nTimeTx);
+
+    if (fPrintProofOfStake)
+        LogPrintf("%s: modifier=0x%016x nTimeBlockFrom=%u nTxPrevOffset=%u nTimeTxPrev=%u nPrevout=%u nTimeTx=%u hashProof=%s\n",
+                  __func__, nStakeModifier, pindexFrom->nTime, txPrev.nTxOffset, txPrev.nTime, prevout.n, nTimeTx,
+                  hashProofOfStake.ToString());
+
+    if (!CheckKernelHashTarget(hashProofOfStake, nBits, txPrev.nValue, txPrev.nTime, nTimeTx))
+        return KERNEL_BAD_TARGET;
+    return KERNEL_VALID;
+}
+
+/**
+ * ComputeKernelHash - Hash the kernel fields
+ * 
+ * Split out of CheckStakeKernelHash so the staking loop and benchmarks
+ * can hash kernels from data they already hold.
+ */
+uint256 Kernel::ComputeKernelHash(uint64_t nStakeModifier, unsigned int nTimeBlockFrom,
+                                  unsigned int nTxPrevOffset, unsigned int nTimeTxPrev,
+                                  unsigned int nPrevout, unsigned int nTimeTx) {
+    // The CHashWriter serialization of the six fields, hashed on the dispatched SHA-256
+    unsigned char vchKernel[8 + 5 * 4];
+    WriteLE64(vchKernel, nStakeModifier);
+    WriteLE32(vchKernel + 8, nTimeBlockFrom);
+    WriteLE32(vchKernel + 12, nTxPrevOffset);
+    WriteLE32(vchKernel + 16, nTimeTxPrev);
+    WriteLE32(vchKernel + 20, nPrevout);
+    WriteLE32(vchKernel + 24, nTimeTx);
+    return Africoin::SHA256d(vchKernel, sizeof(vchKernel));
+}
+
+/**
+ * CheckKernelHashTarget - Compare a kernel hash against its target
+ * 
+ * The target scales with coin-days: the staked value times the time
+ * weight (see GetWeight), in coins and days.
+ */
+bool Kernel::CheckKernelHashTarget(const uint256& hashProofOfStake, unsigned int nBits, int64_t nValueIn,
+                                   unsigned int nTimeTxPrev, unsigned int nTimeTx) {
+    arith_uint256 bnTargetPerCoinDay;
+    bnTargetPerCoinDay.SetCompact(nBits);
+    arith_uint256 bnCoinDayWeight = arith_uint256(nValueIn) * arith_uint256(GetWeight(nTimeTxPrev, nTimeTx))
+                                    / arith_uint256(COIN) / arith_uint256(24 * 60 * 60);
+
+    return UintToArith256(hashProofOfStake) <= bnCoinDayWeight * bnTargetPerCoinDay;
+}
+
 /**
  * GetWeight - Calculate time weight for stake
  * 
@@ -15,6 +15,7 @@ class CTransaction;
 class CBlockIndex;
 class CBlock;
 class COutPoint;
+struct CDiskTxPos;
 
 /**
  * @file kernel.h
@@ -35,6 +36,17 @@ class COutPoint;
 
 namespace PeerCoin {
 
+/** Outcome of Kernel::CheckStakeKernel */
+enum KernelResult {
+    KERNEL_VALID = 0,   //!< Kernel hash meets the target
+    KERNEL_BAD_TXPREV,  //!< txPrev or its output could not be read at posTxPrev
+    KERNEL_BAD_BLOCKFROM, //!< posTxPrev is not in blockFrom's stored data
+    KERNEL_BAD_TIME,    //!< Coinstake is older than txPrev
+    KERNEL_BAD_MIN_AGE, //!< blockFrom is younger than nStakeMinAge
+    KERNEL_NO_MODIFIER, //!< Stake modifier of blockFrom is not known
+    KERNEL_BAD_TARGET,  //!< Kernel hash is above the target
+};
+
 /**
  * @class Kernel
  * @brief PeerCoin's kernel protocol for proof-of-stake validation
@@ -105,6 +117,70 @@ public:
                                      const COutPoint& prevout, unsigned int nTimeTx,
                                      uint256& hashProofOfStake, bool fPrintProofOfStake = false);
 
+    /**
+     * @brief Check the stake kernel hash reading txPrev from the block store
+     * 
+     * Same check as above, but nTxPrevOffset, txPrev.nTime and the staked
+     * output value are read directly from the memory-mapped block file at
+     * posTxPrev, so neither blockFrom nor txPrev has to be deserialized.
+     * posTxPrev must lie in blockFrom's data as pindexFrom records it: the
+     * block store indexes one copy of a txid, and the kernel is only
+     * defined for the copy in blockFrom.
+     * 
+     * @param nBits Target difficulty bits
+     * @param pindexFrom Index entry of the block containing the stake input
+     * @param posTxPrev Disk position of the previous transaction
+     * @param prevout Output point of the stake
+     * @param nTimeTx Timestamp of the transaction
+     * @param hashProofOfStake Output: computed proof-of-stake hash
+     * @param fPrintProofOfStake Whether to print debug information
+     * @return true if the kernel hash meets the target
+     */
+    static bool CheckStakeKernelHash(unsigned int nBits, const CBlockIndex* pindexFrom,
+                                     const CDiskTxPos& posTxPrev, const COutPoint& prevout,
+                                     unsigned int nTimeTx, uint256& hashProofOfStake,
+                                     bool fPrintProofOfStake = false);
+
+    /**
+     * @brief Check the stake kernel from the block store, saying why it failed
+     * 
+     * The checks behind CheckStakeKernelHash(), without logging, for
+     * callers that treat the failures differently (a stake header from a
+     * peer is deferred when the modifier is unknown but rejected when the
+     * hash misses the target).
+     * 
+     * @return KERNEL_VALID, or the first check that failed
+     */
+    static KernelResult CheckStakeKernel(unsigned int nBits, const CBlockIndex* pindexFrom,
+                                         const CDiskTxPos& posTxPrev, const COutPoint& prevout,
+                                         unsigned int nTimeTx, uint256& hashProofOfStake,
+                                         bool fPrintProofOfStake = false);
+
+    /**
+     * @brief Hash the kernel fields into the proof-of-stake hash
+     * 
+     * Serializes nStakeModifier, nTimeBlockFrom, nTxPrevOffset,
+     * nTimeTxPrev, nPrevout and nTimeTx and double-SHA256s them.
+     * 
+     * @return The proof-of-stake hash of the kernel
+     */
+    static uint256 ComputeKernelHash(uint64_t nStakeModifier, unsigned int nTimeBlockFrom,
+                                     unsigned int nTxPrevOffset, unsigned int nTimeTxPrev,
+                                     unsigned int nPrevout, unsigned int nTimeTx);
+
+    /**
+     * @brief Compare a kernel hash against the coin-day weighted target
+     * 
+     * @param hashProofOfStake Kernel hash from ComputeKernelHash()
+     * @param nBits Target difficulty bits (per coin-day)
+     * @param nValueIn Value of the staked output
+     * @param nTimeTxPrev Timestamp of the staked transaction
+     * @param nTimeTx Timestamp of the coinstake
+     * @return true if the hash meets the target
+     */
+    static bool CheckKernelHashTarget(const uint256& hashProofOfStake, unsigned int nBits, int64_t nValueIn,
+                                      unsigned int nTimeTxPrev, unsigned int nTimeTx);
+
     /**
      * @brief Compute the time weight for stake age
      * 
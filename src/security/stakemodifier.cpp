@@ -34,21 +34,42 @@
  */
 
 #include "stakemodifier.h"
+#include "kernel.h"
+
+#include "arith_uint256.h"
+#include "chainparams.h"
+#include "chainparamsbase.h"
+#include "consensus/blockforest.h"
+#include "crypto/common.h"
+#include "crypto/sha256_dispatch.h"
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
+#include "uint256.h"
+#include "util.h"
 
 // TODO: Include actual Africoin headers when integrated
 // #include "chain.h"
-// #include "chainparams.h"
 // #include "hash.h"
 // #include "primitives/block.h"
 // #include "streams.h"
 // #include "uint256.h"
 // #include "util.h"
 
+#include <string.h>
+#include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 
+using Africoin::BlockRef;
+using Africoin::CBlockForest;
+using Africoin::NULL_BLOCK_REF;
+
 namespace PeerCoin {
 
+METRIC_HISTOGRAM(histComputeNextStakeModifier, "africoin_stake_modifier_compute_seconds",
+                 "Time spent computing stake modifiers (StakeModifier::ComputeNextStakeModifier)");
+
 /**
  * Stake modifier checkpoints for Africoin
  * 
@@ -61,6 +82,41 @@ namespace PeerCoin {
  */
 static std::map<int, unsigned int> mapStakeModifierCheckpoints;
 
+/**
+ * Per-network stake modifier parameters
+ * 
+ * Testnet switches to v0.4 two months ahead of mainnet. Regtest switches
+ * after the generated test chains end (they start at 1500000000) but
+ * before any chain mined today, so new regtest chains use v0.4 and
+ * boundary tests can place blocks on either side with explicit times.
+ */
+static const StakeModifierParams paramsMainnet = {
+    1798761600, // nV04SwitchTime: 2027-01-01 00:00:00 UTC
+};
+
+static const StakeModifierParams paramsTestnet = {
+    1793491200, // nV04SwitchTime: 2026-11-01 00:00:00 UTC
+};
+
+static const StakeModifierParams paramsRegtest = {
+    1600000000, // nV04SwitchTime: 2020-09-13 12:26:40 UTC
+};
+
+const StakeModifierParams& GetStakeModifierParams(const std::string& strNetwork)
+{
+    if (strNetwork == CBaseChainParams::MAIN)
+        return paramsMainnet;
+    else if (strNetwork == CBaseChainParams::TESTNET)
+        return paramsTestnet;
+    else
+        return paramsRegtest;
+}
+
+const StakeModifierParams& GetStakeModifierParams()
+{
+    return GetStakeModifierParams(Params().NetworkIDString());
+}
+
 /**
  * ComputeNextStakeModifier - Calculate stake modifier for new block
  * 
@@ -75,6 +131,12 @@ static std::map<int, unsigned int> mapStakeModifierCheckpoints;
 bool StakeModifier::ComputeNextStakeModifier(const CBlockIndex* pindexPrev, 
                                               uint64_t& nStakeModifier, 
                                               bool& fGeneratedStakeModifier) {
+    // v0.3 only: the v0.4 modifier needs the new block's time and kernel
+    // hash, which pindexPrev does not carry (see the forest overload)
+
+    METRIC_SCOPED_TIMER(histComputeNextStakeModifier);
+    TRACE_SPAN("ComputeNextStakeModifier", "modifier");
+
     // TODO: Implement PeerCoin's ComputeNextStakeModifier()
     //
     // Pseudocode from PeerCoin implementation:
@@ -150,6 +212,137 @@ bool StakeModifier::ComputeNextStakeModifier(const CBlockIndex* pindexPrev,
     return false; // Stub - not implemented
 }
 
+/** Hash a block contributes to modifier selection and to the v0.4 modifier */
+static uint256 GetForestKernelHash(const CBlockForest& forest, BlockRef ref)
+{
+    return forest.Hot(ref).IsProofOfStake() ? forest.Cold(ref).hashProof : forest.GetBlockHash(ref);
+}
+
+/** Hash of (hash, nStakeModifierPrev) as CHashWriter serializes them, on the dispatched SHA-256 */
+static uint256 HashWithModifier(const uint256& hash, uint64_t nStakeModifierPrev)
+{
+    unsigned char vch[32 + 8];
+    memcpy(vch, hash.begin(), 32);
+    WriteLE64(vch + 32, nStakeModifierPrev);
+    return Africoin::SHA256d(vch, sizeof(vch));
+}
+
+/**
+ * One v0.3 selection round: among the candidates not selected yet, the
+ * one up to nSelectionIntervalStop with the lowest selection hash. PoS
+ * selection hashes are divided by 2^32 so PoS blocks are preferred.
+ * Candidates are sorted by timestamp; the first one is always eligible.
+ */
+static bool SelectForestBlockFromCandidates(const CBlockForest& forest,
+                                            const std::vector<std::pair<uint32_t, BlockRef>>& vSortedByTimestamp,
+                                            const std::vector<bool>& vSelected, int64_t nSelectionIntervalStop,
+                                            uint64_t nStakeModifierPrev, size_t& nSelected)
+{
+    bool fSelected = false;
+    arith_uint256 hashBest = 0;
+    for (size_t i = 0; i < vSortedByTimestamp.size(); i++) {
+        if (fSelected && vSortedByTimestamp[i].first > nSelectionIntervalStop)
+            break;
+        if (vSelected[i])
+            continue;
+
+        const BlockRef ref = vSortedByTimestamp[i].second;
+        arith_uint256 hashSelection = UintToArith256(HashWithModifier(GetForestKernelHash(forest, ref), nStakeModifierPrev));
+        if (forest.Hot(ref).IsProofOfStake())
+            hashSelection >>= 32;
+        if (!fSelected || hashSelection < hashBest) {
+            fSelected = true;
+            hashBest = hashSelection;
+            nSelected = i;
+        }
+    }
+    return fSelected;
+}
+
+/**
+ * ComputeNextStakeModifier - Stake modifier of a block in the block forest
+ * 
+ * v0.4 blocks hash their kernel into the parent's modifier. v0.3 blocks
+ * follow PeerCoin: keep the last modifier until the parent opens a new
+ * modifier interval, then select 64 blocks from the selection interval
+ * before it and take one entropy bit from each.
+ */
+bool StakeModifier::ComputeNextStakeModifier(const CBlockForest& forest, BlockRef ref,
+                                             uint64_t& nStakeModifier, bool& fGeneratedStakeModifier)
+{
+    METRIC_SCOPED_TIMER(histComputeNextStakeModifier);
+    TRACE_SPAN("ComputeNextStakeModifier", "modifier");
+
+    nStakeModifier = 0;
+    fGeneratedStakeModifier = false;
+
+    const BlockRef prev = forest.GetPrev(ref);
+    if (prev == NULL_BLOCK_REF) {
+        fGeneratedStakeModifier = true;
+        return true;  // Genesis block's modifier is 0
+    }
+
+    if (IsProtocolV04(forest.Hot(ref).nTime)) {
+        nStakeModifier = ComputeStakeModifierV04(forest.Cold(prev).nStakeModifier, GetForestKernelHash(forest, ref));
+        fGeneratedStakeModifier = true;
+        return true;
+    }
+
+    const BlockRef last = forest.GetLastModifierBlock(prev);
+    if (last == NULL_BLOCK_REF)
+        return error("%s: unable to get last modifier", __func__);
+    nStakeModifier = forest.Cold(last).nStakeModifier;
+    const int64_t nPrevTime = forest.Hot(prev).nTime;
+    if (forest.Hot(last).nTime / nModifierInterval >= nPrevTime / nModifierInterval)
+        return true;
+
+    // Candidates: the parent and its ancestors back to the start of the selection interval
+    const int64_t nSelectionInterval = GetStakeModifierSelectionInterval();
+    const int64_t nSelectionIntervalStart = (nPrevTime / nModifierInterval) * nModifierInterval - nSelectionInterval;
+    std::vector<std::pair<uint32_t, BlockRef>> vSortedByTimestamp;
+    vSortedByTimestamp.reserve(nSelectionInterval / nStakeTargetSpacing + nModifierInterval / nStakeTargetSpacing);
+    for (BlockRef r = prev; r != NULL_BLOCK_REF && forest.Hot(r).nTime >= nSelectionIntervalStart; r = forest.GetPrev(r))
+        vSortedByTimestamp.emplace_back(forest.Hot(r).nTime, r);
+    std::reverse(vSortedByTimestamp.begin(), vSortedByTimestamp.end());
+    std::sort(vSortedByTimestamp.begin(), vSortedByTimestamp.end(),
+              [&forest](const std::pair<uint32_t, BlockRef>& a, const std::pair<uint32_t, BlockRef>& b) {
+                  if (a.first != b.first)
+                      return a.first < b.first;
+                  return UintToArith256(forest.GetBlockHash(a.second)) < UintToArith256(forest.GetBlockHash(b.second));
+              });
+
+    // One entropy bit from each selected block; sections split the interval evenly
+    const int64_t nSectionLength = nSelectionInterval / nStakeModifierSections;
+    std::vector<bool> vSelected(vSortedByTimestamp.size(), false);
+    uint64_t nStakeModifierNew = 0;
+    int64_t nSelectionIntervalStop = nSelectionIntervalStart;
+    const int nRounds = std::min(nStakeModifierSections, (int)vSortedByTimestamp.size());
+    for (int nRound = 0; nRound < nRounds; nRound++) {
+        nSelectionIntervalStop += nSectionLength;
+        size_t nSelected;
+        if (!SelectForestBlockFromCandidates(forest, vSortedByTimestamp, vSelected, nSelectionIntervalStop,
+                                             nStakeModifier, nSelected))
+            return error("%s: unable to select block at round %d", __func__, nRound);
+        vSelected[nSelected] = true;
+        nStakeModifierNew |= ((uint64_t)forest.Hot(vSortedByTimestamp[nSelected].second).GetStakeEntropyBit()) << nRound;
+    }
+
+    nStakeModifier = nStakeModifierNew;
+    fGeneratedStakeModifier = true;
+    return true;
+}
+
+/**
+ * ComputeStakeModifierV04 - Per-block modifier from the kernel hash
+ * 
+ * The kernel hash cannot be chosen without already holding a valid
+ * stake, so hashing it into the previous modifier keeps the modifier
+ * unpredictable while costing a single hash per block.
+ */
+uint64_t StakeModifier::ComputeStakeModifierV04(uint64_t nStakeModifierPrev, const uint256& hashKernel) {
+    return HashWithModifier(hashKernel, nStakeModifierPrev).GetUint64(0);
+}
+
 /**
  * GetStakeModifierChecksum - Compute modifier chain checksum
  * 
@@ -331,13 +524,10 @@ bool StakeModifier::IsProtocolV03(int64_t nTime) {
 /**
  * IsProtocolV04 - Check if v0.4 protocol is active
  * 
- * Placeholder for future protocol upgrades.
- * Currently not implemented.
+ * Gated on the block's own timestamp, like the v0.3 switch.
  */
 bool StakeModifier::IsProtocolV04(int64_t nTime) {
-    // Protocol v0.4 not yet defined for Africoin
-    // This is a placeholder for future upgrades
-    return false;
+    return (nTime >= GetStakeModifierParams().nV04SwitchTime);
 }
 
 } // namespace PeerCoin
@@ -7,6 +7,7 @@
 #define AFRICOIN_SECURITY_STAKEMODIFIER_H
 
 #include <stdint.h>
+#include <string>
 #include <vector>
 
 // Forward declarations for Africoin types
@@ -15,9 +16,14 @@ class uint256;
 class CBlockIndex;
 class CBlock;
 
+namespace Africoin {
+class CBlockForest;
+typedef uint32_t BlockRef;
+}
+
 /**
  * @file stakemodifier.h
- * @brief PeerCoin's stake modifier v0.3 protocol
+ * @brief PeerCoin's stake modifier v0.3 protocol and the v0.4 successor
  * 
  * The stake modifier is a critical component of proof-of-stake security.
  * It provides unpredictability to the stake selection process, preventing
@@ -31,6 +37,13 @@ class CBlock;
  * 3. Incorporates entropy from multiple sources
  * 4. Prevents stake grinding attacks
  * 
+ * v0.3 regenerates the modifier once per nModifierInterval by running 64
+ * selection rounds over a candidate window of several days. From the
+ * network's v0.4 switch time (StakeModifierParams) every block instead hashes its kernel hash
+ * into the previous modifier, as PeerCoin does from protocol v0.5: one
+ * hash per block and no candidate scan, so reindexing and fork switches
+ * no longer pay for the window.
+ * 
  * PeerCoin Reference: https://github.com/peercoin/peercoin
  * 
  * TODO: Integrate actual PeerCoin stake modifier implementation from:
@@ -65,6 +78,12 @@ public:
      * - Hash of previous modifier + selected block data
      * - Selection based on stake age and modifier interval
      * 
+     * Only covers v0.3. A v0.4 modifier is keyed by the new block's own
+     * timestamp and kernel hash, and this entry point only sees the
+     * parent, so it cannot produce one. Block connection, reindex and
+     * the kernel read modifiers computed on the block forest path below,
+     * which handles both protocols.
+     * 
      * @param pindexPrev Previous block index
      * @param nStakeModifier Output: computed stake modifier
      * @param fGeneratedStakeModifier Output: true if new modifier was generated
@@ -75,6 +94,38 @@ public:
     static bool ComputeNextStakeModifier(const CBlockIndex* pindexPrev, 
                                          uint64_t& nStakeModifier, 
                                          bool& fGeneratedStakeModifier);
+
+    /**
+     * @brief Compute the stake modifier of a block in the block forest
+     * 
+     * Dispatches on the block's own timestamp: from the v0.4 switch time
+     * the modifier is ComputeStakeModifierV04() of the parent's modifier
+     * and the block's kernel hash, and every block generates one. Before
+     * it, the v0.3 selection runs over the candidate window ending at the
+     * parent, and a new modifier is only generated when the parent starts
+     * a new modifier interval.
+     * 
+     * @param forest Block forest holding ref and all its ancestors
+     * @param ref Block to compute the modifier for; time, flags and proof
+     *            hash must already be set
+     * @param nStakeModifier Output: modifier in effect from this block
+     * @param fGeneratedStakeModifier Output: true if a new modifier was generated
+     * @return false if no earlier modifier or no candidate block was found
+     */
+    static bool ComputeNextStakeModifier(const Africoin::CBlockForest& forest, Africoin::BlockRef ref,
+                                         uint64_t& nStakeModifier, bool& fGeneratedStakeModifier);
+
+    /**
+     * @brief Protocol v0.4 stake modifier
+     * 
+     * First 64 bits of the hash of the kernel hash (the proof-of-stake
+     * hash, or the block hash of a PoW block) and the previous modifier.
+     * 
+     * @param nStakeModifierPrev Modifier in effect at the parent
+     * @param hashKernel Kernel hash of the new block
+     * @return The new block's stake modifier
+     */
+    static uint64_t ComputeStakeModifierV04(uint64_t nStakeModifierPrev, const uint256& hashKernel);
     
     /**
      * @brief Get the stake modifier checksum
@@ -173,9 +224,11 @@ public:
     static bool IsProtocolV03(int64_t nTime);
 
     /**
-     * @brief Check if protocol v0.4 is active (if implemented)
+     * @brief Check if protocol v0.4 is active
      * 
-     * Placeholder for future protocol upgrades.
+     * Blocks timestamped at or after the active network's
+     * StakeModifierParams::nV04SwitchTime use the per-block v0.4 stake
+     * modifier.
      * 
      * @param nTime Block timestamp to check
      * @return true if v0.4 protocol is active
@@ -201,6 +254,25 @@ static const int64_t nModifierInterval = 6 * 60 * 60; // 6 hours
  */
 static const int64_t nStakeModifierV03SwitchTime = 0; // Always use v0.3
 
+/**
+ * @struct StakeModifierParams
+ * @brief Per-network stake modifier consensus parameters
+ * 
+ * One set per network, selected like the checkpoint data by the active
+ * chain's network ID.
+ */
+struct StakeModifierParams {
+    /** Blocks timestamped at or after this derive their modifier from the
+     *  previous modifier and their own kernel hash */
+    int64_t nV04SwitchTime;
+};
+
+/** @brief Stake modifier parameters of the active network */
+const StakeModifierParams& GetStakeModifierParams();
+
+/** @brief Stake modifier parameters of a network by ID (main, test; anything else is regtest) */
+const StakeModifierParams& GetStakeModifierParams(const std::string& strNetwork);
+
 /**
  * @brief Number of sections in stake modifier selection interval
  * 
@@ -0,0 +1,107 @@
+// Copyright (c) 2012-2013 The PeerCoin developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file hybrid_difficulty.cpp
+ * @brief Independent PoW and PoS difficulty tracks for the hybrid chain
+ */
+
+#include "staking/hybrid_difficulty.h"
+
+#include "arith_uint256.h"
+#include "chain.h"
+#include "consensus/blockforest.h"
+#include "security/kernel.h"
+
+namespace Africoin {
+
+static_assert(nTargetPoSPercent > 0 && nTargetPoSPercent < 100, "both block types need a share");
+
+int64_t GetHybridTargetSpacing(bool fProofOfStake, int nHeight)
+{
+    if (nHeight < nPoSStartHeight)
+        return PeerCoin::nStakeTargetSpacing;
+    // Integer only, rounded to nearest, so every platform agrees
+    const int64_t nPercent = fProofOfStake ? nTargetPoSPercent : 100 - nTargetPoSPercent;
+    int64_t nSpacing = (PeerCoin::nStakeTargetSpacing * 100 + nPercent / 2) / nPercent;
+    return nSpacing > 0 ? nSpacing : 1;
+}
+
+uint32_t GetNextTargetRequired(const CDifficultyTrack& track, int64_t nTargetSpacing, int64_t nTimespan)
+{
+    // Genesis of this type, or its first block: nothing to retarget from
+    if (track.nBits == 0)
+        return HYBRID_TARGET_LIMIT_BITS;
+    if (track.nTimePrev == 0)
+        return track.nBits;
+
+    int64_t nActualSpacing = (int64_t)track.nTime - (int64_t)track.nTimePrev;
+    if (nActualSpacing < 0)
+        nActualSpacing = nTargetSpacing;
+    if (nActualSpacing > nHybridMaxSpacingFactor * nTargetSpacing)
+        nActualSpacing = nHybridMaxSpacingFactor * nTargetSpacing;
+
+    // ppcoin: target change every block
+    // ppcoin: retarget with exponential moving toward target spacing
+    arith_uint256 bnTargetLimit;
+    bnTargetLimit.SetCompact(HYBRID_TARGET_LIMIT_BITS);
+    arith_uint256 bnNew;
+    bnNew.SetCompact(track.nBits);
+    int64_t nInterval = nTimespan / nTargetSpacing;
+    if (nInterval < 1)
+        nInterval = 1;
+    bnNew *= arith_uint256((nInterval - 1) * nTargetSpacing + nActualSpacing + nActualSpacing);
+    bnNew /= arith_uint256((nInterval + 1) * nTargetSpacing);
+
+    if (bnNew <= 0 || bnNew > bnTargetLimit)
+        bnNew = bnTargetLimit;
+
+    return bnNew.GetCompact();
+}
+
+uint32_t GetNextHybridTarget(const CHybridDifficultyState& state, BlockType blockType, int nHeight)
+{
+    uint32_t nPoWBits = GetNextTargetRequired(state.pow, GetHybridTargetSpacing(false, nHeight));
+    if (blockType == BLOCK_TYPE_POW)
+        return nPoWBits;
+
+    uint32_t nPoSBits = GetNextTargetRequired(state.pos, GetHybridTargetSpacing(true, nHeight));
+    if (blockType == BLOCK_TYPE_POS)
+        return nPoSBits;
+
+    // Hybrid blocks pass both checks, so they get the easier of the two targets
+    arith_uint256 bnPoW, bnPoS;
+    bnPoW.SetCompact(nPoWBits);
+    bnPoS.SetCompact(nPoSBits);
+    return bnPoW > bnPoS ? nPoWBits : nPoSBits;
+}
+
+uint32_t GetNextHybridTarget(const CBlockIndex* pindexPrev, BlockType blockType)
+{
+    if (!pindexPrev)
+        return HYBRID_TARGET_LIMIT_BITS;
+
+    BlockRef ref = g_blockForest.Find(pindexPrev->GetBlockHash());
+    if (ref != NULL_BLOCK_REF)
+        return GetNextHybridTarget(g_blockForest.Cold(ref).difficulty, blockType, pindexPrev->nHeight + 1);
+    return GetNextHybridTarget(GetDifficultyStateByWalk(pindexPrev), blockType, pindexPrev->nHeight + 1);
+}
+
+CHybridDifficultyState GetDifficultyStateByWalk(const CBlockIndex* pindex)
+{
+    CHybridDifficultyState state;
+    for (; pindex && (state.pow.nTimePrev == 0 || state.pos.nTimePrev == 0); pindex = pindex->pprev) {
+        CDifficultyTrack& track = pindex->IsProofOfStake() ? state.pos : state.pow;
+        if (track.nBits == 0) {
+            track.nBits = pindex->nBits;
+            track.nTime = pindex->nTime;
+        } else if (track.nTimePrev == 0) {
+            track.nTimePrev = pindex->nTime;
+        }
+    }
+    return state;
+}
+
+} // namespace Africoin
@@ -0,0 +1,124 @@
+// Copyright (c) 2012-2013 The PeerCoin developers
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STAKING_HYBRID_DIFFICULTY_H
+#define AFRICOIN_STAKING_HYBRID_DIFFICULTY_H
+
+#include "staking/hybrid_staking.h"
+
+#include <stdint.h>
+
+/**
+ * @file hybrid_difficulty.h
+ * @brief Independent PoW and PoS difficulty tracks for the hybrid chain
+ *
+ * PoW and PoS blocks retarget separately, PeerCoin style: each type's
+ * next target follows from the spacing between the last two blocks of
+ * that type. Finding those by walking back costs as many steps as there
+ * are blocks of the other type in between (dozens of PoS blocks per PoW
+ * block at the target ratio, and unbounded if one side stalls).
+ *
+ * Instead every block index entry carries a CHybridDifficultyState: the
+ * bits and times of the last two blocks of each type up to and including
+ * that block. It is derived from the parent's state in O(1) when the
+ * entry is added, and both retargets read it from pindexPrev in O(1).
+ *
+ * Hybrid blocks carry a coinstake, so they advance the PoS track.
+ */
+
+namespace Africoin {
+
+/** Easiest allowed target for either block type */
+static const uint32_t HYBRID_TARGET_LIMIT_BITS = 0x1e0fffff;
+
+/** Time over which each track converges on its target spacing */
+static const int64_t nHybridTargetTimespan = 24 * 60 * 60; // 1 day
+
+/** A spacing longer than this many target spacings counts as this many */
+static const int64_t nHybridMaxSpacingFactor = 10;
+
+/**
+ * @struct CDifficultyTrack
+ * @brief The last two blocks of one type
+ */
+struct CDifficultyTrack {
+    uint32_t nBits;       //!< Bits of the last block of this type (0: none yet)
+    uint32_t nTime;       //!< Its time
+    uint32_t nTimePrev;   //!< Time of the one before it (0: none)
+
+    CDifficultyTrack() : nBits(0), nTime(0), nTimePrev(0) {}
+
+    void Advance(uint32_t nBitsIn, uint32_t nTimeIn)
+    {
+        nTimePrev = nBits ? nTime : 0;
+        nBits = nBitsIn;
+        nTime = nTimeIn;
+    }
+
+    bool operator==(const CDifficultyTrack& other) const
+    {
+        return nBits == other.nBits && nTime == other.nTime && nTimePrev == other.nTimePrev;
+    }
+};
+
+/**
+ * @struct CHybridDifficultyState
+ * @brief Both difficulty tracks as of one block
+ */
+struct CHybridDifficultyState {
+    CDifficultyTrack pow;
+    CDifficultyTrack pos;
+
+    /** State after a child block with these header fields */
+    void Advance(bool fProofOfStake, uint32_t nBits, uint32_t nTime)
+    {
+        (fProofOfStake ? pos : pow).Advance(nBits, nTime);
+    }
+
+    bool operator==(const CHybridDifficultyState& other) const { return pow == other.pow && pos == other.pos; }
+};
+
+/**
+ * @brief Target spacing of one block type at a height
+ *
+ * Before PoS starts every block is PoW at the full block rate. After
+ * that each type gets its share of blocks given nTargetPoSPercent,
+ * in integer arithmetic.
+ */
+int64_t GetHybridTargetSpacing(bool fProofOfStake, int nHeight);
+
+/**
+ * @brief PeerCoin's retarget on one track
+ *
+ * bnNew = bnPrev * ((nInterval - 1) * spacing + 2 * actual) / ((nInterval + 1) * spacing)
+ * with nInterval = nTimespan / spacing. Negative spacings count as on
+ * target and long stalls are capped at nHybridMaxSpacingFactor spacings.
+ */
+uint32_t GetNextTargetRequired(const CDifficultyTrack& track, int64_t nTargetSpacing,
+                               int64_t nTimespan = nHybridTargetTimespan);
+
+/** @brief Bits for a block of the given type on top of a block with this state */
+uint32_t GetNextHybridTarget(const CHybridDifficultyState& state, BlockType blockType, int nHeight);
+
+/**
+ * @brief Bits for a block of the given type on top of pindexPrev
+ *
+ * Reads the state from the block forest entry of pindexPrev, falling
+ * back to GetDifficultyStateByWalk for blocks not in the forest. Caller
+ * must hold cs_main, which guards the forest.
+ */
+uint32_t GetNextHybridTarget(const CBlockIndex* pindexPrev, BlockType blockType);
+
+/**
+ * @brief Difficulty state as of pindex, by walking back
+ *
+ * Reference implementation of what the block forest stores, used for
+ * blocks not (yet) in the forest and to cross-check it.
+ */
+CHybridDifficultyState GetDifficultyStateByWalk(const CBlockIndex* pindex);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STAKING_HYBRID_DIFFICULTY_H
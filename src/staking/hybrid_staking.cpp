@@ -30,10 +30,13 @@
  */
 
 #include "staking/hybrid_staking.h"
+#include "staking/hybrid_difficulty.h"
 #include "security/kernel.h"
 #include "security/checkpoints.h"
 #include "security/stakemodifier.h"
 #include "security/security_config.h"
+#include "metrics/metrics.h"
+#include "metrics/trace.h"
 
 // TODO: Include actual Africoin headers when integrated
 // #include "chain.h"
@@ -49,6 +52,9 @@
 
 namespace Africoin {
 
+METRIC_HISTOGRAM(histValidateHybridBlock, "africoin_hybrid_validate_block_seconds",
+                 "Time spent in hybrid PoW/PoS block validation (HybridStaking::ValidateHybridBlock)");
+
 /**
  * ValidateHybridBlock - Validate a block using hybrid consensus rules
  * 
@@ -68,6 +74,9 @@ namespace Africoin {
  * - Mature chain: Primarily PoS with hybrid support
  */
 bool HybridStaking::ValidateHybridBlock(const CBlock& block, const CBlockIndex* pindexPrev) {
+    METRIC_SCOPED_TIMER(histValidateHybridBlock);
+    TRACE_SPAN("ValidateHybridBlock", "hybrid");
+
     // TODO: Implement full hybrid validation
     //
     // Pseudocode:
@@ -202,6 +211,8 @@ bool HybridStaking::IsPoSRequired(int nHeight) {
  */
 bool HybridStaking::ValidateProofOfStake(const CTransaction& tx, unsigned int nBits, 
                                           uint256& hashProofOfStake) {
+    TRACE_SPAN("ValidateProofOfStake", "hybrid");
+
     // TODO: Implement using PeerCoin kernel
     //
     // Pseudocode:
@@ -418,38 +429,18 @@ bool HybridStaking::VerifyHybridCheckpoint(int nHeight, const uint256& hash) {
 /**
  * GetHybridDifficulty - Compute difficulty for block type
  * 
- * Difficulty calculation varies by block type:
- * - PoW: Standard Bitcoin-style difficulty adjustment
- * - PoS: Difficulty based on stake age and network stake
- * - Hybrid: Combined difficulty considering both
+ * PoW and PoS blocks retarget independently, each towards its share of
+ * the block rate (see hybrid_difficulty.h):
+ * - PoW: PeerCoin retarget on the last two PoW blocks
+ * - PoS: PeerCoin retarget on the last two PoS/hybrid blocks
+ * - Hybrid: the easier of the two, since the block passes both checks
  * 
- * This ensures appropriate difficulty for each validation type.
+ * The last two blocks of each type are read from the difficulty state
+ * the block forest keeps per entry, so this is O(1) however the types
+ * interleave.
  */
 unsigned int HybridStaking::GetHybridDifficulty(const CBlockIndex* pindexPrev, BlockType blockType) {
-    // TODO: Implement difficulty calculation
-    //
-    // Pseudocode:
-    //
-    // if (!pindexPrev)
-    //     return GetDefaultDifficulty();
-    // 
-    // switch (blockType) {
-    //     case BLOCK_TYPE_POW:
-    //         return GetNextWorkRequired(pindexPrev);
-    //     case BLOCK_TYPE_POS:
-    //         return GetNextProofOfStakeRequired(pindexPrev);
-    //     case BLOCK_TYPE_HYBRID:
-    //         // For hybrid, use weighted average
-    //         unsigned int nPoWTarget = GetNextWorkRequired(pindexPrev);
-    //         unsigned int nPoSTarget = GetNextProofOfStakeRequired(pindexPrev);
-    //         // Use easier of the two to encourage hybrid blocks
-    //         return std::max(nPoWTarget, nPoSTarget);
-    // }
-    // 
-    // return pindexPrev->nBits;
-    
-    // Stub: Return previous difficulty
-    return 0x1e0fffff; // Default difficulty
+    return GetNextHybridTarget(pindexPrev, blockType);
 }
 
 /**
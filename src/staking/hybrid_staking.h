@@ -216,9 +216,11 @@ static const int nPurePoWEndHeight = 10000;
  * @brief Ratio of PoS blocks to total blocks (target)
  * 
  * The chain aims to have this percentage of blocks
- * validated via PoS after the transition period.
+ * validated via PoS after the transition period. Consensus
+ * code (the per-type target spacing) uses the integer percent.
  */
-static const double nTargetPoSRatio = 0.9; // 90% PoS blocks
+static const int nTargetPoSPercent = 90; // 90% PoS blocks
+static const double nTargetPoSRatio = nTargetPoSPercent / 100.0;
 
 /**
  * @brief Hybrid block reward multiplier
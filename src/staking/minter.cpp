@@ -0,0 +1,244 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file minter.cpp
+ * @brief Kernel search state kept by the staking thread
+ */
+
+#include "staking/minter.h"
+
+#include "arith_uint256.h"
+#include "crypto/common.h"
+#include "crypto/sha256_dispatch.h"
+#include "security/kernel.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+namespace Africoin {
+
+void CKernelMidstate::Init(uint64_t nStakeModifierIn, uint32_t nTimeBlockFrom, uint32_t nTxPrevOffset,
+                           uint32_t nTimeTxPrev, uint32_t nPrevout)
+{
+    // Same layout as the CHashWriter serialization in Kernel::ComputeKernelHash
+    WriteLE64(vchPrefix, nStakeModifierIn);
+    WriteLE32(vchPrefix + 8, nTimeBlockFrom);
+    WriteLE32(vchPrefix + 12, nTxPrevOffset);
+    WriteLE32(vchPrefix + 16, nTimeTxPrev);
+    WriteLE32(vchPrefix + 20, nPrevout);
+    nStakeModifier = nStakeModifierIn;
+    fValid = true;
+}
+
+uint256 CKernelMidstate::Hash(uint32_t nTimeTx) const
+{
+    unsigned char vchKernel[KERNEL_PREFIX_SIZE + 4];
+    memcpy(vchKernel, vchPrefix, KERNEL_PREFIX_SIZE);
+    WriteLE32(vchKernel + KERNEL_PREFIX_SIZE, nTimeTx);
+    return SHA256d(vchKernel, sizeof(vchKernel));
+}
+
+void CKernelMidstate::HashBatch(uint32_t nTimeFirst, size_t n, uint256* pHashes) const
+{
+    const size_t nKernelSize = KERNEL_PREFIX_SIZE + 4;
+    unsigned char vchKernels[KERNEL_PROBE_BATCH * nKernelSize];
+    for (size_t i = 0; i < n; i++) {
+        memcpy(vchKernels + i * nKernelSize, vchPrefix, KERNEL_PREFIX_SIZE);
+        WriteLE32(vchKernels + i * nKernelSize + KERNEL_PREFIX_SIZE, nTimeFirst + (uint32_t)i);
+    }
+    SHA256dMany(pHashes[0].begin(), vchKernels, nKernelSize, n);
+}
+
+void CStakeMinter::AddCandidate(const CStakeCandidate& candidate)
+{
+    Entry& entry = mapCandidates[candidate.prevout];
+    entry.candidate = candidate;
+    entry.midstate = CKernelMidstate();
+    entry.nEligibleTime = GetEligibleTime(candidate);
+    entry.nSequence = ++nSequence;
+
+    // Replaced outputs go back to sleep; their old queue entry is now stale
+    setAwake.erase(candidate.prevout);
+    if (entry.nEligibleTime != STAKE_NEVER_ELIGIBLE)
+        queueSleeping.push(Sleeper{entry.nEligibleTime, entry.nSequence, candidate.prevout});
+}
+
+bool CStakeMinter::RemoveCandidate(const COutPoint& prevout)
+{
+    setAwake.erase(prevout);
+    return mapCandidates.erase(prevout) > 0;
+}
+
+const CStakeCandidate* CStakeMinter::GetCandidate(const COutPoint& prevout) const
+{
+    auto it = mapCandidates.find(prevout);
+    return it == mapCandidates.end() ? nullptr : &it->second.candidate;
+}
+
+const CKernelMidstate& CStakeMinter::GetMidstate(Entry& entry, uint64_t nStakeModifier)
+{
+    if (!entry.midstate.IsValid() || entry.midstate.GetStakeModifier() != nStakeModifier) {
+        const CStakeCandidate& candidate = entry.candidate;
+        entry.midstate.Init(nStakeModifier, candidate.nTimeBlockFrom, candidate.nTxPrevOffset,
+                            candidate.nTimeTxPrev, candidate.prevout.n);
+        nMidstateBuilds++;
+    }
+    return entry.midstate;
+}
+
+const CKernelMidstate* CStakeMinter::GetMidstate(const COutPoint& prevout, uint64_t nStakeModifier)
+{
+    auto it = mapCandidates.find(prevout);
+    if (it == mapCandidates.end())
+        return nullptr;
+    return &GetMidstate(it->second, nStakeModifier);
+}
+
+bool CStakeMinter::SearchKernel(const COutPoint& prevout, uint64_t nStakeModifier, unsigned int nBits,
+                                uint32_t nTimeBegin, uint32_t nTimeEnd, uint32_t& nTimeTxOut, uint256& hashProofOut)
+{
+    auto it = mapCandidates.find(prevout);
+    if (it == mapCandidates.end())
+        return false;
+
+    const CKernelMidstate& midstate = GetMidstate(it->second, nStakeModifier);
+    const CStakeCandidate& candidate = it->second.candidate;
+    uint256 vHashes[KERNEL_PROBE_BATCH];
+    for (uint64_t nTimeFirst = nTimeBegin; nTimeFirst <= nTimeEnd; nTimeFirst += KERNEL_PROBE_BATCH) {
+        size_t n = (size_t)std::min<uint64_t>(KERNEL_PROBE_BATCH, nTimeEnd - nTimeFirst + 1);
+        midstate.HashBatch((uint32_t)nTimeFirst, n, vHashes);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t nTimeTx = (uint32_t)(nTimeFirst + i);
+            if (PeerCoin::Kernel::CheckKernelHashTarget(vHashes[i], nBits, candidate.nValue,
+                                                        candidate.nTimeTxPrev, nTimeTx)) {
+                nTimeTxOut = nTimeTx;
+                hashProofOut = vHashes[i];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Expected hits over [nTimeFrom, nTimeTo] for one candidate: the sum of
+ * min(1, coin-day weight * nHitPerCoinDay) in closed form. The weight rises
+ * linearly from the minimum age until it is capped at the maximum age;
+ * coin-day rounding is ignored, as befits an estimate.
+ */
+static double GetExpectedHits(const CStakeCandidate& candidate, uint64_t nTimeFrom, uint64_t nTimeTo,
+                              double nHitPerCoinDay)
+{
+    const double nSlope = (double)candidate.nValue / COIN / (24 * 60 * 60) * nHitPerCoinDay;
+    const double nTimeZero = (double)candidate.nTimeTxPrev + PeerCoin::nStakeMinAge;
+    const double nTimeCap = (double)candidate.nTimeTxPrev + PeerCoin::nStakeMaxAge;
+    // Past nTimeFlat every probe hits with the same probability
+    const double nTimeFlat = nSlope > 0 ? std::min(nTimeCap, nTimeZero + 1 / nSlope) : nTimeCap;
+    const double nRiseTo = std::min((double)nTimeTo, floor(nTimeFlat));
+
+    double nHits = 0;
+    if (nRiseTo >= nTimeFrom)
+        nHits += nSlope * (nRiseTo - nTimeFrom + 1) * ((nTimeFrom + nRiseTo) / 2 - nTimeZero);
+    const double nFlatFrom = std::max((double)nTimeFrom, nRiseTo + 1);
+    if (nTimeTo >= nFlatFrom)
+        nHits += (nTimeTo - nFlatFrom + 1) * std::min(1.0, nSlope * (nTimeCap - nTimeZero));
+    return nHits;
+}
+
+bool CStakeMinter::FindStake(unsigned int nBits, uint32_t nTimeBegin, uint32_t nTimeEnd, uint64_t nMaxProbes,
+                             const StakeModifierLookup& lookup, CStakeHit& hit, CStakeRoundStats& stats)
+{
+    if (nTimeBegin > nTimeEnd)
+        return false;
+    const uint64_t nWindow = (uint64_t)nTimeEnd - nTimeBegin + 1;
+
+    while (!queueSleeping.empty() && queueSleeping.top().nEligibleTime <= nTimeEnd) {
+        Sleeper sleeper = queueSleeping.top();
+        queueSleeping.pop();
+        auto it = mapCandidates.find(sleeper.prevout);
+        if (it != mapCandidates.end() && it->second.nSequence == sleeper.nSequence)
+            setAwake.insert(sleeper.prevout);
+    }
+    stats.nSkippedIneligible += (mapCandidates.size() - setAwake.size()) * nWindow;
+
+    // Hit probability per probe is proportional to coin-day weight
+    std::priority_queue<std::pair<int64_t, Entry*>> queueRanked;
+    for (const COutPoint& prevout : setAwake) {
+        Entry& entry = mapCandidates.find(prevout)->second;
+        queueRanked.emplace(GetCoinDayWeight(entry.candidate, nTimeEnd), &entry);
+    }
+
+    arith_uint256 bnTargetPerCoinDay;
+    bnTargetPerCoinDay.SetCompact(nBits);
+    const double nHitPerCoinDay = bnTargetPerCoinDay.getdouble() / ldexp(1.0, 256);
+
+    for (; !queueRanked.empty(); queueRanked.pop()) {
+        Entry& entry = *queueRanked.top().second;
+        const CStakeCandidate& candidate = entry.candidate;
+        uint64_t nFirst = std::max(nTimeBegin, entry.nEligibleTime);
+        stats.nSkippedIneligible += nFirst - nTimeBegin;
+
+        uint64_t nStakeModifier;
+        if (!lookup(candidate, nStakeModifier))
+            continue;
+
+        uint64_t nTimeTx = nFirst;
+        if (!nMaxProbes || stats.nProbes < nMaxProbes) {
+            const CKernelMidstate& midstate = GetMidstate(entry, nStakeModifier);
+            uint256 vHashes[KERNEL_PROBE_BATCH];
+            while (nTimeTx <= nTimeEnd && (!nMaxProbes || stats.nProbes < nMaxProbes)) {
+                // A batch never runs past the window or the budget
+                uint64_t nBatch = std::min<uint64_t>(KERNEL_PROBE_BATCH, nTimeEnd - nTimeTx + 1);
+                if (nMaxProbes)
+                    nBatch = std::min(nBatch, nMaxProbes - stats.nProbes);
+                midstate.HashBatch((uint32_t)nTimeTx, (size_t)nBatch, vHashes);
+                for (size_t i = 0; i < nBatch; i++, nTimeTx++) {
+                    stats.nProbes++;
+                    if (PeerCoin::Kernel::CheckKernelHashTarget(vHashes[i], nBits, candidate.nValue,
+                                                                candidate.nTimeTxPrev, (uint32_t)nTimeTx)) {
+                        hit.prevout = candidate.prevout;
+                        hit.nTimeTx = (uint32_t)nTimeTx;
+                        hit.hashProof = vHashes[i];
+                        return true;
+                    }
+                }
+            }
+        }
+
+        // The budget ran out: account for the rest of the window in one step
+        if (nTimeTx <= nTimeEnd) {
+            stats.nSkippedBudget += nTimeEnd - nTimeTx + 1;
+            stats.nExpectedSkipped += GetExpectedHits(candidate, nTimeTx, nTimeEnd, nHitPerCoinDay);
+        }
+    }
+    return false;
+}
+
+uint32_t CStakeMinter::GetEligibleTime(const CStakeCandidate& candidate)
+{
+    if (candidate.nValue <= 0)
+        return STAKE_NEVER_ELIGIBLE;
+
+    // Smallest time weight making nValue * weight / COIN / (24 * 60 * 60) at least one
+    const int64_t nCoinDay = COIN * 24 * 60 * 60;
+    int64_t nWeightNeeded = (nCoinDay + candidate.nValue - 1) / candidate.nValue;
+    if (nWeightNeeded > PeerCoin::nStakeMaxAge - PeerCoin::nStakeMinAge)
+        return STAKE_NEVER_ELIGIBLE;
+
+    int64_t nTime = (int64_t)candidate.nTimeTxPrev + PeerCoin::nStakeMinAge + nWeightNeeded;
+    return nTime < STAKE_NEVER_ELIGIBLE ? (uint32_t)nTime : STAKE_NEVER_ELIGIBLE;
+}
+
+int64_t CStakeMinter::GetCoinDayWeight(const CStakeCandidate& candidate, uint32_t nTimeTx)
+{
+    // Same rounding as Kernel::CheckKernelHashTarget
+    arith_uint256 bnCoinDayWeight = arith_uint256(candidate.nValue) *
+                                    arith_uint256(PeerCoin::Kernel::GetWeight(candidate.nTimeTxPrev, nTimeTx)) /
+                                    arith_uint256(COIN) / arith_uint256(24 * 60 * 60);
+    return (int64_t)bnCoinDayWeight.GetLow64();
+}
+
+} // namespace Africoin
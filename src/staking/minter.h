@@ -0,0 +1,228 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STAKING_MINTER_H
+#define AFRICOIN_STAKING_MINTER_H
+
+#include "amount.h"
+#include "primitives/transaction.h"
+#include "uint256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <vector>
+
+/**
+ * @file minter.h
+ * @brief Kernel search state kept by the staking thread
+ *
+ * The kernel hash serializes (nStakeModifier, blockFrom.nTime,
+ * nTxPrevOffset, txPrev.nTime, prevout.n, nTimeTx). While a staker scans
+ * timestamps only nTimeTx changes, and the first five fields only change
+ * when the stake modifier governing the output does.
+ *
+ * The minter therefore keeps, per staked output, the serialized 24-byte
+ * prefix, rebuilt only when it is asked for under a different stake
+ * modifier. A probe appends the 4-byte timestamp, with no serialization.
+ * The whole 28-byte kernel fits in one SHA-256 block, so probes are
+ * hashed KERNEL_PROBE_BATCH timestamps at a time through SHA256dMany,
+ * which runs them side by side on the SIMD backends.
+ *
+ * The kernel target is the per-coin-day target times the output's
+ * coin-day weight, rounded down to whole coin-days. Until an output has
+ * aged into its first whole coin-day its target is zero and no probe can
+ * hit, so the minter computes that time up front (GetEligibleTime) and
+ * keeps the output in a queue ordered by it instead of probing it. Awake
+ * outputs are probed in order of coin-day weight, highest first, so an
+ * optional per-round probe budget (for low-power nodes) is spent where
+ * hits are most likely. Without a budget the hits found are exactly
+ * those a probe of every output and timestamp would find.
+ */
+
+namespace Africoin {
+
+/** Serialized kernel fields before nTimeTx */
+static const size_t KERNEL_PREFIX_SIZE = 8 + 4 * 4;
+
+/** Timestamps hashed together per SHA256dMany call */
+static const size_t KERNEL_PROBE_BATCH = 8;
+
+/** Eligible time of an output too small to ever reach one coin-day */
+static const uint32_t STAKE_NEVER_ELIGIBLE = 0xffffffff;
+
+/**
+ * @struct CStakeCandidate
+ * @brief A wallet output the minter may stake, with its kernel fields
+ */
+struct CStakeCandidate {
+    COutPoint prevout;
+    uint256 hashBlockFrom;     //!< Block containing txPrev
+    uint32_t nTimeBlockFrom;
+    uint32_t nTxPrevOffset;    //!< Offset of txPrev in its block, header included
+    uint32_t nTimeTxPrev;
+    CAmount nValue;
+
+    CStakeCandidate() : nTimeBlockFrom(0), nTxPrevOffset(0), nTimeTxPrev(0), nValue(0) {}
+};
+
+/**
+ * @struct CStakeHit
+ * @brief A kernel found by CStakeMinter::FindStake
+ */
+struct CStakeHit {
+    COutPoint prevout;
+    uint32_t nTimeTx;
+    uint256 hashProof;
+
+    CStakeHit() : nTimeTx(0) {}
+};
+
+/**
+ * @struct CStakeRoundStats
+ * @brief Work done and skipped by one FindStake round
+ */
+struct CStakeRoundStats {
+    uint64_t nProbes;            //!< Kernel hashes checked against the target
+    uint64_t nSkippedIneligible; //!< Probes skipped because the target was zero
+    uint64_t nSkippedBudget;     //!< Probes skipped because the budget ran out
+    double nExpectedSkipped;     //!< Expected hits among the budget-skipped probes
+
+    CStakeRoundStats() : nProbes(0), nSkippedIneligible(0), nSkippedBudget(0), nExpectedSkipped(0) {}
+};
+
+/** Stake modifier governing an output's kernel, false if not yet known */
+typedef std::function<bool(const CStakeCandidate& candidate, uint64_t& nStakeModifier)> StakeModifierLookup;
+
+/**
+ * @class CKernelMidstate
+ * @brief The fixed kernel prefix of one output, serialized
+ */
+class CKernelMidstate {
+public:
+    CKernelMidstate() : nStakeModifier(0), fValid(false) {}
+
+    /** @brief Serialize the prefix for this output under nStakeModifierIn */
+    void Init(uint64_t nStakeModifierIn, uint32_t nTimeBlockFrom, uint32_t nTxPrevOffset,
+              uint32_t nTimeTxPrev, uint32_t nPrevout);
+
+    /** @brief Kernel hash at nTimeTx; equals Kernel::ComputeKernelHash */
+    uint256 Hash(uint32_t nTimeTx) const;
+
+    /** @brief Kernel hashes at nTimeFirst .. nTimeFirst + n - 1, n at most KERNEL_PROBE_BATCH */
+    void HashBatch(uint32_t nTimeFirst, size_t n, uint256* pHashes) const;
+
+    bool IsValid() const { return fValid; }
+    uint64_t GetStakeModifier() const { return nStakeModifier; }
+
+private:
+    unsigned char vchPrefix[KERNEL_PREFIX_SIZE];
+    uint64_t nStakeModifier;
+    bool fValid;
+};
+
+/**
+ * @class CStakeMinter
+ * @brief Staked outputs of a wallet and their kernel midstates
+ *
+ * Owned by the staking thread; not thread safe.
+ */
+class CStakeMinter {
+public:
+    CStakeMinter() : nMidstateBuilds(0), nSequence(0) {}
+
+    /** @brief Add an output, or replace its fields (dropping its midstate) */
+    void AddCandidate(const CStakeCandidate& candidate);
+
+    /** @brief Forget an output that was spent or left the wallet */
+    bool RemoveCandidate(const COutPoint& prevout);
+
+    size_t GetCandidateCount() const { return mapCandidates.size(); }
+
+    /** @brief Fields of an output (nullptr if unknown) */
+    const CStakeCandidate* GetCandidate(const COutPoint& prevout) const;
+
+    /**
+     * @brief Midstate of an output under nStakeModifier
+     *
+     * Rebuilt only when nStakeModifier differs from the one it was built
+     * with. Returns nullptr for unknown outputs.
+     */
+    const CKernelMidstate* GetMidstate(const COutPoint& prevout, uint64_t nStakeModifier);
+
+    /**
+     * @brief Probe timestamps nTimeBegin..nTimeEnd for a kernel meeting nBits
+     *
+     * @param[out] nTimeTxOut     First timestamp that hits
+     * @param[out] hashProofOut   Its kernel hash
+     * @return true if some timestamp in the range hits
+     */
+    bool SearchKernel(const COutPoint& prevout, uint64_t nStakeModifier, unsigned int nBits,
+                      uint32_t nTimeBegin, uint32_t nTimeEnd, uint32_t& nTimeTxOut, uint256& hashProofOut);
+
+    /**
+     * @brief Look for a kernel among all outputs for timestamps nTimeBegin..nTimeEnd
+     *
+     * Wakes outputs whose eligible time has come, then probes the awake
+     * ones in order of coin-day weight at nTimeEnd, each from its
+     * eligible time on. Outputs whose modifier is not known yet are left
+     * for a later round.
+     *
+     * @param nMaxProbes  Probe budget for this round (0: unlimited)
+     * @param[out] hit    The first kernel found
+     * @param[out] stats  Work done and skipped
+     * @return true if a kernel was found
+     */
+    bool FindStake(unsigned int nBits, uint32_t nTimeBegin, uint32_t nTimeEnd, uint64_t nMaxProbes,
+                   const StakeModifierLookup& lookup, CStakeHit& hit, CStakeRoundStats& stats);
+
+    /**
+     * @brief First timestamp at which an output's kernel target is non-zero
+     *
+     * STAKE_NEVER_ELIGIBLE if its value is too small to make a whole
+     * coin-day even at the maximum time weight.
+     */
+    static uint32_t GetEligibleTime(const CStakeCandidate& candidate);
+
+    /** @brief Whole coin-days the kernel target is scaled by at nTimeTx */
+    static int64_t GetCoinDayWeight(const CStakeCandidate& candidate, uint32_t nTimeTx);
+
+    /** Midstates built so far, for tests and the staking log */
+    uint64_t GetMidstateBuilds() const { return nMidstateBuilds; }
+
+    /** Outputs past their eligible time as of the last round */
+    size_t GetAwakeCount() const { return setAwake.size(); }
+
+private:
+    struct Entry {
+        CStakeCandidate candidate;
+        CKernelMidstate midstate;
+        uint32_t nEligibleTime;
+        uint64_t nSequence;      //!< Tells current queue entries from ones left by a replaced output
+    };
+
+    /** Output waiting for its eligible time; the earliest is on top */
+    struct Sleeper {
+        uint32_t nEligibleTime;
+        uint64_t nSequence;
+        COutPoint prevout;
+
+        bool operator<(const Sleeper& other) const { return nEligibleTime > other.nEligibleTime; }
+    };
+
+    const CKernelMidstate& GetMidstate(Entry& entry, uint64_t nStakeModifier);
+
+    std::map<COutPoint, Entry> mapCandidates;
+    std::priority_queue<Sleeper> queueSleeping;
+    std::set<COutPoint> setAwake;
+    uint64_t nMidstateBuilds;
+    uint64_t nSequence;
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STAKING_MINTER_H
@@ -0,0 +1,408 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file blockindexfile.cpp
+ * @brief The block forest saved as fixed-size records, for fast startup
+ */
+
+#include "storage/blockindexfile.h"
+
+#include "arith_uint256.h"
+#include "chainparams.h"
+#include "consensus/scriptcheck.h"
+#include "hash.h"
+#include "init.h"
+#include "metrics/trace.h"
+#include "sync.h"
+#include "tinyformat.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <thread>
+#include <vector>
+
+namespace Africoin {
+
+namespace {
+
+/** Fewest records worth a thread of their own */
+static const size_t MIN_RECORDS_PER_THREAD = 1 << 16;
+/** Records per fwrite */
+static const size_t WRITE_BATCH_RECORDS = 4096;
+/** Entries verified per cs_main hold in the background */
+static const BlockRef VERIFY_SLICE = 1 << 16;
+/** Records hashed between checks for an interrupt */
+static const size_t CHECKSUM_CHUNK_RECORDS = 1 << 16;
+
+void FillRecord(const CBlockForest& forest, BlockRef ref, CBlockIndexRecord& record)
+{
+    const CBlockForestHot& hot = forest.Hot(ref);
+    const CBlockForestCold& cold = forest.Cold(ref);
+    memset(&record, 0, sizeof(record));
+    record.hashBlock = cold.hashBlock;
+    record.hashProof = cold.hashProof;
+    record.nChainTrust = ArithToUint256(cold.nChainTrust);
+    record.nStakeModifier = cold.nStakeModifier;
+    record.nPrev = hot.nPrev;
+    record.nSkip = hot.nSkip;
+    record.nHeight = hot.nHeight;
+    record.nTime = hot.nTime;
+    record.nBits = hot.nBits;
+    record.nFlags = hot.nFlags;
+    record.nStakeModifierChecksum = cold.nStakeModifierChecksum;
+    record.nStatus = cold.nStatus;
+    record.nFile = cold.nFile;
+    record.nDataPos = cold.nDataPos;
+    record.nUndoPos = cold.nUndoPos;
+    record.nSequenceId = cold.nSequenceId;
+    record.difficulty = cold.difficulty;
+    record.nRecordFlags = forest.IsCandidate(ref) ? BLOCK_INDEX_RECORD_CANDIDATE : 0;
+}
+
+/**
+ * Links of record n must point to earlier records at the right heights,
+ * or walks through the forest could leave it. Checked against the file
+ * itself, so it does not matter which thread copies the parent.
+ */
+bool CheckRecordLinks(const CBlockIndexFile& file, size_t n)
+{
+    const CBlockIndexRecord& record = file.GetRecord(n);
+    if (record.nPrev == NULL_BLOCK_REF)
+        return record.nHeight == 0 && record.nSkip == NULL_BLOCK_REF;
+    if (record.nPrev >= n || record.nSkip >= n)
+        return false;
+    return record.nHeight == file.GetRecord(record.nPrev).nHeight + 1 &&
+           file.GetRecord(record.nSkip).nHeight == GetSkipHeight(record.nHeight);
+}
+
+/** Run fn(nBegin, nEnd) on up to nThreads threads over [nBegin, nEnd), the calling thread included */
+template <typename Fn>
+void ParallelRanges(size_t nBegin, size_t nEnd, unsigned int nThreads, Fn fn)
+{
+    size_t nPerThread = std::max(MIN_RECORDS_PER_THREAD, (nEnd - nBegin + nThreads - 1) / std::max(1u, nThreads));
+    std::vector<std::thread> vThreads;
+    for (size_t n = nBegin + nPerThread; n < nEnd; n += nPerThread)
+        vThreads.emplace_back(fn, n, std::min(nEnd, n + nPerThread));
+    fn(nBegin, std::min(nEnd, nBegin + nPerThread));
+    for (std::thread& thread : vThreads)
+        thread.join();
+}
+
+unsigned int GetNodeIndexThreads()
+{
+    int nThreads = GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
+    if (nThreads <= 0)
+        nThreads += std::thread::hardware_concurrency();
+    return std::max(1, std::min(nThreads, MAX_SCRIPTCHECK_THREADS));
+}
+
+std::thread threadVerify;
+std::atomic<bool> fInterruptVerify(false);
+/** The forest came from the database, or the file's passed every check */
+std::atomic<bool> fVerified(true);
+
+} // namespace
+
+std::string CBlockIndexLoadStats::ToString() const
+{
+    double nSeconds = nMicros * 1e-6;
+    return strprintf("%u entries, %.1f MiB %s on %u threads in %.3fs (%.0f entries/s)", nRecords,
+                     nBytes / 1048576.0, fMapped ? "mapped" : "read", nThreads, nSeconds,
+                     nSeconds > 0 ? nRecords / nSeconds : 0.0);
+}
+
+bool WriteBlockIndexFile(const boost::filesystem::path& path, const CBlockForest& forest)
+{
+    TRACE_SPAN("WriteBlockIndexFile", "index");
+
+    CBlockIndexFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.pchMessageStart, Params().MessageStart(), sizeof(header.pchMessageStart));
+    header.nVersion = BLOCK_INDEX_FILE_VERSION;
+    header.nRecordSize = sizeof(CBlockIndexRecord);
+    header.nByteOrder = BLOCK_INDEX_FILE_BYTE_ORDER;
+    header.nRecords = forest.Size();
+
+    // Write then rename, so a node never maps a partial file
+    boost::filesystem::path pathTmp = path;
+    pathTmp += ".new";
+    FILE* file = fopen(pathTmp.string().c_str(), "wb");
+    if (!file)
+        return error("%s: cannot open %s", __func__, pathTmp.string());
+
+    // The header goes first without the hash and is rewritten at the end
+    bool fWritten = fwrite(&header, sizeof(header), 1, file) == 1;
+    CHashWriter hasher(SER_GETHASH, 0);
+    std::vector<CBlockIndexRecord> vBatch(WRITE_BATCH_RECORDS);
+    for (BlockRef ref = 0; fWritten && ref < forest.Size(); ref += WRITE_BATCH_RECORDS) {
+        size_t nBatch = std::min((size_t)WRITE_BATCH_RECORDS, (size_t)(forest.Size() - ref));
+        for (size_t i = 0; i < nBatch; i++)
+            FillRecord(forest, ref + i, vBatch[i]);
+        hasher.write((const char*)vBatch.data(), nBatch * sizeof(CBlockIndexRecord));
+        fWritten = fwrite(vBatch.data(), sizeof(CBlockIndexRecord), nBatch, file) == nBatch;
+    }
+    header.hashRecords = hasher.GetHash();
+    fWritten = fWritten && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+    fWritten = fclose(file) == 0 && fWritten;
+    if (!fWritten || rename(pathTmp.string().c_str(), path.string().c_str()) != 0) {
+        remove(pathTmp.string().c_str());
+        return error("%s: cannot write %s", __func__, path.string());
+    }
+    return true;
+}
+
+bool CBlockIndexFile::Open(const boost::filesystem::path& path)
+{
+    // Threads read their own ranges at once: ask for all of it up front
+    if (!file.Open(path, MADV_WILLNEED))
+        return false;
+    if (file.size() < sizeof(header))
+        return error("%s: %s is truncated", __func__, path.string());
+    memcpy(&header, file.begin(), sizeof(header));
+
+    if (memcmp(header.pchMessageStart, Params().MessageStart(), sizeof(header.pchMessageStart)) != 0)
+        return error("%s: %s is for another network", __func__, path.string());
+    if (header.nVersion != BLOCK_INDEX_FILE_VERSION || header.nRecordSize != sizeof(CBlockIndexRecord) ||
+        header.nByteOrder != BLOCK_INDEX_FILE_BYTE_ORDER)
+        return error("%s: %s is version %u with %u-byte records, written by another build", __func__, path.string(),
+                     header.nVersion, header.nRecordSize);
+    if (header.nRecords >= NULL_BLOCK_REF ||
+        file.size() != sizeof(header) + header.nRecords * sizeof(CBlockIndexRecord))
+        return error("%s: %s holds %u bytes, not %u records", __func__, path.string(), file.size(), header.nRecords);
+
+    pRecords = (const CBlockIndexRecord*)(file.begin() + sizeof(header));
+    return true;
+}
+
+bool CBlockIndexFile::VerifyChecksum(const std::atomic<bool>* pfInterrupt) const
+{
+    CHashWriter hasher(SER_GETHASH, 0);
+    for (size_t nBegin = 0; nBegin < header.nRecords; nBegin += CHECKSUM_CHUNK_RECORDS) {
+        if (pfInterrupt && *pfInterrupt)
+            return false;
+        const size_t nChunk = std::min((size_t)header.nRecords - nBegin, CHECKSUM_CHUNK_RECORDS);
+        hasher.write((const char*)(pRecords + nBegin), nChunk * sizeof(CBlockIndexRecord));
+    }
+    if (hasher.GetHash() != header.hashRecords)
+        return error("%s: block index records do not match their checksum", __func__);
+    return true;
+}
+
+bool LoadBlockIndex(const CBlockIndexFile& file, CBlockForest& forest, unsigned int nThreads,
+                    CBlockIndexLoadStats& stats)
+{
+    TRACE_SPAN("LoadBlockIndex", "index");
+
+    if (forest.Size() != 0)
+        return error("%s: block forest is not empty", __func__);
+
+    const int64_t nStart = GetTimeMicros();
+    const size_t nRecords = file.GetRecordCount();
+    forest.Resize(nRecords);
+    forest.Reserve(nRecords);
+
+    // Copy ranges into the arenas on the other threads while this one
+    // fills the hash map, which cannot take concurrent inserts
+    std::atomic<size_t> nBadLinks(NULL_BLOCK_REF);
+    std::vector<std::thread> vThreads;
+    size_t nPerThread = std::max(MIN_RECORDS_PER_THREAD, (nRecords + nThreads - 1) / std::max(1u, nThreads));
+    for (size_t nBegin = 0; nBegin < nRecords; nBegin += nPerThread) {
+        size_t nEnd = std::min(nRecords, nBegin + nPerThread);
+        vThreads.emplace_back([&file, &forest, &nBadLinks, nBegin, nEnd] {
+            for (size_t n = nBegin; n < nEnd; n++) {
+                if (!CheckRecordLinks(file, n)) {
+                    size_t nFirst = nBadLinks.load();
+                    while (n < nFirst && !nBadLinks.compare_exchange_weak(nFirst, n)) {
+                    }
+                    return;
+                }
+                const CBlockIndexRecord& record = file.GetRecord(n);
+                CBlockForestHot& hot = forest.Hot(n);
+                hot.nPrev = record.nPrev;
+                hot.nSkip = record.nSkip;
+                hot.nHeight = record.nHeight;
+                hot.nTime = record.nTime;
+                hot.nBits = record.nBits;
+                hot.nFlags = record.nFlags;
+
+                CBlockForestCold& cold = forest.Cold(n);
+                cold.hashBlock = record.hashBlock;
+                cold.hashProof = record.hashProof;
+                cold.nStakeModifier = record.nStakeModifier;
+                cold.nStakeModifierChecksum = record.nStakeModifierChecksum;
+                cold.nStatus = record.nStatus;
+                cold.nFile = record.nFile;
+                cold.nDataPos = record.nDataPos;
+                cold.nUndoPos = record.nUndoPos;
+                cold.difficulty = record.difficulty;
+                cold.nChainTrust = UintToArith256(record.nChainTrust);
+                cold.nSequenceId = record.nSequenceId;
+            }
+        });
+    }
+
+    size_t nDuplicate = NULL_BLOCK_REF;
+    for (size_t n = 0; n < nRecords; n++) {
+        if (!forest.IndexBlock(file.GetRecord(n).hashBlock, n)) {
+            nDuplicate = n;
+            break;
+        }
+    }
+    for (std::thread& thread : vThreads)
+        thread.join();
+
+    if (nBadLinks != NULL_BLOCK_REF)
+        return error("%s: entry %u links outside the forest", __func__, nBadLinks.load());
+    if (nDuplicate != NULL_BLOCK_REF)
+        return error("%s: entry %u repeats block %s", __func__, nDuplicate,
+                     file.GetRecord(nDuplicate).hashBlock.ToString());
+
+    for (size_t n = 0; n < nRecords; n++)
+        if (file.GetRecord(n).nRecordFlags & BLOCK_INDEX_RECORD_CANDIDATE)
+            forest.AddCandidate(n);
+
+    stats.nRecords = nRecords;
+    stats.nBytes = file.GetSize();
+    stats.fMapped = file.IsMapped();
+    stats.nThreads = vThreads.size();
+    stats.nMicros = GetTimeMicros() - nStart;
+    return true;
+}
+
+bool VerifyBlockIndex(const CBlockForest& forest, BlockRef nBegin, BlockRef nEnd, unsigned int nThreads)
+{
+    TRACE_SPAN("VerifyBlockIndex", "index");
+
+    std::atomic<size_t> nBad(NULL_BLOCK_REF);
+    ParallelRanges(nBegin, nEnd, nThreads, [&forest, &nBad](size_t nRangeBegin, size_t nRangeEnd) {
+        for (BlockRef ref = nRangeBegin; ref < nRangeEnd && nBad == NULL_BLOCK_REF; ref++) {
+            const CBlockForestHot& hot = forest.Hot(ref);
+            const CBlockForestCold& cold = forest.Cold(ref);
+
+            // As CBlockForest::Add derives them
+            CHybridDifficultyState difficulty;
+            arith_uint256 nChainTrust;
+            bool fValid = forest.Find(cold.hashBlock) == ref;
+            if (hot.nPrev != NULL_BLOCK_REF) {
+                fValid = fValid && hot.nHeight == forest.Hot(hot.nPrev).nHeight + 1 &&
+                         hot.nSkip == forest.GetAncestor(hot.nPrev, GetSkipHeight(hot.nHeight));
+                difficulty = forest.Cold(hot.nPrev).difficulty;
+                nChainTrust = forest.Cold(hot.nPrev).nChainTrust;
+            } else {
+                fValid = fValid && hot.nHeight == 0 && hot.nSkip == NULL_BLOCK_REF;
+            }
+            nChainTrust += GetBlockTrust(hot, difficulty);
+            difficulty.Advance(hot.nFlags & FOREST_PROOF_OF_STAKE, hot.nBits, hot.nTime);
+            fValid = fValid && difficulty == cold.difficulty && nChainTrust == cold.nChainTrust;
+            if (!fValid) {
+                size_t nFirst = nBad.load();
+                while (ref < nFirst && !nBad.compare_exchange_weak(nFirst, ref)) {
+                }
+            }
+        }
+    });
+
+    if (nBad != NULL_BLOCK_REF) {
+        BlockRef ref = nBad;
+        return error("%s: entry %u (%s) at height %d does not follow from its parent", __func__, ref,
+                     forest.GetBlockHash(ref).ToString(), forest.Hot(ref).nHeight);
+    }
+    return true;
+}
+
+boost::filesystem::path GetBlockIndexFilePath()
+{
+    return GetDataDir() / "blocks" / "forest.dat";
+}
+
+bool LoadNodeBlockIndex()
+{
+    const boost::filesystem::path path = GetBlockIndexFilePath();
+    if (!boost::filesystem::exists(path))
+        return false;
+
+    // Shared with the verification thread, which hashes the mapped records
+    std::shared_ptr<CBlockIndexFile> pfile = std::make_shared<CBlockIndexFile>();
+    const unsigned int nThreads = GetNodeIndexThreads();
+    CBlockIndexLoadStats stats;
+    bool fLoaded;
+    {
+        LOCK(cs_main);
+        fLoaded = pfile->Open(path) && LoadBlockIndex(*pfile, g_blockForest, nThreads, stats);
+        if (!fLoaded)
+            g_blockForest.Clear();
+    }
+
+    // Used or not, the file is stale from here on: a node that stops
+    // uncleanly must not find it next time. The mapping outlives it.
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+
+    if (!fLoaded) {
+        LogPrintf("Cannot use %s, loading the block index from the database\n", path.string());
+        return false;
+    }
+    LogPrintf("Loaded block index from %s: %s\n", path.string(), stats.ToString());
+
+    const BlockRef nEnd = stats.nRecords;
+    fVerified = false;
+    fInterruptVerify = false;
+    threadVerify = std::thread([pfile, nEnd, nThreads] {
+        RenameThread("africoin-verifyidx");
+        const int64_t nStart = GetTimeMicros();
+        bool fValid = pfile->VerifyChecksum(&fInterruptVerify);
+        // Entries added since are derived by Add itself. Validation only
+        // waits for one slice at a time.
+        for (BlockRef nBegin = 0; fValid && nBegin < nEnd && !fInterruptVerify; nBegin += VERIFY_SLICE) {
+            LOCK(cs_main);
+            fValid = VerifyBlockIndex(g_blockForest, nBegin, std::min(nEnd, nBegin + VERIFY_SLICE), nThreads);
+        }
+        if (fInterruptVerify)
+            return;
+        if (!fValid) {
+            LogPrintf("Error: the block index loaded at startup is corrupt. Restart with -reindex.\n");
+            StartShutdown();
+            return;
+        }
+        fVerified = true;
+        LogPrintf("Block index verified: %u entries in %.1fs\n", nEnd, (GetTimeMicros() - nStart) * 1e-6);
+    });
+    return true;
+}
+
+void StopBlockIndexVerification()
+{
+    fInterruptVerify = true;
+    if (threadVerify.joinable())
+        threadVerify.join();
+}
+
+bool FlushNodeBlockIndex()
+{
+    if (!fVerified)
+        return error("%s: block index was not verified, not saving it", __func__);
+
+    const boost::filesystem::path path = GetBlockIndexFilePath();
+    const int64_t nStart = GetTimeMicros();
+    LOCK(cs_main);
+    if (g_blockForest.Size() == 0)
+        return true;
+    if (!WriteBlockIndexFile(path, g_blockForest))
+        return false;
+    LogPrintf("Saved block index to %s: %u entries in %.3fs\n", path.string(), g_blockForest.Size(),
+              (GetTimeMicros() - nStart) * 1e-6);
+    return true;
+}
+
+} // namespace Africoin
@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STORAGE_BLOCKINDEXFILE_H
+#define AFRICOIN_STORAGE_BLOCKINDEXFILE_H
+
+#include "consensus/blockforest.h"
+#include "storage/mappedfile.h"
+#include "uint256.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <type_traits>
+
+/**
+ * @file blockindexfile.h
+ * @brief The block forest saved as fixed-size records, for fast startup
+ *
+ * Loading millions of block index entries from the block tree database
+ * means a LevelDB iteration, a deserialization and a hash map insert per
+ * entry, then a pass to recompute chain trust, and a header check per
+ * entry, all before the node answers its first RPC.
+ *
+ * At shutdown the forest is written to blocks/forest.dat instead: a
+ * header followed by one CBlockIndexRecord per entry, in BlockRef order,
+ * in the host's byte order. Parent and skip links are stored as BlockRefs,
+ * i.e. record numbers, so they need no fixing up. At startup the file is
+ * mapped, and worker threads copy disjoint ranges of records into the
+ * forest arenas while the calling thread fills in the hash lookup. Only
+ * the checks that keep later walks in bounds are made on the way in.
+ *
+ * The rest is deferred to VerifyBlockIndex, which runs after RPC is up:
+ * heights, skip links, difficulty state and chain trust must follow from
+ * the parent's, and the records must hash to what the header says. A node
+ * that fails it shuts down and asks for -reindex.
+ *
+ * The file is removed once loaded, so a node that stops uncleanly loads
+ * the block tree database the slow way next time rather than a stale
+ * forest.
+ */
+
+namespace Africoin {
+
+static const uint32_t BLOCK_INDEX_FILE_VERSION = 1;
+/** Written as is: reads back as this value only on a host of the same byte order */
+static const uint32_t BLOCK_INDEX_FILE_BYTE_ORDER = 0x01020304;
+
+/** Record flags */
+enum BlockIndexRecordFlags : uint32_t {
+    BLOCK_INDEX_RECORD_CANDIDATE = (1 << 0),   //!< Was a tip candidate
+};
+
+/**
+ * @struct CBlockIndexFileHeader
+ * @brief First bytes of the block index file
+ */
+struct CBlockIndexFileHeader {
+    unsigned char pchMessageStart[4];
+    uint32_t nVersion;
+    uint32_t nRecordSize;        //!< sizeof(CBlockIndexRecord) of the writer
+    uint32_t nByteOrder;         //!< BLOCK_INDEX_FILE_BYTE_ORDER of the writer
+    uint64_t nRecords;
+    uint256 hashRecords;         //!< SHA256d of the records
+};
+static_assert(sizeof(CBlockIndexFileHeader) == 56, "records must stay 8-byte aligned after the header");
+
+/**
+ * @struct CBlockIndexRecord
+ * @brief One forest entry as stored in the file
+ */
+struct CBlockIndexRecord {
+    uint256 hashBlock;
+    uint256 hashProof;
+    uint256 nChainTrust;         //!< ArithToUint256 of the entry's chain trust
+    uint64_t nStakeModifier;
+    BlockRef nPrev;
+    BlockRef nSkip;
+    int32_t nHeight;
+    uint32_t nTime;
+    uint32_t nBits;
+    uint32_t nFlags;
+    uint32_t nStakeModifierChecksum;
+    uint32_t nStatus;
+    int32_t nFile;
+    uint32_t nDataPos;
+    uint32_t nUndoPos;
+    uint32_t nSequenceId;
+    CHybridDifficultyState difficulty;
+    uint32_t nRecordFlags;
+    uint32_t nReserved;
+};
+static_assert(sizeof(CBlockIndexRecord) == 184, "CBlockIndexRecord layout changed: bump BLOCK_INDEX_FILE_VERSION");
+static_assert(std::is_trivially_copyable<CBlockIndexRecord>::value, "records are mapped directly");
+
+/**
+ * @struct CBlockIndexLoadStats
+ * @brief What a load did
+ */
+struct CBlockIndexLoadStats {
+    uint64_t nRecords;
+    uint64_t nBytes;
+    bool fMapped;
+    unsigned int nThreads;
+    int64_t nMicros;
+
+    CBlockIndexLoadStats() : nRecords(0), nBytes(0), fMapped(false), nThreads(0), nMicros(0) {}
+
+    std::string ToString() const;
+};
+
+/**
+ * @brief Write every entry of the forest to path
+ *
+ * The file is written next to path and renamed into place. Caller must
+ * hold cs_main, which guards the forest.
+ */
+bool WriteBlockIndexFile(const boost::filesystem::path& path, const CBlockForest& forest);
+
+/**
+ * @class CBlockIndexFile
+ * @brief A mapped block index file whose header has been checked
+ */
+class CBlockIndexFile {
+public:
+    CBlockIndexFile() : pRecords(nullptr) {}
+
+    /** @brief Map path and check its header against this network and build */
+    bool Open(const boost::filesystem::path& path);
+
+    const CBlockIndexFileHeader& GetHeader() const { return header; }
+    size_t GetRecordCount() const { return header.nRecords; }
+    const CBlockIndexRecord& GetRecord(size_t n) const { return pRecords[n]; }
+    size_t GetSize() const { return file.size(); }
+    bool IsMapped() const { return file.IsMapped(); }
+
+    /**
+     * @brief True if the records hash to header.hashRecords
+     *
+     * Hashes a chunk at a time and gives up, returning false, once
+     * *pfInterrupt is set.
+     */
+    bool VerifyChecksum(const std::atomic<bool>* pfInterrupt = nullptr) const;
+
+private:
+    CMappedFile file;
+    CBlockIndexFileHeader header;
+    const CBlockIndexRecord* pRecords;
+};
+
+/**
+ * @brief Fill an empty forest from a block index file
+ *
+ * nThreads threads copy the records into the arenas while this thread
+ * builds the hash lookup; tip candidates are restored with their
+ * sequence numbers. Fails on duplicate hashes and on links that do not
+ * point to an earlier entry, leaving a partly filled forest that the
+ * caller must discard.
+ */
+bool LoadBlockIndex(const CBlockIndexFile& file, CBlockForest& forest, unsigned int nThreads,
+                    CBlockIndexLoadStats& stats);
+
+/**
+ * @brief The checks LoadBlockIndex defers, on entries [nBegin, nEnd)
+ *
+ * Each entry's height, skip link, difficulty state and chain trust must
+ * follow from its parent's, as CBlockForest::Add derives them. Reads
+ * only; split over nThreads threads.
+ */
+bool VerifyBlockIndex(const CBlockForest& forest, BlockRef nBegin, BlockRef nEnd, unsigned int nThreads);
+
+/** @brief blocks/forest.dat in the data directory */
+boost::filesystem::path GetBlockIndexFilePath();
+
+/**
+ * @brief Load g_blockForest from the block index file, if there is one
+ *
+ * Uses -par threads. On success the file is removed and verification
+ * starts in the background; false means no usable file, and the forest
+ * is left empty to be loaded from the block tree database. Call before
+ * other threads use the forest.
+ */
+bool LoadNodeBlockIndex();
+
+/** @brief Stop the background verification, at shutdown */
+void StopBlockIndexVerification();
+
+/**
+ * @brief Save g_blockForest for the next start, at shutdown
+ *
+ * Skipped while a forest loaded from the file has not finished the
+ * background verification, whether it failed or was interrupted: the
+ * next start then loads from the block tree database instead.
+ */
+bool FlushNodeBlockIndex();
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STORAGE_BLOCKINDEXFILE_H
@@ -0,0 +1,587 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file blockstore.cpp
+ * @brief Append-only, memory-mapped block files with a transaction index
+ */
+
+#include "storage/blockstore.h"
+
+#include "chainparams.h"
+#include "crypto/common.h"
+#include "hash.h"
+#include "metrics/trace.h"
+#include "primitives/block.h"
+#include "serialize.h"
+#include "streams.h"
+#include "tinyformat.h"
+#include "util.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Africoin {
+
+std::unique_ptr<CBlockStore> g_blockStore;
+
+// Largest window the pread fallback will fetch for a single transaction
+static const uint32_t MAX_TX_READ_WINDOW = 1 << 22;
+static const uint32_t INITIAL_TX_READ_WINDOW = 1024;
+
+static const uint32_t TX_INDEX_FILE_VERSION = 1;
+/** Written as is: reads back as this value only on a host of the same byte order */
+static const uint32_t TX_INDEX_FILE_BYTE_ORDER = 0x01020304;
+/** Entries per fread/fwrite of the saved index */
+static const size_t TX_INDEX_BATCH_ENTRIES = 4096;
+
+/** First bytes of txindex.dat; followed by nFiles covered sizes, the entries and their SHA256d */
+struct CTxIndexFileHeader {
+    unsigned char pchMessageStart[4];
+    uint32_t nVersion;
+    uint32_t nByteOrder;
+    uint32_t nFiles;
+    uint64_t nEntries;
+};
+static_assert(sizeof(CTxIndexFileHeader) == 24, "CTxIndexFileHeader layout changed: bump TX_INDEX_FILE_VERSION");
+
+/** One saved mapTxPos entry */
+struct CTxIndexFileEntry {
+    uint256 txid;
+    int32_t nFile;
+    uint32_t nPos;
+    uint32_t nTxOffset;
+};
+static_assert(sizeof(CTxIndexFileEntry) == 44, "CTxIndexFileEntry layout changed: bump TX_INDEX_FILE_VERSION");
+
+/** Bounds-checked cursor over raw serialized bytes */
+class RawReader {
+public:
+    RawReader(const unsigned char* pbeginIn, const unsigned char* pendIn) : p(pbeginIn), pend(pendIn) {}
+
+    bool Skip(uint64_t n)
+    {
+        if ((uint64_t)(pend - p) < n)
+            return false;
+        p += n;
+        return true;
+    }
+
+    bool ReadLE32(uint32_t& n)
+    {
+        if (pend - p < 4)
+            return false;
+        n = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        p += 4;
+        return true;
+    }
+
+    bool ReadLE64(uint64_t& n)
+    {
+        uint32_t nLo, nHi;
+        if (!ReadLE32(nLo) || !ReadLE32(nHi))
+            return false;
+        n = (uint64_t)nLo | ((uint64_t)nHi << 32);
+        return true;
+    }
+
+    bool ReadCompactSize(uint64_t& n)
+    {
+        if (p >= pend)
+            return false;
+        unsigned char chSize = *p++;
+        if (chSize < 253) {
+            n = chSize;
+            return true;
+        }
+        unsigned int nBytes = chSize == 253 ? 2 : chSize == 254 ? 4 : 8;
+        if ((size_t)(pend - p) < nBytes)
+            return false;
+        n = 0;
+        for (unsigned int i = 0; i < nBytes; i++)
+            n |= (uint64_t)p[i] << (8 * i);
+        p += nBytes;
+        return true;
+    }
+
+    bool PeekByte(unsigned char& ch) const
+    {
+        if (p >= pend)
+            return false;
+        ch = *p;
+        return true;
+    }
+
+private:
+    const unsigned char* p;
+    const unsigned char* pend;
+};
+
+bool ParseStakeTxPrev(const unsigned char* pbegin, const unsigned char* pend,
+                      uint32_t nOut, uint32_t& nTimeOut, CAmount& nValueOut)
+{
+    RawReader reader(pbegin, pend);
+
+    // nVersion, nTime
+    uint32_t nVersion, nTime;
+    if (!reader.ReadLE32(nVersion) || !reader.ReadLE32(nTime))
+        return false;
+
+    // Extended (witness) serialization: empty vin marker followed by flags
+    uint64_t nIn;
+    if (!reader.ReadCompactSize(nIn))
+        return false;
+    if (nIn == 0) {
+        unsigned char chFlags;
+        if (!reader.PeekByte(chFlags) || chFlags == 0 || !reader.Skip(1) || !reader.ReadCompactSize(nIn))
+            return false;
+    }
+
+    for (uint64_t i = 0; i < nIn; i++) {
+        uint64_t nScriptSize;
+        // prevout (32 + 4), scriptSig, nSequence
+        if (!reader.Skip(36) || !reader.ReadCompactSize(nScriptSize) || !reader.Skip(nScriptSize) || !reader.Skip(4))
+            return false;
+    }
+
+    uint64_t nOutputs;
+    if (!reader.ReadCompactSize(nOutputs) || nOut >= nOutputs)
+        return false;
+    for (uint32_t i = 0; i < nOut; i++) {
+        uint64_t nScriptSize;
+        if (!reader.Skip(8) || !reader.ReadCompactSize(nScriptSize) || !reader.Skip(nScriptSize))
+            return false;
+    }
+
+    uint64_t nValue;
+    if (!reader.ReadLE64(nValue))
+        return false;
+
+    nTimeOut = nTime;
+    nValueOut = (CAmount)nValue;
+    return true;
+}
+
+CBlockStore::CBlockStore(const boost::filesystem::path& dirIn, bool fMmapIn, uint32_t nMaxFileSizeIn)
+    : dir(dirIn), fMmap(fMmapIn), nMaxFileSize(nMaxFileSizeIn), nScannedBytes(0)
+{
+}
+
+CBlockStore::~CBlockStore()
+{
+    Flush();
+    if (!vFiles.empty())
+        WriteIndex();
+    for (std::unique_ptr<BlockFile>& file : vFiles) {
+        if (file->pmap)
+            munmap((void*)file->pmap, file->nMapSize);
+        if (file->fd >= 0)
+            close(file->fd);
+    }
+}
+
+boost::filesystem::path CBlockStore::GetFilePath(int nFile) const
+{
+    return dir / strprintf("blk%05u.dat", nFile);
+}
+
+boost::filesystem::path CBlockStore::GetIndexPath() const
+{
+    return dir / "txindex.dat";
+}
+
+bool CBlockStore::OpenFile(int nFile)
+{
+    boost::filesystem::path path = GetFilePath(nFile);
+    int fd = open(path.string().c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return error("%s: cannot open %s: %s", __func__, path.string(), strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return error("%s: cannot stat %s: %s", __func__, path.string(), strerror(errno));
+    }
+
+    std::unique_ptr<BlockFile> file(new BlockFile());
+    file->fd = fd;
+    file->nSize = (uint32_t)st.st_size;
+
+    if (fMmap) {
+        // Map the full file capacity once; only bytes below nSize are ever
+        // touched, so the mapping never needs to grow or move.
+        size_t nMapSize = std::max(nMaxFileSize, (uint32_t)st.st_size);
+        void* pmap = mmap(nullptr, nMapSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (pmap == MAP_FAILED)
+            LogPrintf("%s: mmap of %s failed (%s), falling back to pread\n", __func__, path.string(), strerror(errno));
+        else {
+            file->pmap = (const unsigned char*)pmap;
+            file->nMapSize = nMapSize;
+        }
+    }
+
+    std::unique_lock<std::shared_timed_mutex> lock(csFiles);
+    assert((int)vFiles.size() == nFile);
+    vFiles.push_back(std::move(file));
+    return true;
+}
+
+const unsigned char* CBlockStore::ReadAt(int nFile, uint32_t nPos, uint32_t& nLen, std::vector<unsigned char>& buf) const
+{
+    const BlockFile* file;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(csFiles);
+        if (nFile < 0 || nFile >= (int)vFiles.size())
+            return nullptr;
+        file = vFiles[nFile].get();
+    }
+
+    uint32_t nSize = file->nSize.load(std::memory_order_acquire);
+    if (nPos >= nSize)
+        return nullptr;
+    nLen = std::min(nLen, nSize - nPos);
+
+    if (file->pmap)
+        return file->pmap + nPos;
+
+    buf.resize(nLen);
+    ssize_t nRead = pread(file->fd, buf.data(), nLen, nPos);
+    if (nRead != (ssize_t)nLen)
+        return nullptr;
+    return buf.data();
+}
+
+void CBlockStore::IndexBlock(const CBlock& block, const CDiskBlockPos& pos, bool fOverwrite)
+{
+    std::unique_lock<std::shared_timed_mutex> lock(csIndex);
+    CDiskTxPos posTx(pos, GetSizeOfCompactSize(block.vtx.size()));
+    for (const CTransactionRef& tx : block.vtx) {
+        if (fOverwrite)
+            mapTxPos[tx->GetHash()] = posTx;
+        else
+            mapTxPos.emplace(tx->GetHash(), posTx);
+        posTx.nTxOffset += ::GetSerializeSize(*tx, SER_DISK, CLIENT_VERSION);
+    }
+}
+
+void CBlockStore::ConnectBlock(const CBlock& block, const CDiskBlockPos& pos)
+{
+    IndexBlock(block, pos, true);
+}
+
+void CBlockStore::DisconnectBlock(const CBlock& block, const CDiskBlockPos& pos)
+{
+    std::unique_lock<std::shared_timed_mutex> lock(csIndex);
+    for (const CTransactionRef& tx : block.vtx) {
+        auto it = mapTxPos.find(tx->GetHash());
+        if (it != mapTxPos.end() && it->second.nFile == pos.nFile && it->second.nPos == pos.nPos)
+            mapTxPos.erase(it);
+    }
+}
+
+bool CBlockStore::ScanFile(int nFile, uint32_t nPos)
+{
+    BlockFile* file = vFiles[nFile].get();
+    uint32_t nFileSize = file->nSize.load();
+    const uint32_t nStart = nPos;
+    std::vector<unsigned char> buf;
+
+    while (nPos + BLOCK_RECORD_HEADER_SIZE <= nFileSize) {
+        uint32_t nLen = BLOCK_RECORD_HEADER_SIZE;
+        const unsigned char* p = ReadAt(nFile, nPos, nLen, buf);
+        if (!p || memcmp(p, Params().MessageStart(), CMessageHeader::MESSAGE_START_SIZE) != 0)
+            break;
+        uint32_t nBlockSize = ReadLE32(p + 4);
+        if (nBlockSize > nFileSize - nPos - BLOCK_RECORD_HEADER_SIZE)
+            break;
+
+        CDiskBlockPos pos(nFile, nPos + BLOCK_RECORD_HEADER_SIZE);
+        CBlock block;
+        if (!ReadBlock(pos, block))
+            break;
+        IndexBlock(block, pos, false);
+        nPos += BLOCK_RECORD_HEADER_SIZE + nBlockSize;
+    }
+
+    if (nPos != nFileSize)
+        LogPrintf("%s: ignoring %u trailing bytes in %s\n", __func__, nFileSize - nPos, GetFilePath(nFile).string());
+    file->nSize.store(nPos, std::memory_order_release);
+    nScannedBytes += nFileSize - nStart;
+    return true;
+}
+
+bool CBlockStore::ReadIndex(std::vector<uint32_t>& vIndexed)
+{
+    const boost::filesystem::path path = GetIndexPath();
+    if (!boost::filesystem::exists(path))
+        return false;
+    FILE* file = fopen(path.string().c_str(), "rb");
+    if (!file)
+        return error("%s: cannot open %s", __func__, path.string());
+
+    CTxIndexFileHeader header;
+    bool fValid = fread(&header, sizeof(header), 1, file) == 1 &&
+                  memcmp(header.pchMessageStart, Params().MessageStart(), sizeof(header.pchMessageStart)) == 0 &&
+                  header.nVersion == TX_INDEX_FILE_VERSION && header.nByteOrder == TX_INDEX_FILE_BYTE_ORDER &&
+                  boost::filesystem::file_size(path) == sizeof(header) + header.nFiles * sizeof(uint32_t) +
+                                                           header.nEntries * sizeof(CTxIndexFileEntry) + sizeof(uint256);
+    CHashWriter hasher(SER_GETHASH, 0);
+    hasher.write((const char*)&header, sizeof(header));
+
+    // Files are only ever appended to, so each must still hold what was indexed
+    if (fValid) {
+        vIndexed.resize(header.nFiles);
+        fValid = fread(vIndexed.data(), sizeof(uint32_t), vIndexed.size(), file) == vIndexed.size();
+        hasher.write((const char*)vIndexed.data(), vIndexed.size() * sizeof(uint32_t));
+        for (uint32_t nFile = 0; fValid && nFile < header.nFiles; nFile++) {
+            boost::system::error_code ec;
+            uint64_t nSize = boost::filesystem::file_size(GetFilePath(nFile), ec);
+            fValid = !ec && nSize >= vIndexed[nFile];
+        }
+    }
+
+    std::vector<CTxIndexFileEntry> vBatch(TX_INDEX_BATCH_ENTRIES);
+    if (fValid)
+        mapTxPos.reserve(header.nEntries);
+    for (uint64_t n = 0; fValid && n < header.nEntries; n += vBatch.size()) {
+        size_t nBatch = std::min((uint64_t)vBatch.size(), header.nEntries - n);
+        fValid = fread(vBatch.data(), sizeof(CTxIndexFileEntry), nBatch, file) == nBatch;
+        hasher.write((const char*)vBatch.data(), nBatch * sizeof(CTxIndexFileEntry));
+        for (size_t i = 0; fValid && i < nBatch; i++) {
+            const CTxIndexFileEntry& entry = vBatch[i];
+            fValid = entry.nFile >= 0 && (uint32_t)entry.nFile < header.nFiles && entry.nPos < vIndexed[entry.nFile];
+            mapTxPos[entry.txid] = CDiskTxPos(CDiskBlockPos(entry.nFile, entry.nPos), entry.nTxOffset);
+        }
+    }
+
+    uint256 hashEntries;
+    fValid = fValid && fread(hashEntries.begin(), hashEntries.size(), 1, file) == 1 && hashEntries == hasher.GetHash();
+    fclose(file);
+    if (!fValid) {
+        mapTxPos.clear();
+        vIndexed.clear();
+        return error("%s: %s is damaged or stale, scanning the block files", __func__, path.string());
+    }
+    return true;
+}
+
+bool CBlockStore::WriteIndex() const
+{
+    TRACE_SPAN("WriteIndex", "io");
+
+    // No appends while the marks and the entries are taken together
+    std::lock_guard<std::mutex> lockWrite(csWrite);
+    std::vector<uint32_t> vIndexed;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(csFiles);
+        for (const std::unique_ptr<BlockFile>& file : vFiles)
+            vIndexed.push_back(file->nSize.load(std::memory_order_acquire));
+    }
+    std::shared_lock<std::shared_timed_mutex> lockIndex(csIndex);
+
+    CTxIndexFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.pchMessageStart, Params().MessageStart(), sizeof(header.pchMessageStart));
+    header.nVersion = TX_INDEX_FILE_VERSION;
+    header.nByteOrder = TX_INDEX_FILE_BYTE_ORDER;
+    header.nFiles = vIndexed.size();
+    header.nEntries = mapTxPos.size();
+
+    // Write then rename, so Open never reads a partial index
+    const boost::filesystem::path path = GetIndexPath();
+    boost::filesystem::path pathTmp = path;
+    pathTmp += ".new";
+    FILE* file = fopen(pathTmp.string().c_str(), "wb");
+    if (!file)
+        return error("%s: cannot open %s", __func__, pathTmp.string());
+
+    CHashWriter hasher(SER_GETHASH, 0);
+    hasher.write((const char*)&header, sizeof(header));
+    hasher.write((const char*)vIndexed.data(), vIndexed.size() * sizeof(uint32_t));
+    bool fWritten = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                    fwrite(vIndexed.data(), sizeof(uint32_t), vIndexed.size(), file) == vIndexed.size();
+
+    std::vector<CTxIndexFileEntry> vBatch;
+    vBatch.reserve(TX_INDEX_BATCH_ENTRIES);
+    for (auto it = mapTxPos.begin(); fWritten && it != mapTxPos.end();) {
+        vBatch.clear();
+        for (; it != mapTxPos.end() && vBatch.size() < TX_INDEX_BATCH_ENTRIES; ++it) {
+            CTxIndexFileEntry entry;
+            memset(&entry, 0, sizeof(entry));
+            entry.txid = it->first;
+            entry.nFile = it->second.nFile;
+            entry.nPos = it->second.nPos;
+            entry.nTxOffset = it->second.nTxOffset;
+            vBatch.push_back(entry);
+        }
+        hasher.write((const char*)vBatch.data(), vBatch.size() * sizeof(CTxIndexFileEntry));
+        fWritten = fwrite(vBatch.data(), sizeof(CTxIndexFileEntry), vBatch.size(), file) == vBatch.size();
+    }
+    uint256 hashEntries = hasher.GetHash();
+    fWritten = fWritten && fwrite(hashEntries.begin(), hashEntries.size(), 1, file) == 1;
+    fWritten = fclose(file) == 0 && fWritten;
+    if (!fWritten || rename(pathTmp.string().c_str(), path.string().c_str()) != 0) {
+        remove(pathTmp.string().c_str());
+        return error("%s: cannot write %s", __func__, path.string());
+    }
+    return true;
+}
+
+bool CBlockStore::Open()
+{
+    boost::filesystem::create_directories(dir);
+
+    std::vector<uint32_t> vIndexed;
+    ReadIndex(vIndexed);
+
+    int nFile = 0;
+    while (boost::filesystem::exists(GetFilePath(nFile))) {
+        if (!OpenFile(nFile) || !ScanFile(nFile, nFile < (int)vIndexed.size() ? vIndexed[nFile] : 0))
+            return false;
+        nFile++;
+    }
+    if (nFile == 0 && !OpenFile(0))
+        return false;
+
+    LogPrintf("Block store: %d files, %u transactions indexed, %u bytes scanned (%s)\n",
+              (int)vFiles.size(), GetTxCount(), nScannedBytes, fMmap ? "mmap" : "pread");
+    return true;
+}
+
+bool CBlockStore::WriteBlock(const CBlock& block, CDiskBlockPos& pos)
+{
+    TRACE_SPAN("WriteBlock", "io");
+    CDataStream ssBlock(SER_DISK, CLIENT_VERSION);
+    ssBlock << block;
+
+    std::vector<unsigned char> vRecord(BLOCK_RECORD_HEADER_SIZE);
+    memcpy(vRecord.data(), Params().MessageStart(), CMessageHeader::MESSAGE_START_SIZE);
+    WriteLE32(vRecord.data() + 4, (uint32_t)ssBlock.size());
+    vRecord.insert(vRecord.end(), ssBlock.begin(), ssBlock.end());
+    if (vRecord.size() > nMaxFileSize)
+        return error("%s: block of %u bytes does not fit in a block file", __func__, vRecord.size());
+
+    std::lock_guard<std::mutex> lock(csWrite);
+
+    BlockFile* file;
+    int nFile;
+    {
+        std::shared_lock<std::shared_timed_mutex> lockFiles(csFiles);
+        nFile = (int)vFiles.size() - 1;
+        file = vFiles.back().get();
+    }
+    uint32_t nPos = file->nSize.load(std::memory_order_relaxed);
+    if (nPos > 0 && (uint64_t)nPos + vRecord.size() > nMaxFileSize) {
+        if (!Flush() || !OpenFile(++nFile))
+            return false;
+        std::shared_lock<std::shared_timed_mutex> lockFiles(csFiles);
+        file = vFiles.back().get();
+        nPos = 0;
+    }
+    ssize_t nWritten = pwrite(file->fd, vRecord.data(), vRecord.size(), nPos);
+    if (nWritten != (ssize_t)vRecord.size())
+        return error("%s: write to %s failed: %s", __func__, GetFilePath(nFile).string(), strerror(errno));
+
+    // Publish only after the bytes are in the page cache
+    file->nSize.store(nPos + vRecord.size(), std::memory_order_release);
+
+    pos = CDiskBlockPos(nFile, nPos + BLOCK_RECORD_HEADER_SIZE);
+    IndexBlock(block, pos, false);
+    return true;
+}
+
+bool CBlockStore::ReadBlock(const CDiskBlockPos& pos, CBlock& block) const
+{
+    TRACE_SPAN("ReadBlock", "io");
+    if (pos.nPos < BLOCK_RECORD_HEADER_SIZE)
+        return false;
+
+    std::vector<unsigned char> buf;
+    uint32_t nLen = BLOCK_RECORD_HEADER_SIZE;
+    const unsigned char* p = ReadAt(pos.nFile, pos.nPos - BLOCK_RECORD_HEADER_SIZE, nLen, buf);
+    if (!p || nLen != BLOCK_RECORD_HEADER_SIZE)
+        return error("%s: no block record at %s", __func__, pos.ToString());
+    uint32_t nBlockSize = ReadLE32(p + 4);
+
+    nLen = nBlockSize;
+    p = ReadAt(pos.nFile, pos.nPos, nLen, buf);
+    if (!p || nLen != nBlockSize)
+        return error("%s: truncated block at %s", __func__, pos.ToString());
+
+    try {
+        CDataStream ssBlock((const char*)p, (const char*)p + nLen, SER_DISK, CLIENT_VERSION);
+        ssBlock >> block;
+    } catch (const std::exception& e) {
+        return error("%s: deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+    }
+    return true;
+}
+
+bool CBlockStore::IsFileMapped(int nFile) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(csFiles);
+    return nFile >= 0 && nFile < (int)vFiles.size() && vFiles[nFile]->pmap;
+}
+
+bool CBlockStore::FindTx(const uint256& txid, CDiskTxPos& pos) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(csIndex);
+    auto it = mapTxPos.find(txid);
+    if (it == mapTxPos.end())
+        return false;
+    pos = it->second;
+    return true;
+}
+
+bool CBlockStore::ReadStakeTxPrev(const CDiskTxPos& pos, uint32_t nOut, CStakeTxPrev& txPrev) const
+{
+    TRACE_SPAN("ReadStakeTxPrev", "io");
+    uint32_t nTxPos = pos.nPos + BLOCK_HEADER_DISK_SIZE + pos.nTxOffset;
+    std::vector<unsigned char> buf;
+
+    // With a mapping the whole rest of the file is one window; with pread,
+    // including after a failed mmap, grow the window until the output is reached.
+    uint32_t nWindow = IsFileMapped(pos.nFile) ? MAX_TX_READ_WINDOW : INITIAL_TX_READ_WINDOW;
+    for (;;) {
+        uint32_t nLen = nWindow;
+        const unsigned char* p = ReadAt(pos.nFile, nTxPos, nLen, buf);
+        if (!p)
+            return false;
+        if (ParseStakeTxPrev(p, p + nLen, nOut, txPrev.nTime, txPrev.nValue))
+            break;
+        if (nLen < nWindow || nWindow >= MAX_TX_READ_WINDOW)
+            return false;
+        nWindow *= 4;
+    }
+
+    txPrev.nTxOffset = BLOCK_HEADER_DISK_SIZE + pos.nTxOffset;
+    return true;
+}
+
+bool CBlockStore::Flush()
+{
+    std::shared_lock<std::shared_timed_mutex> lock(csFiles);
+    if (vFiles.empty())
+        return true;
+    if (fdatasync(vFiles.back()->fd) != 0)
+        return error("%s: fdatasync failed: %s", __func__, strerror(errno));
+    return true;
+}
+
+size_t CBlockStore::GetTxCount() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(csIndex);
+    return mapTxPos.size();
+}
+
+} // namespace Africoin
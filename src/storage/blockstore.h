@@ -0,0 +1,204 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STORAGE_BLOCKSTORE_H
+#define AFRICOIN_STORAGE_BLOCKSTORE_H
+
+#include "amount.h"
+#include "chain.h"
+#include "txdb.h"
+#include "uint256.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CBlock;
+
+/**
+ * @file blockstore.h
+ * @brief Append-only, memory-mapped block files with a transaction index
+ *
+ * Blocks are appended to blk?????.dat files using the usual record layout
+ * (message start, 32-bit size, serialized block). Files are never
+ * rewritten, so each one is mapped read-only once, at its maximum size,
+ * and the mapping stays valid for the lifetime of the store: readers get
+ * stable pointers without taking a lock per read.
+ *
+ * Every transaction is indexed by txid to a CDiskTxPos, i.e. (file, block
+ * offset, offset within the block). That is exactly what the kernel needs:
+ * nTxPrevOffset is the offset within the block, and txPrev.nTime and the
+ * staked output value are parsed straight out of the mapped bytes without
+ * deserializing the block or the transaction.
+ *
+ * A txid written in more than one block (a transaction on both sides of
+ * a fork) keeps the copy indexed first until ConnectBlock points it at
+ * the one the active chain holds; DisconnectBlock drops the entries that
+ * point into a block leaving it.
+ *
+ * Where mmap is unavailable (or disabled for comparison) reads fall back
+ * to pread() into a scratch buffer.
+ *
+ * The index is saved to txindex.dat at shutdown together with how many
+ * bytes of each file it covers. Block files are append-only, so the
+ * saved index stays correct for those bytes even after an unclean stop:
+ * Open loads it and only scans what was appended past each file's mark.
+ * A missing or damaged index, or a block file shorter than its mark,
+ * means a full scan.
+ */
+
+namespace Africoin {
+
+/** Maximum size of a blk?????.dat file; also the size of each mapping */
+static const unsigned int MAX_BLOCKFILE_SIZE = 0x8000000; // 128 MiB
+/** Serialized block header size; transaction offsets are relative to it */
+static const unsigned int BLOCK_HEADER_DISK_SIZE = 80;
+/** Record header in front of every block: message start + size */
+static const unsigned int BLOCK_RECORD_HEADER_SIZE = 8;
+
+/**
+ * @struct CStakeTxPrev
+ * @brief The parts of a staked transaction the kernel hash depends on
+ */
+struct CStakeTxPrev {
+    uint32_t nTime;       //!< txPrev.nTime
+    CAmount nValue;       //!< txPrev.vout[n].nValue
+    uint32_t nTxOffset;   //!< Offset of txPrev in its block, header included
+
+    CStakeTxPrev() : nTime(0), nValue(0), nTxOffset(0) {}
+};
+
+/**
+ * @brief Parse nTime and one output value from a serialized transaction
+ *
+ * Walks the transaction in place (skipping scripts and witness marker)
+ * without allocating. Returns false if the data is truncated or nOut is
+ * out of range.
+ */
+bool ParseStakeTxPrev(const unsigned char* pbegin, const unsigned char* pend,
+                      uint32_t nOut, uint32_t& nTimeOut, CAmount& nValueOut);
+
+/**
+ * @class CBlockStore
+ * @brief Owner of the block files and the in-memory transaction index
+ *
+ * Writes are serialized by an internal lock. Reads only take a shared
+ * lock to look up the file table; data is then read from the mapping.
+ */
+class CBlockStore {
+public:
+    /**
+     * @param dirIn      Directory holding the blk?????.dat files
+     * @param fMmapIn    Read through mmap (false: always use pread)
+     * @param nMaxFileSizeIn Roll over to a new file beyond this size
+     */
+    CBlockStore(const boost::filesystem::path& dirIn, bool fMmapIn = true,
+                uint32_t nMaxFileSizeIn = MAX_BLOCKFILE_SIZE);
+    ~CBlockStore();
+
+    CBlockStore(const CBlockStore&) = delete;
+    CBlockStore& operator=(const CBlockStore&) = delete;
+
+    /**
+     * @brief Open existing files and load or rebuild the transaction index
+     *
+     * A truncated record at the end of the last file (unclean shutdown)
+     * is ignored and will be overwritten by the next append.
+     */
+    bool Open();
+
+    /** @brief Save the transaction index for the next Open (also done on destruction) */
+    bool WriteIndex() const;
+
+    /** @brief Append a block; pos receives the position of its data */
+    bool WriteBlock(const CBlock& block, CDiskBlockPos& pos);
+
+    /** @brief Deserialize a block written at pos */
+    bool ReadBlock(const CDiskBlockPos& pos, CBlock& block) const;
+
+    /** @brief Position of a transaction by txid */
+    bool FindTx(const uint256& txid, CDiskTxPos& pos) const;
+
+    /** @brief Index the block's transactions at pos, which joined the active chain */
+    void ConnectBlock(const CBlock& block, const CDiskBlockPos& pos);
+
+    /**
+     * @brief The block at pos left the active chain: drop the entries
+     * pointing into it. Copies elsewhere come back when their block is
+     * connected.
+     */
+    void DisconnectBlock(const CBlock& block, const CDiskBlockPos& pos);
+
+    /** @brief Read txPrev.nTime and vout[nOut].nValue without deserializing */
+    bool ReadStakeTxPrev(const CDiskTxPos& pos, uint32_t nOut, CStakeTxPrev& txPrev) const;
+
+    /** @brief fsync the file currently being appended to */
+    bool Flush();
+
+    bool IsMapped() const { return fMmap; }
+    size_t GetTxCount() const;
+    /** Bytes of block files Open had to scan, i.e. not covered by the saved index */
+    uint64_t GetScannedBytes() const { return nScannedBytes; }
+
+private:
+    struct BlockFile {
+        int fd;
+        const unsigned char* pmap;      //!< nullptr when not mapped
+        size_t nMapSize;
+        std::atomic<uint32_t> nSize;    //!< Bytes of complete records
+
+        BlockFile() : fd(-1), pmap(nullptr), nMapSize(0), nSize(0) {}
+    };
+
+    struct TxidHasher {
+        size_t operator()(const uint256& txid) const { return txid.GetCheapHash(); }
+    };
+
+    boost::filesystem::path GetFilePath(int nFile) const;
+    boost::filesystem::path GetIndexPath() const;
+    bool OpenFile(int nFile);
+    /** Index the blocks of a file from nPos, where the saved index stops */
+    bool ScanFile(int nFile, uint32_t nPos);
+    /** Load txindex.dat; vIndexed receives the bytes of each file it covers */
+    bool ReadIndex(std::vector<uint32_t>& vIndexed);
+    bool IsFileMapped(int nFile) const;
+    /** Index the block's transactions; fOverwrite: also those indexed elsewhere */
+    void IndexBlock(const CBlock& block, const CDiskBlockPos& pos, bool fOverwrite);
+
+    /**
+     * @brief Access nLen bytes at nPos of a file
+     *
+     * Returns a pointer into the mapping, or into buf after a pread.
+     * nLen is clamped to the end of the file.
+     */
+    const unsigned char* ReadAt(int nFile, uint32_t nPos, uint32_t& nLen, std::vector<unsigned char>& buf) const;
+
+    const boost::filesystem::path dir;
+    const bool fMmap;
+    const uint32_t nMaxFileSize;
+    uint64_t nScannedBytes;
+
+    mutable std::shared_timed_mutex csFiles;
+    std::vector<std::unique_ptr<BlockFile>> vFiles;
+
+    mutable std::mutex csWrite;
+
+    mutable std::shared_timed_mutex csIndex;
+    std::unordered_map<uint256, CDiskTxPos, TxidHasher> mapTxPos;
+};
+
+/** Block store of the running node (nullptr until init opens it) */
+extern std::unique_ptr<CBlockStore> g_blockStore;
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STORAGE_BLOCKSTORE_H
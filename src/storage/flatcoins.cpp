@@ -0,0 +1,438 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file flatcoins.cpp
+ * @brief UTXO cache on an open-addressing table with compact entries
+ */
+
+#include "storage/flatcoins.h"
+
+#include "memusage.h"
+#include "metrics/trace.h"
+#include "tinyformat.h"
+#include "util.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <stdexcept>
+#include <string.h>
+
+namespace Africoin {
+
+std::string CFlatCoinsStats::ToString() const
+{
+    uint64_t nLookups = nHits + nMisses;
+    return strprintf("%u coins in %u slots (%.0f%% full), arena %.1f MiB (%.1f MiB unreferenced), "
+                     "%.1f%% hits, %u flushes, %u coins written (%u erased)",
+                     nEntries, nSlots, nSlots ? 100.0 * nEntries / nSlots : 0.0, nArenaBytes / 1048576.0,
+                     nArenaGarbage / 1048576.0, nLookups ? 100.0 * nHits / nLookups : 0.0, nFlushes, nCoinsWritten,
+                     nCoinsErased);
+}
+
+CFlatCoinsCache::CFlatCoinsCache(CCoinsView* baseIn, size_t nMaxBytesIn, size_t nFlushEntriesIn)
+    : base(baseIn), nMaxBytes(nMaxBytesIn), nFlushEntries(std::max((size_t)1, nFlushEntriesIn)), nMask(0),
+      nEntries(0), nArenaGarbage(0)
+{
+    Clear();
+}
+
+size_t CFlatCoinsCache::Find(const COutPoint& outpoint) const
+{
+    for (size_t i = Home(outpoint);; i = (i + 1) & nMask) {
+        const Slot& slot = vSlots[i];
+        if (!(slot.nFlags & SLOT_USED))
+            return NO_SLOT;
+        if (slot.n == outpoint.n && slot.txid == outpoint.hash)
+            return i;
+    }
+}
+
+size_t CFlatCoinsCache::Fetch(const COutPoint& outpoint) const
+{
+    size_t nPos = Find(outpoint);
+    if (nPos != NO_SLOT) {
+        stats.nHits++;
+        return nPos;
+    }
+    stats.nMisses++;
+
+    Coin coin;
+    if (!base->GetCoin(outpoint, coin))
+        return NO_SLOT;
+    bool fInserted;
+    nPos = Insert(outpoint, fInserted);
+    SetCoin(vSlots[nPos], coin);
+    // The base view has no such coin: spending it needs no write
+    if (coin.IsSpent())
+        vSlots[nPos].nFlags |= SLOT_FRESH;
+    return nPos;
+}
+
+size_t CFlatCoinsCache::Insert(const COutPoint& outpoint, bool& fInserted) const
+{
+    // Linear probing degrades quickly past 3/4 full
+    if ((nEntries + 1) * 4 > vSlots.size() * 3)
+        Grow(vSlots.size() * 2);
+
+    size_t i = Home(outpoint);
+    for (; vSlots[i].nFlags & SLOT_USED; i = (i + 1) & nMask) {
+        if (vSlots[i].n == outpoint.n && vSlots[i].txid == outpoint.hash) {
+            fInserted = false;
+            return i;
+        }
+    }
+
+    Slot& slot = vSlots[i];
+    slot.txid = outpoint.hash;
+    slot.n = outpoint.n;
+    slot.nCode = 0;
+    slot.nValue = -1;
+    slot.nScriptPos = 0;
+    slot.nTime = 0;
+    slot.nFlags = SLOT_USED;
+    nEntries++;
+    fInserted = true;
+    return i;
+}
+
+void CFlatCoinsCache::Erase(size_t nPos) const
+{
+    // Backward shift: pull later entries of the probe run into the hole
+    // unless that would move them before their home slot
+    size_t i = nPos;
+    for (size_t j = (i + 1) & nMask; vSlots[j].nFlags & SLOT_USED; j = (j + 1) & nMask) {
+        size_t k = Home(COutPoint(vSlots[j].txid, vSlots[j].n));
+        bool fStays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+        if (fStays)
+            continue;
+        vSlots[i] = vSlots[j];
+        i = j;
+    }
+    vSlots[i].nFlags = 0;
+    nEntries--;
+}
+
+void CFlatCoinsCache::Grow(size_t nSlots) const
+{
+    assert((nSlots & (nSlots - 1)) == 0);
+    std::vector<Slot> vOld(nSlots);
+    vOld.swap(vSlots);
+    nMask = nSlots - 1;
+    for (const Slot& slot : vOld) {
+        if (!(slot.nFlags & SLOT_USED))
+            continue;
+        size_t i = Home(COutPoint(slot.txid, slot.n));
+        while (vSlots[i].nFlags & SLOT_USED)
+            i = (i + 1) & nMask;
+        vSlots[i] = slot;
+    }
+}
+
+void CFlatCoinsCache::SetCoin(Slot& slot, const Coin& coin) const
+{
+    ReleaseScript(slot);
+    if (coin.IsSpent())
+        return;
+
+    const CScript& script = coin.out.scriptPubKey;
+    uint32_t nSize = script.size();
+    slot.nScriptPos = vArena.size();
+    vArena.resize(vArena.size() + sizeof(nSize) + nSize);
+    memcpy(&vArena[slot.nScriptPos], &nSize, sizeof(nSize));
+    if (nSize)
+        memcpy(vArena.data() + slot.nScriptPos + sizeof(nSize), script.data(), nSize);
+
+    slot.nCode = ((uint32_t)coin.nHeight << 2) | (coin.fCoinBase ? 2 : 0) | (coin.fCoinStake ? 1 : 0);
+    slot.nValue = coin.out.nValue;
+    slot.nTime = coin.nTime;
+}
+
+void CFlatCoinsCache::ReleaseScript(Slot& slot) const
+{
+    if (slot.nValue == -1)
+        return;
+    uint32_t nSize;
+    memcpy(&nSize, &vArena[slot.nScriptPos], sizeof(nSize));
+    nArenaGarbage += sizeof(nSize) + nSize;
+    slot.nValue = -1;
+}
+
+void CFlatCoinsCache::ReadCoin(const Slot& slot, Coin& coin) const
+{
+    coin.Clear();
+    if (slot.nValue == -1)
+        return;
+    uint32_t nSize;
+    memcpy(&nSize, &vArena[slot.nScriptPos], sizeof(nSize));
+    const unsigned char* pScript = vArena.data() + slot.nScriptPos + sizeof(nSize);
+    coin.out.nValue = slot.nValue;
+    coin.out.scriptPubKey.assign(pScript, pScript + nSize);
+    coin.nHeight = slot.nCode >> 2;
+    coin.fCoinBase = (slot.nCode >> 1) & 1;
+    coin.fCoinStake = slot.nCode & 1;
+    coin.nTime = slot.nTime;
+}
+
+bool CFlatCoinsCache::GetCoin(const COutPoint& outpoint, Coin& coin) const
+{
+    size_t nPos = Fetch(outpoint);
+    if (nPos == NO_SLOT)
+        return false;
+    ReadCoin(vSlots[nPos], coin);
+    return !coin.IsSpent();
+}
+
+bool CFlatCoinsCache::HaveCoin(const COutPoint& outpoint) const
+{
+    size_t nPos = Fetch(outpoint);
+    return nPos != NO_SLOT && vSlots[nPos].nValue != -1;
+}
+
+bool CFlatCoinsCache::GetCoinMeta(const COutPoint& outpoint, CFlatCoinMeta& meta) const
+{
+    size_t nPos = Fetch(outpoint);
+    if (nPos == NO_SLOT || vSlots[nPos].nValue == -1)
+        return false;
+    const Slot& slot = vSlots[nPos];
+    meta.nValue = slot.nValue;
+    meta.nHeight = slot.nCode >> 2;
+    meta.nTime = slot.nTime;
+    meta.fCoinBase = (slot.nCode >> 1) & 1;
+    meta.fCoinStake = slot.nCode & 1;
+    return true;
+}
+
+uint256 CFlatCoinsCache::GetBestBlock() const
+{
+    if (hashBlock.IsNull())
+        hashBlock = base->GetBestBlock();
+    return hashBlock;
+}
+
+void CFlatCoinsCache::SetBestBlock(const uint256& hashBlockIn)
+{
+    hashBlock = hashBlockIn;
+}
+
+void CFlatCoinsCache::AddCoin(const COutPoint& outpoint, Coin&& coin, bool fPossibleOverwrite)
+{
+    assert(!coin.IsSpent());
+    if (coin.out.scriptPubKey.IsUnspendable())
+        return;
+
+    bool fInserted;
+    Slot& slot = vSlots[Insert(outpoint, fInserted)];
+    bool fFresh = false;
+    if (!fPossibleOverwrite) {
+        if (slot.nValue != -1)
+            throw std::logic_error("Adding new coin that replaces non-pruned entry");
+        fFresh = !(slot.nFlags & SLOT_DIRTY);
+    }
+    SetCoin(slot, coin);
+    MarkDirty(slot);
+    if (fFresh)
+        slot.nFlags |= SLOT_FRESH;
+}
+
+bool CFlatCoinsCache::SpendCoin(const COutPoint& outpoint, Coin* moveto)
+{
+    size_t nPos = Fetch(outpoint);
+    if (nPos == NO_SLOT || vSlots[nPos].nValue == -1)
+        return false;
+
+    Slot& slot = vSlots[nPos];
+    if (moveto)
+        ReadCoin(slot, *moveto);
+    ReleaseScript(slot);
+    if (slot.nFlags & SLOT_FRESH)
+        Erase(nPos);
+    else
+        MarkDirty(slot);
+    return true;
+}
+
+bool CFlatCoinsCache::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlockIn)
+{
+    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); it = mapCoins.erase(it)) {
+        if (!(it->second.flags & CCoinsCacheEntry::DIRTY))
+            continue;
+        const Coin& coin = it->second.coin;
+        const bool fChildFresh = it->second.flags & CCoinsCacheEntry::FRESH;
+
+        size_t nPos = Find(it->first);
+        if (nPos == NO_SLOT) {
+            // A coin created and spent in the child never reaches us
+            if (fChildFresh && coin.IsSpent())
+                continue;
+            bool fInserted;
+            Slot& slot = vSlots[Insert(it->first, fInserted)];
+            SetCoin(slot, coin);
+            MarkDirty(slot);
+            if (fChildFresh)
+                slot.nFlags |= SLOT_FRESH;
+            continue;
+        }
+
+        Slot& slot = vSlots[nPos];
+        if (fChildFresh && slot.nValue != -1)
+            throw std::logic_error("FRESH flag misapplied to cache entry for base transaction with spendable outputs");
+        if ((slot.nFlags & SLOT_FRESH) && coin.IsSpent()) {
+            ReleaseScript(slot);
+            Erase(nPos);
+        } else {
+            SetCoin(slot, coin);
+            MarkDirty(slot);
+        }
+    }
+    hashBlock = hashBlockIn;
+    return true;
+}
+
+void CFlatCoinsCache::MarkDirty(Slot& slot)
+{
+    if (!(slot.nFlags & SLOT_DIRTY))
+        vDirty.push_back(COutPoint(slot.txid, slot.n));
+    slot.nFlags |= SLOT_DIRTY;
+}
+
+bool CFlatCoinsCache::Write()
+{
+    TRACE_SPAN("FlatCoinsWrite", "coins");
+
+    // Outpoints of FRESH coins spent since, or listed twice after being
+    // spent and re-added, resolve to no slot or to the same one
+    std::sort(vDirty.begin(), vDirty.end());
+    vDirty.erase(std::unique(vDirty.begin(), vDirty.end()), vDirty.end());
+
+    // As CReindexCoinsCache::Flush: runs of adjacent keys, and only the
+    // last batch (written even if empty) moves the best block. A full
+    // batch is written once the next dirty coin shows it is not the last.
+    CCoinsMap mapBatch;
+    mapBatch.reserve(std::min(nFlushEntries, vDirty.size()));
+    auto writeBatch = [&](const uint256& hashBestBlock) {
+        size_t nBatch = mapBatch.size();
+        if (!base->BatchWrite(mapBatch, hashBestBlock))
+            return error("CFlatCoinsCache::Write: write of %u coins failed", nBatch);
+        stats.nCoinsWritten += nBatch;
+        mapBatch.clear();
+        return true;
+    };
+    for (const COutPoint& outpoint : vDirty) {
+        size_t nPos = Find(outpoint);
+        if (nPos == NO_SLOT || !(vSlots[nPos].nFlags & SLOT_DIRTY))
+            continue;
+        if (mapBatch.size() >= nFlushEntries && !writeBatch(uint256()))
+            return false;
+        const Slot& slot = vSlots[nPos];
+        CCoinsCacheEntry& entry = mapBatch[outpoint];
+        ReadCoin(slot, entry.coin);
+        entry.flags = CCoinsCacheEntry::DIRTY | ((slot.nFlags & SLOT_FRESH) ? CCoinsCacheEntry::FRESH : 0);
+        if (slot.nValue == -1)
+            stats.nCoinsErased++;
+    }
+    if (!writeBatch(GetBestBlock()))
+        return false;
+    stats.nFlushes++;
+    return true;
+}
+
+bool CFlatCoinsCache::Sync()
+{
+    if (!Write())
+        return false;
+
+    // Everything now matches the base view; the deletions are done
+    for (const COutPoint& outpoint : vDirty) {
+        size_t nPos = Find(outpoint);
+        if (nPos == NO_SLOT)
+            continue;
+        if (vSlots[nPos].nValue == -1)
+            Erase(nPos);
+        else
+            vSlots[nPos].nFlags &= ~(SLOT_DIRTY | SLOT_FRESH);
+    }
+    // Keep the list for the next block, not the one sized by a bulk load
+    if (vDirty.capacity() > nFlushEntries)
+        std::vector<COutPoint>().swap(vDirty);
+    else
+        vDirty.clear();
+
+    if (nArenaGarbage > vArena.size() / 2)
+        CompactArena();
+    return true;
+}
+
+bool CFlatCoinsCache::Flush()
+{
+    if (!Write())
+        return false;
+    Clear();
+    return true;
+}
+
+bool CFlatCoinsCache::FlushIfOverBudget()
+{
+    size_t nUsage = DynamicMemoryUsage();
+    if (nUsage <= nMaxBytes)
+        return true;
+    LogPrint("coindb", "%s: %.1f MiB over the %.1f MiB budget, flushing %u coins\n", __func__,
+             (nUsage - nMaxBytes) / 1048576.0, nMaxBytes / 1048576.0, nEntries);
+    return Flush();
+}
+
+void CFlatCoinsCache::CompactArena()
+{
+    std::vector<unsigned char> vCompact;
+    vCompact.reserve(vArena.size() - nArenaGarbage);
+    for (Slot& slot : vSlots) {
+        if (!(slot.nFlags & SLOT_USED) || slot.nValue == -1)
+            continue;
+        uint32_t nSize;
+        memcpy(&nSize, &vArena[slot.nScriptPos], sizeof(nSize));
+        size_t nPos = vCompact.size();
+        vCompact.insert(vCompact.end(), vArena.begin() + slot.nScriptPos,
+                        vArena.begin() + slot.nScriptPos + sizeof(nSize) + nSize);
+        slot.nScriptPos = nPos;
+    }
+    vArena.swap(vCompact);
+    nArenaGarbage = 0;
+}
+
+void CFlatCoinsCache::Clear()
+{
+    // Release the memory rather than keep a table sized for the last peak
+    std::vector<Slot>(FLAT_COINS_MIN_SLOTS).swap(vSlots);
+    nMask = FLAT_COINS_MIN_SLOTS - 1;
+    nEntries = 0;
+    std::vector<unsigned char>().swap(vArena);
+    nArenaGarbage = 0;
+    std::vector<COutPoint>().swap(vDirty);
+}
+
+void CFlatCoinsCache::Reserve(size_t nEntriesIn)
+{
+    size_t nSlots = vSlots.size();
+    while (nEntriesIn * 4 > nSlots * 3)
+        nSlots *= 2;
+    if (nSlots > vSlots.size())
+        Grow(nSlots);
+}
+
+size_t CFlatCoinsCache::DynamicMemoryUsage() const
+{
+    return memusage::DynamicUsage(vSlots) + memusage::DynamicUsage(vArena) + memusage::DynamicUsage(vDirty);
+}
+
+CFlatCoinsStats CFlatCoinsCache::GetStats() const
+{
+    CFlatCoinsStats result = stats;
+    result.nEntries = nEntries;
+    result.nSlots = vSlots.size();
+    result.nArenaBytes = vArena.size();
+    result.nArenaGarbage = nArenaGarbage;
+    return result;
+}
+
+} // namespace Africoin
@@ -0,0 +1,215 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STORAGE_FLATCOINS_H
+#define AFRICOIN_STORAGE_FLATCOINS_H
+
+#include "amount.h"
+#include "coins.h"
+#include "uint256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file flatcoins.h
+ * @brief UTXO cache on an open-addressing table with compact entries
+ *
+ * CCoinsViewCache keeps every coin in its own std::unordered_map node:
+ * one allocation per coin (two for scripts that do not fit inline), and
+ * a bucket array and a node to chase on every lookup. Kernel checks and
+ * coin age only read the value, height and time, yet every lookup copies
+ * the script as well.
+ *
+ * CFlatCoinsCache stores each coin in one 64-byte slot of a flat table:
+ * outpoint, value, height, time, coinbase and coinstake flags, the
+ * DIRTY/FRESH flags, and the offset of the script in a pooled arena. The
+ * table uses linear probing with backward-shift deletion, so there are no
+ * tombstones and a lookup is a run of adjacent slots, usually one cache
+ * line. GetCoinMeta answers kernel and coin age queries without touching
+ * the arena.
+ *
+ * Entry flags follow CCoinsViewCache:
+ *
+ * - DIRTY: differs from the base view and must be written.
+ * - FRESH: the base view does not have it. A FRESH coin spent before a
+ *   flush is simply dropped, so it never costs a database write.
+ *
+ * Sync writes the DIRTY entries to the base view sorted by outpoint, in
+ * batches of nFlushEntries, and keeps the cache warm. Only the last
+ * batch moves the base view's best block. The outpoints are
+ * listed as they become dirty, so the cost of a sync follows the number
+ * of changes, not the size of the table. Flush does the same and then
+ * empties the cache. FlushIfOverBudget flushes once the table, arena and
+ * dirty list exceed the memory budget (e.g. -dbcache); call it at block
+ * boundaries, as FlushStateToDisk does.
+ *
+ * Not internally synchronised: callers hold cs_main, as for the rest of
+ * the chainstate.
+ */
+
+namespace Africoin {
+
+/** Coins per BatchWrite when flushing */
+static const size_t DEFAULT_FLAT_COINS_FLUSH_ENTRIES = 1 << 16;
+/** Slots in an empty table */
+static const size_t FLAT_COINS_MIN_SLOTS = 1 << 10;
+
+/**
+ * @struct CFlatCoinMeta
+ * @brief A coin without its script: what kernel checks and coin age read
+ */
+struct CFlatCoinMeta {
+    CAmount nValue;
+    int nHeight;
+    uint32_t nTime;
+    bool fCoinBase;
+    bool fCoinStake;
+
+    CFlatCoinMeta() : nValue(0), nHeight(0), nTime(0), fCoinBase(false), fCoinStake(false) {}
+};
+
+/**
+ * @struct CFlatCoinsStats
+ * @brief Cache counters, for logging and the benchmarks
+ */
+struct CFlatCoinsStats {
+    uint64_t nHits;
+    uint64_t nMisses;            //!< Lookups that went to the base view
+    uint64_t nFlushes;           //!< Sync and Flush calls that wrote
+    uint64_t nCoinsWritten;
+    uint64_t nCoinsErased;       //!< Deletions among nCoinsWritten
+    size_t nEntries;
+    size_t nSlots;
+    size_t nArenaBytes;
+    size_t nArenaGarbage;        //!< Arena bytes of scripts no longer referenced
+
+    CFlatCoinsStats()
+        : nHits(0), nMisses(0), nFlushes(0), nCoinsWritten(0), nCoinsErased(0), nEntries(0), nSlots(0),
+          nArenaBytes(0), nArenaGarbage(0) {}
+
+    std::string ToString() const;
+};
+
+/**
+ * @class CFlatCoinsCache
+ * @brief Write-back coins cache on a flat open-addressing table
+ */
+class CFlatCoinsCache : public CCoinsView {
+public:
+    /**
+     * @param baseIn     View to read misses from and write back to
+     * @param nMaxBytesIn Memory budget for the table and the script arena
+     */
+    CFlatCoinsCache(CCoinsView* baseIn, size_t nMaxBytesIn,
+                    size_t nFlushEntriesIn = DEFAULT_FLAT_COINS_FLUSH_ENTRIES);
+
+    CFlatCoinsCache(const CFlatCoinsCache&) = delete;
+    CFlatCoinsCache& operator=(const CFlatCoinsCache&) = delete;
+
+    // CCoinsView
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override;
+    bool HaveCoin(const COutPoint& outpoint) const override;
+    uint256 GetBestBlock() const override;
+    /** @brief Take the dirty entries of a child cache, as CCoinsViewCache::BatchWrite */
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock) override;
+
+    /** @brief Value, height, time and flags of an unspent coin, without its script */
+    bool GetCoinMeta(const COutPoint& outpoint, CFlatCoinMeta& meta) const;
+
+    void SetBestBlock(const uint256& hashBlock);
+
+    /**
+     * @brief Add an unspent coin
+     *
+     * As CCoinsViewCache::AddCoin: unspendable outputs are dropped, and
+     * without fPossibleOverwrite replacing an unspent coin is a logic
+     * error.
+     */
+    void AddCoin(const COutPoint& outpoint, Coin&& coin, bool fPossibleOverwrite);
+
+    /** @brief Spend a coin, moving it to moveto if given; false if spent or unknown */
+    bool SpendCoin(const COutPoint& outpoint, Coin* moveto = nullptr);
+
+    /** @brief Write the dirty entries to the base view and keep the cache */
+    bool Sync();
+
+    /** @brief Write the dirty entries to the base view and empty the cache */
+    bool Flush();
+
+    /** @brief Flush if over the memory budget; false only if a flush failed */
+    bool FlushIfOverBudget();
+
+    /** @brief Size the table for nEntries coins up front */
+    void Reserve(size_t nEntries);
+
+    /** @brief Table, arena and dirty list memory, as compared with the budget */
+    size_t DynamicMemoryUsage() const;
+
+    size_t GetCacheSize() const { return nEntries; }
+    size_t GetMaxBytes() const { return nMaxBytes; }
+
+    CFlatCoinsStats GetStats() const;
+
+private:
+    enum SlotFlags : uint8_t {
+        SLOT_DIRTY = CCoinsCacheEntry::DIRTY,
+        SLOT_FRESH = CCoinsCacheEntry::FRESH,
+        SLOT_USED = (1 << 7),
+    };
+
+    /** One coin; nValue -1 marks a spent coin whose deletion is yet to be written */
+    struct alignas(64) Slot {
+        uint256 txid;
+        uint32_t n;
+        uint32_t nCode;          //!< nHeight << 2 | fCoinBase << 1 | fCoinStake
+        int64_t nValue;
+        uint64_t nScriptPos;     //!< Length-prefixed script in vArena
+        uint32_t nTime;
+        uint8_t nFlags;
+    };
+    static_assert(sizeof(Slot) == 64, "a slot should fill one cache line");
+
+    static const size_t NO_SLOT = (size_t)-1;
+
+    size_t Home(const COutPoint& outpoint) const { return hasher(outpoint) & nMask; }
+    size_t Find(const COutPoint& outpoint) const;
+    /** Slot for outpoint, read from the base view on a miss (NO_SLOT if the base lacks it) */
+    size_t Fetch(const COutPoint& outpoint) const;
+    /** Slot for outpoint, a new empty one if absent; fInserted tells which */
+    size_t Insert(const COutPoint& outpoint, bool& fInserted) const;
+    void Erase(size_t nPos) const;
+    void Grow(size_t nSlots) const;
+
+    /** Set DIRTY, listing the outpoint for the next write if it was clean */
+    void MarkDirty(Slot& slot);
+    void SetCoin(Slot& slot, const Coin& coin) const;
+    void ReleaseScript(Slot& slot) const;
+    void ReadCoin(const Slot& slot, Coin& coin) const;
+    void CompactArena();
+    void Clear();
+    bool Write();
+
+    CCoinsView* base;
+    const size_t nMaxBytes;
+    const size_t nFlushEntries;
+    SaltedOutpointHasher hasher;
+    mutable uint256 hashBlock;     //!< Null until read from the base view or set
+
+    // Mutable: const lookups fill the cache from the base view
+    mutable std::vector<Slot> vSlots;
+    mutable size_t nMask;
+    mutable size_t nEntries;
+    mutable std::vector<unsigned char> vArena;
+    mutable size_t nArenaGarbage;
+    mutable CFlatCoinsStats stats;
+    /** Outpoints marked DIRTY since the last write, so a sync need not scan the table */
+    std::vector<COutPoint> vDirty;
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STORAGE_FLATCOINS_H
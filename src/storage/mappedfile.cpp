@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file mappedfile.cpp
+ * @brief Read-only view of a whole file, mapped when possible
+ */
+
+#include "storage/mappedfile.h"
+
+#include "util.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Africoin {
+
+CMappedFile::~CMappedFile()
+{
+    if (pmap)
+        munmap((void*)pmap, nSize);
+}
+
+bool CMappedFile::Open(const boost::filesystem::path& path, int nAdvice)
+{
+    int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd < 0)
+        return error("%s: cannot open %s: %s", __func__, path.string(), strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return error("%s: cannot stat %s: %s", __func__, path.string(), strerror(errno));
+    }
+    nSize = (size_t)st.st_size;
+
+    if (nSize > 0) {
+        void* pmapIn = mmap(nullptr, nSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pmapIn == MAP_FAILED)
+            LogPrintf("%s: mmap of %s failed (%s), reading it instead\n", __func__, path.string(), strerror(errno));
+        else {
+            madvise(pmapIn, nSize, nAdvice);
+            pmap = (const unsigned char*)pmapIn;
+        }
+    }
+    if (!pmap) {
+        vBuffer.resize(nSize);
+        size_t nRead = 0;
+        while (nRead < nSize) {
+            ssize_t n = read(fd, vBuffer.data() + nRead, nSize - nRead);
+            if (n <= 0) {
+                close(fd);
+                return error("%s: cannot read %s: %s", __func__, path.string(), strerror(errno));
+            }
+            nRead += n;
+        }
+    }
+    close(fd);
+    return true;
+}
+
+} // namespace Africoin
@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STORAGE_MAPPEDFILE_H
+#define AFRICOIN_STORAGE_MAPPEDFILE_H
+
+#include <boost/filesystem/path.hpp>
+
+#include <stddef.h>
+#include <vector>
+
+/**
+ * @file mappedfile.h
+ * @brief Read-only view of a whole file, mapped when possible
+ *
+ * For files read in one pass at startup (snapshots, the block index
+ * file). The file is mapped privately and read-only; if mmap fails it is
+ * read into memory instead, so callers see the same bytes either way.
+ * The view stays valid after the file is unlinked.
+ */
+
+namespace Africoin {
+
+/**
+ * @class CMappedFile
+ * @brief A file's bytes, from a mapping or a buffer
+ */
+class CMappedFile {
+public:
+    CMappedFile() : pmap(nullptr), nSize(0) {}
+    ~CMappedFile();
+
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+
+    /**
+     * @param nAdvice madvise() hint for the mapping, e.g. MADV_SEQUENTIAL
+     *                for one front-to-back pass
+     */
+    bool Open(const boost::filesystem::path& path, int nAdvice);
+
+    const unsigned char* begin() const { return pmap ? pmap : vBuffer.data(); }
+    const unsigned char* end() const { return begin() + nSize; }
+    size_t size() const { return nSize; }
+    bool IsMapped() const { return pmap != nullptr; }
+
+private:
+    const unsigned char* pmap;
+    size_t nSize;
+    std::vector<unsigned char> vBuffer;
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STORAGE_MAPPEDFILE_H
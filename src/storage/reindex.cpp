@@ -0,0 +1,581 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file reindex.cpp
+ * @brief Staged, parallel -reindex-chainstate
+ */
+
+#include "storage/reindex.h"
+
+#include "arith_uint256.h"
+#include "chain.h"
+#include "chainparams.h"
+#include "consensus/scriptcheck.h"
+#include "hash.h"
+#include "memusage.h"
+#include "metrics/trace.h"
+#include "pow.h"
+#include "primitives/block.h"
+#include "security/checkpoints.h"
+#include "security/stakemodifier.h"
+#include "storage/blockstore.h"
+#include "sync.h"
+#include "tinyformat.h"
+#include "txdb.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace Africoin {
+
+/** Modifier batches queued for the UTXO stage */
+static const size_t MAX_QUEUED_BATCHES = 4;
+
+CReindexOptions::CReindexOptions()
+    : nReadThreads(std::max(1u, std::thread::hardware_concurrency())), nWindow(DEFAULT_REINDEX_WINDOW),
+      nModifierBatch(DEFAULT_MODIFIER_BATCH), nCacheBytes((size_t)nDefaultDbCache << 20),
+      nFlushEntries(DEFAULT_REINDEX_FLUSH_ENTRIES), nProgressInterval(DEFAULT_REINDEX_PROGRESS_INTERVAL),
+      fCheckHeaders(true), pfInterrupt(nullptr), pblocktree(nullptr)
+{
+}
+
+std::string CReindexStats::ToString() const
+{
+    double nSeconds = nElapsedMicros * 1e-6;
+    return strprintf("height %d/%d (%.1f%%) after %.1fs: read %.0f blk/s %.1f MB/s, modifier %.0f blk/s, "
+                     "utxo %.0f blk/s %.0f tx/s, cache %.1f MiB, %u flushes, %u coins written",
+                     nHeight, nTipHeight, nTipHeight > 0 ? 100.0 * std::max(nHeight, 0) / nTipHeight : 100.0, nSeconds,
+                     read.GetBlockRate(nElapsedMicros), nSeconds > 0 ? read.nBytes / nSeconds / 1e6 : 0.0,
+                     modifier.GetBlockRate(nElapsedMicros), utxo.GetBlockRate(nElapsedMicros),
+                     nSeconds > 0 ? utxo.nTx / nSeconds : 0.0, nCacheUsage / 1048576.0, nFlushes, nCoinsWritten);
+}
+
+CReindexCoinsCache::CReindexCoinsCache(CCoinsView& baseIn, size_t nFlushEntriesIn)
+    : base(baseIn), nFlushEntries(std::max((size_t)1, nFlushEntriesIn)), nCachedCoinsUsage(0), nFlushes(0),
+      nCoinsWritten(0)
+{
+}
+
+CCoinsMap::iterator CReindexCoinsCache::FetchCoin(const COutPoint& outpoint)
+{
+    CCoinsMap::iterator it = cacheCoins.find(outpoint);
+    if (it != cacheCoins.end())
+        return it;
+    Coin coin;
+    if (!base.GetCoin(outpoint, coin))
+        return cacheCoins.end();
+    it = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint),
+                            std::forward_as_tuple(std::move(coin))).first;
+    nCachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+    return it;
+}
+
+const Coin* CReindexCoinsCache::GetCoin(const COutPoint& outpoint)
+{
+    CCoinsMap::iterator it = FetchCoin(outpoint);
+    if (it == cacheCoins.end() || it->second.coin.IsSpent())
+        return nullptr;
+    return &it->second.coin;
+}
+
+void CReindexCoinsCache::AddCoin(const COutPoint& outpoint, Coin&& coin, bool fPossibleOverwrite)
+{
+    assert(!coin.IsSpent());
+    if (coin.out.scriptPubKey.IsUnspendable())
+        return;
+
+    CCoinsMap::iterator it;
+    bool fInserted;
+    std::tie(it, fInserted) = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint),
+                                                 std::tuple<>());
+    bool fFresh = false;
+    if (!fInserted)
+        nCachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+    if (!fPossibleOverwrite) {
+        if (!it->second.coin.IsSpent())
+            throw std::logic_error("Adding new coin that replaces non-pruned entry");
+        fFresh = !(it->second.flags & CCoinsCacheEntry::DIRTY);
+    }
+    it->second.coin = std::move(coin);
+    it->second.flags |= CCoinsCacheEntry::DIRTY | (fFresh ? CCoinsCacheEntry::FRESH : 0);
+    nCachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+}
+
+bool CReindexCoinsCache::SpendCoin(const COutPoint& outpoint)
+{
+    CCoinsMap::iterator it = FetchCoin(outpoint);
+    if (it == cacheCoins.end() || it->second.coin.IsSpent())
+        return false;
+    nCachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+    if (it->second.flags & CCoinsCacheEntry::FRESH) {
+        cacheCoins.erase(it);
+    } else {
+        it->second.flags |= CCoinsCacheEntry::DIRTY;
+        it->second.coin.Clear();
+    }
+    return true;
+}
+
+bool CReindexCoinsCache::ApplyTransaction(const CTransaction& tx, int nHeight)
+{
+    if (!tx.IsCoinBase()) {
+        for (const CTxIn& txin : tx.vin)
+            if (!SpendCoin(txin.prevout))
+                return error("%s: %s spends missing or spent %s", __func__, tx.GetHash().ToString(),
+                             txin.prevout.ToString());
+    }
+
+    const uint256& txid = tx.GetHash();
+    bool fCoinBase = tx.IsCoinBase();
+    bool fCoinStake = tx.IsCoinStake();
+    for (size_t i = 0; i < tx.vout.size(); i++) {
+        // Pre-BIP30 duplicate coinbases overwrite, as in AddCoins
+        AddCoin(COutPoint(txid, i), Coin(tx.vout[i], nHeight, fCoinBase, fCoinStake, tx.nTime), fCoinBase);
+    }
+    return true;
+}
+
+bool CReindexCoinsCache::Flush(const uint256& hashBlock)
+{
+    TRACE_SPAN("ReindexFlush", "reindex");
+
+    std::vector<CCoinsMap::iterator> vDirty;
+    vDirty.reserve(cacheCoins.size());
+    for (CCoinsMap::iterator it = cacheCoins.begin(); it != cacheCoins.end(); ++it)
+        if (it->second.flags & CCoinsCacheEntry::DIRTY)
+            vDirty.push_back(it);
+    std::sort(vDirty.begin(), vDirty.end(),
+              [](const CCoinsMap::iterator& a, const CCoinsMap::iterator& b) { return a->first < b->first; });
+
+    // Only the last batch moves the best block: until it is written the
+    // base view is not the state as of hashBlock
+    for (size_t nBegin = 0; nBegin < vDirty.size(); nBegin += nFlushEntries) {
+        size_t nEnd = std::min(vDirty.size(), nBegin + nFlushEntries);
+        CCoinsMap mapBatch;
+        mapBatch.reserve(nEnd - nBegin);
+        for (size_t i = nBegin; i < nEnd; i++)
+            mapBatch.emplace(vDirty[i]->first, std::move(vDirty[i]->second));
+        if (!base.BatchWrite(mapBatch, nEnd == vDirty.size() ? hashBlock : uint256()))
+            return error("%s: write of %u coins failed", __func__, nEnd - nBegin);
+        nCoinsWritten += nEnd - nBegin;
+    }
+    if (vDirty.empty()) {
+        CCoinsMap mapEmpty;
+        if (!base.BatchWrite(mapEmpty, hashBlock))
+            return error("%s: best block update failed", __func__);
+    }
+
+    cacheCoins.clear();
+    nCachedCoinsUsage = 0;
+    nFlushes++;
+    return true;
+}
+
+size_t CReindexCoinsCache::DynamicMemoryUsage() const
+{
+    return memusage::DynamicUsage(cacheCoins) + nCachedCoinsUsage;
+}
+
+uint32_t GetForestModifierChecksum(const CBlockForest& forest, BlockRef ref)
+{
+    const CBlockForestHot& hot = forest.Hot(ref);
+    if (hot.nPrev == NULL_BLOCK_REF)
+        return 0;
+
+    // As PeerCoin's GetStakeModifierChecksum, over the CBlockIndex flag bits
+    const CBlockForestCold& cold = forest.Cold(ref);
+    unsigned int nFlags = hot.nFlags & (FOREST_PROOF_OF_STAKE | FOREST_STAKE_ENTROPY | FOREST_STAKE_MODIFIER);
+    CHashWriter ss(SER_GETHASH, 0);
+    ss << forest.Cold(hot.nPrev).nStakeModifierChecksum;
+    ss << nFlags << (hot.IsProofOfStake() ? cold.hashProof : uint256()) << cold.nStakeModifier;
+    arith_uint256 hashChecksum = UintToArith256(ss.GetHash());
+    hashChecksum >>= (256 - 32);
+    return (uint32_t)hashChecksum.GetLow64();
+}
+
+namespace {
+
+/**
+ * What the read and UTXO stages need of one block, copied out of the
+ * forest under cs_main before the run: the forest may grow (and its
+ * vectors move) while they work.
+ */
+struct ReindexEntry {
+    BlockRef ref;
+    uint256 hashBlock;
+    CDiskBlockPos pos;
+    bool fProofOfWork;     //!< PoW or hybrid block: its header carries proof of work
+
+    ReindexEntry() : ref(NULL_BLOCK_REF), fProofOfWork(false) {}
+};
+
+/** One block moving through the stages */
+struct ReindexBlock {
+    std::unique_ptr<CBlock> block;
+    BlockRef ref;
+    int nHeight;
+    uint32_t nBytes;
+
+    ReindexBlock() : ref(NULL_BLOCK_REF), nHeight(-1), nBytes(0) {}
+};
+
+typedef std::vector<ReindexBlock> ReindexBatch;
+
+/** Lock-free counters behind CReindexStageStats */
+struct StageCounters {
+    std::atomic<uint64_t> nBlocks;
+    std::atomic<uint64_t> nTx;
+    std::atomic<uint64_t> nBytes;
+    std::atomic<int64_t> nBusyMicros;
+
+    StageCounters() : nBlocks(0), nTx(0), nBytes(0), nBusyMicros(0) {}
+
+    void Add(const ReindexBlock& item, int64_t nMicros)
+    {
+        nBlocks.fetch_add(1, std::memory_order_relaxed);
+        nTx.fetch_add(item.block->vtx.size(), std::memory_order_relaxed);
+        nBytes.fetch_add(item.nBytes, std::memory_order_relaxed);
+        nBusyMicros.fetch_add(nMicros, std::memory_order_relaxed);
+    }
+
+    CReindexStageStats Get() const
+    {
+        CReindexStageStats stats;
+        stats.nBlocks = nBlocks.load(std::memory_order_relaxed);
+        stats.nTx = nTx.load(std::memory_order_relaxed);
+        stats.nBytes = nBytes.load(std::memory_order_relaxed);
+        stats.nBusyMicros = nBusyMicros.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+class ReindexPipeline {
+public:
+    ReindexPipeline(const CBlockStore& storeIn, CBlockForest& forestIn, CCoinsView& base,
+                    const CReindexOptions& optionsIn, CReindexStats& statsIn)
+        : store(storeIn), forest(forestIn), options(optionsIn), stats(statsIn), cache(base, optionsIn.nFlushEntries),
+          vWindow(std::max(1u, optionsIn.nWindow)), nNextRead(0), nNextModifier(0), fModifierDone(false),
+          fAbort(false), nStartMicros(GetTimeMicros()), nLastProgress(nStartMicros) {}
+
+    bool Run(BlockRef tip)
+    {
+        // Height order, genesis first. Only the modifier stage touches the
+        // forest after this, and it holds cs_main when it does.
+        {
+            LOCK(cs_main);
+            vEntries.resize(forest.Hot(tip).nHeight + 1);
+            for (BlockRef ref = tip; ref != NULL_BLOCK_REF; ref = forest.GetPrev(ref)) {
+                const CBlockForestHot& hot = forest.Hot(ref);
+                const CBlockForestCold& cold = forest.Cold(ref);
+                ReindexEntry& entry = vEntries[hot.nHeight];
+                entry.ref = ref;
+                entry.hashBlock = cold.hashBlock;
+                entry.pos = CDiskBlockPos(cold.nFile, cold.nDataPos);
+                entry.fProofOfWork = !hot.IsProofOfStake() || (hot.nFlags & FOREST_HYBRID);
+            }
+        }
+        stats = CReindexStats();
+        stats.nTipHeight = vEntries.size() - 1;
+        if (options.pblocktree && !options.pblocktree->WriteReindexing(true))
+            return error("%s: cannot set the reindex flag", __func__);
+
+        std::vector<std::thread> vThreads;
+        for (int i = 0; i < std::max(1, options.nReadThreads); i++)
+            vThreads.emplace_back(&ReindexPipeline::ThreadRead, this);
+        vThreads.emplace_back(&ReindexPipeline::ThreadModifier, this);
+
+        bool fOk = ConnectBatches();
+        if (!fOk)
+            Abort(strprintf("UTXO stage stopped at height %d", stats.nHeight + 1));
+        for (std::thread& thread : vThreads)
+            thread.join();
+
+        if (fOk)
+            fOk = cache.Flush(vEntries.back().hashBlock);
+        Report(true);
+        if (!fOk || fAbort)
+            return error("%s: %s", __func__, strError);
+        if (options.pblocktree && !options.pblocktree->WriteReindexing(false))
+            return error("%s: cannot clear the reindex flag", __func__);
+        return true;
+    }
+
+private:
+    void Abort(const std::string& strReason)
+    {
+        {
+            std::lock_guard<std::mutex> lock(csWindow);
+            if (!fAbort.exchange(true))
+                strError = strReason;
+        }
+        cvSpace.notify_all();
+        cvReady.notify_all();
+        {
+            // Taken so a thread between its predicate check and wait sees the flag
+            std::lock_guard<std::mutex> lock(csBatches);
+        }
+        cvBatches.notify_all();
+    }
+
+    /** Stage 1: read, deserialize and check blocks out of order */
+    void ThreadRead()
+    {
+        RenameThread("africoin-reindex");
+        const Consensus::Params& consensus = Params().GetConsensus();
+
+        while (true) {
+            size_t n;
+            {
+                std::unique_lock<std::mutex> lock(csWindow);
+                cvSpace.wait(lock, [&] {
+                    return fAbort || nNextRead >= vEntries.size() || nNextRead < nNextModifier + vWindow.size();
+                });
+                if (fAbort || nNextRead >= vEntries.size())
+                    return;
+                n = nNextRead++;
+            }
+
+            TRACE_SPAN("ReindexRead", "reindex");
+            int64_t nStart = GetTimeMicros();
+            const ReindexEntry& entry = vEntries[n];
+            const uint256& hash = entry.hashBlock;
+            ReindexBlock item;
+            item.ref = entry.ref;
+            item.nHeight = n;
+            item.block.reset(new CBlock());
+
+            if (!store.ReadBlock(entry.pos, *item.block))
+                return Abort(strprintf("cannot read block %s at height %d", hash.ToString(), n));
+            if (item.block->GetHash() != hash)
+                return Abort(strprintf("block at height %d does not match the index (%s)", n, hash.ToString()));
+            if (options.fCheckHeaders) {
+                if (entry.fProofOfWork && !CheckProofOfWork(hash, item.block->nBits, consensus))
+                    return Abort(strprintf("proof of work failed for block %s", hash.ToString()));
+                if (!PeerCoin::Checkpoints::CheckHardened(n, hash))
+                    return Abort(strprintf("block %s rejected by checkpoint at height %d", hash.ToString(), n));
+            }
+            item.nBytes = ::GetSerializeSize(*item.block, SER_DISK, CLIENT_VERSION);
+            counterRead.Add(item, GetTimeMicros() - nStart);
+
+            {
+                std::lock_guard<std::mutex> lock(csWindow);
+                vWindow[n % vWindow.size()] = std::move(item);
+            }
+            cvReady.notify_all();
+        }
+    }
+
+    /** Recompute and check one block's modifier; cs_main is held */
+    bool UpdateModifier(const ReindexBlock& item)
+    {
+        CBlockForestHot& hot = forest.Hot(item.ref);
+        CBlockForestCold& cold = forest.Cold(item.ref);
+
+        if (options.fnModifier) {
+            uint64_t nStakeModifier = cold.nStakeModifier;
+            bool fGenerated = hot.GeneratedStakeModifier();
+            if (!options.fnModifier(item.ref, nStakeModifier, fGenerated))
+                return false;
+            cold.nStakeModifier = nStakeModifier;
+            hot.nFlags = fGenerated ? (hot.nFlags | FOREST_STAKE_MODIFIER) : (hot.nFlags & ~FOREST_STAKE_MODIFIER);
+        }
+
+        cold.nStakeModifierChecksum = GetForestModifierChecksum(forest, item.ref);
+        return PeerCoin::StakeModifier::CheckStakeModifierCheckpoints(item.nHeight, cold.nStakeModifierChecksum);
+    }
+
+    /** Stage 2: modifiers in height order, a batch per cs_main acquisition */
+    void ThreadModifier()
+    {
+        RenameThread("africoin-modifier");
+
+        for (size_t n = 0; n < vEntries.size();) {
+            ReindexBatch batch;
+            {
+                // Wait for the next block, then take whatever else is ready
+                std::unique_lock<std::mutex> lock(csWindow);
+                cvReady.wait(lock, [&] { return fAbort || vWindow[n % vWindow.size()].block; });
+                if (fAbort)
+                    return;
+                while (n < vEntries.size() && batch.size() < options.nModifierBatch && vWindow[n % vWindow.size()].block) {
+                    batch.push_back(std::move(vWindow[n % vWindow.size()]));
+                    vWindow[n % vWindow.size()] = ReindexBlock();
+                    n++;
+                }
+                nNextModifier = n;
+            }
+            cvSpace.notify_all();
+
+            {
+                TRACE_SPAN("ReindexModifierBatch", "reindex");
+                int64_t nStart = GetTimeMicros();
+                LOCK(cs_main);
+                for (const ReindexBlock& item : batch) {
+                    if (!UpdateModifier(item))
+                        return Abort(strprintf("stake modifier check failed at height %d", item.nHeight));
+                }
+                int64_t nMicros = (GetTimeMicros() - nStart) / batch.size();
+                for (const ReindexBlock& item : batch)
+                    counterModifier.Add(item, nMicros);
+            }
+
+            std::unique_lock<std::mutex> lock(csBatches);
+            cvBatches.wait(lock, [&] { return fAbort || queueBatches.size() < MAX_QUEUED_BATCHES; });
+            if (fAbort)
+                return;
+            queueBatches.push_back(std::move(batch));
+            cvBatches.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(csBatches);
+        fModifierDone = true;
+        cvBatches.notify_all();
+    }
+
+    /** Stage 3: apply batches to the coins cache on the calling thread */
+    bool ConnectBatches()
+    {
+        while (true) {
+            ReindexBatch batch;
+            {
+                std::unique_lock<std::mutex> lock(csBatches);
+                cvBatches.wait(lock, [&] { return fAbort || fModifierDone || !queueBatches.empty(); });
+                if (fAbort)
+                    return false;
+                if (queueBatches.empty())
+                    return true;
+                batch = std::move(queueBatches.front());
+                queueBatches.pop_front();
+            }
+            cvBatches.notify_all();
+
+            for (const ReindexBlock& item : batch) {
+                TRACE_SPAN("ReindexConnect", "reindex");
+                int64_t nStart = GetTimeMicros();
+                for (const CTransactionRef& tx : item.block->vtx)
+                    if (!cache.ApplyTransaction(*tx, item.nHeight))
+                        return false;
+                if (cache.DynamicMemoryUsage() > options.nCacheBytes && !cache.Flush(vEntries[item.nHeight].hashBlock))
+                    return false;
+                counterUtxo.Add(item, GetTimeMicros() - nStart);
+                stats.nHeight = item.nHeight;
+            }
+            Report(false);
+            if (options.pfInterrupt && *options.pfInterrupt) {
+                Abort(strprintf("interrupted at height %d", stats.nHeight));
+                return false;
+            }
+        }
+    }
+
+    void Report(bool fFinal)
+    {
+        int64_t nNow = GetTimeMicros();
+        if (!fFinal && nNow - nLastProgress < options.nProgressInterval * 1000000)
+            return;
+        nLastProgress = nNow;
+
+        stats.read = counterRead.Get();
+        stats.modifier = counterModifier.Get();
+        stats.utxo = counterUtxo.Get();
+        stats.nFlushes = cache.GetFlushCount();
+        stats.nCoinsWritten = cache.GetCoinsWritten();
+        stats.nCacheUsage = cache.DynamicMemoryUsage();
+        stats.nElapsedMicros = nNow - nStartMicros;
+        if (options.fnProgress)
+            options.fnProgress(stats);
+        else
+            LogPrintf("Reindex chainstate: %s\n", stats.ToString());
+    }
+
+    const CBlockStore& store;
+    CBlockForest& forest;
+    const CReindexOptions& options;
+    CReindexStats& stats;
+    CReindexCoinsCache cache;
+    std::vector<ReindexEntry> vEntries;    //!< By height; read-only once the threads run
+
+    // Read -> modifier: ring of slots indexed by height
+    std::mutex csWindow;
+    std::condition_variable cvSpace;
+    std::condition_variable cvReady;
+    std::vector<ReindexBlock> vWindow;
+    size_t nNextRead;
+    size_t nNextModifier;
+
+    // Modifier -> UTXO
+    std::mutex csBatches;
+    std::condition_variable cvBatches;
+    std::deque<ReindexBatch> queueBatches;
+    bool fModifierDone;
+
+    std::atomic<bool> fAbort;
+    std::string strError;
+
+    StageCounters counterRead;
+    StageCounters counterModifier;
+    StageCounters counterUtxo;
+    const int64_t nStartMicros;
+    int64_t nLastProgress;
+};
+
+} // namespace
+
+bool ReindexChainstate(const CBlockStore& store, CBlockForest& forest, BlockRef tip, CCoinsView& base,
+                       const CReindexOptions& options, CReindexStats& stats)
+{
+    if (tip == NULL_BLOCK_REF)
+        return error("%s: no tip", __func__);
+
+    ReindexPipeline pipeline(store, forest, base, options, stats);
+    return pipeline.Run(tip);
+}
+
+CReindexOptions GetNodeReindexOptions()
+{
+    CReindexOptions options;
+    int nThreads = GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
+    if (nThreads <= 0)
+        nThreads += std::thread::hardware_concurrency();
+    options.nReadThreads = std::max(1, std::min(nThreads, MAX_SCRIPTCHECK_THREADS));
+    options.nCacheBytes = (size_t)std::max(nMinDbCache, GetArg("-dbcache", nDefaultDbCache)) << 20;
+    options.pblocktree = pblocktree.get();
+    options.fnModifier = [](BlockRef ref, uint64_t& nStakeModifier, bool& fGeneratedStakeModifier) {
+        return PeerCoin::StakeModifier::ComputeNextStakeModifier(g_blockForest, ref, nStakeModifier,
+                                                                 fGeneratedStakeModifier);
+    };
+    return options;
+}
+
+bool ReindexChainstate(const CBlockIndex* pindexTip, CCoinsView& base)
+{
+    if (!g_blockStore || !pindexTip)
+        return error("%s: block store not open", __func__);
+
+    BlockRef tip;
+    {
+        LOCK(cs_main);
+        tip = g_blockForest.Find(pindexTip->GetBlockHash());
+    }
+
+    CReindexOptions options = GetNodeReindexOptions();
+    LogPrintf("Reindexing chainstate to height %d with %d read threads, %u MiB coins cache\n",
+              pindexTip->nHeight, options.nReadThreads, options.nCacheBytes >> 20);
+    CReindexStats stats;
+    return ReindexChainstate(*g_blockStore, g_blockForest, tip, base, options, stats);
+}
+
+} // namespace Africoin
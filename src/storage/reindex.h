@@ -0,0 +1,220 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STORAGE_REINDEX_H
+#define AFRICOIN_STORAGE_REINDEX_H
+
+#include "coins.h"
+#include "consensus/blockforest.h"
+#include "uint256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <string>
+
+/**
+ * @file reindex.h
+ * @brief Staged, parallel -reindex-chainstate
+ *
+ * Rebuilds the UTXO set from the block files for the chain ending at a
+ * given tip of the block forest. A serial loop reading, checking and
+ * connecting one block at a time leaves every core but one idle, and on
+ * a PoS chain the per-block modifier work keeps it from overlapping with
+ * anything else. The pipeline runs three stages concurrently:
+ *
+ * 1. Read (nReadThreads workers): read a block from the block store,
+ *    deserialize it, check its hash against the index, check PoW for
+ *    PoW and hybrid blocks and check hardened checkpoints. Workers run up
+ *    to nWindow blocks ahead of stage 2; results are handed over in
+ *    height order through a ring of slots.
+ * 2. Modifier (one thread): recompute each block's stake modifier
+ *    (through fnModifier) and its checksum from its parent's, and verify
+ *    it against the modifier checkpoints. Past the v0.4 switch this is
+ *    one hash per block; v0.3 blocks still scan their candidate window
+ *    once per modifier interval. The chain is inherently serial here, so blocks are
+ *    taken in batches of nModifierBatch and cs_main is taken once per
+ *    batch rather than once per block.
+ * 3. UTXO (the calling thread): apply every transaction to a write-back
+ *    coins cache. When it exceeds nCacheBytes, dirty entries are sorted by
+ *    outpoint and written to the base view in batches of nFlushEntries,
+ *    so the database sees runs of adjacent keys instead of hash order.
+ *
+ * Scripts are not re-verified: these are blocks the node already
+ * connected and stored. Every stage keeps block, transaction, byte and
+ * busy-time counters; progress with per-stage throughput is reported
+ * every nProgressInterval seconds and at the end.
+ *
+ * A flush moves the base view's best block only with its last batch, so
+ * an interrupted flush leaves the marker at the previous flush. The run
+ * as a whole is covered by the block tree DB's reindex flag
+ * (CBlockTreeDB::WriteReindexing): set before the first block is read,
+ * cleared once the final flush is written. A node stopped in between
+ * finds the flag at the next start and reindexes from scratch.
+ */
+
+class CBlockIndex;
+class CBlockTreeDB;
+
+namespace Africoin {
+
+class CBlockStore;
+
+/** Blocks the read stage may run ahead of the modifier stage */
+static const unsigned int DEFAULT_REINDEX_WINDOW = 1024;
+/** Blocks per modifier batch (one cs_main acquisition each) */
+static const unsigned int DEFAULT_MODIFIER_BATCH = 256;
+/** Coins per sorted BatchWrite */
+static const size_t DEFAULT_REINDEX_FLUSH_ENTRIES = 1 << 16;
+/** Seconds between progress reports */
+static const int64_t DEFAULT_REINDEX_PROGRESS_INTERVAL = 10;
+
+/**
+ * @struct CReindexStageStats
+ * @brief Work done by one stage
+ */
+struct CReindexStageStats {
+    uint64_t nBlocks;
+    uint64_t nTx;
+    uint64_t nBytes;
+    int64_t nBusyMicros;     //!< Summed over the stage's threads
+
+    CReindexStageStats() : nBlocks(0), nTx(0), nBytes(0), nBusyMicros(0) {}
+
+    /** Blocks per second of wall-clock time */
+    double GetBlockRate(int64_t nElapsedMicros) const { return nElapsedMicros > 0 ? nBlocks * 1e6 / nElapsedMicros : 0; }
+};
+
+/**
+ * @struct CReindexStats
+ * @brief Progress of a reindex, as of the last report
+ */
+struct CReindexStats {
+    CReindexStageStats read;
+    CReindexStageStats modifier;
+    CReindexStageStats utxo;
+    int nHeight;             //!< Last block applied to the UTXO cache
+    int nTipHeight;
+    uint64_t nFlushes;
+    uint64_t nCoinsWritten;
+    size_t nCacheUsage;
+    int64_t nElapsedMicros;
+
+    CReindexStats() : nHeight(-1), nTipHeight(-1), nFlushes(0), nCoinsWritten(0), nCacheUsage(0), nElapsedMicros(0) {}
+
+    std::string ToString() const;
+};
+
+/**
+ * Recompute the stake modifier of a block whose parent is done. Gets the
+ * stored values and may replace them; false rejects the chain.
+ */
+typedef std::function<bool(BlockRef ref, uint64_t& nStakeModifier, bool& fGeneratedStakeModifier)> ReindexModifierFn;
+typedef std::function<void(const CReindexStats&)> ReindexProgressFn;
+
+/**
+ * @struct CReindexOptions
+ * @brief Pipeline shape; the defaults follow -par and -dbcache
+ */
+struct CReindexOptions {
+    int nReadThreads;
+    unsigned int nWindow;
+    unsigned int nModifierBatch;
+    size_t nCacheBytes;
+    size_t nFlushEntries;
+    int64_t nProgressInterval;
+    bool fCheckHeaders;              //!< PoW and checkpoint checks in the read stage
+    ReindexModifierFn fnModifier;    //!< Empty: keep the modifiers stored in the index
+    ReindexProgressFn fnProgress;    //!< Empty: log progress
+    const std::atomic<bool>* pfInterrupt; //!< Once set, stop after the current batch; null: run to the end
+    CBlockTreeDB* pblocktree;        //!< Holds the reindex flag during the run; null: no flag
+
+    CReindexOptions();
+};
+
+/**
+ * @class CReindexCoinsCache
+ * @brief Write-back coins cache that flushes in sorted batches
+ *
+ * Same entry semantics as CCoinsViewCache (DIRTY/FRESH flags, fresh
+ * coins spent before a flush never reach the database), but Flush sorts
+ * the dirty entries by outpoint and hands them to the base view in
+ * fixed-size batches.
+ */
+class CReindexCoinsCache {
+public:
+    CReindexCoinsCache(CCoinsView& baseIn, size_t nFlushEntriesIn = DEFAULT_REINDEX_FLUSH_ENTRIES);
+
+    CReindexCoinsCache(const CReindexCoinsCache&) = delete;
+    CReindexCoinsCache& operator=(const CReindexCoinsCache&) = delete;
+
+    /** @brief Coin at outpoint, from the cache or the base view (nullptr if spent or unknown) */
+    const Coin* GetCoin(const COutPoint& outpoint);
+
+    void AddCoin(const COutPoint& outpoint, Coin&& coin, bool fPossibleOverwrite);
+
+    /** @brief false if the coin is spent or unknown */
+    bool SpendCoin(const COutPoint& outpoint);
+
+    /** @brief Spend a transaction's inputs and add its outputs; false on a missing input */
+    bool ApplyTransaction(const CTransaction& tx, int nHeight);
+
+    /**
+     * @brief Write every dirty entry in sorted batches and empty the cache
+     *
+     * Only the last batch carries hashBlock; the others pass a null hash,
+     * which leaves the base view's best block where it was.
+     */
+    bool Flush(const uint256& hashBlock);
+
+    size_t DynamicMemoryUsage() const;
+    size_t GetCacheSize() const { return cacheCoins.size(); }
+    uint64_t GetFlushCount() const { return nFlushes; }
+    uint64_t GetCoinsWritten() const { return nCoinsWritten; }
+
+private:
+    CCoinsMap::iterator FetchCoin(const COutPoint& outpoint);
+
+    CCoinsView& base;
+    const size_t nFlushEntries;
+    CCoinsMap cacheCoins;
+    size_t nCachedCoinsUsage;
+    uint64_t nFlushes;
+    uint64_t nCoinsWritten;
+};
+
+/** @brief Stake modifier checksum of a block from its parent's (0 for genesis) */
+uint32_t GetForestModifierChecksum(const CBlockForest& forest, BlockRef ref);
+
+/**
+ * @brief Rebuild the UTXO set for the chain ending at tip
+ *
+ * Takes cs_main itself, once to copy the chain's block positions out of
+ * the forest and once per modifier batch, so headers may keep arriving
+ * during the run. The caller must not hold it.
+ *
+ * @param store   Block files; each entry's nFile/nDataPos must be set
+ * @param forest  Block index; modifier checksums are rewritten
+ * @param base    Coins database to write to (expected empty)
+ */
+bool ReindexChainstate(const CBlockStore& store, CBlockForest& forest, BlockRef tip, CCoinsView& base,
+                       const CReindexOptions& options, CReindexStats& stats);
+
+/**
+ * @brief Options for the running node: -par read threads, -dbcache coins
+ * cache, modifiers from StakeModifier::ComputeNextStakeModifier on the
+ * global forest
+ */
+CReindexOptions GetNodeReindexOptions();
+
+/**
+ * @brief -reindex-chainstate for the running node: global block store and
+ * forest, GetNodeReindexOptions
+ */
+bool ReindexChainstate(const CBlockIndex* pindexTip, CCoinsView& base);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STORAGE_REINDEX_H
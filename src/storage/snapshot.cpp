@@ -0,0 +1,513 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file snapshot.cpp
+ * @brief Chainstate snapshots (assume-UTXO) anchored at hardened checkpoints
+ */
+
+#include "storage/snapshot.h"
+
+#include "chainparams.h"
+#include "clientversion.h"
+#include "coins.h"
+#include "consensus/fee_burner.h"
+#include "hash.h"
+#include "init.h"
+#include "metrics/trace.h"
+#include "security/checkpoints.h"
+#include "security/stakemodifier.h"
+#include "storage/blockstore.h"
+#include "storage/mappedfile.h"
+#include "storage/reindex.h"
+#include "streams.h"
+#include "sync.h"
+#include "tinyformat.h"
+#include "util.h"
+#include "utiltime.h"
+#include "validation.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <ios>
+#include <memory>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <thread>
+#include <vector>
+
+namespace Africoin {
+
+namespace {
+
+/** Flags of a forest entry that the stake modifier computation sets */
+static const uint32_t MODIFIER_FLAGS = FOREST_STAKE_ENTROPY | FOREST_STAKE_MODIFIER;
+
+/** Stake modifier state of one height */
+struct CSnapshotModifier {
+    uint64_t nStakeModifier;
+    uint32_t nStakeModifierChecksum;
+    uint32_t nFlags;
+
+    CSnapshotModifier() : nStakeModifier(0), nStakeModifierChecksum(0), nFlags(0) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action)
+    {
+        READWRITE(nStakeModifier);
+        READWRITE(nStakeModifierChecksum);
+        READWRITE(nFlags);
+    }
+};
+
+/** Everything in a snapshot besides the coins */
+struct CSnapshotState {
+    std::vector<CSnapshotModifier> vModifiers;   //!< Heights 0..nHeight
+    std::vector<uint256> vProofHashes;           //!< The last heights up to nHeight
+    CHybridDifficultyState difficulty;
+    CChainSlices::RailwayNodeMap mapRailwayNodes;
+    FeeBurnLedger ledger;
+
+    template <typename Stream>
+    static void SerializeTrack(Stream& s, const CDifficultyTrack& track)
+    {
+        s << track.nBits << track.nTime << track.nTimePrev;
+    }
+
+    template <typename Stream>
+    static void UnserializeTrack(Stream& s, CDifficultyTrack& track)
+    {
+        s >> track.nBits >> track.nTime >> track.nTimePrev;
+    }
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s << vModifiers << vProofHashes;
+        SerializeTrack(s, difficulty.pow);
+        SerializeTrack(s, difficulty.pos);
+        WriteCompactSize(s, mapRailwayNodes.size());
+        for (const auto& item : mapRailwayNodes) {
+            const RailwayStakingNode& node = item.second;
+            s << node.code << node.name << node.allocation << node.isActive << node.lastStakeTime
+              << node.totalStakes << ser_double_to_uint64(node.stakingWeight);
+        }
+        s << ledger;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        s >> vModifiers >> vProofHashes;
+        UnserializeTrack(s, difficulty.pow);
+        UnserializeTrack(s, difficulty.pos);
+        mapRailwayNodes.clear();
+        uint64_t nNodes = ReadCompactSize(s);
+        for (uint64_t i = 0; i < nNodes; i++) {
+            RailwayStakingNode node;
+            uint64_t nWeight;
+            s >> node.code >> node.name >> node.allocation >> node.isActive >> node.lastStakeTime
+              >> node.totalStakes >> nWeight;
+            node.stakingWeight = ser_uint64_to_double(nWeight);
+            if (!mapRailwayNodes.emplace(node.code, node).second)
+                throw std::ios_base::failure("duplicate railway node " + node.code);
+        }
+        s >> ledger;
+    }
+};
+
+/** Stream over the bytes of a mapped or buffered snapshot */
+class CSnapshotReader {
+public:
+    CSnapshotReader(const unsigned char* pbeginIn, const unsigned char* pendIn)
+        : p(pbeginIn), pend(pendIn) {}
+
+    int GetType() const { return SER_DISK; }
+    int GetVersion() const { return CLIENT_VERSION; }
+
+    void read(char* pch, size_t nSize)
+    {
+        if ((size_t)(pend - p) < nSize)
+            throw std::ios_base::failure("CSnapshotReader::read(): end of data");
+        memcpy(pch, p, nSize);
+        p += nSize;
+    }
+
+    template <typename T>
+    CSnapshotReader& operator>>(T& obj)
+    {
+        ::Unserialize(*this, obj);
+        return *this;
+    }
+
+    const unsigned char* Position() const { return p; }
+    bool AtEnd() const { return p == pend; }
+
+private:
+    const unsigned char* p;
+    const unsigned char* pend;
+};
+
+/** Serialize every coin of the view as a snapshot record and pass the bytes on */
+template <typename Callback>
+bool ForEachCoinRecord(const CCoinsView& view, Callback fn)
+{
+    std::unique_ptr<CCoinsViewCursor> pcursor(view.Cursor());
+    if (!pcursor)
+        return error("%s: coins view has no cursor", __func__);
+
+    CDataStream ssRecord(SER_DISK, CLIENT_VERSION);
+    for (; pcursor->Valid(); pcursor->Next()) {
+        COutPoint outpoint;
+        Coin coin;
+        if (!pcursor->GetKey(outpoint) || !pcursor->GetValue(coin))
+            return error("%s: unable to read coin", __func__);
+        ssRecord.clear();
+        ssRecord << outpoint << coin;
+        if (!fn(ssRecord))
+            return false;
+    }
+    return true;
+}
+
+std::thread threadValidate;
+std::atomic<bool> fInterruptValidate(false);
+std::atomic<bool> fSnapshotInvalid(false);
+
+} // namespace
+
+CSnapshotMetadata::CSnapshotMetadata()
+    : nVersion(SNAPSHOT_VERSION), nHeight(-1), nCoins(0)
+{
+    memset(pchMessageStart, 0, sizeof(pchMessageStart));
+}
+
+std::string CSnapshotStats::ToString() const
+{
+    double nSeconds = nMicros * 1e-6;
+    return strprintf("%u coins, %.1f MiB %s in %.1fs (%.0f coins/s), %u flushes", nCoins, nBytes / 1048576.0,
+                     fMapped ? "mapped" : "read", nSeconds, nSeconds > 0 ? nCoins / nSeconds : 0.0, nFlushes);
+}
+
+uint256 GetSnapshotCoinsHash(const CCoinsView& view, uint64_t& nCoins)
+{
+    CHashWriter hasher(SER_GETHASH, 0);
+    nCoins = 0;
+    bool fRead = ForEachCoinRecord(view, [&](const CDataStream& ssRecord) {
+        hasher.write(ssRecord.data(), ssRecord.size());
+        nCoins++;
+        return true;
+    });
+    return fRead ? hasher.GetHash() : uint256();
+}
+
+bool WriteSnapshot(const boost::filesystem::path& path, const CCoinsView& view, const CBlockForest& forest, BlockRef base,
+                   const CChainSlices::RailwayNodeMap& mapNodes, const FeeBurnLedger& ledger,
+                   CSnapshotMetadata& metadata)
+{
+    TRACE_SPAN("WriteSnapshot", "snapshot");
+
+    const int nHeight = forest.Hot(base).nHeight;
+    const uint256& hashBlock = forest.GetBlockHash(base);
+    if (view.GetBestBlock() != hashBlock)
+        return error("%s: coins view is not at block %s", __func__, hashBlock.ToString());
+    if (ledger.GetHeight() != nHeight)
+        return error("%s: fee burn ledger at height %d, not %d", __func__, ledger.GetHeight(), nHeight);
+
+    CSnapshotState state;
+    state.vModifiers.resize(nHeight + 1);
+    state.vProofHashes.resize(std::min(nHeight + 1, DEFAULT_SNAPSHOT_PROOF_DEPTH));
+    const int nProofBegin = nHeight + 1 - (int)state.vProofHashes.size();
+    for (BlockRef ref = base; ref != NULL_BLOCK_REF; ref = forest.GetPrev(ref)) {
+        const CBlockForestHot& hot = forest.Hot(ref);
+        const CBlockForestCold& cold = forest.Cold(ref);
+        CSnapshotModifier& modifier = state.vModifiers[hot.nHeight];
+        modifier.nStakeModifier = cold.nStakeModifier;
+        modifier.nStakeModifierChecksum = cold.nStakeModifierChecksum;
+        modifier.nFlags = hot.nFlags;
+        if (hot.nHeight >= nProofBegin)
+            state.vProofHashes[hot.nHeight - nProofBegin] = cold.hashProof;
+    }
+    state.difficulty = forest.Cold(base).difficulty;
+    state.mapRailwayNodes = mapNodes;
+    state.ledger = ledger;
+
+    CDataStream ssState(SER_DISK, CLIENT_VERSION);
+    ssState << state;
+
+    memcpy(metadata.pchMessageStart, Params().MessageStart(), sizeof(metadata.pchMessageStart));
+    metadata.nVersion = SNAPSHOT_VERSION;
+    metadata.nHeight = nHeight;
+    metadata.hashBlock = hashBlock;
+    metadata.nCoins = 0;
+    metadata.hashState = Hash(ssState.begin(), ssState.end());
+
+    // Write then rename, so a node never loads a partial snapshot
+    boost::filesystem::path pathTmp = path;
+    pathTmp += ".new";
+    FILE* file = fopen(pathTmp.string().c_str(), "wb");
+    if (!file)
+        return error("%s: cannot open %s", __func__, pathTmp.string());
+
+    // The header goes first with the coin count and hash still unknown,
+    // and is rewritten in place once the coins are out.
+    CDataStream ssHeader(SER_DISK, CLIENT_VERSION);
+    ssHeader << metadata;
+    bool fWritten = fwrite(ssHeader.data(), 1, ssHeader.size(), file) == ssHeader.size() &&
+                    fwrite(ssState.data(), 1, ssState.size(), file) == ssState.size();
+
+    CHashWriter hasher(SER_GETHASH, 0);
+    fWritten = fWritten && ForEachCoinRecord(view, [&](const CDataStream& ssRecord) {
+        hasher.write(ssRecord.data(), ssRecord.size());
+        metadata.nCoins++;
+        return fwrite(ssRecord.data(), 1, ssRecord.size(), file) == ssRecord.size();
+    });
+    metadata.hashCoins = hasher.GetHash();
+
+    if (fWritten) {
+        ssHeader.clear();
+        ssHeader << metadata;
+        fWritten = fseek(file, 0, SEEK_SET) == 0 && fwrite(ssHeader.data(), 1, ssHeader.size(), file) == ssHeader.size();
+    }
+    fWritten = fclose(file) == 0 && fWritten;
+    if (!fWritten || rename(pathTmp.string().c_str(), path.string().c_str()) != 0) {
+        remove(pathTmp.string().c_str());
+        return error("%s: cannot write %s", __func__, path.string());
+    }
+
+    LogPrintf("Wrote chainstate snapshot at height %d (%s): %u coins\n", nHeight, hashBlock.ToString(), metadata.nCoins);
+    return true;
+}
+
+bool LoadSnapshot(const boost::filesystem::path& path, CBlockForest& forest, CCoinsView& base,
+                  CChainSlices::RailwayNodeMap& mapNodes, FeeBurnLedger& ledger, CSnapshotMetadata& metadata,
+                  CSnapshotStats& stats, size_t nFlushEntries)
+{
+    TRACE_SPAN("LoadSnapshot", "snapshot");
+    const int64_t nTimeStart = GetTimeMicros();
+    nFlushEntries = std::max((size_t)1, nFlushEntries);
+
+    if (!base.GetBestBlock().IsNull())
+        return error("%s: chainstate is not empty", __func__);
+
+    // One front-to-back pass: let the kernel read ahead and drop pages behind
+    CMappedFile file;
+    if (!file.Open(path, MADV_SEQUENTIAL))
+        return false;
+    stats.fMapped = file.IsMapped();
+    stats.nBytes = file.size();
+    CSnapshotReader reader(file.begin(), file.end());
+
+    // --- Header: the block must be a hardened checkpoint we have the header of ---
+    try {
+        reader >> metadata;
+    } catch (const std::exception& e) {
+        return error("%s: %s is not a snapshot: %s", __func__, path.string(), e.what());
+    }
+    if (metadata.nVersion != SNAPSHOT_VERSION)
+        return error("%s: unsupported snapshot version %u", __func__, metadata.nVersion);
+    if (memcmp(metadata.pchMessageStart, Params().MessageStart(), sizeof(metadata.pchMessageStart)) != 0)
+        return error("%s: snapshot is for another network", __func__);
+
+    const int nHeight = metadata.nHeight;
+    const uint256 hashCheckpoint = nHeight >= 0 ? PeerCoin::Checkpoints::GetCheckpointHash(nHeight) : uint256();
+    if (hashCheckpoint.IsNull() || hashCheckpoint != metadata.hashBlock)
+        return error("%s: snapshot block %s at height %d is not a hardened checkpoint", __func__,
+                     metadata.hashBlock.ToString(), nHeight);
+    // The header is the file's own claim; the coins and the state section
+    // must match what the assume-UTXO map or a signed sync checkpoint says
+    // they hash to
+    PeerCoin::Checkpoints::CAssumeUtxoData trusted;
+    if (!PeerCoin::Checkpoints::GetAssumeUtxo(nHeight, trusted))
+        return error("%s: no trusted snapshot hash at height %d", __func__, nHeight);
+    if (trusted.hashCoins != metadata.hashCoins || trusted.nCoins != metadata.nCoins)
+        return error("%s: snapshot coins %s (%u) differ from the trusted %s (%u) at height %d", __func__,
+                     metadata.hashCoins.ToString(), metadata.nCoins, trusted.hashCoins.ToString(), trusted.nCoins,
+                     nHeight);
+    if (trusted.hashState != metadata.hashState)
+        return error("%s: snapshot state %s differs from the trusted %s at height %d", __func__,
+                     metadata.hashState.ToString(), trusted.hashState.ToString(), nHeight);
+    const BlockRef ref = forest.Find(metadata.hashBlock);
+    if (ref == NULL_BLOCK_REF || forest.Hot(ref).nHeight != nHeight)
+        return error("%s: snapshot block %s is not in the block index", __func__, metadata.hashBlock.ToString());
+
+    // --- State section ---
+    CSnapshotState state;
+    const unsigned char* pStateBegin = reader.Position();
+    try {
+        reader >> state;
+    } catch (const std::exception& e) {
+        return error("%s: corrupt state section: %s", __func__, e.what());
+    }
+    if (Hash(pStateBegin, reader.Position()) != metadata.hashState)
+        return error("%s: state section does not match its hash", __func__);
+    if (state.vModifiers.size() != (size_t)nHeight + 1 || state.vProofHashes.size() > (size_t)nHeight + 1)
+        return error("%s: state section does not cover heights 0..%d", __func__, nHeight);
+    if (!state.ledger.IsConsistent() || state.ledger.GetHeight() != nHeight)
+        return error("%s: fee burn ledger does not end at height %d", __func__, nHeight);
+    if (!(state.difficulty == forest.Cold(ref).difficulty))
+        return error("%s: difficulty state does not match the headers", __func__);
+    for (const auto& item : state.mapRailwayNodes)
+        if (item.first != item.second.code)
+            return error("%s: railway node %s filed under %s", __func__, item.second.code, item.first);
+
+    // Modifiers go onto the checkpointed chain. Where the proof hashes are
+    // included each checksum is recomputed from its parent's, which ties
+    // the modifiers to the headers; all of them must pass the modifier
+    // checkpoints.
+    const int nProofBegin = nHeight + 1 - (int)state.vProofHashes.size();
+    for (BlockRef r = ref; r != NULL_BLOCK_REF; r = forest.GetPrev(r)) {
+        CBlockForestHot& hot = forest.Hot(r);
+        CBlockForestCold& cold = forest.Cold(r);
+        const CSnapshotModifier& modifier = state.vModifiers[hot.nHeight];
+        if ((modifier.nFlags & ~MODIFIER_FLAGS) != (hot.nFlags & ~MODIFIER_FLAGS))
+            return error("%s: block flags at height %d do not match the headers", __func__, hot.nHeight);
+        if (!PeerCoin::StakeModifier::CheckStakeModifierCheckpoints(hot.nHeight, modifier.nStakeModifierChecksum))
+            return error("%s: stake modifier checkpoint failed at height %d", __func__, hot.nHeight);
+        hot.nFlags = modifier.nFlags;
+        cold.nStakeModifier = modifier.nStakeModifier;
+        cold.nStakeModifierChecksum = modifier.nStakeModifierChecksum;
+        if (hot.nHeight >= nProofBegin)
+            cold.hashProof = state.vProofHashes[hot.nHeight - nProofBegin];
+    }
+    for (BlockRef r = ref; r != NULL_BLOCK_REF && forest.Hot(r).nHeight >= std::max(nProofBegin, 1); r = forest.GetPrev(r)) {
+        if (GetForestModifierChecksum(forest, r) != forest.Cold(r).nStakeModifierChecksum)
+            return error("%s: stake modifier checksum mismatch at height %d", __func__, forest.Hot(r).nHeight);
+    }
+
+    // --- Coins: one pass, hashed while the record is in cache ---
+    CHashWriter hasher(SER_GETHASH, 0);
+    CCoinsMap mapBatch;
+    mapBatch.reserve(std::min((uint64_t)nFlushEntries, metadata.nCoins));
+    try {
+        for (uint64_t i = 0; i < metadata.nCoins; i++) {
+            const unsigned char* pRecord = reader.Position();
+            COutPoint outpoint;
+            CCoinsCacheEntry entry;
+            reader >> outpoint >> entry.coin;
+            hasher.write((const char*)pRecord, reader.Position() - pRecord);
+            if (entry.coin.IsSpent())
+                return error("%s: spent coin %s in snapshot", __func__, outpoint.ToString());
+            entry.flags = CCoinsCacheEntry::DIRTY | CCoinsCacheEntry::FRESH;
+            // A full batch is written once the next coin shows it is not
+            // the last; only the last one moves the best block
+            if (mapBatch.size() >= nFlushEntries) {
+                stats.nCoins += mapBatch.size();
+                if (!base.BatchWrite(mapBatch, uint256()))
+                    return error("%s: write of %u coins failed", __func__, mapBatch.size());
+                mapBatch.clear();
+                stats.nFlushes++;
+            }
+            if (!mapBatch.emplace(outpoint, std::move(entry)).second)
+                return error("%s: duplicate coin %s in snapshot", __func__, outpoint.ToString());
+        }
+    } catch (const std::exception& e) {
+        return error("%s: corrupt coins section: %s", __func__, e.what());
+    }
+
+    // Until the coins are known to be the trusted ones the best block
+    // stays null, so a failed or interrupted load is never taken for the
+    // chainstate at the snapshot block
+    if (!reader.AtEnd())
+        return error("%s: trailing data after %u coins", __func__, metadata.nCoins);
+    if (hasher.GetHash() != metadata.hashCoins)
+        return error("%s: coins do not match the snapshot hash", __func__);
+    stats.nCoins += mapBatch.size();
+    if (!base.BatchWrite(mapBatch, metadata.hashBlock))
+        return error("%s: write of %u coins failed", __func__, mapBatch.size());
+    stats.nFlushes++;
+
+    mapNodes.swap(state.mapRailwayNodes);
+    ledger = std::move(state.ledger);
+    stats.nMicros = GetTimeMicros() - nTimeStart;
+    LogPrintf("Loaded chainstate snapshot at height %d (%s): %s\n", nHeight, metadata.hashBlock.ToString(),
+              stats.ToString());
+    return true;
+}
+
+bool ValidateSnapshot(const CBlockStore& store, CBlockForest& forest, const CSnapshotMetadata& metadata,
+                      CCoinsView& viewBackground, const CReindexOptions& options, CReindexStats& stats)
+{
+    TRACE_SPAN("ValidateSnapshot", "snapshot");
+
+    BlockRef ref;
+    uint32_t nChecksum;
+    {
+        LOCK(cs_main);
+        ref = forest.Find(metadata.hashBlock);
+        if (ref == NULL_BLOCK_REF)
+            return error("%s: snapshot block %s is not in the block index", __func__, metadata.hashBlock.ToString());
+        nChecksum = forest.Cold(ref).nStakeModifierChecksum;
+    }
+
+    // Recomputes every modifier and checksum up to the snapshot block
+    if (!ReindexChainstate(store, forest, ref, viewBackground, options, stats))
+        return error("%s: cannot rebuild the chainstate to height %d", __func__, metadata.nHeight);
+
+    {
+        LOCK(cs_main);
+        if (forest.Cold(ref).nStakeModifierChecksum != nChecksum)
+            return error("%s: snapshot stake modifiers differ from history at height %d", __func__, metadata.nHeight);
+    }
+
+    uint64_t nCoins;
+    uint256 hashCoins = GetSnapshotCoinsHash(viewBackground, nCoins);
+    if (nCoins != metadata.nCoins || hashCoins != metadata.hashCoins)
+        return error("%s: snapshot coins differ from history at height %d (%u coins, %u in snapshot)", __func__,
+                     metadata.nHeight, nCoins, metadata.nCoins);
+
+    LogPrintf("Chainstate snapshot at height %d validated against history\n", metadata.nHeight);
+    return true;
+}
+
+bool ValidateSnapshot(const CSnapshotMetadata& metadata, CCoinsView& viewBackground)
+{
+    if (!g_blockStore)
+        return error("%s: block store not open", __func__);
+
+    // The background view is not the chainstate: an interrupted run is
+    // simply started again, with no block tree reindex flag
+    CReindexOptions options = GetNodeReindexOptions();
+    options.pfInterrupt = &fInterruptValidate;
+    options.pblocktree = nullptr;
+    CReindexStats stats;
+    return ValidateSnapshot(*g_blockStore, g_blockForest, metadata, viewBackground, options, stats);
+}
+
+void StartSnapshotValidation(const CSnapshotMetadata& metadata, std::unique_ptr<CCoinsView> pviewBackground)
+{
+    fInterruptValidate = false;
+    threadValidate = std::thread([metadata, pview = std::move(pviewBackground)] {
+        RenameThread("africoin-snapval");
+        const bool fValid = ValidateSnapshot(metadata, *pview);
+        // Stopped at shutdown: nothing learnt, the next start validates again
+        if (fInterruptValidate)
+            return;
+        if (!fValid) {
+            fSnapshotInvalid = true;
+            LogPrintf("Error: the chainstate snapshot at height %d does not match the block history. "
+                      "Restart with -reindex-chainstate.\n", metadata.nHeight);
+            StartShutdown();
+        }
+    });
+}
+
+void StopSnapshotValidation()
+{
+    fInterruptValidate = true;
+    if (threadValidate.joinable())
+        threadValidate.join();
+}
+
+bool IsSnapshotInvalid()
+{
+    return fSnapshotInvalid;
+}
+
+} // namespace Africoin
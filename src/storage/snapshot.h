@@ -0,0 +1,197 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_STORAGE_SNAPSHOT_H
+#define AFRICOIN_STORAGE_SNAPSHOT_H
+
+#include "consensus/blockforest.h"
+#include "consensus/reorg.h"
+#include "serialize.h"
+#include "uint256.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+class CCoinsView;
+
+/**
+ * @file snapshot.h
+ * @brief Chainstate snapshots (assume-UTXO) anchored at hardened checkpoints
+ *
+ * A snapshot is the chainstate as of one block: the UTXO set, the stake
+ * modifier of every height, the per-type difficulty state, the railway
+ * node state and the fee burn ledger. A new node syncs headers, loads a
+ * snapshot whose block is a hardened checkpoint, and validates and stakes
+ * on top of it at once; the history below it is validated afterwards.
+ *
+ * File layout, everything in the usual serialization:
+ *
+ * 1. CSnapshotMetadata: network, height and block, coin count, and the
+ *    hashes of the coin records and of the state section.
+ * 2. State section: stake modifier, checksum and flags of every height,
+ *    proof hashes of the last DEFAULT_SNAPSHOT_PROOF_DEPTH heights, the
+ *    difficulty state, the railway nodes and the fee burn ledger.
+ * 3. nCoins coin records (COutPoint, Coin) in the order of the
+ *    chainstate cursor.
+ *
+ * Loading maps the file and makes a single sequential pass over it:
+ * coins are deserialized straight out of the mapping, hashed while the
+ * record is still in cache, and written to the coins view in batches of
+ * nFlushEntries. As with -reindex-chainstate only the last batch moves
+ * the best block, and it is written after the coins hash has matched:
+ * a failed or interrupted load leaves a null best block, and the caller
+ * wipes the chainstate.
+ *
+ * The checkpoint vouches for the block hash. hashCoins, nCoins and
+ * hashState in the header are only the file's claim, so they must also
+ * equal the values the assume-UTXO map or a signed sync checkpoint gives
+ * for that height (Checkpoints::GetAssumeUtxo); the state section and
+ * the coin records are then hashed against them. StartSnapshotValidation additionally rebuilds the
+ * chainstate from the block files in the background (the -reindex-
+ * chainstate pipeline), hashes it the same way and compares, along with
+ * the stake modifier checksum at the snapshot height; a mismatch shuts
+ * the node down.
+ */
+
+namespace Africoin {
+
+class CBlockStore;
+class FeeBurnLedger;
+struct CReindexOptions;
+struct CReindexStats;
+
+static const uint32_t SNAPSHOT_VERSION = 1;
+/** Heights below the snapshot block whose proof hashes are kept (v0.3 modifier selection) */
+static const int DEFAULT_SNAPSHOT_PROOF_DEPTH = 5000;
+/** Coins per BatchWrite while loading */
+static const size_t DEFAULT_SNAPSHOT_FLUSH_ENTRIES = 1 << 16;
+
+/**
+ * @struct CSnapshotMetadata
+ * @brief Fixed-size header of a snapshot file
+ */
+struct CSnapshotMetadata {
+    unsigned char pchMessageStart[4];
+    uint32_t nVersion;
+    int32_t nHeight;
+    uint256 hashBlock;
+    uint64_t nCoins;
+    uint256 hashCoins;       //!< SHA256d of the coin records, in file order
+    uint256 hashState;       //!< SHA256d of the state section
+
+    CSnapshotMetadata();
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action)
+    {
+        READWRITE(FLATDATA(pchMessageStart));
+        READWRITE(nVersion);
+        READWRITE(nHeight);
+        READWRITE(hashBlock);
+        READWRITE(nCoins);
+        READWRITE(hashCoins);
+        READWRITE(hashState);
+    }
+};
+
+/**
+ * @struct CSnapshotStats
+ * @brief What a load did
+ */
+struct CSnapshotStats {
+    uint64_t nCoins;
+    uint64_t nBytes;
+    uint64_t nFlushes;
+    bool fMapped;            //!< Read through mmap rather than a buffer
+    int64_t nMicros;
+
+    CSnapshotStats() : nCoins(0), nBytes(0), nFlushes(0), fMapped(false), nMicros(0) {}
+
+    std::string ToString() const;
+};
+
+/**
+ * @brief SHA256d of the coin records of a coins view, as a snapshot stores them
+ * @param nCoins Output: number of coins
+ */
+uint256 GetSnapshotCoinsHash(const CCoinsView& view, uint64_t& nCoins);
+
+/**
+ * @brief Write the chainstate as of block base to path
+ *
+ * @param view     Coins database whose best block is base; must support
+ *                 Cursor(), so flush any cache in front of it first
+ * @param mapNodes Railway node state as of base
+ * @param ledger   Fee burn ledger whose tip is base
+ * @param metadata Output: the header written
+ *
+ * The file is written next to path and renamed into place.
+ */
+bool WriteSnapshot(const boost::filesystem::path& path, const CCoinsView& view, const CBlockForest& forest, BlockRef base,
+                   const CChainSlices::RailwayNodeMap& mapNodes, const FeeBurnLedger& ledger,
+                   CSnapshotMetadata& metadata);
+
+/**
+ * @brief Load a snapshot into an empty chainstate
+ *
+ * The snapshot block must be in the forest (headers are synced first) and
+ * be the hardened checkpoint at its height (Checkpoints::GetCheckpointHash,
+ * sync checkpoints included), and its coins hash and count and state hash
+ * must be the trusted ones (Checkpoints::GetAssumeUtxo); every modifier checksum must pass the
+ * modifier checkpoints and the difficulty state must match the forest's.
+ * The forest then gets the modifiers of the snapshot block's ancestors;
+ * where proof hashes are included, the checksums are recomputed from them
+ * and must match. mapNodes and ledger are replaced only on success. On
+ * failure the modifiers already written to the forest are recomputed when
+ * those blocks are connected.
+ *
+ * Caller must hold cs_main, which guards the forest and the ledger.
+ */
+bool LoadSnapshot(const boost::filesystem::path& path, CBlockForest& forest, CCoinsView& base,
+                  CChainSlices::RailwayNodeMap& mapNodes, FeeBurnLedger& ledger, CSnapshotMetadata& metadata,
+                  CSnapshotStats& stats, size_t nFlushEntries = DEFAULT_SNAPSHOT_FLUSH_ENTRIES);
+
+/**
+ * @brief Check a loaded snapshot against history
+ *
+ * Rebuilds the chainstate up to the snapshot block into viewBackground
+ * (expected empty) with ReindexChainstate, which also recomputes every
+ * stake modifier in the forest, then compares the coins hash and count
+ * and the modifier checksum with the snapshot's. The blocks up to the
+ * snapshot block must be in the store.
+ */
+bool ValidateSnapshot(const CBlockStore& store, CBlockForest& forest, const CSnapshotMetadata& metadata,
+                      CCoinsView& viewBackground, const CReindexOptions& options, CReindexStats& stats);
+
+/**
+ * @brief ValidateSnapshot for the running node: global block store and
+ * forest, options as for -reindex-chainstate, stopped by
+ * StopSnapshotValidation
+ */
+bool ValidateSnapshot(const CSnapshotMetadata& metadata, CCoinsView& viewBackground);
+
+/**
+ * @brief Run ValidateSnapshot on a background thread, after a snapshot load
+ *
+ * The thread owns pviewBackground. If history disagrees with the snapshot
+ * the node shuts down and IsSnapshotInvalid() is set; an interrupted run
+ * proves nothing and is started again at the next start.
+ */
+void StartSnapshotValidation(const CSnapshotMetadata& metadata, std::unique_ptr<CCoinsView> pviewBackground);
+
+/** @brief Stop the background validation, at shutdown */
+void StopSnapshotValidation();
+
+/** @brief The background validation found the snapshot does not match history */
+bool IsSnapshotInvalid();
+
+} // namespace Africoin
+
+#endif // AFRICOIN_STORAGE_SNAPSHOT_H
@@ -1 +1,55 @@
-// africoin_tests.cpp: Unit tests for Africoin core components.
\ No newline at end of file
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <iostream>
+
+void BlockForestTests();
+void BlockIndexFileTests();
+void BlockTemplateTests();
+void BlockStoreTests();
+void ChainGenTests();
+void CheckpointSyncTests();
+void FeeBurnerTests();
+void FlatCoinsTests();
+void HybridDifficultyTests();
+void MetricsTests();
+void MinterTests();
+void ReindexTests();
+void ReorgTests();
+void ScriptCheckTests();
+void Sha256Tests();
+void SnapshotTests();
+void StakeHeaderTests();
+void StakeModifierTests();
+void StakeSeenTests();
+void TraceTests();
+void WalletTests();
+
+int main()
+{
+    BlockForestTests();
+    BlockIndexFileTests();
+    BlockTemplateTests();
+    BlockStoreTests();
+    ChainGenTests();
+    CheckpointSyncTests();
+    FeeBurnerTests();
+    FlatCoinsTests();
+    HybridDifficultyTests();
+    MetricsTests();
+    MinterTests();
+    ReindexTests();
+    ReorgTests();
+    ScriptCheckTests();
+    Sha256Tests();
+    SnapshotTests();
+    StakeHeaderTests();
+    StakeModifierTests();
+    StakeSeenTests();
+    TraceTests();
+    WalletTests();
+
+    std::cout << "All Africoin tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include "../rpc/mining.h"
+#include "arith_uint256.h"
+
+using namespace Africoin;
+
+static TemplateTxInfo TemplateTx(uint32_t n, unsigned int nSize, CAmount nFee,
+                                 const std::vector<uint256>& vParents = std::vector<uint256>())
+{
+    TemplateTxInfo info;
+    info.txid = ArithToUint256(arith_uint256(n));
+    info.nSize = nSize;
+    info.nFee = nFee;
+    info.vParents = vParents;
+    return info;
+}
+
+/** Txids in the template, in the order the snapshot emits them */
+static std::vector<uint256> TemplateTxids(const BlockTemplateAssembler& assembler)
+{
+    std::vector<uint256> vTxids;
+    BlockTemplateSnapshot snapshot = assembler.GetTemplate();
+    for (const CAmount nFee : snapshot.vTxFees)
+        vTxids.push_back(ArithToUint256(arith_uint256(nFee / 1000)));
+    return vTxids;
+}
+
+void BlockTemplateTests()
+{
+    // --- The best fee rates fill the size limit; worse ones wait ---
+    {
+        BlockTemplateAssembler assembler(1000);
+        assert(assembler.GetMaxSize() == 1000);
+        assembler.UpdateTip(nullptr);
+        for (uint32_t i = 1; i <= 10; i++)
+            assembler.TransactionAdded(TemplateTx(i, 200, i * 1000));
+
+        BlockTemplateSnapshot snapshot = assembler.GetTemplate();
+        assert(snapshot.nSize == 1000 && snapshot.vtx.size() == 5);
+        assert(snapshot.nFees == (6 + 7 + 8 + 9 + 10) * 1000);
+        assert(assembler.GetSelectedCount() == 5 && assembler.GetPendingCount() == 5);
+
+        // A mined entry frees room for the best pending one
+        assembler.TransactionRemoved(ArithToUint256(arith_uint256(10)));
+        snapshot = assembler.GetTemplate();
+        assert(snapshot.nSize == 1000 && snapshot.nFees == (5 + 6 + 7 + 8 + 9) * 1000);
+    }
+    std::cout << "Block Template Fee Rate Test Passed\n";
+
+    // --- Parents come first, and leave together with their children ---
+    {
+        // Fees are the txid times 1000 so TemplateTxids can read the order back
+        const uint256 hashA = ArithToUint256(arith_uint256(1));
+        const uint256 hashB = ArithToUint256(arith_uint256(200));
+        const uint256 hashC = ArithToUint256(arith_uint256(50));
+        const uint256 hashD = ArithToUint256(arith_uint256(60));
+        BlockTemplateAssembler assembler(300);
+        assembler.UpdateTip(nullptr);
+
+        assembler.TransactionAdded(TemplateTx(1, 100, 1000));
+        assembler.TransactionAdded(TemplateTx(200, 100, 200000, {hashA}));
+        std::vector<uint256> vTxids = TemplateTxids(assembler);
+        assert(vTxids.size() == 2 && vTxids[0] == hashA && vTxids[1] == hashB);
+
+        // Evicting the cheap parent for a better entry takes the child too
+        assembler.TransactionAdded(TemplateTx(50, 100, 50000));
+        assembler.TransactionAdded(TemplateTx(60, 100, 60000));
+        vTxids = TemplateTxids(assembler);
+        assert(vTxids.size() == 2 && vTxids[0] == hashC && vTxids[1] == hashD);
+        assert(assembler.GetPendingCount() == 2);
+
+        // Once the parent is mined the child stands on its own
+        assembler.TransactionRemoved(hashA);
+        vTxids = TemplateTxids(assembler);
+        assert(vTxids.size() == 3 && vTxids[2] == hashB);
+        assert(assembler.GetPendingCount() == 0);
+    }
+    std::cout << "Block Template Parents Test Passed\n";
+
+    // --- Long-pollers wake on a new tip or a large enough fee change only ---
+    {
+        BlockTemplateAssembler assembler(DEFAULT_TEMPLATE_MAX_SIZE, 1000);
+        assembler.UpdateTip(nullptr);
+        uint64_t nSequence = assembler.GetSequence();
+        assert(nSequence == 1);
+
+        assembler.TransactionAdded(TemplateTx(1, 250, 500));
+        assert(assembler.GetSequence() == nSequence);
+        assert(assembler.WaitForUpdate(nSequence, 1) == nSequence);
+        assembler.TransactionAdded(TemplateTx(2, 250, 600));
+        assert(assembler.GetSequence() == nSequence + 1);
+        assert(assembler.WaitForUpdate(nSequence, 60 * 1000) == nSequence + 1);
+
+        assembler.TransactionRemoved(ArithToUint256(arith_uint256(2)));
+        assert(assembler.GetSequence() == nSequence + 1);
+
+        // The same tip again is not news
+        assembler.UpdateTip(nullptr);
+        assert(assembler.GetSequence() == nSequence + 1);
+    }
+    std::cout << "Block Template Long Poll Test Passed\n";
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include "../consensus/blockforest.h"
+#include "arith_uint256.h"
+
+using namespace Africoin;
+
+static uint256 ForestHash(uint32_t n)
+{
+    return ArithToUint256(arith_uint256(n + 1));
+}
+
+void BlockForestTests()
+{
+    CBlockForest forest;
+
+    // --- Main chain of 10000 blocks, every 100th regenerates the modifier ---
+    std::vector<BlockRef> vChain;
+    BlockRef prev = NULL_BLOCK_REF;
+    for (uint32_t i = 0; i < 10000; i++) {
+        uint32_t nFlags = (i % 2 ? (uint32_t)FOREST_PROOF_OF_STAKE : 0) | (i % 100 == 0 ? (uint32_t)FOREST_STAKE_MODIFIER : 0);
+        prev = forest.Add(ForestHash(i), prev, 1500000000 + i * 64, 0x1e0fffff, nFlags);
+        vChain.push_back(prev);
+    }
+    assert(forest.Size() == 10000);
+    assert(forest.Hot(vChain.back()).nHeight == 9999);
+    assert(forest.Find(ForestHash(1234)) == vChain[1234]);
+    assert(forest.Find(ForestHash(20000)) == NULL_BLOCK_REF);
+    assert(forest.Add(ForestHash(5), vChain[4], 0, 0, 0) == vChain[5]);
+    assert(forest.Size() == 10000);
+    std::cout << "Block Forest Insert Test Passed\n";
+
+    // --- Skip-link ancestors agree with the parent chain ---
+    for (int nFrom = 0; nFrom < 10000; nFrom += 97) {
+        for (int nHeight = 0; nHeight <= nFrom; nHeight += 13)
+            assert(forest.GetAncestor(vChain[nFrom], nHeight) == vChain[nHeight]);
+        assert(forest.GetAncestor(vChain[nFrom], nFrom + 1) == NULL_BLOCK_REF);
+    }
+    assert(forest.GetLastModifierBlock(vChain[4321]) == vChain[4300]);
+    std::cout << "Block Forest Ancestor Test Passed\n";
+
+    // --- A fork off height 5000 ---
+    prev = vChain[5000];
+    for (uint32_t i = 0; i < 300; i++)
+        prev = forest.Add(ForestHash(100000 + i), prev, 0, 0, 0);
+    assert(forest.Hot(prev).nHeight == 5300);
+    assert(forest.FindFork(prev, vChain.back()) == vChain[5000]);
+    assert(forest.FindFork(vChain[4000], prev) == vChain[4000]);
+    assert(forest.GetAncestor(prev, 4999) == vChain[4999]);
+
+    // Deep forks at random heights, against a walk over parent links
+    std::mt19937 rng(44);
+    for (int i = 0; i < 200; i++) {
+        BlockRef fork = vChain[rng() % 10000];
+        BlockRef tipFork = fork;
+        int nLength = 1 + rng() % 3000;
+        for (int j = 0; j < nLength; j++)
+            tipFork = forest.Add(ForestHash(200000 + i * 4000 + j), tipFork, 0, 0, 0);
+        BlockRef other = vChain[rng() % 10000];
+        BlockRef expected = forest.Hot(other).nHeight < forest.Hot(fork).nHeight ? other : fork;
+        assert(forest.FindFork(tipFork, other) == expected && forest.FindFork(other, tipFork) == expected);
+        assert(forest.FindFork(tipFork, vChain.back()) == fork);
+    }
+    std::cout << "Block Forest Fork Test Passed\n";
+
+    // --- Chain trust: 2^256 / (target + 1) per block, a hybrid block's proofs on both tracks ---
+    CBlockForest trusted;
+    const uint32_t nBits = 0x1d00ffff;   // Target 0xffff * 2^208: 2^32 + 2^16 + 1 hashes, rounded
+    const arith_uint256 bnBlock = GetTargetTrust(nBits);
+    assert(bnBlock == arith_uint256(0x100010001ULL));
+    BlockRef pow = trusted.Add(ForestHash(0), NULL_BLOCK_REF, 0, nBits, 0);
+    BlockRef pos = trusted.Add(ForestHash(1), pow, 0, nBits, FOREST_PROOF_OF_STAKE);
+    BlockRef hybrid = trusted.Add(ForestHash(2), pos, 0, nBits, FOREST_PROOF_OF_STAKE | FOREST_HYBRID);
+    assert(trusted.Cold(pow).nChainTrust == bnBlock);
+    assert(trusted.Cold(pos).nChainTrust == bnBlock * 2);
+    assert(trusted.Cold(hybrid).nChainTrust == bnBlock * 4);
+    assert(trusted.Cold(trusted.Add(ForestHash(3), hybrid, 0, 0, 0)).nChainTrust == trusted.Cold(hybrid).nChainTrust);
+
+    // A harder nBits than either track asks for earns no more than one block per track
+    BlockRef hard = trusted.Add(ForestHash(5), hybrid, 0, 0x1c00ffff, FOREST_PROOF_OF_STAKE | FOREST_HYBRID);
+    assert(trusted.Cold(hard).nChainTrust == trusted.Cold(hybrid).nChainTrust + bnBlock * 2);
+
+    // Without PoW history the PoW track only asks for the limit, and only that is credited
+    CBlockForest stakeOnly;
+    BlockRef stake = stakeOnly.Add(ForestHash(6), NULL_BLOCK_REF, 0, nBits, FOREST_PROOF_OF_STAKE);
+    BlockRef early = stakeOnly.Add(ForestHash(7), stake, 0, nBits, FOREST_PROOF_OF_STAKE | FOREST_HYBRID);
+    assert(stakeOnly.Cold(early).nChainTrust == bnBlock * 2 + GetTargetTrust(HYBRID_TARGET_LIMIT_BITS));
+
+    // An easier target adds less trust
+    BlockRef easy = trusted.Add(ForestHash(4), hybrid, 0, 0x1e0fffff, FOREST_PROOF_OF_STAKE);
+    assert(trusted.Cold(easy).nChainTrust > trusted.Cold(hybrid).nChainTrust);
+    assert(trusted.Cold(easy).nChainTrust < trusted.Cold(hybrid).nChainTrust + bnBlock);
+    std::cout << "Block Forest Trust Test Passed\n";
+
+    // --- Tip candidates: most trust first, first received among equals ---
+    BlockRef a = trusted.Add(ForestHash(10), hybrid, 0, nBits, FOREST_PROOF_OF_STAKE);
+    BlockRef b = trusted.Add(ForestHash(11), hybrid, 0, nBits, FOREST_PROOF_OF_STAKE);
+    trusted.AddCandidate(easy);
+    trusted.AddCandidate(b);
+    trusted.AddCandidate(a);
+    assert(trusted.GetBestCandidate() == b && trusted.GetCandidateCount() == 3);
+    trusted.AddCandidate(b);
+    assert(trusted.GetCandidateCount() == 3);
+
+    BlockRef c = trusted.Add(ForestHash(12), a, 0, 0x1e0fffff, FOREST_PROOF_OF_STAKE);
+    trusted.AddCandidate(c);
+    assert(trusted.GetBestCandidate() == c);
+
+    // b was received before a: after pruning behind c, re-adding keeps it ahead of a
+    trusted.PruneCandidates(c);
+    assert(trusted.GetCandidateCount() == 1);
+    trusted.RemoveCandidate(c);
+    trusted.AddCandidate(a);
+    trusted.AddCandidate(b);
+    assert(trusted.GetBestCandidate() == b);
+    std::cout << "Block Forest Candidate Test Passed\n";
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string.h>
+#include <vector>
+#include "../consensus/blockforest.h"
+#include "../metrics/startup.h"
+#include "../storage/blockindexfile.h"
+#include "arith_uint256.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using namespace Africoin;
+
+/** A main chain with forks, stake modifiers, block positions and tip candidates */
+static void BuildIndexFileForest(CBlockForest& forest)
+{
+    std::mt19937 rng(50);
+    std::vector<BlockRef> vAll;
+    BlockRef prev = NULL_BLOCK_REF;
+    for (uint32_t i = 0; i < 150000; i++) {
+        // Mostly extend the last block, sometimes fork off an earlier one
+        if (i > 0 && rng() % 50 == 0)
+            prev = vAll[rng() % vAll.size()];
+        uint32_t nFlags = (rng() % 2 ? (uint32_t)FOREST_PROOF_OF_STAKE : 0) | (rng() % 10 == 0 ? (uint32_t)FOREST_HYBRID : 0);
+        uint32_t nTime = 1500000000 + (prev == NULL_BLOCK_REF ? 0 : forest.Hot(prev).nHeight * 64 + rng() % 64);
+        prev = forest.Add(ArithToUint256(arith_uint256(i + 1)), prev, nTime, 0x1e0fffff - (rng() % 4096), nFlags);
+        vAll.push_back(prev);
+
+        CBlockForestCold& cold = forest.Cold(prev);
+        cold.hashProof = ArithToUint256(arith_uint256(rng()));
+        cold.nStakeModifier = ((uint64_t)rng() << 32) | rng();
+        cold.nStakeModifierChecksum = rng();
+        cold.nStatus = rng() % 32;
+        cold.nFile = i / 1000;
+        cold.nDataPos = rng();
+        cold.nUndoPos = rng();
+        if (rng() % 500 == 0)
+            forest.AddCandidate(prev);
+    }
+    forest.AddCandidate(prev);
+}
+
+static void WriteIndexFileBytes(const boost::filesystem::path& path, size_t nOffset, const void* pData, size_t nSize)
+{
+    boost::filesystem::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(nOffset);
+    file.write((const char*)pData, nSize);
+}
+
+void BlockIndexFileTests()
+{
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+                                  boost::filesystem::unique_path("africoin-indexfile-%%%%%%%%");
+    boost::filesystem::create_directories(dir);
+    const boost::filesystem::path path = dir / "forest.dat";
+
+    CBlockForest forest;
+    BuildIndexFileForest(forest);
+    assert(WriteBlockIndexFile(path, forest));
+    assert(!boost::filesystem::exists(dir / "forest.dat.new"));
+    assert(boost::filesystem::file_size(path) == sizeof(CBlockIndexFileHeader) + forest.Size() * sizeof(CBlockIndexRecord));
+
+    // --- Round trip on several threads: every field, lookup and candidate comes back ---
+    {
+        CBlockIndexFile file;
+        assert(file.Open(path) && file.GetRecordCount() == forest.Size());
+        CBlockForest loaded;
+        CBlockIndexLoadStats stats;
+        assert(LoadBlockIndex(file, loaded, 4, stats));
+        assert(stats.nRecords == forest.Size() && stats.nThreads == 3 && stats.nBytes == file.GetSize());
+
+        assert(loaded.Size() == forest.Size());
+        for (BlockRef ref = 0; ref < forest.Size(); ref++) {
+            const CBlockForestHot& a = forest.Hot(ref);
+            const CBlockForestHot& b = loaded.Hot(ref);
+            assert(a.nPrev == b.nPrev && a.nSkip == b.nSkip && a.nHeight == b.nHeight && a.nTime == b.nTime &&
+                   a.nBits == b.nBits && a.nFlags == b.nFlags);
+            const CBlockForestCold& c = forest.Cold(ref);
+            const CBlockForestCold& d = loaded.Cold(ref);
+            assert(c.hashBlock == d.hashBlock && c.hashProof == d.hashProof && c.nStakeModifier == d.nStakeModifier &&
+                   c.nStakeModifierChecksum == d.nStakeModifierChecksum && c.nStatus == d.nStatus &&
+                   c.nFile == d.nFile && c.nDataPos == d.nDataPos && c.nUndoPos == d.nUndoPos &&
+                   c.difficulty == d.difficulty && c.nChainTrust == d.nChainTrust && c.nSequenceId == d.nSequenceId);
+            assert(loaded.Find(c.hashBlock) == ref && loaded.IsCandidate(ref) == forest.IsCandidate(ref));
+        }
+        assert(loaded.GetCandidateCount() == forest.GetCandidateCount());
+        assert(loaded.GetBestCandidate() == forest.GetBestCandidate());
+
+        // The deferred checks pass on what was written, split or whole
+        assert(file.VerifyChecksum());
+        std::atomic<bool> fInterrupt(false);
+        assert(file.VerifyChecksum(&fInterrupt));
+        fInterrupt = true;
+        assert(!file.VerifyChecksum(&fInterrupt));
+        assert(VerifyBlockIndex(loaded, 0, loaded.Size(), 4));
+        assert(VerifyBlockIndex(loaded, 1000, 2000, 1));
+
+        // The loaded forest keeps growing as Add would have built it
+        BlockRef tip = loaded.Add(ArithToUint256(arith_uint256(999999999)), loaded.GetBestCandidate(), 1600000000,
+                                  0x1e0fffff, 0);
+        assert(VerifyBlockIndex(loaded, tip, tip + 1, 1));
+        loaded.AddCandidate(tip);
+        assert(loaded.GetBestCandidate() == tip);
+
+        // Only an empty forest can be loaded into
+        assert(!LoadBlockIndex(file, loaded, 1, stats));
+    }
+    std::cout << "Block Index File Round Trip Test Passed\n";
+
+    const size_t nRecordOffset = sizeof(CBlockIndexFileHeader) + 70000 * sizeof(CBlockIndexRecord);
+    CBlockIndexRecord record;
+    {
+        CBlockIndexFile file;
+        assert(file.Open(path));
+        record = file.GetRecord(70000);
+    }
+
+    // --- Corrupted chain trust loads but fails the deferred checks ---
+    {
+        CBlockIndexRecord bad = record;
+        bad.nChainTrust.begin()[3] ^= 1;
+        WriteIndexFileBytes(path, nRecordOffset, &bad, sizeof(bad));
+        CBlockIndexFile file;
+        assert(file.Open(path));
+        CBlockForest loaded;
+        CBlockIndexLoadStats stats;
+        assert(LoadBlockIndex(file, loaded, 2, stats));
+        assert(!file.VerifyChecksum());
+        assert(!VerifyBlockIndex(loaded, 0, loaded.Size(), 2));
+        assert(VerifyBlockIndex(loaded, 0, 70000, 2));
+    }
+
+    // --- Links out of the forest and repeated hashes are refused on load ---
+    {
+        CBlockIndexRecord bad = record;
+        bad.nPrev = 70000;
+        WriteIndexFileBytes(path, nRecordOffset, &bad, sizeof(bad));
+        CBlockIndexFile file;
+        assert(file.Open(path));
+        CBlockForest loaded;
+        CBlockIndexLoadStats stats;
+        assert(!LoadBlockIndex(file, loaded, 2, stats));
+
+        bad = record;
+        bad.hashBlock = forest.GetBlockHash(10);
+        WriteIndexFileBytes(path, nRecordOffset, &bad, sizeof(bad));
+        CBlockIndexFile file2;
+        assert(file2.Open(path));
+        CBlockForest loaded2;
+        assert(!LoadBlockIndex(file2, loaded2, 2, stats));
+    }
+    WriteIndexFileBytes(path, nRecordOffset, &record, sizeof(record));
+
+    // --- Files from another build or cut short are refused on open ---
+    {
+        CBlockIndexFile file;
+        assert(file.Open(path) && file.VerifyChecksum());
+
+        uint32_t nVersion = BLOCK_INDEX_FILE_VERSION + 1;
+        WriteIndexFileBytes(path, offsetof(CBlockIndexFileHeader, nVersion), &nVersion, sizeof(nVersion));
+        CBlockIndexFile file2;
+        assert(!file2.Open(path));
+        nVersion = BLOCK_INDEX_FILE_VERSION;
+        WriteIndexFileBytes(path, offsetof(CBlockIndexFileHeader, nVersion), &nVersion, sizeof(nVersion));
+
+        boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 1);
+        CBlockIndexFile file3;
+        assert(!file3.Open(path));
+        CBlockIndexFile file4;
+        assert(!file4.Open(dir / "missing.dat"));
+    }
+    std::cout << "Block Index File Corruption Test Passed\n";
+
+    // --- Time to RPC ready is kept from the first call only ---
+    Startup::Begin();
+    assert(Startup::GetRPCReadyMicros() == -1);
+    Startup::MarkPhase("block index");
+    Startup::SetRPCReady();
+    int64_t nReady = Startup::GetRPCReadyMicros();
+    assert(nReady >= 0);
+    Startup::SetRPCReady();
+    assert(Startup::GetRPCReadyMicros() == nReady);
+    std::cout << "Startup Timing Test Passed\n";
+
+    boost::filesystem::remove_all(dir);
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "../storage/blockstore.h"
+#include "primitives/block.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using namespace Africoin;
+
+static void PushLE(std::vector<unsigned char>& v, uint64_t n, int nBytes)
+{
+    for (int i = 0; i < nBytes; i++)
+        v.push_back((unsigned char)(n >> (8 * i)));
+}
+
+/** Serialize a transaction the way the block files store it */
+static std::vector<unsigned char> MakeRawTx(uint32_t nTime, const std::vector<int64_t>& vValues,
+                                            unsigned int nScriptSize, bool fWitness)
+{
+    std::vector<unsigned char> v;
+    PushLE(v, 1, 4);                       // nVersion
+    PushLE(v, nTime, 4);                   // nTime
+    if (fWitness) {
+        v.push_back(0x00);                 // marker
+        v.push_back(0x01);                 // flags
+    }
+    v.push_back(2);                        // vin
+    for (int i = 0; i < 2; i++) {
+        v.insert(v.end(), 36, 0xab);       // prevout
+        v.push_back(253);                  // scriptSig, 3-byte compact size
+        PushLE(v, nScriptSize, 2);
+        v.insert(v.end(), nScriptSize, 0x51);
+        PushLE(v, 0xffffffff, 4);          // nSequence
+    }
+    v.push_back((unsigned char)vValues.size());
+    for (int64_t nValue : vValues) {
+        PushLE(v, nValue, 8);
+        v.push_back(25);
+        v.insert(v.end(), 25, 0x76);
+    }
+    PushLE(v, 0, 4);                       // nLockTime
+    return v;
+}
+
+/** A block of nTxs transactions with distinct txids */
+static CBlock MakeStoreBlock(uint32_t nBlock, int nTxs)
+{
+    CBlock block;
+    block.nTime = 1500000000 + nBlock * 64;
+    for (int i = 0; i < nTxs; i++) {
+        CMutableTransaction tx;
+        tx.nTime = block.nTime;
+        tx.vin.resize(1);
+        tx.vin[0].scriptSig = CScript() << (int64_t)nBlock << (int64_t)i;
+        tx.vout.resize(1);
+        tx.vout[0].nValue = (i + 1) * COIN;
+        tx.vout[0].scriptPubKey = CScript() << std::vector<unsigned char>(24, 0x76);
+        block.vtx.push_back(MakeTransactionRef(std::move(tx)));
+    }
+    return block;
+}
+
+/** Every transaction written so far is found where it was written */
+static void CheckStoreIndex(const CBlockStore& store, const std::map<uint256, CDiskTxPos>& mapWritten)
+{
+    assert(store.GetTxCount() == mapWritten.size());
+    for (const auto& entry : mapWritten) {
+        CDiskTxPos pos;
+        assert(store.FindTx(entry.first, pos));
+        assert(pos.nFile == entry.second.nFile && pos.nPos == entry.second.nPos &&
+               pos.nTxOffset == entry.second.nTxOffset);
+        CStakeTxPrev txPrev;
+        assert(store.ReadStakeTxPrev(pos, 0, txPrev) && txPrev.nValue > 0);
+    }
+}
+
+static void WriteStoreBlocks(CBlockStore& store, uint32_t nBegin, uint32_t nEnd, std::map<uint256, CDiskTxPos>& mapWritten)
+{
+    for (uint32_t n = nBegin; n < nEnd; n++) {
+        CBlock block = MakeStoreBlock(n, 1 + n % 5);
+        CDiskBlockPos pos;
+        assert(store.WriteBlock(block, pos));
+        for (const CTransactionRef& tx : block.vtx) {
+            CDiskTxPos posTx;
+            assert(store.FindTx(tx->GetHash(), posTx));
+            mapWritten[tx->GetHash()] = posTx;
+        }
+    }
+}
+
+void BlockStoreTests()
+{
+    std::vector<int64_t> vValues = {1000, 25 * COIN, 7};
+    uint32_t nTime = 0;
+    CAmount nValue = 0;
+
+    // --- Every output of a legacy transaction ---
+    std::vector<unsigned char> vTx = MakeRawTx(1500000123, vValues, 300, false);
+    for (uint32_t n = 0; n < vValues.size(); n++) {
+        assert(ParseStakeTxPrev(vTx.data(), vTx.data() + vTx.size(), n, nTime, nValue));
+        assert(nTime == 1500000123);
+        assert(nValue == vValues[n]);
+    }
+    assert(!ParseStakeTxPrev(vTx.data(), vTx.data() + vTx.size(), 3, nTime, nValue));
+    std::cout << "Block Store TxPrev Parse Test Passed\n";
+
+    // --- Witness marker is skipped ---
+    vTx = MakeRawTx(42, vValues, 10, true);
+    assert(ParseStakeTxPrev(vTx.data(), vTx.data() + vTx.size(), 2, nTime, nValue));
+    assert(nTime == 42 && nValue == 7);
+    std::cout << "Block Store Witness Parse Test Passed\n";
+
+    // --- Truncated data never reads past the end ---
+    vTx = MakeRawTx(42, vValues, 300, false);
+    for (size_t nLen = 0; nLen < vTx.size(); nLen++) {
+        std::vector<unsigned char> vPartial(vTx.begin(), vTx.begin() + nLen);
+        bool fOk = ParseStakeTxPrev(vPartial.data(), vPartial.data() + nLen, 2, nTime, nValue);
+        // The last output's value is complete before its script
+        assert(fOk == (nLen >= vTx.size() - 4 - 26));
+    }
+    std::cout << "Block Store Truncation Test Passed\n";
+
+    // --- The saved index spares Open the scan, up to where it was saved ---
+    {
+        boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+                                      boost::filesystem::unique_path("africoin-blockstore-%%%%%%%%");
+        const boost::filesystem::path pathIndex = dir / "txindex.dat";
+        std::map<uint256, CDiskTxPos> mapWritten;
+        {
+            CBlockStore store(dir, true, 8192);
+            assert(store.Open() && store.GetScannedBytes() == 0);
+            WriteStoreBlocks(store, 0, 100, mapWritten);
+        }
+        {
+            CBlockStore store(dir, true, 8192);
+            assert(store.Open() && store.GetScannedBytes() == 0);
+            CheckStoreIndex(store, mapWritten);
+
+            // Saved midway, then more blocks: as if the node had stopped uncleanly
+            assert(store.WriteIndex());
+            boost::filesystem::copy_file(pathIndex, dir / "txindex.old");
+            WriteStoreBlocks(store, 100, 150, mapWritten);
+        }
+        boost::filesystem::remove(pathIndex);
+        boost::filesystem::rename(dir / "txindex.old", pathIndex);
+        uint64_t nStaleScanned;
+        {
+            // Read through pread, so windows grow as they would after a failed mmap
+            CBlockStore store(dir, false, 8192);
+            assert(store.Open());
+            nStaleScanned = store.GetScannedBytes();
+            assert(nStaleScanned > 0);
+            CheckStoreIndex(store, mapWritten);
+        }
+
+        // A damaged index is thrown away for a full scan
+        {
+            boost::filesystem::fstream file(pathIndex, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(100);
+            file.put(0x5a);
+        }
+        {
+            CBlockStore store(dir, true, 8192);
+            assert(store.Open() && store.GetScannedBytes() > nStaleScanned);
+            CheckStoreIndex(store, mapWritten);
+        }
+        boost::filesystem::remove_all(dir);
+    }
+    std::cout << "Block Store Saved Index Test Passed\n";
+
+    // --- A transaction on both sides of a fork follows the active chain ---
+    {
+        boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+                                      boost::filesystem::unique_path("africoin-blockstore-%%%%%%%%");
+        {
+            CBlockStore store(dir);
+            assert(store.Open());
+            CBlock blockMain = MakeStoreBlock(0, 3);
+            CBlock blockFork = MakeStoreBlock(1, 2);
+            blockFork.vtx.push_back(blockMain.vtx[2]);
+            const uint256 txidShared = blockMain.vtx[2]->GetHash();
+            const uint256 txidFork = blockFork.vtx[0]->GetHash();
+            CDiskBlockPos posMain, posFork;
+            CDiskTxPos pos;
+            assert(store.WriteBlock(blockMain, posMain) && store.WriteBlock(blockFork, posFork));
+
+            // Writing the fork block leaves the copy already indexed alone
+            assert(store.FindTx(txidShared, pos) && pos.nPos == posMain.nPos);
+
+            // Reorg to the fork, then back
+            store.DisconnectBlock(blockMain, posMain);
+            assert(!store.FindTx(txidShared, pos) && !store.FindTx(blockMain.vtx[0]->GetHash(), pos));
+            store.ConnectBlock(blockFork, posFork);
+            assert(store.FindTx(txidShared, pos) && pos.nPos == posFork.nPos);
+            CStakeTxPrev txPrev;
+            assert(store.ReadStakeTxPrev(pos, 0, txPrev) && txPrev.nValue == 3 * COIN);
+
+            store.DisconnectBlock(blockFork, posFork);
+            assert(!store.FindTx(txidShared, pos) && !store.FindTx(txidFork, pos));
+            store.ConnectBlock(blockMain, posMain);
+            assert(store.FindTx(txidShared, pos) && pos.nPos == posMain.nPos);
+
+            // Disconnecting a block whose copy is not the indexed one keeps the entry
+            store.DisconnectBlock(blockFork, posFork);
+            assert(store.FindTx(txidShared, pos) && pos.nPos == posMain.nPos);
+        }
+        boost::filesystem::remove_all(dir);
+    }
+    std::cout << "Block Store Fork Copy Test Passed\n";
+}
@@ -0,0 +1,293 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file chaingen.cpp
+ * @brief Deterministic synthetic PoW/PoS/hybrid chains for tests and benchmarks
+ */
+
+#include "test/chaingen.h"
+
+#include "consensus/blockforest.h"
+#include "crypto/common.h"
+#include "crypto/sha256.h"
+#include "security/kernel.h"
+#include "security/stakemodifier.h"
+#include "staking/hybrid_staking.h"
+#include "streams.h"
+#include "util.h"
+
+#include <stdio.h>
+
+namespace Africoin {
+
+static const uint32_t CHAINGEN_FIXTURE_MAGIC = 0x47434641; // "AFCG"
+static const uint32_t CHAINGEN_FIXTURE_VERSION = 1;
+static const uint32_t PPM = 1000000;
+
+/**
+ * xoshiro256** seeded through splitmix64. Kept local rather than using
+ * <random> distributions, whose output is implementation-defined.
+ */
+class ChainGenRng {
+public:
+    explicit ChainGenRng(uint64_t nSeed)
+    {
+        for (int i = 0; i < 4; i++) {
+            nSeed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = nSeed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            s[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t Next()
+    {
+        uint64_t result = Rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 45);
+        return result;
+    }
+
+    /** Uniform in [0, nRange) */
+    uint64_t Range(uint64_t nRange) { return nRange ? Next() % nRange : 0; }
+
+    /** True with probability nPpm / 1e6 */
+    bool Chance(uint32_t nPpm) { return Range(PPM) < nPpm; }
+
+    /**
+     * -ln(U) for U uniform in (0, 1], as 32.32 fixed point. Computed with
+     * integer log2 (repeated squaring of the mantissa) rather than libm
+     * log(), whose last bits differ between platforms.
+     */
+    uint64_t ExponentialQ32()
+    {
+        uint64_t x = (Next() >> 11) + 1; // U = x / 2^53
+        int nExp = 0;
+        while (nExp < 63 && (x >> (nExp + 1)))
+            nExp++;
+        uint64_t y = nExp >= 31 ? x >> (nExp - 31) : x << (31 - nExp); // [1, 2) in Q31
+        uint64_t nLog2 = (uint64_t)nExp << 32;
+        for (int i = 31; i >= 0; i--) {
+            y = (y * y) >> 31;
+            if (y >= (2ULL << 31)) {
+                y >>= 1;
+                nLog2 |= 1ULL << i;
+            }
+        }
+        // -ln(U) = (53 - log2(x)) * ln(2), ln(2) in Q24
+        return (((53ULL << 32) - nLog2) * 11629080) >> 24;
+    }
+
+private:
+    static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t s[4];
+};
+
+CChainGenParams::CChainGenParams()
+    : nSeed(1), nBlocks(100000), nStartTime(1500000000), nSpacing(PeerCoin::nStakeTargetSpacing),
+      nTimes(CHAINGEN_TIMES_EXPONENTIAL), nBits(0x1e0fffff), nPoSStartHeight(Africoin::nPoSStartHeight),
+      nPoSRatioPpm((uint32_t)(nTargetPoSRatio * PPM)), nHybridRatioPpm(PPM / 2), nRailwaySharePpm(PPM / 5)
+{
+    // Weighted by the initial allocations in AfricaRailwaysStakingManager
+    vStations.emplace_back("JNB", 500);
+    vStations.emplace_back("NBO", 500);
+    vStations.emplace_back("CAI", 500);
+    vStations.emplace_back("LOS", 500);
+    vStations.emplace_back("CPT", 300);
+    vStations.emplace_back("ADD", 300);
+}
+
+static uint32_t NextSpacing(const CChainGenParams& params, ChainGenRng& rng)
+{
+    switch (params.nTimes) {
+    case CHAINGEN_TIMES_UNIFORM:
+        return 1 + rng.Range(2 * (uint64_t)params.nSpacing);
+    case CHAINGEN_TIMES_EXPONENTIAL: {
+        uint64_t nExp = rng.ExponentialQ32();
+        uint64_t nSeconds = (nExp >> 32) * params.nSpacing + (((nExp & 0xffffffff) * params.nSpacing) >> 32);
+        return nSeconds < 1 ? 1 : nSeconds > 100 * (uint64_t)params.nSpacing ? 100 * params.nSpacing : (uint32_t)nSeconds;
+    }
+    default:
+        return params.nSpacing;
+    }
+}
+
+static uint8_t PickStation(const CChainGenParams& params, ChainGenRng& rng)
+{
+    uint64_t nTotal = 0;
+    for (const CChainGenStation& station : params.vStations)
+        nTotal += station.nWeight;
+    if (nTotal == 0)
+        return CHAINGEN_NO_STATION;
+
+    uint64_t nPick = rng.Range(nTotal);
+    for (size_t i = 0; i < params.vStations.size(); i++) {
+        if (nPick < params.vStations[i].nWeight)
+            return (uint8_t)i;
+        nPick -= params.vStations[i].nWeight;
+    }
+    return CHAINGEN_NO_STATION;
+}
+
+/** Highest height whose time is at or before nTime (times are increasing) */
+static int FindHeightAtTime(const std::vector<CGenBlock>& vBlocks, int64_t nTime)
+{
+    int nLow = 0, nHigh = (int)vBlocks.size() - 1;
+    if (nHigh < 0 || vBlocks[0].nTime > nTime)
+        return 0;
+    while (nLow < nHigh) {
+        int nMid = nLow + (nHigh - nLow + 1) / 2;
+        if (vBlocks[nMid].nTime <= nTime)
+            nLow = nMid;
+        else
+            nHigh = nMid - 1;
+    }
+    return nLow;
+}
+
+static void PickStakeInput(const CChainGenParams& params, ChainGenRng& rng, CGeneratedChain& chain, CGenBlock& block)
+{
+    // Coin age uniform between the minimum and the point where weight stops growing,
+    // plus some slack past it. Early in the chain nothing is old enough; those
+    // blocks stake from genesis.
+    int64_t nAge = PeerCoin::nStakeMinAge + rng.Range(PeerCoin::nStakeMaxAge);
+    block.nBlockFromHeight = FindHeightAtTime(chain.vBlocks, (int64_t)block.nTime - nAge);
+    block.nTxPrevTime = chain.vBlocks[block.nBlockFromHeight].nTime;
+    // After the 80 byte header and the transaction count
+    block.nTxPrevOffset = 81 + rng.Range(100000);
+    block.nPrevoutN = rng.Range(4);
+
+    if (block.nStation != CHAINGEN_NO_STATION) {
+        // Railway allocations are kept in large, similar-sized outputs
+        block.nStakeValue = (4000 + rng.Range(2000)) * COIN;
+    } else {
+        // Roughly log-uniform between 1 and 100000 coins
+        CAmount nValue = (1 + rng.Range(9)) * COIN;
+        for (uint64_t nDigits = rng.Range(5); nDigits > 0; nDigits--)
+            nValue *= 10;
+        block.nStakeValue = nValue + rng.Range(COIN);
+    }
+}
+
+void GenerateChain(const CChainGenParams& params, CGeneratedChain& chain)
+{
+    ChainGenRng rng(params.nSeed);
+    chain.params = params;
+    chain.vBlocks.clear();
+    chain.vBlocks.reserve(params.nBlocks);
+
+    unsigned char vchSeed[8];
+    WriteLE64(vchSeed, params.nSeed);
+
+    uint256 hashPrev;
+    for (uint32_t nHeight = 0; nHeight < params.nBlocks; nHeight++) {
+        CGenBlock block;
+        block.nTime = nHeight == 0 ? params.nStartTime : chain.vBlocks.back().nTime + NextSpacing(params, rng);
+        block.nBits = params.nBits;
+
+        if ((int)nHeight >= params.nPoSStartHeight) {
+            if (rng.Chance(params.nPoSRatioPpm))
+                block.nType = BLOCK_TYPE_POS;
+            else if (rng.Chance(params.nHybridRatioPpm))
+                block.nType = BLOCK_TYPE_HYBRID;
+        }
+
+        if (block.IsProofOfStake()) {
+            if (rng.Chance(params.nRailwaySharePpm))
+                block.nStation = PickStation(params, rng);
+            PickStakeInput(params, rng, chain, block);
+        }
+
+        unsigned char vchHeight[4];
+        WriteLE32(vchHeight, nHeight);
+        CSHA256().Write(vchSeed, sizeof(vchSeed)).Write(vchHeight, sizeof(vchHeight))
+                 .Write(hashPrev.begin(), 32).Write(&block.nType, 1).Finalize(block.hashBlock.begin());
+        block.nEntropyBit = block.hashBlock.begin()[0] & 1;
+
+        // A new modifier once per modifier interval, as in the v0.3 protocol
+        bool fNewInterval = nHeight == 0 ||
+            block.nTime / PeerCoin::nModifierInterval != chain.vBlocks.back().nTime / PeerCoin::nModifierInterval;
+        block.fGeneratedModifier = fNewInterval;
+        block.nStakeModifier = fNewInterval ? rng.Next() : chain.vBlocks.back().nStakeModifier;
+
+        hashPrev = block.hashBlock;
+        chain.vBlocks.push_back(block);
+    }
+}
+
+bool WriteChainFixture(const std::string& strPath, const CGeneratedChain& chain)
+{
+    CAutoFile fileout(fopen(strPath.c_str(), "wb"), SER_DISK, CLIENT_VERSION);
+    if (fileout.IsNull())
+        return error("%s: cannot open %s for writing", __func__, strPath);
+    try {
+        fileout << CHAINGEN_FIXTURE_MAGIC << CHAINGEN_FIXTURE_VERSION << chain;
+    } catch (const std::exception& e) {
+        return error("%s: write of %s failed: %s", __func__, strPath, e.what());
+    }
+    return true;
+}
+
+bool ReadChainFixture(const std::string& strPath, CGeneratedChain& chain)
+{
+    CAutoFile filein(fopen(strPath.c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull())
+        return false;
+    try {
+        uint32_t nMagic, nVersion;
+        filein >> nMagic >> nVersion;
+        if (nMagic != CHAINGEN_FIXTURE_MAGIC || nVersion != CHAINGEN_FIXTURE_VERSION)
+            return error("%s: %s is not a chain fixture (or has an unknown version)", __func__, strPath);
+        filein >> chain;
+    } catch (const std::exception& e) {
+        return error("%s: read of %s failed: %s", __func__, strPath, e.what());
+    }
+    return true;
+}
+
+bool LoadOrGenerateChain(const std::string& strPath, const CChainGenParams& params, CGeneratedChain& chain)
+{
+    CDataStream ssWanted(SER_DISK, CLIENT_VERSION);
+    ssWanted << params;
+
+    if (ReadChainFixture(strPath, chain)) {
+        CDataStream ssLoaded(SER_DISK, CLIENT_VERSION);
+        ssLoaded << chain.params;
+        if (ssLoaded.str() == ssWanted.str())
+            return true;
+    }
+
+    GenerateChain(params, chain);
+    return WriteChainFixture(strPath, chain);
+}
+
+void BuildBlockForest(const CGeneratedChain& chain, CBlockForest& forest)
+{
+    forest.Reserve(forest.Size() + chain.vBlocks.size());
+
+    BlockRef prev = NULL_BLOCK_REF;
+    for (const CGenBlock& block : chain.vBlocks) {
+        uint32_t nFlags = 0;
+        if (block.IsProofOfStake())
+            nFlags |= FOREST_PROOF_OF_STAKE;
+        if (block.nType == BLOCK_TYPE_HYBRID)
+            nFlags |= FOREST_HYBRID;
+        if (block.fGeneratedModifier)
+            nFlags |= FOREST_STAKE_MODIFIER;
+        if (block.nEntropyBit)
+            nFlags |= FOREST_STAKE_ENTROPY;
+
+        prev = forest.Add(block.hashBlock, prev, block.nTime, block.nBits, nFlags);
+        forest.Cold(prev).nStakeModifier = block.nStakeModifier;
+    }
+}
+
+} // namespace Africoin
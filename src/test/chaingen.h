@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_TEST_CHAINGEN_H
+#define AFRICOIN_TEST_CHAINGEN_H
+
+#include "amount.h"
+#include "serialize.h"
+#include "uint256.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file chaingen.h
+ * @brief Deterministic synthetic PoW/PoS/hybrid chains for tests and benchmarks
+ *
+ * Generates header-level chains (times, bits, block types, stake inputs,
+ * modifier flags and railway stakers) of any length from a seed. Every
+ * random decision comes from a seeded xoshiro256** stream and integer
+ * parts-per-million probabilities, so the same parameters give the same
+ * chain on every platform and compiler.
+ *
+ * Chains can be dumped to a binary fixture and loaded back, so kernel,
+ * modifier, checkpoint and railway benchmarks can all run on exactly the
+ * same data without regenerating it.
+ *
+ * Usage:
+ *
+ *   CChainGenParams params;
+ *   params.nBlocks = 1000000;
+ *   params.nPoSRatioPpm = 800000;
+ *   CGeneratedChain chain;
+ *   GenerateChain(params, chain);
+ *   WriteChainFixture("hybrid-1m.bin", chain);
+ */
+
+namespace Africoin {
+
+class CBlockForest;
+
+/** Inter-block time distribution */
+enum ChainGenTimes : uint8_t {
+    CHAINGEN_TIMES_FIXED = 0,        //!< Exactly nSpacing seconds apart
+    CHAINGEN_TIMES_UNIFORM = 1,      //!< Uniform in [1, 2 * nSpacing]
+    CHAINGEN_TIMES_EXPONENTIAL = 2,  //!< Poisson arrivals with mean nSpacing
+};
+
+/** Marks a block not staked by a railway node */
+static const uint8_t CHAINGEN_NO_STATION = 0xff;
+
+/**
+ * @struct CChainGenStation
+ * @brief A railway staking node and its share of railway stakes
+ */
+struct CChainGenStation {
+    std::string strCode;
+    uint32_t nWeight;
+
+    CChainGenStation() : nWeight(0) {}
+    CChainGenStation(const std::string& strCodeIn, uint32_t nWeightIn) : strCode(strCodeIn), nWeight(nWeightIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(strCode);
+        READWRITE(nWeight);
+    }
+};
+
+/**
+ * @class CChainGenParams
+ * @brief Everything that determines a generated chain
+ */
+class CChainGenParams {
+public:
+    uint64_t nSeed;
+    uint32_t nBlocks;
+    uint32_t nStartTime;
+    uint32_t nSpacing;
+    uint8_t nTimes;              //!< ChainGenTimes
+    uint32_t nBits;
+    int32_t nPoSStartHeight;     //!< Only PoW below this height
+    uint32_t nPoSRatioPpm;       //!< Share of PoS blocks after nPoSStartHeight
+    uint32_t nHybridRatioPpm;    //!< Share of the remaining blocks that are hybrid
+    uint32_t nRailwaySharePpm;   //!< Share of PoS/hybrid blocks staked by railway nodes
+    std::vector<CChainGenStation> vStations;
+
+    /** Defaults: the hybrid schedule and the six initial railway stations */
+    CChainGenParams();
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(nSeed);
+        READWRITE(nBlocks);
+        READWRITE(nStartTime);
+        READWRITE(nSpacing);
+        READWRITE(nTimes);
+        READWRITE(nBits);
+        READWRITE(nPoSStartHeight);
+        READWRITE(nPoSRatioPpm);
+        READWRITE(nHybridRatioPpm);
+        READWRITE(nRailwaySharePpm);
+        READWRITE(vStations);
+    }
+};
+
+/**
+ * @struct CGenBlock
+ * @brief One generated block: header fields plus its stake input
+ *
+ * Stake fields are only meaningful for PoS and hybrid blocks; they give
+ * everything CheckStakeKernelHash reads (blockFrom, txPrev time and
+ * offset, prevout index, staked value).
+ */
+struct CGenBlock {
+    uint256 hashBlock;
+    uint32_t nTime;
+    uint32_t nBits;
+    uint8_t nType;               //!< BlockType
+    uint8_t nStation;            //!< Index into vStations, or CHAINGEN_NO_STATION
+    uint8_t fGeneratedModifier;
+    uint8_t nEntropyBit;
+    uint64_t nStakeModifier;     //!< Modifier in effect after this block
+    int32_t nBlockFromHeight;
+    uint32_t nTxPrevTime;
+    uint32_t nTxPrevOffset;
+    uint32_t nPrevoutN;
+    CAmount nStakeValue;
+
+    CGenBlock()
+        : nTime(0), nBits(0), nType(0), nStation(CHAINGEN_NO_STATION), fGeneratedModifier(0), nEntropyBit(0),
+          nStakeModifier(0), nBlockFromHeight(-1), nTxPrevTime(0), nTxPrevOffset(0), nPrevoutN(0), nStakeValue(0) {}
+
+    bool IsProofOfStake() const { return nType != 0; }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(hashBlock);
+        READWRITE(nTime);
+        READWRITE(nBits);
+        READWRITE(nType);
+        READWRITE(nStation);
+        READWRITE(fGeneratedModifier);
+        READWRITE(nEntropyBit);
+        READWRITE(nStakeModifier);
+        READWRITE(nBlockFromHeight);
+        READWRITE(nTxPrevTime);
+        READWRITE(nTxPrevOffset);
+        READWRITE(nPrevoutN);
+        READWRITE(nStakeValue);
+    }
+};
+
+/**
+ * @class CGeneratedChain
+ * @brief A generated chain; vBlocks[h] is the block at height h
+ */
+class CGeneratedChain {
+public:
+    CChainGenParams params;
+    std::vector<CGenBlock> vBlocks;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(params);
+        READWRITE(vBlocks);
+    }
+};
+
+/** @brief Generate the chain described by params */
+void GenerateChain(const CChainGenParams& params, CGeneratedChain& chain);
+
+/** @brief Write a chain to a binary fixture file */
+bool WriteChainFixture(const std::string& strPath, const CGeneratedChain& chain);
+
+/** @brief Load a fixture written by WriteChainFixture */
+bool ReadChainFixture(const std::string& strPath, CGeneratedChain& chain);
+
+/**
+ * @brief Load a fixture if it exists and matches params, else generate it
+ *
+ * Lets benchmarks share one on-disk chain across runs and binaries.
+ */
+bool LoadOrGenerateChain(const std::string& strPath, const CChainGenParams& params, CGeneratedChain& chain);
+
+/** @brief Add every block of the chain to a block forest, in height order */
+void BuildBlockForest(const CGeneratedChain& chain, CBlockForest& forest);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_TEST_CHAINGEN_H
@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include "../test/chaingen.h"
+#include "../consensus/blockforest.h"
+#include "../security/kernel.h"
+#include "../staking/hybrid_staking.h"
+
+using namespace Africoin;
+
+static bool SameBlock(const CGenBlock& a, const CGenBlock& b)
+{
+    return a.hashBlock == b.hashBlock && a.nTime == b.nTime && a.nType == b.nType &&
+           a.nStation == b.nStation && a.nStakeModifier == b.nStakeModifier &&
+           a.nBlockFromHeight == b.nBlockFromHeight && a.nTxPrevOffset == b.nTxPrevOffset &&
+           a.nStakeValue == b.nStakeValue;
+}
+
+void ChainGenTests()
+{
+    CChainGenParams params;
+    params.nBlocks = 50000;
+    params.nPoSStartHeight = 1000;
+    params.nPoSRatioPpm = 800000;
+
+    // --- Same seed, same chain; different seed, different chain ---
+    CGeneratedChain chainA, chainB, chainC;
+    GenerateChain(params, chainA);
+    GenerateChain(params, chainB);
+    params.nSeed = 2;
+    GenerateChain(params, chainC);
+    params.nSeed = 1;
+    assert(chainA.vBlocks.size() == 50000);
+    for (size_t i = 0; i < chainA.vBlocks.size(); i++)
+        assert(SameBlock(chainA.vBlocks[i], chainB.vBlocks[i]));
+    assert(chainA.vBlocks[10].hashBlock != chainC.vBlocks[10].hashBlock);
+    std::cout << "Chain Generator Determinism Test Passed\n";
+
+    // --- Shape: schedule, ratio, monotonic time, stake age ---
+    int nPoS = 0, nRailway = 0;
+    for (size_t h = 0; h < chainA.vBlocks.size(); h++) {
+        const CGenBlock& block = chainA.vBlocks[h];
+        if (h > 0)
+            assert(block.nTime > chainA.vBlocks[h - 1].nTime);
+        if ((int)h < params.nPoSStartHeight) {
+            assert(block.nType == BLOCK_TYPE_POW);
+            continue;
+        }
+        if (block.nType == BLOCK_TYPE_POS)
+            nPoS++;
+        if (block.IsProofOfStake()) {
+            assert(block.nBlockFromHeight >= 0 && block.nBlockFromHeight < (int)h);
+            assert(block.nTxPrevTime == chainA.vBlocks[block.nBlockFromHeight].nTime);
+            if (block.nBlockFromHeight > 0)
+                assert(block.nTime - block.nTxPrevTime >= PeerCoin::nStakeMinAge);
+            if (block.nStation != CHAINGEN_NO_STATION)
+                nRailway++;
+        }
+    }
+    int nAfterStart = params.nBlocks - params.nPoSStartHeight;
+    assert(nPoS > nAfterStart * 78 / 100 && nPoS < nAfterStart * 82 / 100);
+    assert(nRailway > 0);
+    std::cout << "Chain Generator Shape Test Passed\n";
+
+    // --- Binary fixture round trip ---
+    std::string strPath = "chaingen_tests_fixture.bin";
+    assert(WriteChainFixture(strPath, chainA));
+    CGeneratedChain chainLoaded;
+    assert(ReadChainFixture(strPath, chainLoaded));
+    assert(chainLoaded.vBlocks.size() == chainA.vBlocks.size());
+    assert(chainLoaded.params.nPoSRatioPpm == params.nPoSRatioPpm);
+    assert(chainLoaded.params.vStations.size() == params.vStations.size());
+    for (size_t i = 0; i < chainA.vBlocks.size(); i++)
+        assert(SameBlock(chainA.vBlocks[i], chainLoaded.vBlocks[i]));
+    std::remove(strPath.c_str());
+    std::cout << "Chain Generator Fixture Test Passed\n";
+
+    // --- Loads into a block forest ---
+    CBlockForest forest;
+    BuildBlockForest(chainA, forest);
+    BlockRef tip = forest.Find(chainA.vBlocks.back().hashBlock);
+    assert(forest.Hot(tip).nHeight == 49999);
+    BlockRef mod = forest.GetLastModifierBlock(tip);
+    assert(chainA.vBlocks[forest.Hot(mod).nHeight].fGeneratedModifier);
+    std::cout << "Chain Generator Forest Test Passed\n";
+}
@@ -0,0 +1,241 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include "../security/checkpoints.h"
+#include "../security/checkpointsync.h"
+#include "arith_uint256.h"
+#include "chain.h"
+#include "dbwrapper.h"
+#include "key.h"
+#include "streams.h"
+#include "util.h"
+#include "validation.h"
+#include "version.h"
+
+using namespace PeerCoin;
+
+static CSyncCheckpoint MakeCheckpoint(const CKey& keyMaster, int nHeight, const uint256& hash)
+{
+    CSyncCheckpoint checkpoint;
+    checkpoint.nHeight = nHeight;
+    checkpoint.hashCheckpoint = hash;
+    assert(checkpoint.Sign(keyMaster));
+    return checkpoint;
+}
+
+static SyncCheckpointResult Process(const CSyncCheckpoint& checkpoint, std::string& strReason, int& nDoS)
+{
+    CValidationState state;
+    SyncCheckpointResult result = g_syncCheckpoints.ProcessSyncCheckpoint(checkpoint, state);
+    strReason = state.GetRejectReason();
+    nDoS = 0;
+    state.IsInvalid(nDoS);
+    return result;
+}
+
+void CheckpointSyncTests()
+{
+    ECC_Start();
+    {
+        ECCVerifyHandle verifyHandle;
+        LOCK(cs_main);
+
+        // A chain of 20 blocks and a fork off height 12
+        std::vector<uint256> vHash(20), vForkHash(20);
+        std::vector<CBlockIndex> vIndex(20), vFork(20);
+        for (int h = 0; h < 20; h++) {
+            vHash[h] = ArithToUint256(arith_uint256(1000 + h));
+            vIndex[h].phashBlock = &vHash[h];
+            vIndex[h].pprev = h > 0 ? &vIndex[h - 1] : nullptr;
+            vIndex[h].nHeight = h;
+            mapBlockIndex[vHash[h]] = &vIndex[h];
+        }
+        for (int h = 13; h < 20; h++) {
+            vForkHash[h] = ArithToUint256(arith_uint256(5000 + h));
+            vFork[h].phashBlock = &vForkHash[h];
+            vFork[h].pprev = h > 13 ? &vFork[h - 1] : &vIndex[12];
+            vFork[h].nHeight = h;
+            mapBlockIndex[vForkHash[h]] = &vFork[h];
+        }
+
+        CKey keyMaster, keyHub0, keyHub1, keyRogue;
+        keyMaster.MakeNewKey(true);
+        keyHub0.MakeNewKey(true);
+        keyHub1.MakeNewKey(true);
+        keyRogue.MakeNewKey(true);
+
+        assert(!Checkpoints::AutoCheckpointsEnabled());
+        g_syncCheckpoints.SetKeys(keyMaster.GetPubKey(), {keyHub0.GetPubKey(), keyHub1.GetPubKey()}, 1);
+        assert(Checkpoints::AutoCheckpointsEnabled() && g_syncCheckpoints.GetHeight() == -1);
+
+        std::string strReason;
+        int nDoS;
+
+        // --- Signatures: master first, then the hub threshold ---
+        CSyncCheckpoint checkpoint = MakeCheckpoint(keyMaster, 10, vHash[10]);
+        assert(Process(checkpoint, strReason, nDoS) == SYNC_CHECKPOINT_INVALID);
+        assert(strReason == "bad-checkpoint-sig" && nDoS == 100);
+
+        CSyncCheckpoint rogue = MakeCheckpoint(keyRogue, 10, vHash[10]);
+        assert(rogue.AddHubSignature(keyHub0, 0));
+        assert(Process(rogue, strReason, nDoS) == SYNC_CHECKPOINT_INVALID && strReason == "bad-checkpoint-sig");
+
+        CSyncCheckpoint twice(checkpoint);
+        assert(twice.AddHubSignature(keyHub0, 0) && twice.AddHubSignature(keyHub0, 0));
+        assert(Process(twice, strReason, nDoS) == SYNC_CHECKPOINT_INVALID);
+        CSyncCheckpoint wrongHub(checkpoint);
+        assert(wrongHub.AddHubSignature(keyHub0, 1));
+        assert(Process(wrongHub, strReason, nDoS) == SYNC_CHECKPOINT_INVALID);
+        CSyncCheckpoint unknownHub(checkpoint);
+        assert(unknownHub.AddHubSignature(keyHub1, 2));
+        assert(Process(unknownHub, strReason, nDoS) == SYNC_CHECKPOINT_INVALID);
+
+        CSyncCheckpoint garbled(checkpoint);
+        garbled.vchMsg.pop_back();
+        assert(Process(garbled, strReason, nDoS) == SYNC_CHECKPOINT_INVALID && strReason == "bad-checkpoint-msg");
+
+        // --- Over the wire and accepted once co-signed ---
+        assert(checkpoint.AddHubSignature(keyHub1, 1));
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << checkpoint;
+        CSyncCheckpoint received;
+        ss >> received;
+        assert(received.vchMsg == checkpoint.vchMsg && received.vHubSigs.size() == 1);
+        assert(Process(received, strReason, nDoS) == SYNC_CHECKPOINT_ACCEPTED);
+        assert(g_syncCheckpoints.GetHeight() == 10 && g_syncCheckpoints.GetCheckpoint().hashCheckpoint == vHash[10]);
+
+        // --- Verified once: the same message from every peer is a cache hit ---
+        const CSyncCheckpointStats statsBefore = g_syncCheckpoints.GetStats();
+        for (int i = 0; i < 8; i++)
+            assert(Process(received, strReason, nDoS) == SYNC_CHECKPOINT_IGNORED);
+        CSyncCheckpointStats stats = g_syncCheckpoints.GetStats();
+        assert(stats.nVerified == statsBefore.nVerified && stats.nCacheHits == statsBefore.nCacheHits + 8);
+        assert(stats.nAccepted == 1);
+
+        // --- Overlay on the hardcoded checkpoints ---
+        assert(Checkpoints::CheckHardened(10, vHash[10]) && !Checkpoints::CheckHardened(10, vHash[9]));
+        assert(Checkpoints::CheckHardened(4, vHash[4]) && !Checkpoints::CheckHardened(4, vHash[5]));
+        assert(Checkpoints::CheckHardened(15, vForkHash[15]));
+        assert(Checkpoints::GetLastCheckpointHeight() == 10 && Checkpoints::GetTotalBlocksEstimate() == 10);
+        assert(Checkpoints::GetCheckpointHash(10) == vHash[10] && Checkpoints::GetCheckpointHash(9).IsNull());
+        assert(Checkpoints::VerifyCheckpointsInChain(&vIndex[19]) && Checkpoints::VerifyCheckpointsInChain(&vFork[19]));
+
+        // --- Assume-valid: the checkpointed chain only ---
+        assert(g_syncCheckpoints.IsAssumedValid(&vIndex[3]) && g_syncCheckpoints.IsAssumedValid(&vIndex[10]));
+        assert(!g_syncCheckpoints.IsAssumedValid(&vIndex[11]));
+        CBlockIndex indexStale;
+        indexStale.phashBlock = &vForkHash[19];
+        indexStale.pprev = &vIndex[4];
+        indexStale.nHeight = 5;
+        assert(!g_syncCheckpoints.IsAssumedValid(&indexStale));
+        g_syncCheckpoints.SetAssumeValid(false);
+        assert(!g_syncCheckpoints.IsAssumedValid(&vIndex[3]));
+        g_syncCheckpoints.SetAssumeValid(true);
+
+        // --- A checkpoint ahead of the block index waits for its block ---
+        g_syncCheckpoints.SetKeys(keyMaster.GetPubKey(), {keyHub0.GetPubKey(), keyHub1.GetPubKey()}, 0);
+        assert(Process(MakeCheckpoint(keyMaster, 10, vHash[10]), strReason, nDoS) == SYNC_CHECKPOINT_ACCEPTED);
+        mapBlockIndex.erase(vHash[15]);
+        assert(Process(MakeCheckpoint(keyMaster, 15, vHash[15]), strReason, nDoS) == SYNC_CHECKPOINT_PENDING);
+        assert(g_syncCheckpoints.GetPendingHash() == vHash[15] && !g_syncCheckpoints.AcceptPendingSyncCheckpoint());
+        assert(g_syncCheckpoints.GetHeight() == 10);
+        mapBlockIndex[vHash[15]] = &vIndex[15];
+        assert(g_syncCheckpoints.AcceptPendingSyncCheckpoint());
+        assert(g_syncCheckpoints.GetHeight() == 15 && g_syncCheckpoints.GetPendingHash().IsNull());
+        assert(Checkpoints::GetCheckpointHash(10) == vHash[10] && Checkpoints::GetCheckpointHash(15) == vHash[15]);
+
+        // --- Version 2 carries a snapshot commitment ---
+        CSyncCheckpoint snapshot;
+        snapshot.nVersion = SYNC_CHECKPOINT_VERSION_SNAPSHOT;
+        snapshot.nHeight = 16;
+        snapshot.hashCheckpoint = vHash[16];
+        snapshot.hashSnapshotCoins = ArithToUint256(arith_uint256(77));
+        snapshot.nSnapshotCoins = 1234;
+        snapshot.hashSnapshotState = ArithToUint256(arith_uint256(78));
+        assert(snapshot.Sign(keyMaster));
+        CSyncCheckpoint unpacked;
+        unpacked.vchMsg = snapshot.vchMsg;
+        assert(unpacked.Unpack() && unpacked.hashSnapshotCoins == snapshot.hashSnapshotCoins && unpacked.nSnapshotCoins == 1234);
+        assert(unpacked.hashSnapshotState == snapshot.hashSnapshotState);
+        assert(Process(snapshot, strReason, nDoS) == SYNC_CHECKPOINT_ACCEPTED);
+        Checkpoints::CAssumeUtxoData assumeUtxo;
+        assert(Checkpoints::GetAssumeUtxo(16, assumeUtxo));
+        assert(assumeUtxo.hashCoins == snapshot.hashSnapshotCoins && assumeUtxo.nCoins == 1234);
+        assert(assumeUtxo.hashState == snapshot.hashSnapshotState);
+        assert(!Checkpoints::GetAssumeUtxo(15, assumeUtxo));
+
+        // --- Signed but wrong: refused without blaming the peer ---
+        assert(Process(MakeCheckpoint(keyMaster, 17, vHash[16]), strReason, nDoS) == SYNC_CHECKPOINT_INVALID);
+        assert(strReason == "checkpoint-height-mismatch" && nDoS == 0);
+        g_syncCheckpoints.SetKeys(keyMaster.GetPubKey(), std::vector<CPubKey>(), 0);
+        assert(Process(MakeCheckpoint(keyMaster, 12, vHash[12]), strReason, nDoS) == SYNC_CHECKPOINT_ACCEPTED);
+        assert(Process(MakeCheckpoint(keyMaster, 18, vForkHash[18]), strReason, nDoS) == SYNC_CHECKPOINT_ACCEPTED);
+        assert(Process(MakeCheckpoint(keyMaster, 19, vHash[19]), strReason, nDoS) == SYNC_CHECKPOINT_INVALID);
+        assert(strReason == "checkpoint-conflict" && nDoS == 0 && g_syncCheckpoints.GetHeight() == 18);
+        assert(!Checkpoints::CheckHardened(13, vHash[13]) && Checkpoints::CheckHardened(13, vForkHash[13]));
+        assert(!Checkpoints::VerifyCheckpointsInChain(&vIndex[19]) && Checkpoints::VerifyCheckpointsInChain(&vFork[19]));
+        assert(Process(MakeCheckpoint(keyMaster, 11, vHash[11]), strReason, nDoS) == SYNC_CHECKPOINT_IGNORED);
+
+        // --- The current checkpoint survives a restart through the block tree DB ---
+        CDBWrapper db(GetDataDir() / "synccheckpoints", 1 << 20, true);
+        {
+            CSyncCheckpointManager before;
+            before.SetKeys(keyMaster.GetPubKey(), std::vector<CPubKey>(), 0);
+            before.SetDB(&db);
+            CValidationState state;
+            assert(before.ProcessSyncCheckpoint(MakeCheckpoint(keyMaster, 11, vHash[11]), state) == SYNC_CHECKPOINT_ACCEPTED);
+            assert(before.ProcessSyncCheckpoint(MakeCheckpoint(keyMaster, 14, vHash[14]), state) == SYNC_CHECKPOINT_ACCEPTED);
+        }
+        CSyncCheckpointManager restarted;
+        restarted.SetKeys(keyMaster.GetPubKey(), std::vector<CPubKey>(), 0);
+        assert(restarted.LoadCheckpoint() && restarted.GetHeight() == -1);
+        restarted.SetDB(&db);
+        assert(restarted.LoadCheckpoint() && restarted.GetHeight() == 14);
+        assert(restarted.GetCheckpoint().hashCheckpoint == vHash[14]);
+        assert(restarted.CheckHardened(14, vHash[14]) && !restarted.CheckHardened(14, vForkHash[14]));
+        assert(restarted.CheckHardened(11, vHash[11]) && restarted.IsAssumedValid(&vIndex[11]));
+
+        // Signed with a key no longer configured: dropped
+        CSyncCheckpointManager rekeyed;
+        rekeyed.SetKeys(keyRogue.GetPubKey(), std::vector<CPubKey>(), 0);
+        rekeyed.SetDB(&db);
+        assert(rekeyed.LoadCheckpoint() && rekeyed.GetHeight() == -1);
+
+        // Block not indexed yet: pending until it is
+        mapBlockIndex.erase(vHash[14]);
+        CSyncCheckpointManager early;
+        early.SetKeys(keyMaster.GetPubKey(), std::vector<CPubKey>(), 0);
+        early.SetDB(&db);
+        assert(early.LoadCheckpoint() && early.GetHeight() == -1 && early.GetPendingHash() == vHash[14]);
+        mapBlockIndex[vHash[14]] = &vIndex[14];
+        assert(early.AcceptPendingSyncCheckpoint() && early.GetHeight() == 14);
+
+        // --- The cache is bounded ---
+        CSyncCheckpointManager manager(2);
+        manager.SetKeys(keyMaster.GetPubKey(), std::vector<CPubKey>(), 0);
+        CSyncCheckpoint vCheckpoints[3] = {MakeCheckpoint(keyMaster, 1, vHash[1]), MakeCheckpoint(keyMaster, 2, vHash[2]),
+                                           MakeCheckpoint(keyRogue, 3, vHash[3])};
+        for (const CSyncCheckpoint& c : vCheckpoints)
+            assert(manager.CheckSignatures(c) == (&c != &vCheckpoints[2]));
+        assert(!manager.CheckSignatures(vCheckpoints[2]) && manager.CheckSignatures(vCheckpoints[1]));
+        assert(manager.GetStats().nVerified == 3 && manager.GetStats().nCacheHits == 2);
+        assert(manager.CheckSignatures(vCheckpoints[0]) && manager.GetStats().nVerified == 4);
+
+        // --- Without a master key nothing is overlaid ---
+        g_syncCheckpoints.SetKeys(CPubKey(), std::vector<CPubKey>(), 0);
+        assert(!Checkpoints::AutoCheckpointsEnabled() && Checkpoints::CheckHardened(13, vHash[13]));
+        assert(Process(MakeCheckpoint(keyMaster, 12, vHash[12]), strReason, nDoS) == SYNC_CHECKPOINT_IGNORED);
+        assert(Checkpoints::GetLastCheckpointHeight() == 0 && !g_syncCheckpoints.IsAssumedValid(&vIndex[3]));
+
+        for (int h = 0; h < 20; h++) {
+            mapBlockIndex.erase(vHash[h]);
+            mapBlockIndex.erase(vForkHash[h]);
+        }
+    }
+    ECC_Stop();
+    std::cout << "Checkpoint Sync Test Passed\n";
+}
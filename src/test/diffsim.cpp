@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file diffsim.cpp
+ * @brief Hashrate and stake shock simulator for the hybrid retargets
+ */
+
+#include "test/diffsim.h"
+
+#include "arith_uint256.h"
+
+#include <math.h>
+#include <random>
+
+namespace Africoin {
+
+/** Target as a fraction of the target limit */
+static double TargetRatio(uint32_t nBits)
+{
+    arith_uint256 bnTarget, bnLimit;
+    bnTarget.SetCompact(nBits);
+    bnLimit.SetCompact(HYBRID_TARGET_LIMIT_BITS);
+    return bnTarget.getdouble() / bnLimit.getdouble();
+}
+
+/**
+ * Exponential with mean 1. Uses the raw mt19937_64 output rather than
+ * std::exponential_distribution, whose output is implementation-defined.
+ */
+static double SampleExponential(std::mt19937_64& rng)
+{
+    return -log(((rng() >> 11) + 1) * (1.0 / 9007199254740992.0));
+}
+
+class CDiffSimTrack {
+public:
+    CDiffSimTrackResult result;
+    double nPower;
+    int64_t nTargetSpacing;
+    uint32_t nNextBits;
+
+    CDiffSimTrack(double nPowerIn, int64_t nTargetSpacingIn)
+        : nPower(nPowerIn), nTargetSpacing(nTargetSpacingIn), nNextBits(HYBRID_TARGET_LIMIT_BITS) {}
+
+    double GetRate() const { return nPower * TargetRatio(nNextBits); }
+
+    bool WithinTolerance(double nTolerance) const
+    {
+        return fabs(1.0 / GetRate() / nTargetSpacing - 1.0) <= nTolerance;
+    }
+
+    /** A block of this type was found (or the shock hit) at nSeconds after the shock */
+    void Check(double nTolerance, int64_t nSeconds)
+    {
+        if (!result.fConverged && WithinTolerance(nTolerance)) {
+            result.fConverged = true;
+            result.nSeconds = nSeconds;
+        }
+    }
+};
+
+CDiffSimResult SimulateDifficultyShock(const CDiffSimParams& params, const CDiffSimShock& shock)
+{
+    std::mt19937_64 rng(params.nSeed);
+    CHybridDifficultyState state;
+    CDiffSimTrack pow(params.nHashPower, GetHybridTargetSpacing(false, params.nStartHeight));
+    CDiffSimTrack pos(params.nStakePower, GetHybridTargetSpacing(true, params.nStartHeight));
+    CDiffSimResult result;
+    result.nBlocks = 0;
+
+    double nClock = params.nStartTime;
+    double nShockTime = 0;
+    for (int i = 0; i < params.nWarmupBlocks + params.nMaxBlocks; i++) {
+        if (i == params.nWarmupBlocks) {
+            pow.nPower *= shock.nHashFactor;
+            pos.nPower *= shock.nStakeFactor;
+            pow.result.nSpacingAtShock = 1.0 / pow.GetRate();
+            pos.result.nSpacingAtShock = 1.0 / pos.GetRate();
+            nShockTime = nClock;
+            pow.Check(params.nTolerance, 0);
+            pos.Check(params.nTolerance, 0);
+        }
+        bool fShocked = i >= params.nWarmupBlocks;
+        if (fShocked && pow.result.fConverged && pos.result.fConverged)
+            break;
+
+        // Both sides race from the last block; the process is memoryless,
+        // so the loser's progress is simply discarded.
+        double nPoWTime = SampleExponential(rng) / pow.GetRate();
+        double nPoSTime = SampleExponential(rng) / pos.GetRate();
+        bool fProofOfStake = nPoSTime < nPoWTime;
+        nClock += fProofOfStake ? nPoSTime : nPoWTime;
+
+        CDiffSimTrack& track = fProofOfStake ? pos : pow;
+        state.Advance(fProofOfStake, track.nNextBits, (uint32_t)nClock);
+        track.nNextBits = GetNextTargetRequired(fProofOfStake ? state.pos : state.pow, track.nTargetSpacing,
+                                                params.nTimespan);
+        if (fShocked) {
+            result.nBlocks++;
+            if (!track.result.fConverged)
+                track.result.nBlocks++;
+            track.Check(params.nTolerance, (int64_t)(nClock - nShockTime));
+        }
+    }
+
+    result.pow = pow.result;
+    result.pos = pos.result;
+    return result;
+}
+
+} // namespace Africoin
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_TEST_DIFFSIM_H
+#define AFRICOIN_TEST_DIFFSIM_H
+
+#include "staking/hybrid_difficulty.h"
+
+#include <stdint.h>
+
+/**
+ * @file diffsim.h
+ * @brief Hashrate and stake shock simulator for the hybrid retargets
+ *
+ * Miners and stakers race as two Poisson processes. At target T a side
+ * with power P finds blocks at rate P * T / T_limit per second, so P is
+ * the block rate that side would have at the easiest allowed target.
+ * Every block retargets its own track exactly as the chain does
+ * (GetNextTargetRequired with the per-type spacing).
+ *
+ * After a warm-up at the initial powers, the powers are multiplied by a
+ * shock and the simulator counts blocks and seconds until each track's
+ * expected spacing at the current target (i.e. 1 / rate) is back within
+ * a tolerance of its target spacing.
+ *
+ * Usage:
+ *
+ *   CDiffSimParams params;
+ *   CDiffSimShock shock;
+ *   shock.nHashFactor = 10;   // hashrate jumps tenfold
+ *   CDiffSimResult result = SimulateDifficultyShock(params, shock);
+ */
+
+namespace Africoin {
+
+/**
+ * @struct CDiffSimParams
+ * @brief Network and retarget settings for a simulation run
+ */
+struct CDiffSimParams {
+    uint64_t nSeed;
+    int nStartHeight;          //!< Height of the first simulated block
+    uint32_t nStartTime;
+    double nHashPower;         //!< PoW blocks per second at the target limit
+    double nStakePower;        //!< PoS blocks per second at the target limit
+    int64_t nTimespan;         //!< Retarget timespan for both tracks
+    int nWarmupBlocks;         //!< Blocks before the shock
+    int nMaxBlocks;            //!< Give up this many blocks after the shock
+    double nTolerance;         //!< Converged when expected spacing is within this fraction
+
+    CDiffSimParams()
+        : nSeed(1), nStartHeight(nPoSStartHeight), nStartTime(1500000000), nHashPower(1.0 / 15),
+          nStakePower(1.0 / 10), nTimespan(nHybridTargetTimespan), nWarmupBlocks(20000), nMaxBlocks(200000),
+          nTolerance(0.1) {}
+};
+
+/**
+ * @struct CDiffSimShock
+ * @brief Multipliers applied to the powers at the end of the warm-up
+ */
+struct CDiffSimShock {
+    double nHashFactor;
+    double nStakeFactor;
+
+    CDiffSimShock() : nHashFactor(1), nStakeFactor(1) {}
+};
+
+/**
+ * @struct CDiffSimTrackResult
+ * @brief Convergence of one track after the shock
+ */
+struct CDiffSimTrackResult {
+    bool fConverged;
+    int nBlocks;               //!< Blocks of this type until converged
+    int64_t nSeconds;          //!< Seconds from the shock until converged
+    double nSpacingAtShock;    //!< Expected spacing right after the shock
+
+    CDiffSimTrackResult() : fConverged(false), nBlocks(0), nSeconds(0), nSpacingAtShock(0) {}
+};
+
+/**
+ * @struct CDiffSimResult
+ */
+struct CDiffSimResult {
+    CDiffSimTrackResult pow;
+    CDiffSimTrackResult pos;
+    int nBlocks;               //!< Blocks of either type simulated after the shock
+};
+
+/** @brief Run one shock scenario */
+CDiffSimResult SimulateDifficultyShock(const CDiffSimParams& params, const CDiffSimShock& shock);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_TEST_DIFFSIM_H
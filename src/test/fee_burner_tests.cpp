@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include "../consensus/fee_burner.h"
+#include "../security/security_config.h"
+
+using namespace Africoin;
+
+void FeeBurnerTests()
+{
+    FeeBurnLedger ledger;
+    CFeeBurnUndo undo;
+    std::vector<CFeeBurnUndo> vUndo;
+
+    // --- Prefix sums over a short chain; each payout claims 400 of the fees ---
+    for (int nHeight = 0; nHeight < 10; nHeight++) {
+        CAmount nClaimed = nHeight ? 400 : 0;
+        assert(ledger.ConnectBlock(nHeight, nHeight * 1000, 50 * COIN + nClaimed, BLOCK_TYPE_POW, undo));
+        assert(undo.nBurned == nHeight * 1000 - nClaimed);
+        vUndo.push_back(undo);
+    }
+    assert(ledger.GetHeight() == 9);
+    assert(ledger.GetBurned(0, 9) == 45000 - 9 * 400);
+    assert(ledger.GetBurned(3, 3) == 2600);
+    assert(ledger.GetBurned(5, 100) == ledger.GetBurned(5, 9));
+    assert(ledger.GetBurned(7, 2) == 0);
+    assert(ledger.GetMinted(0, 9) == 10 * 50 * COIN);
+    assert(ledger.GetCirculatingSupply(9) == ledger.GetMinted(0, 9) - ledger.GetBurned(0, 9));
+    assert(ledger.GetBurnedInEpoch(0) == ledger.GetBurned(0, 9));
+    std::cout << "Fee Burn Prefix Sum Test Passed\n";
+
+    // --- Out-of-order connect is rejected ---
+    assert(!ledger.ConnectBlock(12, 1000, 50 * COIN, BLOCK_TYPE_POW, undo));
+    assert(ledger.GetHeight() == 9);
+
+    // --- Reorg: disconnect three blocks, reconnect with different fees ---
+    assert(!ledger.DisconnectBlock(vUndo[5]));
+    for (int i = 0; i < 3; i++) {
+        assert(ledger.DisconnectBlock(vUndo.back()));
+        vUndo.pop_back();
+    }
+    assert(ledger.GetHeight() == 6);
+    assert(ledger.GetBurned(0, 9) == ledger.GetBurned(0, 6));
+    const CAmount nHybridReward = HybridStaking::CalculateBlockReward(7, BLOCK_TYPE_HYBRID);
+    for (int nHeight = 7; nHeight < 10; nHeight++)
+        assert(ledger.ConnectBlock(nHeight, 2000, nHybridReward + 2000, BLOCK_TYPE_HYBRID, undo));
+    assert(ledger.GetBurned(7, 9) == 0);
+    assert(ledger.GetMinted(7, 7) == HybridStaking::CalculateBlockReward(7, BLOCK_TYPE_HYBRID));
+    std::cout << "Fee Burn Reorg Test Passed\n";
+
+    // --- Multi-block disconnect is all or nothing, and can be put back ---
+    vUndo.clear();
+    for (int nHeight = 10; nHeight < 14; nHeight++) {
+        assert(ledger.ConnectBlock(nHeight, nHeight * 1000, 50 * COIN, BLOCK_TYPE_POW, undo));
+        vUndo.insert(vUndo.begin(), undo);
+    }
+    CAmount nBurned = ledger.GetBurned(0, 13);
+    std::vector<CFeeBurnUndo> vBad = vUndo;
+    vBad[2].nBurned++;
+    assert(!ledger.DisconnectBlocks(vBad));
+    assert(ledger.GetHeight() == 13 && ledger.GetBurned(0, 13) == nBurned);
+    assert(ledger.DisconnectBlocks(vUndo));
+    assert(ledger.GetHeight() == 9);
+    assert(ledger.ConnectBlock(10, 5000, 0, BLOCK_TYPE_POS, undo));
+    ledger.RestoreBlocks(9, vUndo);
+    assert(ledger.GetHeight() == 13 && ledger.GetBurned(0, 13) == nBurned);
+    std::cout << "Fee Burn Multi-Block Disconnect Test Passed\n";
+
+    // --- Unclaimed fees: the burn and mint split of a payout ---
+    assert(FeeBurnLedger::GetBurnAmount(0, BLOCK_TYPE_POW, 1000, 50 * COIN + 1000) == 0);
+    assert(FeeBurnLedger::GetBurnAmount(0, BLOCK_TYPE_POW, 1000, 50 * COIN + 250) == 750);
+    assert(FeeBurnLedger::GetBurnAmount(0, BLOCK_TYPE_POW, 1000, 50 * COIN) == 1000);
+    assert(FeeBurnLedger::GetBurnAmount(0, BLOCK_TYPE_POW, 1000, 10 * COIN) == 1000);
+    assert(FeeBurnLedger::GetBurnAmount(0, BLOCK_TYPE_POW, 1000, 60 * COIN) == 0);
+    assert(FeeBurnLedger::GetBurnAmount(0, BLOCK_TYPE_POW, -5, 50 * COIN) == 0);
+    assert(FeeBurnLedger::GetMintAmount(0, BLOCK_TYPE_POW, 10 * COIN) == 10 * COIN);
+    assert(FeeBurnLedger::GetMintAmount(0, BLOCK_TYPE_POW, 60 * COIN) == 50 * COIN);
+    assert(FeeBurnLedger::GetMintAmount(0, BLOCK_TYPE_POW, -1) == 0);
+
+    // A payout short of the subsidy burns every fee and mints only what it paid
+    FeeBurnLedger ledgerShort;
+    assert(ledgerShort.ConnectBlock(0, 1000, 10 * COIN, BLOCK_TYPE_POW, undo));
+    assert(undo.nBurned == 1000 && undo.nMinted == 10 * COIN);
+    assert(ledgerShort.GetCirculatingSupply(0) == 10 * COIN - 1000);
+    std::cout << "Fee Burn Unclaimed Fees Test Passed\n";
+
+    std::cout << "All FeeBurnerTests Passed.\n";
+}
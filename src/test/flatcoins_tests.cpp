@@ -0,0 +1,255 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../storage/flatcoins.h"
+#include "arith_uint256.h"
+
+using namespace Africoin;
+
+/** Coins database that checks the flags of what it is given */
+class FlatBaseCoinsView : public CCoinsView {
+public:
+    std::map<COutPoint, Coin> mapCoins;
+    std::vector<size_t> vBatchSizes;
+    std::vector<uint256> vBestBlocks;
+    uint256 hashBest;
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override
+    {
+        auto it = mapCoins.find(outpoint);
+        if (it == mapCoins.end())
+            return false;
+        coin = it->second;
+        return true;
+    }
+
+    uint256 GetBestBlock() const override { return hashBest; }
+
+    bool BatchWrite(CCoinsMap& mapBatch, const uint256& hashBlock) override
+    {
+        for (auto& entry : mapBatch) {
+            assert(entry.second.flags & CCoinsCacheEntry::DIRTY);
+            if (entry.second.flags & CCoinsCacheEntry::FRESH) {
+                // A fresh coin is new to us and was not spent in the cache
+                assert(!mapCoins.count(entry.first) && !entry.second.coin.IsSpent());
+            }
+            if (entry.second.coin.IsSpent())
+                mapCoins.erase(entry.first);
+            else
+                mapCoins[entry.first] = entry.second.coin;
+        }
+        vBatchSizes.push_back(mapBatch.size());
+        vBestBlocks.push_back(hashBlock);
+        mapBatch.clear();
+        // A null hash leaves the best block alone, as in CCoinsViewDB
+        if (!hashBlock.IsNull())
+            hashBest = hashBlock;
+        return true;
+    }
+};
+
+static bool SameCoin(const Coin& a, const Coin& b)
+{
+    return a.out.nValue == b.out.nValue && a.out.scriptPubKey == b.out.scriptPubKey && a.nHeight == b.nHeight &&
+           a.nTime == b.nTime && a.fCoinBase == b.fCoinBase && a.fCoinStake == b.fCoinStake;
+}
+
+static Coin RandomCoin(std::mt19937& rng)
+{
+    // Scripts of every size up to a bare multisig, so the arena is uneven
+    CScript script = CScript() << std::vector<unsigned char>(rng() % 72, (unsigned char)(rng() % 0x60));
+    return Coin(CTxOut(1 + rng() % 1000000, script), rng() % 500000, rng() % 8 == 0, rng() % 4 == 0,
+                1500000000 + rng() % 1000000);
+}
+
+void FlatCoinsTests()
+{
+    std::mt19937 rng(49);
+
+    // --- Against a map: random adds, spends, syncs and flushes over a populated database ---
+    {
+        FlatBaseCoinsView db;
+        std::map<COutPoint, Coin> mapModel;
+        std::vector<COutPoint> vOutpoints;
+        for (uint32_t i = 0; i < 3000; i++) {
+            COutPoint outpoint(ArithToUint256(arith_uint256(rng())), i % 4);
+            Coin coin = RandomCoin(rng);
+            db.mapCoins[outpoint] = coin;
+            mapModel[outpoint] = coin;
+            vOutpoints.push_back(outpoint);
+        }
+
+        CFlatCoinsCache cache(&db, 1 << 30, 500);
+        for (int nStep = 0; nStep < 60000; nStep++) {
+            int nOp = rng() % 100;
+            if (nOp < 30 || vOutpoints.empty()) {
+                COutPoint outpoint(ArithToUint256(arith_uint256(rng())), rng() % 4);
+                Coin coin = RandomCoin(rng);
+                mapModel[outpoint] = coin;
+                vOutpoints.push_back(outpoint);
+                cache.AddCoin(outpoint, std::move(coin), false);
+            } else if (nOp < 55) {
+                size_t n = rng() % vOutpoints.size();
+                const COutPoint outpoint = vOutpoints[n];
+                Coin moved;
+                bool fUnspent = mapModel.count(outpoint);
+                assert(cache.SpendCoin(outpoint, &moved) == fUnspent);
+                if (fUnspent) {
+                    assert(SameCoin(moved, mapModel[outpoint]));
+                    mapModel.erase(outpoint);
+                }
+                assert(!cache.HaveCoin(outpoint));
+                // Sometimes the same outpoint comes back, as after a reorg
+                if (rng() % 4 == 0) {
+                    Coin coin = RandomCoin(rng);
+                    mapModel[outpoint] = coin;
+                    cache.AddCoin(outpoint, std::move(coin), rng() % 2);
+                } else {
+                    vOutpoints[n] = vOutpoints.back();
+                    vOutpoints.pop_back();
+                }
+            } else if (nOp < 98) {
+                const COutPoint& outpoint = vOutpoints[rng() % vOutpoints.size()];
+                Coin coin;
+                bool fUnspent = mapModel.count(outpoint);
+                assert(cache.GetCoin(outpoint, coin) == fUnspent);
+                assert(cache.HaveCoin(outpoint) == fUnspent);
+                if (fUnspent)
+                    assert(SameCoin(coin, mapModel[outpoint]));
+            } else if (nOp < 99) {
+                assert(cache.Sync());
+                assert(db.mapCoins.size() == mapModel.size());
+            } else {
+                assert(cache.Flush());
+                assert(cache.GetCacheSize() == 0);
+            }
+
+            // An unspent coin is never replaced unknowingly
+            if (nStep % 1000 == 0 && !mapModel.empty()) {
+                const COutPoint& outpoint = mapModel.begin()->first;
+                assert(cache.HaveCoin(outpoint));
+                bool fThrew = false;
+                try {
+                    cache.AddCoin(outpoint, RandomCoin(rng), false);
+                } catch (const std::logic_error&) {
+                    fThrew = true;
+                }
+                assert(fThrew);
+            }
+        }
+        assert(cache.Sync());
+        assert(db.mapCoins.size() == mapModel.size());
+        for (const auto& entry : mapModel)
+            assert(db.mapCoins.count(entry.first) && SameCoin(db.mapCoins[entry.first], entry.second));
+
+        // Sync compacts the arena once half of it is unreferenced
+        CFlatCoinsStats stats = cache.GetStats();
+        assert(stats.nArenaGarbage * 2 <= stats.nArenaBytes && stats.nFlushes > 1);
+        assert(stats.nHits > 0 && stats.nMisses > 0 && stats.nCoinsErased > 0);
+        for (size_t n : db.vBatchSizes)
+            assert(n <= 500);
+    }
+    std::cout << "FlatCoins Model Test Passed\n";
+
+    // --- A coin created and spent between flushes never reaches the database ---
+    {
+        FlatBaseCoinsView db;
+        CFlatCoinsCache cache(&db, 1 << 30);
+        COutPoint outpoint(ArithToUint256(arith_uint256(1)), 0);
+        CScript script = CScript() << std::vector<unsigned char>(25, 0x76);
+        cache.AddCoin(outpoint, Coin(CTxOut(5 * COIN, script), 10, false, true, 1500000000), false);
+        assert(cache.SpendCoin(outpoint));
+        assert(cache.GetCacheSize() == 0);
+        uint256 hashBlock = ArithToUint256(arith_uint256(77));
+        cache.SetBestBlock(hashBlock);
+        assert(cache.Flush());
+        assert(db.mapCoins.empty() && db.vBatchSizes.size() == 1 && db.vBatchSizes[0] == 0);
+        assert(db.hashBest == hashBlock && cache.GetStats().nCoinsWritten == 0);
+    }
+    std::cout << "FlatCoins Fresh Spend Test Passed\n";
+
+    // --- Metadata without the script, and a child cache written into this one ---
+    {
+        FlatBaseCoinsView db;
+        COutPoint stake(ArithToUint256(arith_uint256(2)), 1);
+        CScript script = CScript() << std::vector<unsigned char>(33, 0x02);
+        db.mapCoins[stake] = Coin(CTxOut(1000 * COIN, script), 12345, false, true, 1600000000);
+        CFlatCoinsCache cache(&db, 1 << 30);
+
+        CFlatCoinMeta meta;
+        assert(cache.GetCoinMeta(stake, meta));
+        assert(meta.nValue == 1000 * COIN && meta.nHeight == 12345 && meta.nTime == 1600000000);
+        assert(meta.fCoinStake && !meta.fCoinBase);
+        assert(!cache.GetCoinMeta(COutPoint(stake.hash, 0), meta));
+
+        COutPoint created(ArithToUint256(arith_uint256(3)), 0);
+        COutPoint transient(ArithToUint256(arith_uint256(4)), 0);
+        CCoinsMap mapChild;
+        mapChild[stake].coin.Clear();
+        mapChild[stake].flags = CCoinsCacheEntry::DIRTY;
+        mapChild[created].coin = Coin(CTxOut(7, script), 20, true, false, 1600000100);
+        mapChild[created].flags = CCoinsCacheEntry::DIRTY | CCoinsCacheEntry::FRESH;
+        mapChild[transient].flags = CCoinsCacheEntry::DIRTY | CCoinsCacheEntry::FRESH;
+        uint256 hashBlock = ArithToUint256(arith_uint256(78));
+        assert(cache.BatchWrite(mapChild, hashBlock));
+        assert(mapChild.empty() && cache.GetBestBlock() == hashBlock);
+        assert(!cache.HaveCoin(stake) && cache.HaveCoin(created) && cache.GetCacheSize() == 2);
+
+        // FRESH on a coin this cache holds unspent is the child's bug
+        mapChild[created].coin = Coin(CTxOut(8, CScript()), 21, false, false, 1600000200);
+        mapChild[created].flags = CCoinsCacheEntry::DIRTY | CCoinsCacheEntry::FRESH;
+        bool fThrew = false;
+        try {
+            cache.BatchWrite(mapChild, hashBlock);
+        } catch (const std::logic_error&) {
+            fThrew = true;
+        }
+        assert(fThrew);
+
+        assert(cache.Sync());
+        assert(!db.mapCoins.count(stake) && db.mapCoins.count(created) && !db.mapCoins.count(transient));
+        assert(db.hashBest == hashBlock && cache.GetCacheSize() == 1);
+    }
+    std::cout << "FlatCoins BatchWrite Test Passed\n";
+
+    // --- Memory budget: growth past it flushes everything in sorted batches ---
+    {
+        FlatBaseCoinsView db;
+        CFlatCoinsCache cache(&db, 256 * 1024, 1000);
+        uint256 hashBlock = ArithToUint256(arith_uint256(79));
+        cache.SetBestBlock(hashBlock);
+        size_t nFlushed = 0;
+        for (uint32_t i = 0; i < 20000; i++) {
+            cache.AddCoin(COutPoint(ArithToUint256(arith_uint256(i + 1)), 0), RandomCoin(rng), false);
+            size_t nEntries = cache.GetCacheSize();
+            assert(cache.FlushIfOverBudget());
+            if (cache.GetCacheSize() == 0) {
+                nFlushed += nEntries;
+                assert(db.mapCoins.size() == nFlushed);
+            }
+            assert(cache.DynamicMemoryUsage() <= cache.GetMaxBytes());
+        }
+        assert(nFlushed > 0 && nFlushed < 20000 && cache.GetStats().nFlushes > 1);
+
+        // Each flush moves the best block once, with its last batch
+        assert(db.vBatchSizes.size() > cache.GetStats().nFlushes && db.hashBest == hashBlock);
+        assert((uint64_t)std::count_if(db.vBestBlocks.begin(), db.vBestBlocks.end(),
+                                       [](const uint256& hash) { return !hash.IsNull(); }) == cache.GetStats().nFlushes);
+
+        // Reserving up front does not lose or move coins out of reach
+        cache.Reserve(100000);
+        assert(cache.GetStats().nSlots >= 131072);
+        for (uint32_t i = nFlushed; i < 20000; i++)
+            assert(cache.HaveCoin(COutPoint(ArithToUint256(arith_uint256(i + 1)), 0)));
+        assert(cache.Flush() && db.mapCoins.size() == 20000);
+    }
+    std::cout << "FlatCoins Budget Test Passed\n";
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include "../arith_uint256.h"
+#include "../chain.h"
+#include "../consensus/blockforest.h"
+#include "../security/kernel.h"
+#include "../staking/hybrid_difficulty.h"
+#include "../test/chaingen.h"
+#include "../test/diffsim.h"
+
+using namespace Africoin;
+
+static arith_uint256 Target(uint32_t nBits)
+{
+    arith_uint256 bnTarget;
+    bnTarget.SetCompact(nBits);
+    return bnTarget;
+}
+
+static void PrintShock(const char* pszName, const CDiffSimResult& result)
+{
+    printf("  %-12s PoW %s after %d blocks / %llds, PoS %s after %d blocks / %llds\n", pszName,
+           result.pow.fConverged ? "converged" : "NOT converged", result.pow.nBlocks, (long long)result.pow.nSeconds,
+           result.pos.fConverged ? "converged" : "NOT converged", result.pos.nBlocks, (long long)result.pos.nSeconds);
+}
+
+void HybridDifficultyTests()
+{
+    // --- Per-type spacing follows the PoS ratio once staking starts ---
+    const int64_t nPoWSpacing = GetHybridTargetSpacing(false, nPoSStartHeight);
+    const int64_t nPoSSpacing = GetHybridTargetSpacing(true, nPoSStartHeight);
+    assert(GetHybridTargetSpacing(false, nPoSStartHeight - 1) == PeerCoin::nStakeTargetSpacing);
+    assert(nPoWSpacing == 1500);
+    assert(nPoSSpacing == 167);
+    std::cout << "Hybrid Target Spacing Test Passed\n";
+
+    // --- Retarget direction ---
+    const uint32_t nBits = 0x1c0fffff;
+    CDifficultyTrack track;
+    assert(GetNextTargetRequired(track, nPoSSpacing) == HYBRID_TARGET_LIMIT_BITS);
+    track.Advance(nBits, 1500000000);
+    assert(GetNextTargetRequired(track, nPoSSpacing) == nBits);
+
+    CDifficultyTrack onTarget = track, fast = track, slow = track, backwards = track, stalled = track, capped = track;
+    onTarget.Advance(nBits, track.nTime + nPoSSpacing);
+    fast.Advance(nBits, track.nTime + nPoSSpacing / 2);
+    slow.Advance(nBits, track.nTime + nPoSSpacing * 2);
+    backwards.Advance(nBits, track.nTime - 60);
+    stalled.Advance(nBits, track.nTime + nPoSSpacing * 1000);
+    capped.Advance(nBits, track.nTime + nPoSSpacing * nHybridMaxSpacingFactor);
+    assert(GetNextTargetRequired(onTarget, nPoSSpacing) == nBits);
+    assert(Target(GetNextTargetRequired(fast, nPoSSpacing)) < Target(nBits));
+    assert(Target(GetNextTargetRequired(slow, nPoSSpacing)) > Target(nBits));
+    assert(GetNextTargetRequired(backwards, nPoSSpacing) == nBits);
+    assert(GetNextTargetRequired(stalled, nPoSSpacing) == GetNextTargetRequired(capped, nPoSSpacing));
+
+    CDifficultyTrack atLimit;
+    atLimit.Advance(HYBRID_TARGET_LIMIT_BITS, 1500000000);
+    atLimit.Advance(HYBRID_TARGET_LIMIT_BITS, 1500000000 + nPoSSpacing * 2);
+    assert(GetNextTargetRequired(atLimit, nPoSSpacing) == HYBRID_TARGET_LIMIT_BITS);
+    std::cout << "Hybrid Retarget Direction Test Passed\n";
+
+    // --- Tracks are independent; hybrid blocks get the easier target ---
+    CHybridDifficultyState state;
+    state.Advance(false, nBits, 1500000000);
+    state.Advance(false, nBits, 1500000000 + nPoWSpacing / 2);
+    state.Advance(true, nBits, 1500000100);
+    state.Advance(true, nBits, 1500000100 + nPoSSpacing * 2);
+    uint32_t nPoWBits = GetNextHybridTarget(state, BLOCK_TYPE_POW, nPoSStartHeight);
+    uint32_t nPoSBits = GetNextHybridTarget(state, BLOCK_TYPE_POS, nPoSStartHeight);
+    assert(Target(nPoWBits) < Target(nBits));
+    assert(Target(nPoSBits) > Target(nBits));
+    assert(GetNextHybridTarget(state, BLOCK_TYPE_HYBRID, nPoSStartHeight) == nPoSBits);
+    std::cout << "Hybrid Track Independence Test Passed\n";
+
+    // --- Forest state is what walking back finds, at every height ---
+    CChainGenParams params;
+    params.nBlocks = 20000;
+    params.nPoSRatioPpm = 950000;
+    CGeneratedChain chain;
+    GenerateChain(params, chain);
+    CBlockForest forest;
+    BuildBlockForest(chain, forest);
+
+    std::unique_ptr<CBlockIndex[]> pIndex(new CBlockIndex[chain.vBlocks.size()]);
+    BlockRef ref = NULL_BLOCK_REF;
+    for (uint32_t h = 0; h < chain.vBlocks.size(); h++) {
+        const CGenBlock& block = chain.vBlocks[h];
+        pIndex[h].phashBlock = &block.hashBlock;
+        pIndex[h].pprev = h > 0 ? &pIndex[h - 1] : nullptr;
+        pIndex[h].nHeight = h;
+        pIndex[h].nTime = block.nTime;
+        pIndex[h].nBits = block.nBits;
+        if (block.IsProofOfStake())
+            pIndex[h].SetProofOfStake();
+
+        ref = forest.Find(block.hashBlock);
+        assert(ref != NULL_BLOCK_REF);
+        assert(forest.Cold(ref).difficulty == GetDifficultyStateByWalk(&pIndex[h]));
+    }
+    assert(forest.Cold(ref).difficulty.pos.nTimePrev != 0);
+    std::cout << "Hybrid Difficulty State Test Passed\n";
+
+    // --- Shocks: the shocked track recovers, the other one is undisturbed ---
+    CDiffSimParams simParams;
+    simParams.nWarmupBlocks = 30000;
+    simParams.nMaxBlocks = 100000;
+
+    CDiffSimShock hashUp;
+    hashUp.nHashFactor = 10;
+    CDiffSimResult result = SimulateDifficultyShock(simParams, hashUp);
+    PrintShock("10x hash", result);
+    assert(result.pow.fConverged && result.pos.fConverged);
+    assert(result.pow.nSpacingAtShock < nPoWSpacing / 5.0);
+    assert(result.pow.nBlocks > 0 && result.pow.nBlocks < 500);
+    assert(fabs(result.pos.nSpacingAtShock / nPoSSpacing - 1.0) < 0.5);
+
+    CDiffSimResult again = SimulateDifficultyShock(simParams, hashUp);
+    assert(again.nBlocks == result.nBlocks && again.pow.nSeconds == result.pow.nSeconds);
+
+    CDiffSimShock stakeDown;
+    stakeDown.nStakeFactor = 0.1;
+    result = SimulateDifficultyShock(simParams, stakeDown);
+    PrintShock("0.1x stake", result);
+    assert(result.pow.fConverged && result.pos.fConverged);
+    assert(result.pos.nSpacingAtShock > nPoSSpacing * 5.0);
+    assert(result.pos.nBlocks > 0 && result.pos.nBlocks < 2000);
+    assert(fabs(result.pow.nSpacingAtShock / nPoWSpacing - 1.0) < 0.5);
+    std::cout << "Hybrid Difficulty Shock Test Passed\n";
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../metrics/metrics.h"
+
+using namespace Africoin::Metrics;
+
+static CCounter testCounter("africoin_test_events_total", "Test events");
+static CHistogram testHistogram("africoin_test_latency_seconds", "Test latency");
+
+void MetricsTests()
+{
+    // --- Buckets: contiguous, and every value within 1/16 of its bucket ---
+    for (unsigned int i = 0; i + 1 < CHistogram::NUM_BUCKETS; i++)
+        assert(CHistogram::BucketUpperBound(i) + 1 == CHistogram::BucketLowerBound(i + 1));
+    assert(CHistogram::BucketUpperBound(CHistogram::NUM_BUCKETS - 1) == ~(uint64_t)0);
+    for (uint64_t nValue : {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 1000ULL, 123456789ULL, ~0ULL}) {
+        unsigned int nIndex = CHistogram::BucketIndex(nValue);
+        assert(nIndex < CHistogram::NUM_BUCKETS);
+        assert(CHistogram::BucketLowerBound(nIndex) <= nValue && nValue <= CHistogram::BucketUpperBound(nIndex));
+        assert(CHistogram::BucketUpperBound(nIndex) - CHistogram::BucketLowerBound(nIndex) <= nValue / 16);
+    }
+    std::cout << "Metrics Histogram Bucket Test Passed\n";
+
+    // --- Counters and histograms summed across threads ---
+    std::vector<std::thread> vThreads;
+    for (int t = 0; t < 12; t++) {
+        vThreads.emplace_back([] {
+            for (uint64_t i = 1; i <= 10000; i++) {
+                testCounter.Add();
+                testHistogram.Record(i * 1000);
+            }
+        });
+    }
+    for (std::thread& thread : vThreads)
+        thread.join();
+    assert(testCounter.Get() == 120000);
+
+    CHistogram::Snapshot snapshot;
+    testHistogram.GetSnapshot(snapshot);
+    assert(snapshot.nCount == 120000);
+    assert(snapshot.nSum == 12 * 1000 * (10000ULL * 10001 / 2));
+    uint64_t nMedian = snapshot.Quantile(0.5), nP99 = snapshot.Quantile(0.99);
+    assert(nMedian >= 5000000 && nMedian <= 5000000 + 5000000 / 16 + 1);
+    assert(nP99 >= 9900000 && nP99 <= 9900000 + 9900000 / 16 + 1);
+    assert(snapshot.Quantile(1.0) >= 10000000);
+    std::cout << "Metrics Sharded Update Test Passed\n";
+
+    // --- Scoped timers and the Prometheus export ---
+    {
+        CScopedTimer timer(testHistogram);
+    }
+    testHistogram.GetSnapshot(snapshot);
+    assert(snapshot.nCount == 120001);
+
+    std::string strOut = FormatPrometheus();
+    assert(strOut.find("# TYPE africoin_test_events_total counter\n") != std::string::npos);
+    assert(strOut.find("africoin_test_events_total 120000\n") != std::string::npos);
+    assert(strOut.find("# TYPE africoin_test_latency_seconds summary\n") != std::string::npos);
+    assert(strOut.find("africoin_test_latency_seconds_count 120001\n") != std::string::npos);
+    assert(strOut.find("africoin_test_latency_seconds{quantile=\"0.99\"}") != std::string::npos);
+    std::cout << "Metrics Prometheus Export Test Passed\n";
+}
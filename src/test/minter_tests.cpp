@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <math.h>
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "arith_uint256.h"
+#include "../security/kernel.h"
+#include "../staking/minter.h"
+
+using namespace Africoin;
+using PeerCoin::Kernel;
+
+void MinterTests()
+{
+    // --- Midstate hash is the kernel hash ---
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 1000; i++) {
+        uint64_t nModifier = rng();
+        uint32_t nTimeBlockFrom = rng(), nTxPrevOffset = rng(), nTimeTxPrev = rng(), nPrevout = rng() % 16;
+        CKernelMidstate midstate;
+        midstate.Init(nModifier, nTimeBlockFrom, nTxPrevOffset, nTimeTxPrev, nPrevout);
+        for (uint32_t nTimeTx = nTimeTxPrev; nTimeTx < nTimeTxPrev + 4; nTimeTx++)
+            assert(midstate.Hash(nTimeTx) ==
+                   Kernel::ComputeKernelHash(nModifier, nTimeBlockFrom, nTxPrevOffset, nTimeTxPrev, nPrevout, nTimeTx));
+    }
+    std::cout << "Kernel Midstate Hash Test Passed\n";
+
+    // --- Midstates are rebuilt only when the modifier changes ---
+    CStakeMinter minter;
+    CStakeCandidate candidate;
+    candidate.prevout = COutPoint(uint256(), 1);
+    candidate.nTimeBlockFrom = 1500000000;
+    candidate.nTxPrevOffset = 81;
+    candidate.nTimeTxPrev = 1500000000;
+    candidate.nValue = 1000 * COIN;
+    minter.AddCandidate(candidate);
+    assert(minter.GetMidstate(COutPoint(uint256(), 2), 1) == nullptr);
+
+    const CKernelMidstate* pmidstate = minter.GetMidstate(candidate.prevout, 7);
+    assert(pmidstate && pmidstate->GetStakeModifier() == 7);
+    minter.GetMidstate(candidate.prevout, 7);
+    assert(minter.GetMidstateBuilds() == 1);
+    pmidstate = minter.GetMidstate(candidate.prevout, 8);
+    assert(minter.GetMidstateBuilds() == 2);
+    assert(pmidstate->Hash(1503000000) == Kernel::ComputeKernelHash(8, 1500000000, 81, 1500000000, 1, 1503000000));
+
+    minter.AddCandidate(candidate);
+    minter.GetMidstate(candidate.prevout, 8);
+    assert(minter.GetMidstateBuilds() == 3);
+    std::cout << "Kernel Midstate Cache Test Passed\n";
+
+    // --- Search finds the first timestamp a full check would accept ---
+    const unsigned int nBits = 0x1e0fffff;
+    const uint32_t nTimeBegin = candidate.nTimeTxPrev + PeerCoin::nStakeMinAge + 86400;
+    uint32_t nTimeTx = 0;
+    uint256 hashProof;
+    bool fFound = minter.SearchKernel(candidate.prevout, 8, nBits, nTimeBegin, nTimeBegin + 100000, nTimeTx, hashProof);
+    uint32_t nTimeExpected = 0;
+    for (uint32_t t = nTimeBegin; t <= nTimeBegin + 100000 && !nTimeExpected; t++) {
+        uint256 hash = Kernel::ComputeKernelHash(8, 1500000000, 81, 1500000000, 1, t);
+        if (Kernel::CheckKernelHashTarget(hash, nBits, candidate.nValue, candidate.nTimeTxPrev, t))
+            nTimeExpected = t;
+    }
+    assert(fFound == (nTimeExpected != 0));
+    if (fFound)
+        assert(nTimeTx == nTimeExpected && hashProof == Kernel::ComputeKernelHash(8, 1500000000, 81, 1500000000, 1, nTimeTx));
+    assert(minter.GetMidstateBuilds() == 3);
+
+    assert(minter.RemoveCandidate(candidate.prevout));
+    assert(!minter.SearchKernel(candidate.prevout, 8, nBits, nTimeBegin, nTimeBegin + 10, nTimeTx, hashProof));
+    std::cout << "Kernel Search Test Passed\n";
+
+    // --- Eligible time is the first whole coin-day ---
+    CStakeCandidate coin;
+    coin.nTimeTxPrev = 1500000000;
+    coin.nValue = COIN;
+    uint32_t nEligible = CStakeMinter::GetEligibleTime(coin);
+    assert(nEligible == 1500000000 + PeerCoin::nStakeMinAge + 24 * 60 * 60);
+    assert(CStakeMinter::GetCoinDayWeight(coin, nEligible - 1) == 0);
+    assert(CStakeMinter::GetCoinDayWeight(coin, nEligible) == 1);
+    coin.nValue = 1000 * COIN;
+    nEligible = CStakeMinter::GetEligibleTime(coin);
+    assert(nEligible == 1500000000 + PeerCoin::nStakeMinAge + 87);
+    assert(CStakeMinter::GetCoinDayWeight(coin, nEligible - 1) == 0);
+    assert(CStakeMinter::GetCoinDayWeight(coin, nEligible) == 1);
+    coin.nValue = 1000;
+    assert(CStakeMinter::GetEligibleTime(coin) == STAKE_NEVER_ELIGIBLE);
+    std::cout << "Stake Eligible Time Test Passed\n";
+
+    // --- Rounds skip only zero-target probes, heaviest outputs first ---
+    const uint32_t nNow = 1500000000 + PeerCoin::nStakeMinAge + 2 * 24 * 60 * 60;
+    const uint32_t nWindow = 64;
+    CStakeMinter wallet;
+    for (uint32_t i = 0; i < 200; i++) {
+        CStakeCandidate output;
+        output.prevout = COutPoint(uint256(), i);
+        output.nTimeBlockFrom = 1500000000 + i;
+        output.nTxPrevOffset = 81 + i;
+        // Half just past the minimum age, too young for a whole coin-day in this window
+        output.nTimeTxPrev = nNow - PeerCoin::nStakeMinAge - rng() % (i % 2 ? 4 * 24 * 60 * 60 : 60);
+        output.nValue = (1 + rng() % 100) * COIN;
+        wallet.AddCandidate(output);
+    }
+    std::vector<uint32_t> vLookups;
+    StakeModifierLookup lookup = [&vLookups](const CStakeCandidate& output, uint64_t& nStakeModifier) {
+        vLookups.push_back(output.prevout.n);
+        nStakeModifier = output.nTimeBlockFrom * 31ULL;
+        return true;
+    };
+
+    // Target so hard nothing hits: every probe runs, none is wasted
+    uint64_t nExpectedProbes = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        const CStakeCandidate& output = *wallet.GetCandidate(COutPoint(uint256(), i));
+        for (uint32_t t = nNow; t < nNow + nWindow; t++)
+            nExpectedProbes += CStakeMinter::GetCoinDayWeight(output, t) > 0;
+    }
+    CStakeHit hit;
+    CStakeRoundStats stats;
+    assert(!wallet.FindStake(0x1a0fffff, nNow, nNow + nWindow - 1, 0, lookup, hit, stats));
+    assert(stats.nProbes == nExpectedProbes);
+    assert(stats.nProbes + stats.nSkippedIneligible == 200 * nWindow);
+    assert(stats.nSkippedIneligible > 0 && stats.nSkippedBudget == 0);
+
+    int64_t nHeaviest = 0;
+    for (uint32_t i = 0; i < 200; i++)
+        nHeaviest = std::max(nHeaviest, CStakeMinter::GetCoinDayWeight(*wallet.GetCandidate(COutPoint(uint256(), i)),
+                                                                       nNow + nWindow - 1));
+    assert(CStakeMinter::GetCoinDayWeight(*wallet.GetCandidate(COutPoint(uint256(), vLookups[0])),
+                                          nNow + nWindow - 1) == nHeaviest);
+
+    // A budget of one window probes only the heaviest output
+    vLookups.clear();
+    stats = CStakeRoundStats();
+    assert(!wallet.FindStake(0x1a0fffff, nNow, nNow + nWindow - 1, nWindow, lookup, hit, stats));
+    assert(stats.nProbes == nWindow);
+    assert(stats.nProbes + stats.nSkippedBudget == nExpectedProbes);
+    assert(stats.nExpectedSkipped > 0);
+
+    // ...and estimates the hits it skipped close to probe-by-probe
+    arith_uint256 bnTargetPerCoinDay;
+    bnTargetPerCoinDay.SetCompact(0x1a0fffff);
+    const double nHitPerCoinDay = bnTargetPerCoinDay.getdouble() / ldexp(1.0, 256);
+    double nSkippedHits = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        const CStakeCandidate& output = *wallet.GetCandidate(COutPoint(uint256(), i));
+        for (uint32_t t = nNow; t < nNow + nWindow && i != vLookups[0]; t++)
+            nSkippedHits += std::min(1.0, CStakeMinter::GetCoinDayWeight(output, t) * nHitPerCoinDay);
+    }
+    assert(fabs(stats.nExpectedSkipped - nSkippedHits) < 0.05 * nSkippedHits);
+
+    // Easy target: the kernel found is valid
+    stats = CStakeRoundStats();
+    assert(wallet.FindStake(0x1e0fffff, nNow, nNow + nWindow - 1, 0, lookup, hit, stats));
+    const CStakeCandidate& winner = *wallet.GetCandidate(hit.prevout);
+    assert(hit.hashProof == Kernel::ComputeKernelHash(winner.nTimeBlockFrom * 31ULL, winner.nTimeBlockFrom,
+                                                      winner.nTxPrevOffset, winner.nTimeTxPrev, winner.prevout.n,
+                                                      hit.nTimeTx));
+    assert(Kernel::CheckKernelHashTarget(hit.hashProof, 0x1e0fffff, winner.nValue, winner.nTimeTxPrev, hit.nTimeTx));
+    std::cout << "Stake Round Scheduling Test Passed\n";
+}
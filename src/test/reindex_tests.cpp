@@ -0,0 +1,273 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../consensus/blockforest.h"
+#include "../storage/blockstore.h"
+#include "../storage/reindex.h"
+#include "arith_uint256.h"
+#include "primitives/block.h"
+#include "sync.h"
+#include "txdb.h"
+#include "validation.h"
+
+#include <boost/filesystem.hpp>
+
+using namespace Africoin;
+
+/** In-memory coins database that records every batch it is given */
+class MemoryCoinsView : public CCoinsView {
+public:
+    std::map<COutPoint, Coin> mapCoins;
+    std::vector<std::vector<COutPoint>> vBatches;
+    std::vector<uint256> vBestBlocks;
+    uint256 hashBest;
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override
+    {
+        auto it = mapCoins.find(outpoint);
+        if (it == mapCoins.end())
+            return false;
+        coin = it->second;
+        return true;
+    }
+
+    bool BatchWrite(CCoinsMap& mapBatch, const uint256& hashBlock) override
+    {
+        std::vector<COutPoint> vKeys;
+        for (auto& entry : mapBatch) {
+            assert(entry.second.flags & CCoinsCacheEntry::DIRTY);
+            vKeys.push_back(entry.first);
+            if (entry.second.coin.IsSpent())
+                mapCoins.erase(entry.first);
+            else
+                mapCoins[entry.first] = entry.second.coin;
+        }
+        mapBatch.clear();
+        std::sort(vKeys.begin(), vKeys.end());
+        vBatches.push_back(vKeys);
+        vBestBlocks.push_back(hashBlock);
+        // A null hash leaves the best block alone, as in CCoinsViewDB
+        if (!hashBlock.IsNull())
+            hashBest = hashBlock;
+        return true;
+    }
+};
+
+static CTransactionRef MakeTx(uint32_t nTime, const std::vector<COutPoint>& vPrevouts, const std::vector<CAmount>& vValues)
+{
+    CMutableTransaction tx;
+    tx.nTime = nTime;
+    tx.vin.resize(vPrevouts.empty() ? 1 : vPrevouts.size());
+    for (size_t i = 0; i < vPrevouts.size(); i++)
+        tx.vin[i].prevout = vPrevouts[i];
+    if (vPrevouts.empty())
+        tx.vin[0].scriptSig = CScript() << (int64_t)nTime;   // Unique coinbase
+    for (CAmount nValue : vValues) {
+        tx.vout.emplace_back();
+        tx.vout.back().nValue = nValue;
+        tx.vout.back().scriptPubKey = CScript() << std::vector<unsigned char>(24, 0x76);
+    }
+    return MakeTransactionRef(std::move(tx));
+}
+
+void ReindexTests()
+{
+    std::mt19937 rng(7);
+
+    // --- Sorted write-back: each batch a separate key range, fresh coins spent in cache never written ---
+    MemoryCoinsView db;
+    {
+        CReindexCoinsCache cache(db, 100);
+        std::map<COutPoint, CAmount> mapExpected;
+        for (uint32_t i = 0; i < 2000; i++) {
+            COutPoint outpoint(ArithToUint256(arith_uint256(rng())), i % 3);
+            cache.AddCoin(outpoint, Coin(CTxOut(i + 1, CScript()), 1, false, false, 0), false);
+            mapExpected[outpoint] = i + 1;
+        }
+        // Half of them are spent before they ever reach the database
+        size_t nSpent = 0;
+        for (auto it = mapExpected.begin(); it != mapExpected.end(); nSpent++) {
+            if (nSpent % 2) {
+                assert(cache.SpendCoin(it->first));
+                assert(!cache.SpendCoin(it->first));
+                it = mapExpected.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        const uint256 hashFlush = ArithToUint256(arith_uint256(77));
+        assert(cache.Flush(hashFlush));
+        assert(db.vBatches.size() == 10 && cache.GetCoinsWritten() == 1000);
+        for (size_t i = 1; i < db.vBatches.size(); i++) {
+            assert(db.vBatches[i - 1].back() < db.vBatches[i].front());
+            assert(db.vBestBlocks[i - 1].IsNull());
+        }
+        assert(db.vBestBlocks.back() == hashFlush && db.hashBest == hashFlush);
+        assert(db.mapCoins.size() == mapExpected.size() && cache.GetCacheSize() == 0);
+
+        // Spending a flushed coin reads it back and writes the deletion
+        COutPoint outpoint = mapExpected.begin()->first;
+        assert(cache.GetCoin(outpoint) && cache.GetCoin(outpoint)->out.nValue == mapExpected.begin()->second);
+        assert(cache.SpendCoin(outpoint));
+        assert(cache.Flush(uint256()));
+        assert(!db.mapCoins.count(outpoint) && db.mapCoins.size() == mapExpected.size() - 1);
+    }
+    std::cout << "Reindex Sorted Flush Test Passed\n";
+
+    // --- Pipeline: a chain on disk rebuilt into an empty coins view ---
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+                                  boost::filesystem::unique_path("africoin-reindex-%%%%%%%%");
+    CBlockStore store(dir);
+    assert(store.Open());
+    CBlockForest forest;
+    std::map<COutPoint, CAmount> mapUtxo;
+    std::vector<COutPoint> vUnspent;
+    BlockRef tip = NULL_BLOCK_REF;
+    uint256 hashPrev;
+    const int nBlocks = 600;
+    for (int nHeight = 0; nHeight < nBlocks; nHeight++) {
+        CBlock block;
+        block.nTime = 1500000000 + nHeight * 64;
+        block.nBits = 0x1e0fffff;
+        block.hashPrevBlock = hashPrev;
+        block.vtx.push_back(MakeTx(block.nTime, {}, {50 * COIN, 25 * COIN}));
+        for (int i = 0; i < 8 && vUnspent.size() > 4; i++) {
+            std::vector<COutPoint> vSpend;
+            CAmount nIn = 0;
+            for (int j = 0; j < 2; j++) {
+                size_t n = rng() % vUnspent.size();
+                vSpend.push_back(vUnspent[n]);
+                nIn += mapUtxo[vUnspent[n]];
+                mapUtxo.erase(vUnspent[n]);
+                vUnspent[n] = vUnspent.back();
+                vUnspent.pop_back();
+            }
+            block.vtx.push_back(MakeTx(block.nTime, vSpend, {nIn / 3, nIn - nIn / 3}));
+        }
+        for (const CTransactionRef& tx : block.vtx) {
+            for (uint32_t n = 0; n < tx->vout.size(); n++) {
+                mapUtxo[COutPoint(tx->GetHash(), n)] = tx->vout[n].nValue;
+                vUnspent.push_back(COutPoint(tx->GetHash(), n));
+            }
+        }
+        block.hashMerkleRoot = block.vtx[0]->GetHash();
+
+        CDiskBlockPos pos;
+        assert(store.WriteBlock(block, pos));
+        uint32_t nFlags = (nHeight % 3 ? (uint32_t)FOREST_PROOF_OF_STAKE : 0) |
+                          (nHeight % 50 == 0 ? (uint32_t)FOREST_STAKE_MODIFIER : 0);
+        tip = forest.Add(block.GetHash(), tip, block.nTime, block.nBits, nFlags);
+        forest.Cold(tip).nFile = pos.nFile;
+        forest.Cold(tip).nDataPos = pos.nPos;
+        forest.Cold(tip).nStakeModifier = nHeight / 50;
+        hashPrev = block.GetHash();
+    }
+
+    CReindexOptions options;
+    options.nReadThreads = 4;
+    options.nWindow = 16;
+    options.nModifierBatch = 8;
+    options.nCacheBytes = 64 * 1024;
+    options.nFlushEntries = 500;
+    options.fCheckHeaders = false;
+    size_t nReports = 0;
+    options.fnProgress = [&](const CReindexStats&) { nReports++; };
+    CBlockTreeDB blocktree(1 << 20, true);
+    options.pblocktree = &blocktree;
+    int nModifierCalls = 0;
+    options.fnModifier = [&](BlockRef ref, uint64_t& nStakeModifier, bool& fGenerated) {
+        // Called in height order, and sees the stored value
+        bool fReindexing = false;
+        blocktree.ReadReindexing(fReindexing);
+        assert(fReindexing);
+        assert(forest.Hot(ref).nHeight == nModifierCalls++);
+        assert(nStakeModifier == (uint64_t)forest.Hot(ref).nHeight / 50);
+        return true;
+    };
+
+    MemoryCoinsView chainstate;
+    CReindexStats stats;
+    assert(ReindexChainstate(store, forest, tip, chainstate, options, stats));
+    assert(nModifierCalls == nBlocks && nReports >= 1);
+    assert(stats.nHeight == nBlocks - 1 && stats.nTipHeight == nBlocks - 1);
+    assert(stats.read.nBlocks == (uint64_t)nBlocks && stats.utxo.nBlocks == (uint64_t)nBlocks);
+    assert(stats.utxo.nTx == stats.read.nTx && stats.nFlushes > 1);
+    assert(chainstate.hashBest == forest.GetBlockHash(tip));
+    bool fReindexing = true;
+    blocktree.ReadReindexing(fReindexing);
+    assert(!fReindexing);
+
+    // Each flush moves the best block once, with its last batch
+    assert(chainstate.vBatches.size() > stats.nFlushes);
+    assert((uint64_t)std::count_if(chainstate.vBestBlocks.begin(), chainstate.vBestBlocks.end(),
+                                   [](const uint256& hash) { return !hash.IsNull(); }) == stats.nFlushes);
+    assert(chainstate.mapCoins.size() == mapUtxo.size());
+    for (const auto& entry : mapUtxo)
+        assert(chainstate.mapCoins.count(entry.first) && chainstate.mapCoins[entry.first].out.nValue == entry.second);
+
+    // Checksums chain from the parent's, as a serial pass computes them
+    uint32_t nChecksum = 0;
+    for (BlockRef ref = 0; ref < forest.Size(); ref++) {
+        nChecksum = forest.Cold(ref).nStakeModifierChecksum;
+        assert(nChecksum == GetForestModifierChecksum(forest, ref));
+    }
+    assert(nChecksum != 0);
+    std::cout << "Reindex Pipeline Test Passed\n";
+
+    // --- Headers arriving during a run (as for snapshot validation) ---
+    {
+        std::atomic<bool> fDone(false);
+        std::atomic<size_t> nAdded(0);
+        std::thread threadHeaders([&] {
+            BlockRef branch = 0;
+            while (!fDone && nAdded < 200000) {
+                LOCK(cs_main);
+                branch = forest.Add(ArithToUint256(arith_uint256(1000000 + nAdded)), branch, 1500000000 + nAdded,
+                                    0x1e0fffff, 0);
+                nAdded++;
+            }
+        });
+        while (nAdded == 0)
+            std::this_thread::yield();
+        options.fnModifier = nullptr;
+        MemoryCoinsView grown;
+        const bool fOk = ReindexChainstate(store, forest, tip, grown, options, stats);
+        fDone = true;
+        threadHeaders.join();
+        assert(fOk && nAdded > 0 && forest.Size() == (size_t)nBlocks + nAdded);
+        assert(grown.hashBest == forest.GetBlockHash(tip) && grown.mapCoins.size() == mapUtxo.size());
+    }
+    std::cout << "Reindex Concurrent Headers Test Passed\n";
+
+    // --- An interrupt stops the run after the batch in progress ---
+    std::atomic<bool> fInterrupt(true);
+    options.pfInterrupt = &fInterrupt;
+    MemoryCoinsView interrupted;
+    assert(!ReindexChainstate(store, forest, tip, interrupted, options, stats));
+    assert(stats.nHeight < stats.nTipHeight);
+    blocktree.ReadReindexing(fReindexing);
+    assert(fReindexing);
+    options.pfInterrupt = nullptr;
+    std::cout << "Reindex Interrupt Test Passed\n";
+
+    // --- A block that does not match the index stops the run ---
+    forest.Cold(forest.GetAncestor(tip, 300)).nDataPos = forest.Cold(forest.GetAncestor(tip, 299)).nDataPos;
+    MemoryCoinsView partial;
+    assert(blocktree.WriteReindexing(false));
+    assert(!ReindexChainstate(store, forest, tip, partial, options, stats));
+    assert(stats.nHeight < 300);
+    blocktree.ReadReindexing(fReindexing);
+    assert(fReindexing);
+    std::cout << "Reindex Abort Test Passed\n";
+
+    boost::filesystem::remove_all(dir);
+}
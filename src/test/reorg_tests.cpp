@@ -0,0 +1,429 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+#include "../consensus/blockforest.h"
+#include "../consensus/fee_burner.h"
+#include "../consensus/reorg.h"
+#include "arith_uint256.h"
+#include "coins.h"
+#include "primitives/block.h"
+#include "undo.h"
+#include "validation.h"
+
+using namespace Africoin;
+
+/** In-memory chainstate that counts its writes */
+class ReorgCoinsView : public CCoinsView {
+public:
+    std::map<COutPoint, Coin> mapCoins;
+    uint256 hashBest;
+    unsigned int nWrites = 0;
+    bool fFailWrites = false;
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override
+    {
+        auto it = mapCoins.find(outpoint);
+        if (it == mapCoins.end())
+            return false;
+        coin = it->second;
+        return true;
+    }
+
+    uint256 GetBestBlock() const override { return hashBest; }
+
+    bool BatchWrite(CCoinsMap& mapBatch, const uint256& hashBlock) override
+    {
+        if (fFailWrites)
+            return false;
+        for (auto& entry : mapBatch) {
+            if (!(entry.second.flags & CCoinsCacheEntry::DIRTY))
+                continue;
+            if (entry.second.coin.IsSpent())
+                mapCoins.erase(entry.first);
+            else
+                mapCoins[entry.first] = entry.second.coin;
+        }
+        mapBatch.clear();
+        hashBest = hashBlock;
+        nWrites++;
+        return true;
+    }
+};
+
+static bool SameCoins(const ReorgCoinsView& a, const ReorgCoinsView& b)
+{
+    if (a.mapCoins.size() != b.mapCoins.size())
+        return false;
+    for (const auto& entry : a.mapCoins) {
+        auto it = b.mapCoins.find(entry.first);
+        if (it == b.mapCoins.end() || it->second.out != entry.second.out || it->second.nHeight != entry.second.nHeight)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Blocks on several branches of a forest: each block has a coinbase and
+ * one transaction spending the previous block's, so every reorg has to
+ * restore spent coins as well as remove created ones.
+ */
+class ReorgTestChain {
+public:
+    CBlockForest forest;
+    std::map<BlockRef, CBlock> mapBlocks;
+    std::map<BlockRef, CBlockUndo> mapUndo;
+    std::map<BlockRef, CFeeBurnUndo> mapBurnUndo;
+    std::set<BlockRef> setBad;
+    FeeBurnLedger ledger;
+    CChainSlices slices;
+    CChainSlices::RailwayNodeMap mapNodes;
+    BlockRef genesis;
+
+    explicit ReorgTestChain(size_t nSliceDepth = DEFAULT_REORG_SLICE_DEPTH) : slices(nSliceDepth)
+    {
+        for (const char* code : {"TZR", "SAR", "KRC"}) {
+            mapNodes[code].code = code;
+            mapNodes[code].isActive = true;
+        }
+        genesis = forest.Add(ArithToUint256(arith_uint256(1)), NULL_BLOCK_REF, 1500000000, HYBRID_TARGET_LIMIT_BITS, 0);
+        CFeeBurnUndo burnundo;
+        ledger.ConnectBlock(0, 0, HybridStaking::CalculateBlockReward(0, BLOCK_TYPE_POW), BLOCK_TYPE_POW, burnundo);
+        slices.Reset(0);
+    }
+
+    /** Extend prev with n blocks of a branch; returns the last one */
+    BlockRef Extend(BlockRef prev, int n, uint32_t nBranch)
+    {
+        for (int i = 0; i < n; i++) {
+            const CBlockForestHot& hotPrev = forest.Hot(prev);
+            int nHeight = hotPrev.nHeight + 1;
+            uint32_t nTime = hotPrev.nTime + 64;
+            uint256 hash = ArithToUint256(arith_uint256((uint64_t)nBranch << 32 | nHeight));
+
+            CBlock block;
+            block.nTime = nTime;
+            block.vtx.push_back(MakeTx(nTime, nBranch, {}));
+            auto itPrev = mapBlocks.find(prev);
+            if (itPrev != mapBlocks.end())
+                block.vtx.push_back(MakeTx(nTime, nBranch, {COutPoint(itPrev->second.vtx.back()->GetHash(), 0)}));
+            BlockRef ref = forest.Add(hash, prev, nTime, HYBRID_TARGET_LIMIT_BITS, FOREST_PROOF_OF_STAKE);
+            forest.Cold(ref).nStatus |= BLOCK_HAVE_DATA;
+            forest.AddCandidate(ref);
+            mapBlocks[ref] = block;
+            prev = ref;
+        }
+        return prev;
+    }
+
+    static CTransactionRef MakeTx(uint32_t nTime, uint32_t nBranch, const std::vector<COutPoint>& vPrevouts)
+    {
+        CMutableTransaction tx;
+        tx.nTime = nTime;
+        tx.vin.resize(vPrevouts.empty() ? 1 : vPrevouts.size());
+        for (size_t i = 0; i < vPrevouts.size(); i++)
+            tx.vin[i].prevout = vPrevouts[i];
+        if (vPrevouts.empty())
+            tx.vin[0].scriptSig = CScript() << (int64_t)nTime << (int64_t)nBranch;
+        tx.vout.resize(1);
+        tx.vout[0].nValue = 1000 + nBranch;
+        tx.vout[0].scriptPubKey = CScript() << std::vector<unsigned char>(24, 0x76);
+        return MakeTransactionRef(std::move(tx));
+    }
+
+    CReorgOptions Options()
+    {
+        CReorgOptions options;
+        options.fnReadUndo = [this](BlockRef ref, CBlock& block, CBlockUndo& blockundo, CFeeBurnUndo& burnundo) {
+            if (!mapUndo.count(ref))
+                return false;
+            block = mapBlocks.at(ref);
+            blockundo = mapUndo.at(ref);
+            burnundo = mapBurnUndo.at(ref);
+            return true;
+        };
+        options.fnReadBlock = [this](BlockRef ref, CBlock& block) {
+            block = mapBlocks.at(ref);
+            return true;
+        };
+        options.fnConnect = [this](BlockRef ref, const CBlock& block, CCoinsViewCache& view, CValidationState& state) {
+            const CBlockForestHot& hot = forest.Hot(ref);
+            // Every third height is a railway stake, recorded before the block is known to be valid
+            if (hot.nHeight % 3 == 0)
+                slices.RecordRailwayStake(mapNodes[hot.nHeight % 2 ? "TZR" : "SAR"], hot.nTime);
+            if (setBad.count(ref))
+                return state.DoS(100, false, REJECT_INVALID, "bad-test-block");
+            CBlockUndo blockundo;
+            for (const CTransactionRef& tx : block.vtx) {
+                if (!tx->IsCoinBase()) {
+                    blockundo.vtxundo.emplace_back();
+                    for (const CTxIn& txin : tx->vin) {
+                        Coin coin;
+                        if (!view.SpendCoin(txin.prevout, &coin))
+                            return state.DoS(100, false, REJECT_INVALID, "bad-txns-inputs-missingorspent");
+                        blockundo.vtxundo.back().vprevout.push_back(coin);
+                    }
+                }
+                for (size_t i = 0; i < tx->vout.size(); i++)
+                    view.AddCoin(COutPoint(tx->GetHash(), i), Coin(tx->vout[i], hot.nHeight, tx->IsCoinBase(), false, tx->nTime), false);
+            }
+            mapUndo[ref] = blockundo;
+            CAmount nValueCreated = HybridStaking::CalculateBlockReward(hot.nHeight, BLOCK_TYPE_POS);
+            return ledger.ConnectBlock(hot.nHeight, 0, nValueCreated, BLOCK_TYPE_POS, mapBurnUndo[ref]) ||
+                   state.Error("ledger");
+        };
+        options.pFeeBurnLedger = &ledger;
+        options.pSlices = &slices;
+        options.pRailwayNodes = &mapNodes;
+        return options;
+    }
+
+    bool Reorganize(BlockRef& tip, BlockRef newTip, CCoinsView& base, CValidationState& state, CReorgStats& stats)
+    {
+        return ReorganizeChain(forest, tip, newTip, base, Options(), state, stats);
+    }
+
+    /** Chainstate and railway nodes of a node that only ever followed genesis..tip */
+    void Replay(BlockRef tip, ReorgCoinsView& base, CChainSlices::RailwayNodeMap& mapExpected)
+    {
+        ReorgTestChain fresh;
+        std::vector<BlockRef> vPath;
+        for (BlockRef ref = tip; ref != genesis; ref = forest.GetPrev(ref))
+            vPath.push_back(ref);
+        BlockRef prev = fresh.genesis;
+        for (auto it = vPath.rbegin(); it != vPath.rend(); ++it) {
+            const CBlockForestHot& hot = forest.Hot(*it);
+            BlockRef ref = fresh.forest.Add(forest.GetBlockHash(*it), prev, hot.nTime, hot.nBits, hot.nFlags);
+            fresh.mapBlocks[ref] = mapBlocks.at(*it);
+            prev = ref;
+        }
+        CValidationState state;
+        CReorgStats stats;
+        BlockRef freshTip = fresh.genesis;
+        assert(fresh.Reorganize(freshTip, prev, base, state, stats));
+        mapExpected = fresh.mapNodes;
+    }
+};
+
+static bool SameNodes(const CChainSlices::RailwayNodeMap& a, const CChainSlices::RailwayNodeMap& b)
+{
+    for (const auto& entry : a) {
+        const RailwayStakingNode& other = b.at(entry.first);
+        if (entry.second.lastStakeTime != other.lastStakeTime || entry.second.totalStakes != other.totalStakes)
+            return false;
+    }
+    return true;
+}
+
+void ReorgTests()
+{
+    // --- Slices: a window of heights, railway stakes restored newest first ---
+    {
+        CChainSlices slices(4);
+        CChainSlices::RailwayNodeMap mapNodes;
+        mapNodes["TZR"].code = "TZR";
+        slices.Reset(9);
+        for (int h = 10; h < 16; h++) {
+            slices.RecordRailwayStake(mapNodes["TZR"], 1000 * h);
+            slices.Connect(h, h * 7, h * 11);
+        }
+        assert(slices.GetHeight() == 15 && mapNodes["TZR"].totalStakes == 6 && mapNodes["TZR"].lastStakeTime == 15000);
+        assert(!slices.Get(11) && slices.Get(12) && slices.Get(12)->nStakeModifier == 84 && slices.Get(15)->ref == 15);
+        assert(slices.CanRewind(11) && !slices.CanRewind(10) && !slices.CanRewind(16));
+
+        slices.RecordRailwayStake(mapNodes["TZR"], 16000);
+        slices.DiscardPending(mapNodes);
+        assert(mapNodes["TZR"].totalStakes == 6 && mapNodes["TZR"].lastStakeTime == 15000);
+
+        assert(slices.Rewind(13, mapNodes));
+        assert(slices.GetHeight() == 13 && mapNodes["TZR"].totalStakes == 4 && mapNodes["TZR"].lastStakeTime == 13000);
+        assert(!slices.Rewind(10, mapNodes) && slices.GetHeight() == 13);
+        assert(slices.Rewind(11, mapNodes) && slices.GetHeight() == 11 && mapNodes["TZR"].totalStakes == 2);
+
+        // Rollback puts back what Rewind popped and Connect dropped, but not what was connected
+        for (int h = 12; h < 16; h++) {
+            slices.RecordRailwayStake(mapNodes["TZR"], 1000 * h);
+            slices.Connect(h, h * 7, h * 11);
+        }
+        slices.Begin(mapNodes);
+        assert(slices.Rewind(13, mapNodes));
+        for (int h = 14; h < 20; h++) {
+            slices.RecordRailwayStake(mapNodes["TZR"], 2000 * h);
+            slices.Connect(h, h * 13, h * 17);
+        }
+        assert(slices.GetHeight() == 19 && !slices.Get(15) && mapNodes["TZR"].totalStakes == 10);
+        slices.Rollback(mapNodes);
+        assert(slices.GetHeight() == 15 && slices.CanRewind(11) && !slices.CanRewind(10));
+        for (int h = 12; h <= 15; h++)
+            assert(slices.Get(h)->ref == (BlockRef)h && slices.Get(h)->nStakeModifier == h * 7ULL);
+        assert(mapNodes["TZR"].totalStakes == 6 && mapNodes["TZR"].lastStakeTime == 15000);
+        assert(slices.Rewind(11, mapNodes) && mapNodes["TZR"].totalStakes == 2);
+    }
+    std::cout << "Reorg Slices Test Passed\n";
+
+    // --- Disconnecting a block's coins restores the view it was connected to ---
+    {
+        ReorgTestChain chain;
+        BlockRef tip = chain.genesis;
+        BlockRef a3 = chain.Extend(tip, 3, 1);
+        ReorgCoinsView base;
+        CValidationState state;
+        CReorgStats stats;
+        assert(chain.Reorganize(tip, a3, base, state, stats) && tip == a3);
+
+        CCoinsViewCache view(&base);
+        const CBlock& block = chain.mapBlocks.at(a3);
+        bool fClean;
+        assert(DisconnectBlockCoins(block, 3, chain.mapUndo.at(a3), view, fClean) && fClean);
+        view.Flush();
+        ReorgCoinsView expected;
+        CChainSlices::RailwayNodeMap mapExpected;
+        chain.Replay(chain.forest.GetPrev(a3), expected, mapExpected);
+        assert(SameCoins(base, expected));
+
+        // Undo data of another block does not fit
+        CCoinsViewCache view2(&base);
+        CBlockUndo badundo;
+        assert(!DisconnectBlockCoins(chain.mapBlocks.at(a3), 3, badundo, view2, fClean));
+        // The outputs are gone already: unclean
+        badundo = chain.mapUndo.at(a3);
+        badundo.vtxundo[0].vprevout[0] = Coin(CTxOut(5, CScript()), 1, false, false, 0);
+        assert(DisconnectBlockCoins(chain.mapBlocks.at(a3), 3, badundo, view2, fClean) && !fClean);
+    }
+    std::cout << "Reorg Disconnect Test Passed\n";
+
+    // --- Switching branches: one write, the same state as a node that only saw the new branch ---
+    {
+        ReorgTestChain chain;
+        BlockRef a10 = chain.Extend(chain.genesis, 10, 1);
+        BlockRef a5 = chain.forest.GetAncestor(a10, 5);
+        BlockRef b13 = chain.Extend(a5, 8, 2);
+        assert(chain.forest.GetBestCandidate() == b13);
+
+        ReorgCoinsView base;
+        CValidationState state;
+        CReorgStats stats;
+        BlockRef tip = chain.genesis;
+        assert(chain.Reorganize(tip, a10, base, state, stats) && tip == a10 && stats.nConnected == 10);
+        ReorgCoinsView baseA = base;
+        CChainSlices::RailwayNodeMap mapA = chain.mapNodes;
+
+        unsigned int nWrites = base.nWrites;
+        stats = CReorgStats();
+        assert(chain.Reorganize(tip, b13, base, state, stats) && tip == b13);
+        assert(stats.nForkHeight == 5 && stats.nDisconnected == 5 && stats.nConnected == 8);
+        assert(base.nWrites == nWrites + 1 && base.hashBest == chain.forest.GetBlockHash(b13));
+        assert(chain.ledger.GetHeight() == 13 && chain.slices.GetHeight() == 13 && chain.slices.Get(13)->ref == b13);
+        assert(chain.slices.Get(5)->ref == a5);
+        assert(chain.forest.IsCandidate(b13) && !chain.forest.IsCandidate(a10));
+
+        ReorgCoinsView expected;
+        CChainSlices::RailwayNodeMap mapExpected;
+        chain.Replay(b13, expected, mapExpected);
+        assert(SameCoins(base, expected) && SameNodes(chain.mapNodes, mapExpected));
+
+        // And back: the old branch's undo data was kept, its state comes back exactly
+        assert(chain.Reorganize(tip, a10, base, state, stats) && tip == a10);
+        assert(SameCoins(base, baseA) && SameNodes(chain.mapNodes, mapA) && chain.ledger.GetHeight() == 10);
+    }
+    std::cout << "Reorg Switch Test Passed\n";
+
+    // --- An invalid block stops the reorg at its parent and leaves the candidates ---
+    {
+        ReorgTestChain chain;
+        BlockRef a10 = chain.Extend(chain.genesis, 10, 1);
+        BlockRef c14 = chain.Extend(chain.forest.GetAncestor(a10, 7), 7, 3);
+        BlockRef c9 = chain.forest.GetAncestor(c14, 9);
+        chain.setBad.insert(c9);
+
+        ReorgCoinsView base;
+        CValidationState state;
+        CReorgStats stats;
+        BlockRef tip = chain.genesis;
+        assert(chain.Reorganize(tip, a10, base, state, stats));
+        assert(!chain.Reorganize(tip, c14, base, state, stats) && state.IsInvalid());
+        assert(tip == chain.forest.GetPrev(c9) && state.GetRejectReason() == "bad-test-block");
+        assert(chain.forest.Cold(c9).nStatus & BLOCK_FAILED_VALID && chain.forest.Cold(c14).nStatus & BLOCK_FAILED_CHILD);
+        assert(chain.forest.GetBestCandidate() == a10);
+
+        ReorgCoinsView expected;
+        CChainSlices::RailwayNodeMap mapExpected;
+        chain.Replay(tip, expected, mapExpected);
+        assert(SameCoins(base, expected) && SameNodes(chain.mapNodes, mapExpected));
+        assert(chain.slices.GetHeight() == 8 && chain.ledger.GetHeight() == 8);
+
+        // The next activation goes back to the best candidate
+        CValidationState state2;
+        assert(chain.Reorganize(tip, chain.forest.GetBestCandidate(), base, state2, stats) && tip == a10);
+    }
+    std::cout << "Reorg Invalid Test Passed\n";
+
+    // --- Deeper than the retained slices, or without undo data: refused before any write ---
+    {
+        ReorgTestChain chain(4);
+        BlockRef a10 = chain.Extend(chain.genesis, 10, 1);
+        BlockRef b12 = chain.Extend(chain.forest.GetAncestor(a10, 5), 7, 2);
+        BlockRef c11 = chain.Extend(chain.forest.GetAncestor(a10, 8), 3, 3);
+
+        ReorgCoinsView base;
+        CValidationState state;
+        CReorgStats stats;
+        BlockRef tip = chain.genesis;
+        assert(chain.Reorganize(tip, a10, base, state, stats));
+        ReorgCoinsView baseA = base;
+        assert(!chain.Reorganize(tip, b12, base, state, stats) && tip == a10);
+        assert(base.nWrites == baseA.nWrites && chain.slices.GetHeight() == 10 && chain.ledger.GetHeight() == 10);
+
+        // A burn record that does not match the ledger: no block is removed from it
+        CFeeBurnUndo burnundo = chain.mapBurnUndo.at(chain.forest.GetAncestor(a10, 9));
+        chain.mapBurnUndo[chain.forest.GetAncestor(a10, 9)].nMinted++;
+        assert(!chain.Reorganize(tip, c11, base, state, stats) && tip == a10);
+        assert(chain.ledger.GetHeight() == 10 && chain.slices.GetHeight() == 10);
+        chain.mapBurnUndo[chain.forest.GetAncestor(a10, 9)] = burnundo;
+
+        chain.mapUndo.erase(a10);
+        assert(!chain.Reorganize(tip, c11, base, state, stats) && tip == a10);
+        assert(base.nWrites == baseA.nWrites && SameCoins(base, baseA) && chain.slices.GetHeight() == 10);
+    }
+    std::cout << "Reorg Refused Test Passed\n";
+
+    // --- A failed chainstate write leaves the ledger, slices and railway nodes at the old tip ---
+    {
+        ReorgTestChain chain(7);
+        BlockRef a10 = chain.Extend(chain.genesis, 10, 1);
+        BlockRef b13 = chain.Extend(chain.forest.GetAncestor(a10, 6), 7, 2);
+
+        ReorgCoinsView base;
+        CValidationState state;
+        CReorgStats stats;
+        BlockRef tip = chain.genesis;
+        assert(chain.Reorganize(tip, a10, base, state, stats));
+        ReorgCoinsView baseA = base;
+        CChainSlices::RailwayNodeMap mapA = chain.mapNodes;
+        CAmount nMintedA = chain.ledger.GetMinted(0, 10);
+
+        base.fFailWrites = true;
+        assert(!chain.Reorganize(tip, b13, base, state, stats) && tip == a10);
+        assert(SameCoins(base, baseA) && SameNodes(chain.mapNodes, mapA));
+        assert(chain.ledger.GetHeight() == 10 && chain.ledger.GetMinted(0, 10) == nMintedA);
+        assert(chain.slices.GetHeight() == 10 && chain.slices.Get(10)->ref == a10 && chain.slices.Get(4));
+
+        // Nothing was lost: the same reorg goes through once writes work again
+        base.fFailWrites = false;
+        CValidationState state2;
+        assert(chain.Reorganize(tip, b13, base, state2, stats) && tip == b13);
+        ReorgCoinsView expected;
+        CChainSlices::RailwayNodeMap mapExpected;
+        chain.Replay(b13, expected, mapExpected);
+        assert(SameCoins(base, expected) && SameNodes(chain.mapNodes, mapExpected));
+        assert(chain.ledger.GetHeight() == 13 && chain.slices.Get(13)->ref == b13);
+        assert(chain.Reorganize(tip, a10, base, state2, stats) && tip == a10);
+        assert(SameCoins(base, baseA) && SameNodes(chain.mapNodes, mapA) && chain.ledger.GetMinted(0, 10) == nMintedA);
+    }
+    std::cout << "Reorg Failed Write Test Passed\n";
+}
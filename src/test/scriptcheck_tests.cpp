@@ -0,0 +1,216 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../consensus/lockfree_queue.h"
+#include "../consensus/scriptcheck.h"
+#include "../consensus/sigcache.h"
+#include "arith_uint256.h"
+#include "coins.h"
+#include "key.h"
+#include "script/script.h"
+#include "validation.h"
+
+using namespace Africoin;
+
+static uint256 Entry(uint64_t n)
+{
+    return ArithToUint256(arith_uint256(n) * arith_uint256(0x9e3779b97f4a7c15ULL));
+}
+
+/** One input per script, each spending a fresh output locked by that script */
+static CTransaction MakeSpend(const std::vector<CScript>& vScripts, CCoinsViewCache& view)
+{
+    static uint64_t nNextPrevout = 1000;
+    CMutableTransaction tx;
+    for (size_t i = 0; i < vScripts.size(); i++) {
+        COutPoint prevout(Entry(nNextPrevout++), 0);
+        view.AddCoin(prevout, Coin(CTxOut(1000, vScripts[i]), 1, false, false, 1500000000), false);
+        tx.vin.emplace_back(prevout);
+    }
+    tx.vout.emplace_back(1000, CScript() << OP_TRUE);
+    return CTransaction(tx);
+}
+
+static std::vector<CScriptCheck> MakeChecks(const CTransaction& tx, const CCoinsViewCache& view,
+                                            const PrecomputedTransactionData& txdata)
+{
+    std::vector<CScriptCheck> vChecks;
+    for (unsigned int i = 0; i < tx.vin.size(); i++)
+        vChecks.emplace_back(view.AccessCoin(tx.vin[i].prevout).out, tx, i, SCRIPT_VERIFY_NONE, false, &txdata);
+    return vChecks;
+}
+
+void ScriptCheckTests()
+{
+    // --- Lock-free queue: capacity, FIFO order, full and empty ---
+    CLockFreeQueue<int> queue(5);
+    assert(queue.Capacity() == 8);
+    int nValue;
+    assert(!queue.Pop(nValue));
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 8; i++)
+            assert(queue.Push(round * 8 + i));
+        assert(!queue.Push(-1));
+        assert(queue.SizeApprox() == 8);
+        for (int i = 0; i < 8; i++)
+            assert(queue.Pop(nValue) && nValue == round * 8 + i);
+        assert(!queue.Pop(nValue));
+    }
+    std::cout << "Lock-Free Queue Order Test Passed\n";
+
+    // --- Lock-free queue: every item is popped exactly once under contention ---
+    {
+        const int nThreads = 4, nPerThread = 10000;
+        CLockFreeQueue<int> shared(64);
+        std::vector<std::atomic<int>> vSeen(nThreads * nPerThread);
+        std::atomic<int> nPopped{0};
+        std::vector<std::thread> vThreads;
+        for (int t = 0; t < nThreads; t++) {
+            vThreads.emplace_back([&, t] {
+                for (int i = 0; i < nPerThread; i++) {
+                    while (!shared.Push(t * nPerThread + i))
+                        std::this_thread::yield();
+                }
+            });
+            vThreads.emplace_back([&] {
+                int n;
+                while (nPopped.load() < nThreads * nPerThread) {
+                    if (shared.Pop(n)) {
+                        vSeen[n].fetch_add(1);
+                        nPopped.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : vThreads)
+            thread.join();
+        for (const std::atomic<int>& nSeen : vSeen)
+            assert(nSeen.load() == 1);
+    }
+    std::cout << "Lock-Free Queue Concurrency Test Passed\n";
+
+    // --- Salted cache: per-instance salt, erase on hit, eviction bound ---
+    CSaltedHashCache cacheA(64), cacheB(64);
+    uint256 hashA, hashB, hashA2;
+    CSHA256(cacheA.GetSaltedHasher()).Write(Entry(1).begin(), 32).Finalize(hashA.begin());
+    CSHA256(cacheB.GetSaltedHasher()).Write(Entry(1).begin(), 32).Finalize(hashB.begin());
+    CSHA256(cacheA.GetSaltedHasher()).Write(Entry(1).begin(), 32).Finalize(hashA2.begin());
+    assert(hashA == hashA2 && hashA != hashB);
+
+    cacheA.Insert(Entry(1));
+    assert(cacheA.Contains(Entry(1), false) && cacheA.Contains(Entry(1), false));
+    assert(cacheA.Contains(Entry(1), true));
+    assert(!cacheA.Contains(Entry(1), false));
+
+    for (uint64_t n = 0; n < 1000; n++) {
+        cacheA.Insert(Entry(n));
+        assert(cacheA.Contains(Entry(n), false));
+    }
+    assert(cacheA.Size() > 0 && cacheA.Size() <= 64);
+    cacheA.SetMaxEntries(0);
+    cacheA.Insert(Entry(5000));
+    assert(!cacheA.Contains(Entry(5000), false));
+
+    CSaltedHashCache cacheDefault;
+    for (uint64_t n = 0; n < 1000; n++)
+        cacheDefault.Insert(Entry(n));
+    assert(cacheDefault.Size() == 1000);
+    std::cout << "Salted Hash Cache Test Passed\n";
+
+    ECC_Start();
+    {
+        ECCVerifyHandle verifyHandle;
+
+        // --- Signature cache: a hit skips verification, block connect erases it ---
+        CKey key;
+        key.MakeNewKey(true);
+        CPubKey pubkey = key.GetPubKey();
+        uint256 sighash = Entry(42);
+        std::vector<unsigned char> vchSig;
+        assert(key.Sign(sighash, vchSig));
+        std::vector<unsigned char> vchBadSig = vchSig;
+        vchBadSig[vchBadSig.size() / 2] ^= 1;
+
+        CCoinsView viewDummy;
+        CCoinsViewCache view(&viewDummy);
+        CTransaction txSig = MakeSpend({CScript() << OP_TRUE}, view);
+        PrecomputedTransactionData txdataSig(txSig);
+        CachingTransactionSignatureChecker mempoolChecker(&txSig, 0, 1000, true, txdataSig);
+        CachingTransactionSignatureChecker blockChecker(&txSig, 0, 1000, false, txdataSig);
+
+        size_t nSize = g_signatureCache.Size();
+        assert(mempoolChecker.VerifySignature(vchSig, pubkey, sighash));
+        assert(g_signatureCache.Size() == nSize + 1);
+        assert(!mempoolChecker.VerifySignature(vchBadSig, pubkey, sighash));
+        assert(g_signatureCache.Size() == nSize + 1);
+
+        // A forged entry is trusted, which shows the cache hit never reaches ECDSA
+        g_signatureCache.Insert(GetSignatureCacheEntry(sighash, vchBadSig, pubkey));
+        assert(mempoolChecker.VerifySignature(vchBadSig, pubkey, sighash));
+        assert(blockChecker.VerifySignature(vchBadSig, pubkey, sighash));
+        assert(!blockChecker.VerifySignature(vchBadSig, pubkey, sighash));
+
+        assert(blockChecker.VerifySignature(vchSig, pubkey, sighash));
+        assert(!g_signatureCache.Contains(GetSignatureCacheEntry(sighash, vchSig, pubkey), false));
+        assert(blockChecker.VerifySignature(vchSig, pubkey, sighash));
+        std::cout << "Signature Cache Test Passed\n";
+
+        // --- Script execution cache: a cached transaction produces no checks ---
+        CTransaction txFalse = MakeSpend({CScript() << OP_FALSE}, view);
+        PrecomputedTransactionData txdataFalse(txFalse);
+        CValidationState state;
+        assert(!CheckInputScripts(txFalse, state, view, SCRIPT_VERIFY_NONE, false, txdataFalse, nullptr));
+        g_scriptExecutionCache.Insert(GetScriptExecutionCacheEntry(txFalse.GetWitnessHash(), SCRIPT_VERIFY_NONE));
+        CValidationState stateCached;
+        assert(CheckInputScripts(txFalse, stateCached, view, SCRIPT_VERIFY_NONE, true, txdataFalse, nullptr));
+        assert(CheckInputScripts(txFalse, stateCached, view, SCRIPT_VERIFY_NONE, false, txdataFalse, nullptr));
+        assert(!CheckInputScripts(txFalse, stateCached, view, SCRIPT_VERIFY_NONE, false, txdataFalse, nullptr));
+        assert(!CheckInputScripts(txFalse, stateCached, view, SCRIPT_VERIFY_P2SH, true, txdataFalse, nullptr));
+
+        CTransaction txTrue = MakeSpend({CScript() << OP_TRUE, CScript() << OP_TRUE}, view);
+        PrecomputedTransactionData txdataTrue(txTrue);
+        uint256 entryTrue = GetScriptExecutionCacheEntry(txTrue.GetWitnessHash(), SCRIPT_VERIFY_NONE);
+        assert(CheckInputScripts(txTrue, stateCached, view, SCRIPT_VERIFY_NONE, true, txdataTrue, nullptr));
+        assert(g_scriptExecutionCache.Contains(entryTrue, false));
+        std::cout << "Script Execution Cache Test Passed\n";
+
+        // --- Verify batches: inline and pooled, one failing check fails the batch ---
+        std::vector<CScript> vScripts(200, CScript() << OP_TRUE);
+        CTransaction txGood = MakeSpend(vScripts, view);
+        vScripts[137] = CScript() << OP_FALSE;
+        CTransaction txBad = MakeSpend(vScripts, view);
+        PrecomputedTransactionData txdataGood(txGood), txdataBad(txBad);
+
+        CVerifyPool pool(16);
+        pool.Start(3);
+        for (CVerifyPool* ppool : {(CVerifyPool*)nullptr, &pool}) {
+            CVerifyBatch batchGood(ppool);
+            std::vector<CScriptCheck> vChecks = MakeChecks(txGood, view, txdataGood);
+            batchGood.Add(vChecks);
+            assert(vChecks.empty());
+            assert(batchGood.Wait() && batchGood.IsOk());
+
+            CVerifyBatch batchBad(ppool);
+            vChecks = MakeChecks(txGood, view, txdataGood);
+            batchBad.Add(vChecks);
+            vChecks = MakeChecks(txBad, view, txdataBad);
+            batchBad.Add(vChecks);
+            assert(!batchBad.Wait() && !batchBad.IsOk());
+
+            // Through CheckInputScripts: the result is only known after Wait
+            CVerifyBatch batchInputs(ppool);
+            CValidationState stateBatch;
+            assert(CheckInputScripts(txBad, stateBatch, view, SCRIPT_VERIFY_NONE, false, txdataBad, &batchInputs));
+            assert(!batchInputs.Wait());
+        }
+        pool.Stop();
+        std::cout << "Verify Batch Test Passed\n";
+    }
+    ECC_Stop();
+}
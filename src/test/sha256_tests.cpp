@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../crypto/sha256_dispatch.h"
+#include "../security/kernel.h"
+#include "../staking/minter.h"
+#include "consensus/merkle.h"
+#include "hash.h"
+
+using namespace Africoin;
+using PeerCoin::Kernel;
+
+/** SHA256(SHA256(x)) through CSHA256, which the dispatched code must match */
+static void ReferenceSHA256d(unsigned char* out, const unsigned char* data, size_t len)
+{
+    unsigned char inner[CSHA256::OUTPUT_SIZE];
+    CSHA256().Write(data, len).Finalize(inner);
+    CSHA256().Write(inner, sizeof(inner)).Finalize(out);
+}
+
+void Sha256Tests()
+{
+    std::cout << "SHA-256 backend: " << SHA256AutoDetect() << "\n";
+    const SHA256Backend chosen = SHA256GetBackend();
+    assert(SHA256BackendAvailable(chosen) && SHA256BackendAvailable(SHA256_PORTABLE));
+
+    std::mt19937 rng(1);
+    std::vector<unsigned char> vData(300 * 20);
+    for (unsigned char& ch : vData)
+        ch = (unsigned char)rng();
+
+    for (int b = 0; b < SHA256_BACKEND_COUNT; b++) {
+        const SHA256Backend backend = (SHA256Backend)b;
+        if (!SHA256SetBackend(backend)) {
+            assert(!SHA256BackendAvailable(backend));
+            continue;
+        }
+        assert(SHA256GetBackend() == backend);
+        assert(SHA256SelfTest());
+
+        // --- Known answers ---
+        static const unsigned char hashAbc[32] = {
+            0x4f, 0x8b, 0x42, 0xc2, 0x2d, 0xd3, 0x72, 0x9b, 0x51, 0x9b, 0xa6, 0xf6, 0x8d, 0x2d, 0xa7, 0xcc,
+            0x5b, 0x2d, 0x60, 0x6d, 0x05, 0xda, 0xed, 0x5a, 0xd5, 0x12, 0x8c, 0xc0, 0x3e, 0x6c, 0x63, 0x58};
+        assert(memcmp(SHA256d((const unsigned char*)"abc", 3).begin(), hashAbc, 32) == 0);
+
+        // --- Every length across the block boundaries, single and many, against CSHA256 ---
+        unsigned char expected[32], out[32 * 20];
+        for (size_t len = 0; len <= 300; len++) {
+            unsigned char single[32];
+            CSHA256().Write(vData.data(), len).Finalize(expected);
+            SHA256Single(single, vData.data(), len);
+            assert(memcmp(single, expected, 32) == 0);
+
+            const size_t n = 1 + len % 20;
+            SHA256dMany(out, vData.data(), len, n);
+            for (size_t i = 0; i < n; i++) {
+                ReferenceSHA256d(expected, vData.data() + i * len, len);
+                assert(memcmp(out + i * 32, expected, 32) == 0);
+            }
+        }
+
+        // --- Kernel and batch hashes are the CHashWriter serialization ---
+        for (int i = 0; i < 100; i++) {
+            uint64_t nModifier = ((uint64_t)rng() << 32) | rng();
+            uint32_t nTimeBlockFrom = rng(), nTxPrevOffset = rng(), nTimeTxPrev = rng(), nPrevout = rng() % 16;
+            CHashWriter ss(SER_GETHASH, 0);
+            ss << nModifier << nTimeBlockFrom << nTxPrevOffset << nTimeTxPrev << nPrevout << nTimeTxPrev;
+            assert(Kernel::ComputeKernelHash(nModifier, nTimeBlockFrom, nTxPrevOffset, nTimeTxPrev, nPrevout,
+                                             nTimeTxPrev) == ss.GetHash());
+
+            CKernelMidstate midstate;
+            midstate.Init(nModifier, nTimeBlockFrom, nTxPrevOffset, nTimeTxPrev, nPrevout);
+            uint256 vHashes[KERNEL_PROBE_BATCH];
+            const size_t nBatch = 1 + i % KERNEL_PROBE_BATCH;
+            midstate.HashBatch(nTimeTxPrev, nBatch, vHashes);
+            for (size_t j = 0; j < nBatch; j++)
+                assert(vHashes[j] == midstate.Hash(nTimeTxPrev + (uint32_t)j));
+        }
+
+        // --- Merkle roots, odd levels and mutation included ---
+        for (size_t nLeaves = 0; nLeaves <= 40; nLeaves++) {
+            std::vector<uint256> vLeaves(nLeaves);
+            for (uint256& leaf : vLeaves)
+                for (unsigned char* p = leaf.begin(); p != leaf.end(); p++)
+                    *p = (unsigned char)rng();
+            if (nLeaves >= 6 && nLeaves % 3 == 0)
+                vLeaves[nLeaves - 1] = vLeaves[nLeaves - 2];
+            bool fMutated, fMutatedExpected;
+            uint256 root = SHA256MerkleRoot(vLeaves, &fMutated);
+            assert(root == ComputeMerkleRoot(vLeaves, &fMutatedExpected));
+            assert(fMutated == fMutatedExpected);
+        }
+    }
+    SHA256SetBackend(chosen);
+    std::cout << "SHA-256 Dispatch Test Passed\n";
+}
@@ -0,0 +1,347 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+#include "../consensus/blockforest.h"
+#include "../consensus/fee_burner.h"
+#include "../security/checkpoints.h"
+#include "../security/checkpointsync.h"
+#include "../storage/blockstore.h"
+#include "../storage/reindex.h"
+#include "../storage/snapshot.h"
+#include "arith_uint256.h"
+#include "chain.h"
+#include "key.h"
+#include "primitives/block.h"
+#include "validation.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using namespace Africoin;
+
+/** In-memory coins database with a cursor, as a snapshot is written from */
+class CursorCoinsView : public CCoinsView {
+public:
+    std::map<COutPoint, Coin> mapCoins;
+    uint256 hashBest;
+    size_t nBatches = 0;
+
+    class MapCursor : public CCoinsViewCursor {
+    public:
+        MapCursor(const std::map<COutPoint, Coin>& mapIn, const uint256& hashBlockIn)
+            : CCoinsViewCursor(hashBlockIn), it(mapIn.begin()), end(mapIn.end()) {}
+
+        bool GetKey(COutPoint& key) const override { key = it->first; return true; }
+        bool GetValue(Coin& coin) const override { coin = it->second; return true; }
+        unsigned int GetValueSize() const override { return 0; }
+        bool Valid() const override { return it != end; }
+        void Next() override { ++it; }
+
+    private:
+        std::map<COutPoint, Coin>::const_iterator it, end;
+    };
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override
+    {
+        auto it = mapCoins.find(outpoint);
+        if (it == mapCoins.end())
+            return false;
+        coin = it->second;
+        return true;
+    }
+
+    uint256 GetBestBlock() const override { return hashBest; }
+
+    bool BatchWrite(CCoinsMap& mapBatch, const uint256& hashBlock) override
+    {
+        for (auto& entry : mapBatch) {
+            if (entry.second.coin.IsSpent())
+                mapCoins.erase(entry.first);
+            else
+                mapCoins[entry.first] = entry.second.coin;
+        }
+        mapBatch.clear();
+        // A null hash leaves the best block alone, as in CCoinsViewDB
+        if (!hashBlock.IsNull())
+            hashBest = hashBlock;
+        nBatches++;
+        return true;
+    }
+
+    CCoinsViewCursor* Cursor() const override { return new MapCursor(mapCoins, hashBest); }
+};
+
+static CTransactionRef MakeSnapshotTx(uint32_t nTime, const std::vector<COutPoint>& vPrevouts, CAmount nValue)
+{
+    CMutableTransaction tx;
+    tx.nTime = nTime;
+    tx.vin.resize(vPrevouts.empty() ? 1 : vPrevouts.size());
+    for (size_t i = 0; i < vPrevouts.size(); i++)
+        tx.vin[i].prevout = vPrevouts[i];
+    if (vPrevouts.empty())
+        tx.vin[0].scriptSig = CScript() << (int64_t)nTime;   // Unique coinbase
+    for (int i = 0; i < 2; i++) {
+        tx.vout.emplace_back();
+        tx.vout.back().nValue = nValue / 2;
+        tx.vout.back().scriptPubKey = CScript() << std::vector<unsigned char>(24, 0x76 + i);
+    }
+    return MakeTransactionRef(std::move(tx));
+}
+
+/** Flip one byte of a copy of the snapshot */
+static boost::filesystem::path CorruptCopy(const boost::filesystem::path& path, const std::string& strName, long nOffset)
+{
+    boost::filesystem::path pathCopy = path.parent_path() / strName;
+    boost::filesystem::copy_file(path, pathCopy);
+    boost::filesystem::fstream file(pathCopy, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(nOffset, nOffset < 0 ? std::ios::end : std::ios::beg);
+    char ch = file.peek();
+    file.seekp(file.tellg());
+    file.put(ch ^ 0x5a);
+    return pathCopy;
+}
+
+void SnapshotTests()
+{
+    ECC_Start();
+    {
+        ECCVerifyHandle verifyHandle;
+        std::mt19937 rng(11);
+
+        boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+                                      boost::filesystem::unique_path("africoin-snapshot-%%%%%%%%");
+        CBlockStore store(dir / "blocks");
+        assert(store.Open());
+
+        // --- A 300 block chain: the full node's index and a headers-only index ---
+        CBlockForest forestFull, forestHeaders, forestOther;
+        FeeBurnLedger ledgerFull;
+        std::vector<COutPoint> vUnspent;
+        BlockRef tip = NULL_BLOCK_REF, tipHeaders = NULL_BLOCK_REF, tipOther = NULL_BLOCK_REF;
+        uint256 hashPrev;
+        const int nBlocks = 300;
+        for (int nHeight = 0; nHeight < nBlocks; nHeight++) {
+            CBlock block;
+            block.nTime = 1500000000 + nHeight * 64;
+            block.nBits = 0x1e0fffff;
+            block.hashPrevBlock = hashPrev;
+            block.vtx.push_back(MakeSnapshotTx(block.nTime, {}, 50 * COIN));
+            for (int i = 0; i < 4 && vUnspent.size() > 8; i++) {
+                size_t n = rng() % vUnspent.size();
+                block.vtx.push_back(MakeSnapshotTx(block.nTime, {vUnspent[n]}, COIN));
+                vUnspent[n] = vUnspent.back();
+                vUnspent.pop_back();
+            }
+            for (const CTransactionRef& tx : block.vtx)
+                for (uint32_t n = 0; n < tx->vout.size(); n++)
+                    vUnspent.push_back(COutPoint(tx->GetHash(), n));
+            block.hashMerkleRoot = block.vtx[0]->GetHash();
+
+            CDiskBlockPos pos;
+            assert(store.WriteBlock(block, pos));
+            uint32_t nFlags = nHeight % 3 ? (uint32_t)FOREST_PROOF_OF_STAKE : 0;
+            tipHeaders = forestHeaders.Add(block.GetHash(), tipHeaders, block.nTime, block.nBits, nFlags);
+            tipOther = forestOther.Add(block.GetHash(), tipOther, block.nTime + (nHeight == nBlocks - 1), block.nBits, nFlags);
+            if (nHeight % 50 == 0)
+                nFlags |= FOREST_STAKE_MODIFIER;
+            if (rng() % 2)
+                nFlags |= FOREST_STAKE_ENTROPY;
+            tip = forestFull.Add(block.GetHash(), tip, block.nTime, block.nBits, nFlags);
+            forestFull.Cold(tip).nStakeModifier = 7 * (nHeight / 50) + 1;
+            if (nHeight % 3)
+                forestFull.Cold(tip).hashProof = ArithToUint256(arith_uint256(rng()));
+            for (CBlockForest* forest : {&forestFull, &forestHeaders}) {
+                BlockRef ref = forest->Find(block.GetHash());
+                forest->Cold(ref).nFile = pos.nFile;
+                forest->Cold(ref).nDataPos = pos.nPos;
+            }
+            CFeeBurnUndo burnundo;
+            BlockType blockType = nHeight % 3 ? BLOCK_TYPE_POS : BLOCK_TYPE_POW;
+            CAmount nValueCreated = HybridStaking::CalculateBlockReward(nHeight, blockType) + 500 * nHeight;
+            assert(ledgerFull.ConnectBlock(nHeight, 1000 * nHeight, nValueCreated, blockType, burnundo));
+            hashPrev = block.GetHash();
+        }
+        const uint256 hashTip = forestFull.GetBlockHash(tip);
+
+        CReindexOptions options;
+        options.nReadThreads = 2;
+        options.nWindow = 16;
+        options.nFlushEntries = 256;
+        options.fCheckHeaders = false;
+        options.fnProgress = [](const CReindexStats&) {};
+        CursorCoinsView chainstateFull;
+        CReindexStats reindexStats;
+        assert(ReindexChainstate(store, forestFull, tip, chainstateFull, options, reindexStats));
+
+        CChainSlices::RailwayNodeMap mapNodesFull;
+        for (const char* code : {"TAZ", "ZRL"}) {
+            RailwayStakingNode& node = mapNodesFull[code];
+            node.code = code;
+            node.name = std::string(code) + " Railway";
+            node.allocation = 1000000 * COIN;
+            node.isActive = true;
+            node.lastStakeTime = 1500000000 + rng() % 10000;
+            node.totalStakes = rng() % 100;
+            node.stakingWeight = 1.25;
+        }
+
+        // --- Write ---
+        boost::filesystem::path path = dir / "snapshot.dat";
+        CSnapshotMetadata metadata;
+        CursorCoinsView stale;
+        assert(!WriteSnapshot(path, stale, forestFull, tip, mapNodesFull, ledgerFull, metadata));
+        assert(WriteSnapshot(path, chainstateFull, forestFull, tip, mapNodesFull, ledgerFull, metadata));
+        assert(metadata.nHeight == nBlocks - 1 && metadata.hashBlock == hashTip);
+        assert(metadata.nCoins == chainstateFull.mapCoins.size() && metadata.nCoins > 500);
+        uint64_t nCoins;
+        assert(GetSnapshotCoinsHash(chainstateFull, nCoins) == metadata.hashCoins && nCoins == metadata.nCoins);
+        assert(!boost::filesystem::exists(dir / "snapshot.dat.new"));
+
+        CursorCoinsView chainstate;
+        CChainSlices::RailwayNodeMap mapNodes;
+        FeeBurnLedger ledger;
+        CSnapshotMetadata metadataLoaded;
+        CSnapshotStats stats;
+        CBlockIndex indexTip;
+        {
+            LOCK(cs_main);
+
+            // --- Not a hardened checkpoint: refused ---
+            assert(!LoadSnapshot(path, forestHeaders, chainstate, mapNodes, ledger, metadataLoaded, stats));
+            assert(chainstate.nBatches == 0);
+
+            indexTip.phashBlock = &hashTip;
+            indexTip.nHeight = nBlocks - 1;
+            mapBlockIndex[hashTip] = &indexTip;
+            CKey keyMaster;
+            keyMaster.MakeNewKey(true);
+            // Sync checkpoint at the tip; version 1, without a snapshot commitment, if hashCoins is null
+            auto CheckpointTip = [&](const uint256& hashCoins, uint64_t nCoinsIn, const uint256& hashState) {
+                PeerCoin::g_syncCheckpoints.SetKeys(keyMaster.GetPubKey(), std::vector<CPubKey>(), 0);
+                PeerCoin::CSyncCheckpoint checkpoint;
+                if (!hashCoins.IsNull())
+                    checkpoint.nVersion = PeerCoin::SYNC_CHECKPOINT_VERSION_SNAPSHOT;
+                checkpoint.nHeight = nBlocks - 1;
+                checkpoint.hashCheckpoint = hashTip;
+                checkpoint.hashSnapshotCoins = hashCoins;
+                checkpoint.nSnapshotCoins = nCoinsIn;
+                checkpoint.hashSnapshotState = hashState;
+                assert(checkpoint.Sign(keyMaster));
+                CValidationState state;
+                assert(PeerCoin::g_syncCheckpoints.ProcessSyncCheckpoint(checkpoint, state) == PeerCoin::SYNC_CHECKPOINT_ACCEPTED);
+            };
+
+            // --- The block is checkpointed but nothing vouches for the coins: refused ---
+            CheckpointTip(uint256(), 0, uint256());
+            assert(PeerCoin::Checkpoints::GetCheckpointHash(nBlocks - 1) == hashTip);
+            PeerCoin::Checkpoints::CAssumeUtxoData trusted;
+            assert(!PeerCoin::Checkpoints::GetAssumeUtxo(nBlocks - 1, trusted));
+            assert(!LoadSnapshot(path, forestHeaders, chainstate, mapNodes, ledger, metadataLoaded, stats));
+            assert(chainstate.nBatches == 0);
+
+            // --- Coins hash or count or state hash other than the signed ones: refused ---
+            CheckpointTip(ArithToUint256(arith_uint256(1)), metadata.nCoins, metadata.hashState);
+            assert(!LoadSnapshot(path, forestHeaders, chainstate, mapNodes, ledger, metadataLoaded, stats));
+            CheckpointTip(metadata.hashCoins, metadata.nCoins + 1, metadata.hashState);
+            assert(!LoadSnapshot(path, forestHeaders, chainstate, mapNodes, ledger, metadataLoaded, stats));
+            CheckpointTip(metadata.hashCoins, metadata.nCoins, ArithToUint256(arith_uint256(1)));
+            assert(!LoadSnapshot(path, forestHeaders, chainstate, mapNodes, ledger, metadataLoaded, stats));
+            assert(chainstate.nBatches == 0);
+
+            CheckpointTip(metadata.hashCoins, metadata.nCoins, metadata.hashState);
+            assert(PeerCoin::Checkpoints::GetAssumeUtxo(nBlocks - 1, trusted));
+            assert(trusted.hashCoins == metadata.hashCoins && trusted.nCoins == metadata.nCoins);
+            assert(trusted.hashState == metadata.hashState);
+
+            // --- Corrupt or mismatched snapshots are refused ---
+            // A file consistent with its own header, but missing a coin
+            CursorCoinsView chainstateForged;
+            chainstateForged.mapCoins = chainstateFull.mapCoins;
+            chainstateForged.mapCoins.erase(chainstateForged.mapCoins.begin());
+            chainstateForged.hashBest = chainstateFull.hashBest;
+            CSnapshotMetadata metadataForgedFile;
+            assert(WriteSnapshot(dir / "forged.dat", chainstateForged, forestFull, tip, mapNodesFull, ledgerFull,
+                                 metadataForgedFile));
+            CursorCoinsView chainstateForgedLoad;
+            assert(!LoadSnapshot(dir / "forged.dat", forestHeaders, chainstateForgedLoad, mapNodes, ledger,
+                                 metadataLoaded, stats));
+            assert(chainstateForgedLoad.nBatches == 0 && mapNodes.empty());
+            // The same coins with a state section of its own making
+            CChainSlices::RailwayNodeMap mapNodesForged = mapNodesFull;
+            mapNodesForged["TAZ"].stakingWeight = 100;
+            assert(WriteSnapshot(dir / "forgedstate.dat", chainstateFull, forestFull, tip, mapNodesForged, ledgerFull,
+                                 metadataForgedFile));
+            assert(metadataForgedFile.hashCoins == metadata.hashCoins && metadataForgedFile.hashState != metadata.hashState);
+            assert(!LoadSnapshot(dir / "forgedstate.dat", forestHeaders, chainstateForgedLoad, mapNodes, ledger,
+                                 metadataLoaded, stats));
+            assert(chainstateForgedLoad.nBatches == 0 && mapNodes.empty());
+            CursorCoinsView chainstateBad;
+            assert(!LoadSnapshot(CorruptCopy(path, "state.dat", 130), forestHeaders, chainstateBad, mapNodes, ledger,
+                                 metadataLoaded, stats));
+            assert(chainstateBad.nBatches == 0 && mapNodes.empty() && ledger.GetHeight() == -1);
+            CursorCoinsView chainstateBadCoins;
+            assert(!LoadSnapshot(CorruptCopy(path, "coins.dat", -3), forestHeaders, chainstateBadCoins, mapNodes, ledger,
+                                 metadataLoaded, stats, 100));
+            assert(mapNodes.empty() && ledger.GetHeight() == -1);
+            // Coins already written never claim to be the snapshot block's
+            assert(chainstateBadCoins.nBatches > 0 && chainstateBadCoins.hashBest.IsNull());
+            CursorCoinsView chainstateOther;
+            assert(!LoadSnapshot(path, forestOther, chainstateOther, mapNodes, ledger, metadataLoaded, stats));
+            assert(chainstateOther.nBatches == 0);
+            assert(!LoadSnapshot(path, forestHeaders, chainstateFull, mapNodes, ledger, metadataLoaded, stats));
+            std::cout << "Snapshot Rejection Test Passed\n";
+
+            // --- Load into a headers-only node ---
+            stats = CSnapshotStats();
+            assert(LoadSnapshot(path, forestHeaders, chainstate, mapNodes, ledger, metadataLoaded, stats, 100));
+            assert(stats.fMapped && stats.nCoins == metadata.nCoins);
+            assert(stats.nFlushes == std::max<uint64_t>(1, (metadata.nCoins + 99) / 100));
+            assert(metadataLoaded.hashCoins == metadata.hashCoins && metadataLoaded.hashState == metadata.hashState);
+            assert(chainstate.hashBest == hashTip && chainstate.mapCoins.size() == chainstateFull.mapCoins.size());
+            for (const auto& entry : chainstateFull.mapCoins) {
+                const Coin& coin = chainstate.mapCoins.at(entry.first);
+                assert(coin.out == entry.second.out && coin.nHeight == entry.second.nHeight);
+                assert(coin.IsCoinBase() == entry.second.IsCoinBase() && coin.nTime == entry.second.nTime);
+            }
+            for (BlockRef ref = 0; ref < forestFull.Size(); ref++) {
+                BlockRef refHeaders = forestHeaders.Find(forestFull.GetBlockHash(ref));
+                assert(forestHeaders.Hot(refHeaders).nFlags == forestFull.Hot(ref).nFlags);
+                assert(forestHeaders.Cold(refHeaders).nStakeModifier == forestFull.Cold(ref).nStakeModifier);
+                assert(forestHeaders.Cold(refHeaders).nStakeModifierChecksum == forestFull.Cold(ref).nStakeModifierChecksum);
+                assert(forestHeaders.Cold(refHeaders).hashProof == forestFull.Cold(ref).hashProof);
+            }
+            assert(mapNodes.size() == 2 && mapNodes["ZRL"].totalStakes == mapNodesFull["ZRL"].totalStakes);
+            assert(mapNodes["TAZ"].lastStakeTime == mapNodesFull["TAZ"].lastStakeTime && mapNodes["TAZ"].stakingWeight == 1.25);
+            assert(ledger.GetHeight() == nBlocks - 1);
+            assert(ledger.GetCirculatingSupply(nBlocks - 1) == ledgerFull.GetCirculatingSupply(nBlocks - 1));
+            assert(ledger.GetBurned(0, nBlocks - 1) == ledgerFull.GetBurned(0, nBlocks - 1));
+            std::cout << "Snapshot Load Test Passed\n";
+        }
+
+        // --- Background validation against the block files ---
+        CursorCoinsView background;
+        CReindexStats validateStats;
+        assert(ValidateSnapshot(store, forestHeaders, metadataLoaded, background, options, validateStats));
+        assert(validateStats.nHeight == nBlocks - 1 && background.mapCoins.size() == chainstate.mapCoins.size());
+
+        CSnapshotMetadata metadataForged = metadataLoaded;
+        metadataForged.hashCoins = ArithToUint256(arith_uint256(1));
+        CursorCoinsView backgroundForged;
+        assert(!ValidateSnapshot(store, forestHeaders, metadataForged, backgroundForged, options, validateStats));
+        std::cout << "Snapshot Validation Test Passed\n";
+
+        LOCK(cs_main);
+        PeerCoin::g_syncCheckpoints.SetKeys(CPubKey(), std::vector<CPubKey>(), 0);
+        mapBlockIndex.erase(hashTip);
+        boost::filesystem::remove_all(dir);
+    }
+    ECC_Stop();
+}
+
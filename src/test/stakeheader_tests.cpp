@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include "../consensus/stakeheader.h"
+#include "../consensus/stakeseen.h"
+#include "../staking/hybrid_difficulty.h"
+#include "arith_uint256.h"
+#include "chain.h"
+#include "consensus/merkle.h"
+#include "streams.h"
+#include "validation.h"
+#include "version.h"
+
+using namespace Africoin;
+
+static CTransactionRef MakeTx(uint32_t nTime, const COutPoint& prevout, bool fCoinStake)
+{
+    CMutableTransaction tx;
+    tx.nTime = nTime;
+    tx.vin.resize(1);
+    tx.vin[0].prevout = prevout;
+    tx.vin[0].scriptSig = CScript() << std::vector<unsigned char>(72, 0x30);
+    tx.vout.resize(2);
+    tx.vout[0].nValue = fCoinStake ? 0 : 1000;   // The coinstake marker is an empty first output
+    if (!fCoinStake)
+        tx.vout[0].scriptPubKey = CScript() << std::vector<unsigned char>(25, 0x76);
+    tx.vout[1].nValue = 1000;
+    tx.vout[1].scriptPubKey = CScript() << std::vector<unsigned char>(25, 0x76);
+    return MakeTransactionRef(std::move(tx));
+}
+
+static StakeHeaderResult Check(const CStakeHeader& stakeHeader, const CBlockIndex* pindexPrev, std::string& strReason)
+{
+    CValidationState state;
+    uint256 hashProofOfStake;
+    StakeHeaderResult result = CheckStakeHeader(stakeHeader, pindexPrev, state, hashProofOfStake);
+    strReason = state.GetRejectReason();
+    return result;
+}
+
+void StakeHeaderTests()
+{
+    LOCK(cs_main);
+
+    // A short PoW chain to build on: the first PoS block gets the target limit
+    std::vector<uint256> vHash(10);
+    std::vector<CBlockIndex> vIndex(10);
+    for (int h = 0; h < 10; h++) {
+        vHash[h] = ArithToUint256(arith_uint256(1000 + h));
+        vIndex[h].phashBlock = &vHash[h];
+        vIndex[h].pprev = h > 0 ? &vIndex[h - 1] : nullptr;
+        vIndex[h].nHeight = h;
+        vIndex[h].nTime = 1500000000 + h * 150;
+        vIndex[h].nBits = HYBRID_TARGET_LIMIT_BITS;
+    }
+    const CBlockIndex* pindexPrev = &vIndex[9];
+    const uint32_t nTime = vIndex[9].nTime + 64;
+
+    CBlock block;
+    block.hashPrevBlock = vHash[9];
+    block.nTime = nTime;
+    block.nBits = GetNextHybridTarget(pindexPrev, BLOCK_TYPE_POS);
+    block.vtx.push_back(MakeTx(nTime, COutPoint(), false));
+    block.vtx.push_back(MakeTx(nTime, COutPoint(ArithToUint256(arith_uint256(7)), 1), true));
+    for (int i = 0; i < 9; i++)
+        block.vtx.push_back(MakeTx(nTime, COutPoint(ArithToUint256(arith_uint256(100 + i)), 0), false));
+    block.hashMerkleRoot = BlockMerkleRoot(block);
+
+    // --- The message: a few hundred bytes, round trips ---
+    CStakeHeader stakeHeader(block, vHash[2]);
+    assert(stakeHeader.GetHash() == block.GetHash() && stakeHeader.vMerkleBranch.size() == 4);
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << stakeHeader;
+    assert(ss.size() < 500 && ss.size() * 4 < ::GetSerializeSize(block, SER_NETWORK, PROTOCOL_VERSION));
+    CStakeHeader received;
+    ss >> received;
+    assert(received.GetHash() == stakeHeader.GetHash() && received.hashBlockFrom == vHash[2]);
+    assert(received.txCoinStake->GetHash() == block.vtx[1]->GetHash() && received.vMerkleBranch == stakeHeader.vMerkleBranch);
+    std::cout << "Stake Header Message Test Passed\n";
+
+    // --- Structure, target and merkle binding are checked without any local data ---
+    std::string strReason;
+    assert(Check(stakeHeader, pindexPrev, strReason) == STAKE_HEADER_DEFERRED);
+
+    CStakeHeader bad = stakeHeader;
+    bad.txCoinStake = block.vtx[2];
+    assert(Check(bad, pindexPrev, strReason) == STAKE_HEADER_INVALID && strReason == "bad-stakehdr-coinstake");
+
+    bad = stakeHeader;
+    bad.txCoinStake = MakeTx(nTime + 16, block.vtx[1]->vin[0].prevout, true);
+    assert(Check(bad, pindexPrev, strReason) == STAKE_HEADER_INVALID && strReason == "bad-stakehdr-time");
+
+    bad = stakeHeader;
+    bad.header.nBits = 0x1d00ffff;
+    assert(Check(bad, pindexPrev, strReason) == STAKE_HEADER_INVALID && strReason == "bad-diffbits");
+
+    bad = stakeHeader;
+    bad.txCoinStake = MakeTx(nTime, COutPoint(ArithToUint256(arith_uint256(8)), 1), true);
+    assert(Check(bad, pindexPrev, strReason) == STAKE_HEADER_INVALID && strReason == "bad-stakehdr-merkle");
+
+    bad = stakeHeader;
+    bad.vMerkleBranch.resize(MAX_STAKE_HEADER_BRANCH + 1);
+    assert(Check(bad, pindexPrev, strReason) == STAKE_HEADER_INVALID && strReason == "bad-stakehdr-branch");
+    std::cout << "Stake Header Structure Test Passed\n";
+
+    // --- A stake already used by an indexed block is a duplicate, without penalty ---
+    CStakeId stake(block.vtx[1]->vin[0].prevout, nTime);
+    g_stakeSeen.AddBlockStake(stake, 10);
+    CValidationState state;
+    uint256 hashProofOfStake;
+    assert(CheckStakeHeader(stakeHeader, pindexPrev, state, hashProofOfStake) == STAKE_HEADER_INVALID);
+    int nDoS = -1;
+    assert(state.IsInvalid(nDoS) && nDoS == 0 && state.GetRejectReason() == "dup-stake");
+    g_stakeSeen.Prune(10 + DEFAULT_STAKE_SEEN_DEPTH + 1);
+    std::cout << "Stake Header Duplicate Test Passed\n";
+
+    // --- blockFrom must be an ancestor of the new block ---
+    uint256 hashFork = ArithToUint256(arith_uint256(2000));
+    CBlockIndex indexFork;
+    indexFork.phashBlock = &hashFork;
+    indexFork.pprev = &vIndex[1];
+    indexFork.nHeight = 2;
+    mapBlockIndex[vHash[2]] = &vIndex[2];
+    mapBlockIndex[hashFork] = &indexFork;
+
+    // On the chain: the kernel needs txPrev from the block store, absent here
+    assert(Check(stakeHeader, pindexPrev, strReason) == STAKE_HEADER_DEFERRED);
+    bad = stakeHeader;
+    bad.hashBlockFrom = hashFork;
+    assert(Check(bad, pindexPrev, strReason) == STAKE_HEADER_INVALID && strReason == "bad-stakehdr-blockfrom");
+
+    mapBlockIndex.erase(vHash[2]);
+    mapBlockIndex.erase(hashFork);
+    std::cout << "Stake Header BlockFrom Test Passed\n";
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+#include "../consensus/blockforest.h"
+#include "../security/stakemodifier.h"
+#include "chainparamsbase.h"
+#include "uint256.h"
+
+using namespace Africoin;
+using PeerCoin::StakeModifier;
+
+static uint256 RandomHash(std::mt19937_64& rng)
+{
+    uint256 hash;
+    for (int i = 0; i < 4; i++) {
+        uint64_t n = rng();
+        memcpy(hash.begin() + 8 * i, &n, 8);
+    }
+    return hash;
+}
+
+/** Kernel hash the modifier code uses for a block */
+static uint256 KernelHash(const CBlockForest& forest, BlockRef ref)
+{
+    return forest.Hot(ref).IsProofOfStake() ? forest.Cold(ref).hashProof : forest.GetBlockHash(ref);
+}
+
+/** Add a block and compute its modifier as block connection would */
+static BlockRef AddBlock(CBlockForest& forest, BlockRef prev, uint32_t nTime, bool fProofOfStake, std::mt19937_64& rng)
+{
+    uint32_t nFlags = (fProofOfStake ? (uint32_t)FOREST_PROOF_OF_STAKE : 0) |
+                      (rng() & 1 ? (uint32_t)FOREST_STAKE_ENTROPY : 0);
+    BlockRef ref = forest.Add(RandomHash(rng), prev, nTime, 0x1e0fffff, nFlags);
+    if (fProofOfStake)
+        forest.Cold(ref).hashProof = RandomHash(rng);
+
+    uint64_t nStakeModifier;
+    bool fGenerated;
+    bool fComputed = StakeModifier::ComputeNextStakeModifier(forest, ref, nStakeModifier, fGenerated);
+    assert(fComputed);
+    forest.Cold(ref).nStakeModifier = nStakeModifier;
+    if (fGenerated)
+        forest.Hot(ref).nFlags |= FOREST_STAKE_MODIFIER;
+    return ref;
+}
+
+void StakeModifierTests()
+{
+    const int64_t nSwitch = PeerCoin::GetStakeModifierParams().nV04SwitchTime;
+    std::mt19937_64 rng(41);
+
+    // --- Per-network switch times: regtest, then testnet, then mainnet ---
+    const int64_t nSwitchMain = PeerCoin::GetStakeModifierParams(CBaseChainParams::MAIN).nV04SwitchTime;
+    const int64_t nSwitchTest = PeerCoin::GetStakeModifierParams(CBaseChainParams::TESTNET).nV04SwitchTime;
+    const int64_t nSwitchRegtest = PeerCoin::GetStakeModifierParams(CBaseChainParams::REGTEST).nV04SwitchTime;
+    assert(nSwitchRegtest < nSwitchTest && nSwitchTest < nSwitchMain);
+    assert(nSwitch == nSwitchMain || nSwitch == nSwitchTest || nSwitch == nSwitchRegtest);
+
+    // --- Activation is gated on the block timestamp ---
+    assert(!StakeModifier::IsProtocolV04(nSwitch - 1));
+    assert(StakeModifier::IsProtocolV04(nSwitch));
+    assert(StakeModifier::IsProtocolV03(nSwitch - 1) && StakeModifier::IsProtocolV03(nSwitch));
+    std::cout << "Stake Modifier Activation Test Passed\n";
+
+    // --- Six days of v0.3 blocks up to the switch, then a day of v0.4 ---
+    CBlockForest forest;
+    std::vector<BlockRef> vChain;
+    BlockRef tip = NULL_BLOCK_REF;
+    for (int64_t nTime = nSwitch - 6 * 24 * 60 * 60; nTime < nSwitch + 24 * 60 * 60; nTime += 600) {
+        tip = AddBlock(forest, tip, nTime, vChain.size() % 3 != 0, rng);
+        vChain.push_back(tip);
+    }
+    assert(forest.Cold(vChain[0]).nStakeModifier == 0 && forest.Hot(vChain[0]).GeneratedStakeModifier());
+
+    size_t nFirstV04 = 0;
+    while (!StakeModifier::IsProtocolV04(forest.Hot(vChain[nFirstV04]).nTime))
+        nFirstV04++;
+    assert(forest.Hot(vChain[nFirstV04]).nTime == nSwitch);
+
+    // v0.3: a new modifier only when the parent opens a new 6 hour interval
+    std::set<uint64_t> setGenerated;
+    for (size_t h = 1; h < nFirstV04; h++) {
+        const CBlockForestHot& parent = forest.Hot(vChain[h - 1]);
+        const CBlockForestHot& last = forest.Hot(forest.GetLastModifierBlock(vChain[h - 1]));
+        bool fNewInterval = last.nTime / PeerCoin::nModifierInterval < parent.nTime / PeerCoin::nModifierInterval;
+        assert(forest.Hot(vChain[h]).GeneratedStakeModifier() == fNewInterval);
+        if (fNewInterval)
+            setGenerated.insert(forest.Cold(vChain[h]).nStakeModifier);
+        else
+            assert(forest.Cold(vChain[h]).nStakeModifier == forest.Cold(vChain[h - 1]).nStakeModifier);
+    }
+    assert(setGenerated.size() >= 20);
+    std::cout << "Stake Modifier v0.3 Interval Test Passed\n";
+
+    // v0.4: every block hashes its kernel into its parent's modifier, starting from the last v0.3 one
+    for (size_t h = nFirstV04; h < vChain.size(); h++) {
+        assert(forest.Hot(vChain[h]).GeneratedStakeModifier());
+        assert(forest.Cold(vChain[h]).nStakeModifier ==
+               StakeModifier::ComputeStakeModifierV04(forest.Cold(vChain[h - 1]).nStakeModifier, KernelHash(forest, vChain[h])));
+        assert(forest.Cold(vChain[h]).nStakeModifier != forest.Cold(vChain[h - 1]).nStakeModifier);
+    }
+    std::cout << "Stake Modifier v0.4 Chain Test Passed\n";
+
+    // --- Siblings either side of the switch off the last v0.3 block ---
+    const BlockRef parent = vChain[nFirstV04 - 1];
+    BlockRef before = AddBlock(forest, parent, nSwitch - 1, true, rng);
+    BlockRef at = AddBlock(forest, parent, nSwitch, true, rng);
+    BlockRef atPoW = AddBlock(forest, parent, nSwitch, false, rng);
+    forest.Cold(atPoW).hashProof = RandomHash(rng);   // Ignored: PoW blocks use their block hash
+    assert(forest.Cold(before).nStakeModifier == forest.Cold(forest.GetLastModifierBlock(parent)).nStakeModifier);
+    assert(forest.Cold(at).nStakeModifier ==
+           StakeModifier::ComputeStakeModifierV04(forest.Cold(parent).nStakeModifier, forest.Cold(at).hashProof));
+    uint64_t nStakeModifier;
+    bool fGenerated;
+    assert(StakeModifier::ComputeNextStakeModifier(forest, atPoW, nStakeModifier, fGenerated) && fGenerated);
+    assert(nStakeModifier ==
+           StakeModifier::ComputeStakeModifierV04(forest.Cold(parent).nStakeModifier, forest.GetBlockHash(atPoW)));
+    assert(nStakeModifier != forest.Cold(at).nStakeModifier);
+    std::cout << "Stake Modifier Switch Boundary Test Passed\n";
+
+    // --- Recomputing the stored chain (as reindex does) gives the same modifiers ---
+    for (size_t h = 0; h < vChain.size(); h++) {
+        assert(StakeModifier::ComputeNextStakeModifier(forest, vChain[h], nStakeModifier, fGenerated));
+        assert(nStakeModifier == forest.Cold(vChain[h]).nStakeModifier);
+        assert(fGenerated == forest.Hot(vChain[h]).GeneratedStakeModifier());
+    }
+
+    // A v0.4 block only reads its parent: rewriting older kernels changes nothing
+    uint64_t nTipModifier = forest.Cold(tip).nStakeModifier;
+    for (size_t h = nFirstV04; h + 1 < vChain.size(); h++)
+        forest.Cold(vChain[h]).hashProof = RandomHash(rng);
+    assert(StakeModifier::ComputeNextStakeModifier(forest, tip, nStakeModifier, fGenerated));
+    assert(nStakeModifier == nTipModifier);
+    std::cout << "Stake Modifier Recompute Test Passed\n";
+
+    // --- v0.3 needs an earlier modifier to build on ---
+    CBlockForest orphan;
+    BlockRef genesis = orphan.Add(RandomHash(rng), NULL_BLOCK_REF, nSwitch - 100000, 0x1e0fffff, 0);
+    BlockRef child = orphan.Add(RandomHash(rng), genesis, nSwitch - 99000, 0x1e0fffff, 0);
+    assert(!StakeModifier::ComputeNextStakeModifier(orphan, child, nStakeModifier, fGenerated));
+    std::cout << "Stake Modifier Missing Base Test Passed\n";
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../consensus/stakeseen.h"
+#include "primitives/block.h"
+
+using namespace Africoin;
+
+static CStakeId RandomStake(std::mt19937_64& rng)
+{
+    uint256 hash;
+    for (int i = 0; i < 4; i++) {
+        uint64_t n = rng();
+        memcpy(hash.begin() + 8 * i, &n, 8);
+    }
+    return CStakeId(COutPoint(hash, rng() % 4), 1500000000 + (rng() % 1000000) * 16);
+}
+
+void StakeSeenTests()
+{
+    std::mt19937_64 rng(42);
+
+    // --- Cuckoo filter: no false negatives through growth and erase ---
+    {
+        CStakeFilter filter(1000);
+        std::vector<uint64_t> vHashes;
+        while (filter.Size() < filter.GetCapacity() * 9 / 10) {
+            vHashes.push_back(rng());
+            assert(filter.Insert(vHashes.back()));
+        }
+        for (uint64_t nHash : vHashes)
+            assert(filter.Contains(nHash));
+        for (size_t i = 0; i < vHashes.size(); i += 2)
+            assert(filter.Erase(vHashes[i]));
+        for (size_t i = 1; i < vHashes.size(); i += 2)
+            assert(filter.Contains(vHashes[i]));
+        assert(filter.Size() == vHashes.size() / 2);
+        assert(filter.DynamicMemoryUsage() * 8 <= filter.GetCapacity() * 16);
+    }
+
+    CStakeSeenSet set(rng(), rng());
+    std::vector<CStakeId> vStakes;
+    for (int i = 0; i < 20000; i++) {
+        vStakes.push_back(RandomStake(rng));
+        assert(set.Insert(vStakes.back(), i / 10));
+        assert(!set.Insert(vStakes.back(), i / 10));
+    }
+    for (const CStakeId& stake : vStakes)
+        assert(set.Contains(stake));
+    assert(set.Size() == vStakes.size() && set.GetMinHeight() == 0);
+
+    // Unknown stakes are almost all answered by the filter alone
+    for (int i = 0; i < 100000; i++)
+        assert(!set.Contains(RandomStake(rng)));
+    assert(set.GetFilterMisses() + set.GetFalsePositives() == 100000);
+    assert(set.GetFalsePositives() < 100);
+    assert(set.GetFilterMemoryUsage() < vStakes.size() * 4);
+    std::cout << "Stake Seen Filter Test Passed\n";
+
+    // --- Prune by height, and erase of single stakes ---
+    assert(set.PruneBelow(1000) == 10000);
+    assert(set.GetMinHeight() == 1000 && set.Size() == 10000);
+    for (size_t i = 0; i < vStakes.size(); i++)
+        assert(set.Contains(vStakes[i]) == (i >= 10000));
+    assert(set.Erase(vStakes[10000]) && !set.Erase(vStakes[10000]) && !set.Contains(vStakes[10000]));
+    assert(set.Contains(vStakes[10001]));
+    std::cout << "Stake Seen Prune Test Passed\n";
+
+    // --- Index: duplicate blocks are rejected unless an orphan wants them ---
+    CStakeSeenIndex index(100, 50);
+    CBlock block;
+    block.nTime = 1500000000;
+    CMutableTransaction coinbase, coinstake;
+    coinbase.vin.resize(1);
+    coinstake.vin.resize(1);
+    coinstake.vin[0].prevout = vStakes[0].prevout;
+    block.vtx.push_back(MakeTransactionRef(std::move(coinbase)));
+    block.vtx.push_back(MakeTransactionRef(std::move(coinstake)));
+    CStakeId stake = GetBlockStake(block);
+    assert(stake == CStakeId(vStakes[0].prevout, 1500000000));
+
+    assert(index.CheckBlockStake(stake, false));
+    index.AddBlockStake(stake, 10);
+    assert(!index.CheckBlockStake(stake, false));
+    assert(index.CheckBlockStake(stake, true));
+    assert(index.CheckBlockStake(CStakeId(stake.prevout, stake.nTime + 16), false));
+    assert(index.GetStats().nRejected == 1);
+
+    // Pruned once the block is more than nDepth below the tip
+    index.Prune(110);
+    assert(!index.CheckBlockStake(stake, false));
+    index.Prune(111);
+    assert(index.CheckBlockStake(stake, false));
+    assert(index.GetStats().nStakes == 0);
+    std::cout << "Stake Seen Block Test Passed\n";
+
+    // --- Orphans: one per stake, bounded, oldest evicted first ---
+    assert(index.CheckOrphanStake(vStakes[0], false));
+    assert(!index.CheckOrphanStake(vStakes[0], false));
+    assert(index.CheckOrphanStake(vStakes[0], true));
+    index.RemoveOrphanStake(vStakes[0]);
+    assert(index.CheckOrphanStake(vStakes[0], false));
+    for (int i = 1; i < 60; i++)
+        assert(index.CheckOrphanStake(vStakes[i], false));
+    CStakeSeenStats stats = index.GetStats();
+    assert(stats.nOrphanStakes == 50 && stats.nRejected == 3);
+    for (int i = 0; i < 10; i++)
+        assert(index.CheckOrphanStake(vStakes[i], false));       // Evicted: accepted again
+    for (int i = 20; i < 60; i++)
+        assert(!index.CheckOrphanStake(vStakes[i], false));
+    std::cout << "Stake Seen Orphan Test Passed\n";
+}
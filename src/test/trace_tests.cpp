@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../metrics/trace.h"
+
+using namespace Africoin::Trace;
+
+static size_t CountOf(const std::string& str, const std::string& strNeedle)
+{
+    size_t n = 0;
+    for (size_t pos = str.find(strNeedle); pos != std::string::npos; pos = str.find(strNeedle, pos + 1))
+        n++;
+    return n;
+}
+
+void TraceTests()
+{
+    ClearTrace();
+    g_fTraceEnabled = true;
+
+    // --- Spans from several threads, each in its own buffer ---
+    std::vector<std::thread> vThreads;
+    for (int t = 0; t < 4; t++) {
+        vThreads.emplace_back([] {
+            for (int i = 0; i < 100; i++) {
+                CTraceSpan span("TestOuter", "test");
+                CTraceSpan inner("TestInner", "test");
+            }
+        });
+    }
+    for (std::thread& thread : vThreads)
+        thread.join();
+
+    std::string strTrace = FormatChromeTrace();
+    assert(strTrace.find("\"traceEvents\":[") != std::string::npos);
+    assert(CountOf(strTrace, "\"name\":\"TestOuter\"") == 400);
+    assert(CountOf(strTrace, "\"name\":\"TestInner\"") == 400);
+    assert(CountOf(strTrace, "\"ph\":\"X\"") == 800);
+    std::cout << "Trace Multi-Thread Record Test Passed\n";
+
+    // --- Ring buffer keeps only the most recent spans ---
+    ClearTrace();
+    std::thread([] {
+        for (size_t i = 0; i < TRACE_BUFFER_EVENTS + 1000; i++)
+            CTraceSpan span(i < 1000 ? "TestOld" : "TestNew", "test");
+    }).join();
+    strTrace = FormatChromeTrace();
+    assert(CountOf(strTrace, "\"name\":\"TestOld\"") == 0);
+    assert(CountOf(strTrace, "\"name\":\"TestNew\"") == TRACE_BUFFER_EVENTS);
+    std::cout << "Trace Ring Buffer Wrap Test Passed\n";
+
+    // --- Dumps taken while the owners overwrite their slots ---
+    // Each writer pairs a name with one category and duration, so a slot
+    // copied half old and half new would show a mismatched line; a slot
+    // overwritten before it was copied would break the time order
+    ClearTrace();
+    std::atomic<bool> fStop(false);
+    std::vector<std::thread> vWriters;
+    for (int t = 0; t < 2; t++) {
+        vWriters.emplace_back([&fStop] {
+            for (uint64_t i = 0; !fStop; i++) {
+                uint64_t nStart = TraceNow();
+                if (i % 2)
+                    RecordSpan("TestTornA", "torna", nStart, nStart + 1000);
+                else
+                    RecordSpan("TestTornB", "tornb", nStart, nStart + 2000);
+            }
+        });
+    }
+    size_t nChecked = 0;
+    for (int nDump = 0; nDump < 20; nDump++) {
+        std::istringstream ss(FormatChromeTrace());
+        std::map<int, double> mapLastStart;
+        for (std::string strLine; std::getline(ss, strLine);) {
+            if (strLine.find("\"name\":\"TestTorn") == std::string::npos)
+                continue;
+            bool fA = strLine.find("\"name\":\"TestTornA\",\"cat\":\"torna\"") != std::string::npos;
+            bool fB = strLine.find("\"name\":\"TestTornB\",\"cat\":\"tornb\"") != std::string::npos;
+            assert(fA != fB);
+            assert(strLine.find(fA ? "\"dur\":1.000}" : "\"dur\":2.000}") != std::string::npos);
+            int nTid = std::stoi(strLine.substr(strLine.find("\"tid\":") + 6));
+            double nStart = std::stod(strLine.substr(strLine.find("\"ts\":") + 5));
+            assert(!mapLastStart.count(nTid) || mapLastStart[nTid] <= nStart);
+            mapLastStart[nTid] = nStart;
+            nChecked++;
+        }
+    }
+    fStop = true;
+    for (std::thread& thread : vWriters)
+        thread.join();
+    assert(nChecked > 0);
+    std::cout << "Trace Concurrent Dump Test Passed\n";
+
+    // --- Disabled tracing records nothing ---
+    ClearTrace();
+    g_fTraceEnabled = false;
+    {
+        CTraceSpan span("TestDisabled", "test");
+    }
+    assert(CountOf(FormatChromeTrace(), "\"ph\":\"X\"") == 0);
+    g_fTraceEnabled = DEFAULT_TRACE;
+    std::cout << "Trace Disable Test Passed\n";
+}
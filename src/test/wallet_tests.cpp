@@ -0,0 +1,152 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../security/kernel.h"
+#include "../wallet/staking.h"
+#include "../wallet/wallet.h"
+
+using namespace Africoin;
+
+static bool SameInfo(const CStakingInfo& a, const CStakingInfo& b)
+{
+    return a.nBalance == b.nBalance && a.nEligibleBalance == b.nEligibleBalance &&
+           a.nImmatureBalance == b.nImmatureBalance && a.nEligibleCoins == b.nEligibleCoins &&
+           a.nImmatureCoins == b.nImmatureCoins && a.nStakeWeight == b.nStakeWeight &&
+           a.nNextMaturity == b.nNextMaturity;
+}
+
+void WalletTests()
+{
+    const int64_t nMinAge = PeerCoin::nStakeMinAge;
+    const int64_t nMaxAge = PeerCoin::nStakeMaxAge;
+
+    // --- One coin through immature, growing and capped ---
+    CWalletCoinStore store;
+    const uint32_t nStart = 1500000000;
+    CWalletCoin coin(COutPoint(uint256(), 0), 10 * COIN, nStart, 81);
+    assert(store.AddCoin(coin));
+    assert(!store.AddCoin(coin));
+
+    CStakingInfo info = store.GetStakingInfo(nStart + nMinAge - 1);
+    assert(info.nImmatureBalance == 10 * COIN && info.nEligibleCoins == 0);
+    assert(info.nNextMaturity == nStart + nMinAge);
+    assert(store.GetStakeWeight(nStart + nMinAge + 24 * 60 * 60) == 10);
+    assert(store.GetEligibleCoins().size() == 1);
+    uint64_t nCapped = 10 * (nMaxAge - nMinAge) / (24 * 60 * 60);
+    assert(store.GetStakeWeight(nStart + nMaxAge) == nCapped);
+    assert(store.GetStakeWeight(nStart + 2 * nMaxAge) == nCapped);
+    assert(store.SpendCoin(coin.outpoint));
+    assert(!store.SpendCoin(coin.outpoint));
+    assert(store.GetBalance() == 0 && store.GetStakeWeight(nStart + 3 * nMaxAge) == 0);
+    std::cout << "Wallet Coin Lifecycle Test Passed\n";
+
+    // --- Running totals match a full scan under random churn ---
+    std::mt19937_64 rng(1);
+    CWalletCoinStore wallet(8 * 60 * 60, nMaxAge); // Railway minimum age
+    std::vector<CWalletCoin> vUnspent;
+    std::vector<CWalletCoin> vSpent;
+    uint32_t nNow = nStart;
+    for (int nRound = 0; nRound < 200; nRound++) {
+        for (int i = 0; i < 100; i++) {
+            uint64_t nAction = rng() % 10;
+            if (nAction < 6 || vUnspent.empty()) {
+                CWalletCoin output(COutPoint(uint256(), nRound * 1000 + i), (1 + rng() % 1000) * COIN / 10,
+                                   nNow - rng() % (2 * nMaxAge), 81 + i);
+                assert(wallet.AddCoin(output));
+                vUnspent.push_back(output);
+            } else if (nAction < 9 || vSpent.empty()) {
+                size_t n = rng() % vUnspent.size();
+                assert(wallet.SpendCoin(vUnspent[n].outpoint));
+                vSpent.push_back(vUnspent[n]);
+                vUnspent[n] = vUnspent.back();
+                vUnspent.pop_back();
+            } else {
+                // A reorg puts a spent output back
+                size_t n = rng() % vSpent.size();
+                assert(wallet.AddCoin(vSpent[n]));
+                vUnspent.push_back(vSpent[n]);
+                vSpent[n] = vSpent.back();
+                vSpent.pop_back();
+            }
+        }
+        nNow += rng() % (4 * 60 * 60);
+        info = wallet.GetStakingInfo(nNow);
+        assert(SameInfo(info, wallet.GetStakingInfoByScan(nNow)));
+        assert(info.nEligibleCoins == wallet.GetEligibleCoins().size());
+        assert(wallet.GetCoinCount() == vUnspent.size());
+    }
+    std::cout << "Wallet Staking Totals Test Passed\n";
+
+    // --- Output sizing: efficiency falls with size, chosen size meets the bound ---
+    const unsigned int nBits = 0x1c15fd7f;
+    double nLast = 1.0;
+    for (CAmount nValue = COIN; nValue <= 1000000 * COIN; nValue *= 10) {
+        double nEfficiency = GetStakeEfficiency(nValue, nBits);
+        assert(nEfficiency > 0 && nEfficiency <= nLast);
+        nLast = nEfficiency;
+    }
+    assert(GetStakeEfficiency(COIN, nBits) > 0.99);
+    CAmount nTarget = ChooseStakeOutputSize(nBits, 0.9);
+    assert(GetStakeEfficiency(nTarget, nBits) >= 0.9);
+    assert(GetStakeEfficiency(nTarget + COIN, nBits) < 0.9);
+
+    CStakeOutputPolicy policy(nTarget);
+    assert(SplitCoinstakeOutput(policy.nSplitThreshold, policy).size() == 1);
+    std::vector<CAmount> vSplit = SplitCoinstakeOutput(7 * nTarget + 3, policy);
+    CAmount nSplitTotal = 0;
+    for (CAmount nValue : vSplit)
+        nSplitTotal += nValue;
+    assert(vSplit.size() == 7 && nSplitTotal == 7 * nTarget + 3);
+
+    std::vector<CWalletCoin> vSmall;
+    for (uint32_t i = 0; i < 20; i++)
+        vSmall.push_back(CWalletCoin(COutPoint(uint256(), i), nTarget / 10 + i, nStart, 81));
+    std::vector<COutPoint> vCombine = SelectCombineInputs(vSmall, vSmall[19].outpoint, nTarget / 2, policy);
+    CAmount nCombined = nTarget / 2;
+    for (const COutPoint& outpoint : vCombine) {
+        assert(outpoint != vSmall[19].outpoint);
+        nCombined += vSmall[outpoint.n].nValue;
+    }
+    assert(!vCombine.empty() && nCombined <= nTarget);
+    std::cout << "Stake Output Sizing Test Passed\n";
+
+    // --- Simulated stake frequency matches the expected cycle ---
+    CStakeSimParams params;
+    params.nBits = nBits;
+    params.nStartTime = nStart;
+    params.nDuration = 4 * 365 * 24 * 60 * 60;
+    std::vector<CWalletCoin> vUniform;
+    for (uint32_t i = 0; i < 2000; i++)
+        vUniform.push_back(CWalletCoin(COutPoint(uint256(), i), nTarget, nStart, 81));
+    CStakeSimResult sim = SimulateStaking(vUniform, nullptr, params);
+    double nExpected = vUniform.size() * params.nDuration / GetExpectedStakeCycle(nTarget, nBits);
+    assert(fabs(sim.nBlocks / nExpected - 1) < 0.05);
+    assert(sim.nFinalOutputs == vUniform.size() && sim.nFinalBalance == (CAmount)vUniform.size() * nTarget);
+    std::cout << "Stake Simulation Test Passed\n";
+
+    // --- Planning a fragmented wallet: fewer outputs and probes, similar yield ---
+    CWalletCoinStore fragmented;
+    for (uint32_t i = 0; i < 3000; i++) {
+        CAmount nValue = i < 10 ? 50 * nTarget : (1 + rng() % 20) * nTarget / 100;
+        fragmented.AddCoin(CWalletCoin(COutPoint(uint256(), i), nValue, nStart - rng() % nMaxAge, 81));
+    }
+    fragmented.AdvanceTime(nStart);
+    params.nDuration = 365 * 24 * 60 * 60;
+    CStakeOutputPlan plan = PlanStakeOutputs(fragmented, params);
+    assert(plan.policy.nTargetSize == nTarget && plan.vSplits.size() == 10 && !plan.vMerges.empty());
+    for (const CStakeMerge& merge : plan.vMerges)
+        assert(merge.vInputs.size() >= 2 && merge.nValue <= nTarget);
+    assert(plan.planned.nAvgOutputs < plan.current.nAvgOutputs / 2);
+    assert(plan.planned.GetProbesPerBlock() < plan.current.GetProbesPerBlock() / 2);
+    assert(plan.planned.nBlocks > plan.current.nBlocks * 9 / 10);
+    assert(plan.planned.nFinalBalance == plan.current.nFinalBalance);
+    assert(fragmented.GetCoinCount() == 3000);
+    assert(!FormatStakeOutputPlan(plan, params).empty());
+    std::cout << "Stake Output Plan Test Passed\n";
+}
@@ -1 +1,411 @@
-// staking.cpp: Proof-of-stake and staking operations for Africoin.
\ No newline at end of file
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file staking.cpp
+ * @brief Coinstake output sizing: split/combine policy, simulation and planner
+ */
+
+#include "wallet/staking.h"
+
+#include "arith_uint256.h"
+#include "tinyformat.h"
+#include "utilmoneystr.h"
+#include "wallet/wallet.h"
+
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <random>
+#include <set>
+
+namespace Africoin {
+
+static const double SECONDS_PER_DAY = 24 * 60 * 60;
+static const double SECONDS_PER_YEAR = 365 * SECONDS_PER_DAY;
+
+CStakeOutputPolicy::CStakeOutputPolicy(CAmount nTargetSizeIn)
+    : nTargetSize(nTargetSizeIn), nSplitThreshold(2 * nTargetSizeIn), nCombineThreshold(nTargetSizeIn / 2),
+      nMaxCombineInputs(50), nConsolidateInterval(0)
+{
+}
+
+double GetStakeProbability(unsigned int nBits)
+{
+    arith_uint256 bnTarget;
+    bnTarget.SetCompact(nBits);
+    return ldexp(bnTarget.getdouble(), -256);
+}
+
+/**
+ * Slope of the hit rate of an output of nValue: a probe per second with
+ * weight v * s / COIN-day hits with probability weight * p, so the hazard
+ * s seconds after maturity is c * s.
+ */
+static double GetHazardSlope(CAmount nValue, unsigned int nBits)
+{
+    return (double)nValue / COIN * GetStakeProbability(nBits) / SECONDS_PER_DAY;
+}
+
+/** Cumulative hazard after s seconds of maturity */
+static double CumulativeHazard(double c, double nCap, double s)
+{
+    if (s <= nCap)
+        return c * s * s / 2;
+    return c * nCap * nCap / 2 + c * nCap * (s - nCap);
+}
+
+/** Inverse of CumulativeHazard */
+static double HazardToTime(double c, double nCap, double nHazard)
+{
+    double nCapHazard = c * nCap * nCap / 2;
+    if (nHazard <= nCapHazard)
+        return sqrt(2 * nHazard / c);
+    return nCap + (nHazard - nCapHazard) / (c * nCap);
+}
+
+double GetExpectedStakeCycle(CAmount nValue, unsigned int nBits, int64_t nMinAge, int64_t nMaxAge)
+{
+    double c = GetHazardSlope(nValue, nBits);
+    double nCap = nMaxAge - nMinAge;
+    if (c <= 0 || nCap <= 0)
+        return std::numeric_limits<double>::infinity();
+
+    // Survival is exp(-c s^2 / 2) up to the cap and exponential after it
+    double nGrowing = sqrt(M_PI / (2 * c)) * erf(nCap * sqrt(c / 2));
+    double nCapped = exp(-c * nCap * nCap / 2) / (c * nCap);
+    return nMinAge + nGrowing + nCapped;
+}
+
+double GetStakeEfficiency(CAmount nValue, unsigned int nBits, int64_t nMinAge, int64_t nMaxAge)
+{
+    // Stakes per coin per second are 1 / (v * cycle); for tiny outputs the
+    // cycle tends to 1 / (c * cap), so the limit is (c / v) * cap.
+    double c = GetHazardSlope(nValue, nBits);
+    double nCap = nMaxAge - nMinAge;
+    double nCycle = GetExpectedStakeCycle(nValue, nBits, nMinAge, nMaxAge);
+    if (c <= 0 || nCap <= 0 || !std::isfinite(nCycle))
+        return 0;
+    return 1 / (c * nCap * nCycle);
+}
+
+CAmount ChooseStakeOutputSize(unsigned int nBits, double nMinEfficiency, int64_t nMinAge, int64_t nMaxAge)
+{
+    // Efficiency falls as outputs grow; search whole coins
+    CAmount nLow = 1, nHigh = MAX_MONEY / COIN;
+    if (GetStakeEfficiency(nLow * COIN, nBits, nMinAge, nMaxAge) < nMinEfficiency)
+        return COIN;
+    while (nLow < nHigh) {
+        CAmount nMid = nLow + (nHigh - nLow + 1) / 2;
+        if (GetStakeEfficiency(nMid * COIN, nBits, nMinAge, nMaxAge) >= nMinEfficiency)
+            nLow = nMid;
+        else
+            nHigh = nMid - 1;
+    }
+    return nLow * COIN;
+}
+
+std::vector<CAmount> SplitCoinstakeOutput(CAmount nValue, const CStakeOutputPolicy& policy)
+{
+    std::vector<CAmount> vOut;
+    if (policy.nTargetSize <= 0 || policy.nSplitThreshold <= 0 || nValue <= policy.nSplitThreshold) {
+        vOut.push_back(nValue);
+        return vOut;
+    }
+
+    CAmount nOutputs = std::max<CAmount>(2, nValue / policy.nTargetSize);
+    vOut.assign(nOutputs, nValue / nOutputs);
+    vOut.back() += nValue % nOutputs;
+    return vOut;
+}
+
+/**
+ * Group values (sorted largest first) into batches of at least two that
+ * stay within the target size. Returns indexes into vValues.
+ */
+static std::vector<std::vector<size_t>> GroupMerges(const std::vector<CAmount>& vValues,
+                                                    const CStakeOutputPolicy& policy)
+{
+    std::vector<std::vector<size_t>> vGroups;
+    std::vector<size_t> vBatch;
+    CAmount nBatch = 0;
+    for (size_t i = 0; i <= vValues.size(); i++) {
+        bool fFits = i < vValues.size() && nBatch + vValues[i] <= policy.nTargetSize &&
+                     vBatch.size() < policy.nMaxCombineInputs;
+        if (fFits) {
+            vBatch.push_back(i);
+            nBatch += vValues[i];
+            continue;
+        }
+        if (vBatch.size() >= 2)
+            vGroups.push_back(vBatch);
+        vBatch.clear();
+        nBatch = 0;
+        if (i < vValues.size()) {
+            vBatch.push_back(i);
+            nBatch = vValues[i];
+        }
+    }
+    return vGroups;
+}
+
+std::vector<COutPoint> SelectCombineInputs(const std::vector<CWalletCoin>& vEligible, const COutPoint& kernel,
+                                           CAmount nKernelValue, const CStakeOutputPolicy& policy)
+{
+    std::vector<const CWalletCoin*> vSmall;
+    for (const CWalletCoin& coin : vEligible)
+        if (coin.nValue < policy.nCombineThreshold && coin.outpoint != kernel)
+            vSmall.push_back(&coin);
+    std::sort(vSmall.begin(), vSmall.end(),
+              [](const CWalletCoin* a, const CWalletCoin* b) { return a->nValue > b->nValue; });
+
+    std::vector<COutPoint> vInputs;
+    CAmount nTotal = nKernelValue;
+    for (const CWalletCoin* pcoin : vSmall) {
+        if (vInputs.size() >= policy.nMaxCombineInputs)
+            break;
+        if (nTotal + pcoin->nValue > policy.nTargetSize)
+            continue;
+        vInputs.push_back(pcoin->outpoint);
+        nTotal += pcoin->nValue;
+    }
+    return vInputs;
+}
+
+namespace {
+
+/** Event-driven replay of one wallet; see SimulateStaking */
+class StakeSimulation {
+public:
+    StakeSimulation(const CStakeOutputPolicy* ppolicyIn, const CStakeSimParams& paramsIn)
+        : ppolicy(ppolicyIn), params(paramsIn), rng(paramsIn.nSeed), nStart(paramsIn.nStartTime),
+          nEnd(paramsIn.nStartTime + (double)paramsIn.nDuration), nCap(paramsIn.nMaxAge - paramsIn.nMinAge),
+          nOutputSeconds(0) {}
+
+    void Add(CAmount nValue, double nTime)
+    {
+        uint32_t nId = vCoins.size();
+        vCoins.push_back(Coin{nValue, nTime, true});
+        if (IsSmall(nValue))
+            setSmall.emplace(nValue, nId);
+
+        // Draw the hit time, conditioned on no hit before the start
+        double c = GetHazardSlope(nValue, params.nBits);
+        if (c <= 0 || nCap <= 0)
+            return;
+        double nMatured = std::max(0.0, nStart - nTime - params.nMinAge);
+        double nHazard = CumulativeHazard(c, nCap, nMatured) - log(Unit());
+        queueHits.emplace(nTime + params.nMinAge + HazardToTime(c, nCap, nHazard), nId);
+    }
+
+    CStakeSimResult Run()
+    {
+        int64_t nInterval = ppolicy ? ppolicy->nConsolidateInterval : 0;
+        double nNextConsolidate = nInterval > 0 ? nStart + nInterval : nEnd;
+        while (true) {
+            while (!queueHits.empty() && !vCoins[queueHits.top().second].fAlive)
+                queueHits.pop();
+            double nHit = queueHits.empty() ? nEnd : queueHits.top().first;
+            if (nNextConsolidate < nEnd && nNextConsolidate <= nHit) {
+                Consolidate(nNextConsolidate);
+                nNextConsolidate += nInterval;
+                continue;
+            }
+            if (nHit >= nEnd)
+                break;
+            uint32_t nId = queueHits.top().second;
+            queueHits.pop();
+            Stake(nId, nHit);
+        }
+
+        for (uint32_t nId = 0; nId < vCoins.size(); nId++) {
+            if (!vCoins[nId].fAlive)
+                continue;
+            result.nFinalOutputs++;
+            result.nFinalBalance += vCoins[nId].nValue;
+            Account(vCoins[nId], nEnd);
+        }
+        result.nAvgOutputs = params.nDuration > 0 ? nOutputSeconds / params.nDuration : 0;
+        return result;
+    }
+
+private:
+    struct Coin {
+        CAmount nValue;
+        double nTime;
+        bool fAlive;
+    };
+
+    typedef std::pair<double, uint32_t> Hit;
+
+    bool IsSmall(CAmount nValue) const { return ppolicy && nValue < ppolicy->nCombineThreshold; }
+    bool IsMature(const Coin& coin, double nTime) const { return coin.nTime + params.nMinAge <= nTime; }
+    double Unit() { return ((rng() >> 11) + 1) * (1.0 / 9007199254740992.0); }
+
+    /** Output-seconds and probe-seconds of a coin up to nTime */
+    void Account(const Coin& coin, double nTime)
+    {
+        nOutputSeconds += std::max(0.0, nTime - std::max(coin.nTime, nStart));
+        result.nProbes += std::max(0.0, nTime - std::max(coin.nTime + params.nMinAge, nStart));
+    }
+
+    void Spend(uint32_t nId, double nTime)
+    {
+        Coin& coin = vCoins[nId];
+        coin.fAlive = false;
+        if (IsSmall(coin.nValue))
+            setSmall.erase(std::make_pair(coin.nValue, nId));
+        Account(coin, nTime);
+    }
+
+    void Stake(uint32_t nId, double nTime)
+    {
+        CAmount nTotal = vCoins[nId].nValue;
+        Spend(nId, nTime);
+        result.nBlocks++;
+
+        if (ppolicy) {
+            std::vector<uint32_t> vCombine;
+            for (auto it = setSmall.rbegin(); it != setSmall.rend(); ++it) {
+                if (vCombine.size() >= ppolicy->nMaxCombineInputs)
+                    break;
+                if (nTotal + it->first > ppolicy->nTargetSize || !IsMature(vCoins[it->second], nTime))
+                    continue;
+                vCombine.push_back(it->second);
+                nTotal += it->first;
+            }
+            for (uint32_t nCombine : vCombine)
+                Spend(nCombine, nTime);
+            result.nCombined += vCombine.size();
+        }
+
+        nTotal += params.nReward;
+        std::vector<CAmount> vOut = ppolicy ? SplitCoinstakeOutput(nTotal, *ppolicy) : std::vector<CAmount>(1, nTotal);
+        if (vOut.size() > 1)
+            result.nSplits++;
+        for (CAmount nValue : vOut)
+            Add(nValue, nTime);
+    }
+
+    void Consolidate(double nTime)
+    {
+        std::vector<CAmount> vValues;
+        std::vector<uint32_t> vIds;
+        for (auto it = setSmall.rbegin(); it != setSmall.rend(); ++it) {
+            if (IsMature(vCoins[it->second], nTime)) {
+                vValues.push_back(it->first);
+                vIds.push_back(it->second);
+            }
+        }
+        for (const std::vector<size_t>& vGroup : GroupMerges(vValues, *ppolicy)) {
+            CAmount nTotal = 0;
+            for (size_t i : vGroup) {
+                nTotal += vValues[i];
+                Spend(vIds[i], nTime);
+            }
+            result.nConsolidated += vGroup.size();
+            Add(nTotal, nTime);
+        }
+    }
+
+    const CStakeOutputPolicy* ppolicy;
+    const CStakeSimParams& params;
+    std::mt19937_64 rng;
+    const double nStart;
+    const double nEnd;
+    const double nCap;
+
+    std::vector<Coin> vCoins;
+    std::set<std::pair<CAmount, uint32_t>> setSmall;   //!< Live coins below the combine threshold
+    std::priority_queue<Hit, std::vector<Hit>, std::greater<Hit>> queueHits;   //!< Earliest first, stale entries skipped
+    double nOutputSeconds;
+    CStakeSimResult result;
+};
+
+} // namespace
+
+CStakeSimResult SimulateStaking(const std::vector<CWalletCoin>& vCoins, const CStakeOutputPolicy* ppolicy,
+                                const CStakeSimParams& params)
+{
+    StakeSimulation sim(ppolicy, params);
+    for (const CWalletCoin& coin : vCoins)
+        sim.Add(coin.nValue, coin.nTime);
+    return sim.Run();
+}
+
+CStakeOutputPlan PlanStakeOutputs(const CWalletCoinStore& store, const CStakeSimParams& params, double nMinEfficiency,
+                                  size_t nMaxOutputs)
+{
+    CStakeOutputPlan plan;
+    CAmount nTarget = ChooseStakeOutputSize(params.nBits, nMinEfficiency, params.nMinAge, params.nMaxAge);
+    if (nMaxOutputs > 0)
+        nTarget = std::max<CAmount>(nTarget, (store.GetBalance() + nMaxOutputs - 1) / nMaxOutputs);
+    plan.policy = CStakeOutputPolicy(nTarget);
+    plan.policy.nConsolidateInterval = params.nMaxAge - params.nMinAge;
+    plan.nEfficiency = GetStakeEfficiency(plan.policy.nTargetSize, params.nBits, params.nMinAge, params.nMaxAge);
+
+    std::vector<CWalletCoin> vCoins = store.GetCoins();
+    std::vector<const CWalletCoin*> vSmall;
+    for (const CWalletCoin& coin : vCoins) {
+        if (coin.nValue > plan.policy.nSplitThreshold)
+            plan.vSplits.push_back(coin.outpoint);
+        else if (coin.nValue < plan.policy.nCombineThreshold && coin.nTime + params.nMinAge <= params.nStartTime)
+            vSmall.push_back(&coin);
+    }
+    std::sort(vSmall.begin(), vSmall.end(),
+              [](const CWalletCoin* a, const CWalletCoin* b) { return a->nValue > b->nValue; });
+
+    std::vector<CAmount> vValues;
+    for (const CWalletCoin* pcoin : vSmall)
+        vValues.push_back(pcoin->nValue);
+
+    // The planned wallet is the current one with the consolidations sent now
+    std::set<COutPoint> setMerged;
+    std::vector<CWalletCoin> vPlanned;
+    for (const std::vector<size_t>& vGroup : GroupMerges(vValues, plan.policy)) {
+        CStakeMerge merge;
+        for (size_t i : vGroup) {
+            merge.vInputs.push_back(vSmall[i]->outpoint);
+            merge.nValue += vSmall[i]->nValue;
+            setMerged.insert(vSmall[i]->outpoint);
+        }
+        vPlanned.push_back(CWalletCoin(COutPoint(), merge.nValue, params.nStartTime, 0));
+        plan.vMerges.push_back(merge);
+    }
+    for (const CWalletCoin& coin : vCoins)
+        if (!setMerged.count(coin.outpoint))
+            vPlanned.push_back(coin);
+
+    plan.current = SimulateStaking(vCoins, nullptr, params);
+    plan.planned = SimulateStaking(vPlanned, &plan.policy, params);
+    return plan;
+}
+
+std::string FormatStakeOutputPlan(const CStakeOutputPlan& plan, const CStakeSimParams& params)
+{
+    size_t nMergedInputs = 0;
+    for (const CStakeMerge& merge : plan.vMerges)
+        nMergedInputs += merge.vInputs.size();
+
+    double nYears = params.nDuration / SECONDS_PER_YEAR;
+    std::string strReport = "Stake output plan (dry run)\n";
+    strReport += strprintf("  target output size    %s (%.1f%% of small-output yield)\n",
+                           FormatMoney(plan.policy.nTargetSize), 100 * plan.nEfficiency);
+    strReport += strprintf("  split above           %s\n", FormatMoney(plan.policy.nSplitThreshold));
+    strReport += strprintf("  merge below           %s\n", FormatMoney(plan.policy.nCombineThreshold));
+    strReport += strprintf("  consolidate now       %u transactions, %u outputs\n", plan.vMerges.size(), nMergedInputs);
+    strReport += strprintf("  split at next stake   %u outputs\n", plan.vSplits.size());
+    strReport += strprintf("  simulated over %.2f years      current      planned\n", nYears);
+    strReport += strprintf("  average outputs       %12.1f %12.1f\n", plan.current.nAvgOutputs, plan.planned.nAvgOutputs);
+    strReport += strprintf("  stakes found          %12u %12u\n", plan.current.nBlocks, plan.planned.nBlocks);
+    strReport += strprintf("  probes per stake      %12.4g %12.4g\n", plan.current.GetProbesPerBlock(),
+                           plan.planned.GetProbesPerBlock());
+    strReport += strprintf("  final outputs         %12u %12u\n", plan.current.nFinalOutputs, plan.planned.nFinalOutputs);
+    strReport += strprintf("  final balance   %18s %18s\n", FormatMoney(plan.current.nFinalBalance),
+                           FormatMoney(plan.planned.nFinalBalance));
+    return strReport;
+}
+
+} // namespace Africoin
@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_WALLET_STAKING_H
+#define AFRICOIN_WALLET_STAKING_H
+
+#include "amount.h"
+#include "primitives/transaction.h"
+#include "security/kernel.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file staking.h
+ * @brief Coinstake output sizing: split/combine policy, simulation and planner
+ *
+ * Time weight grows for nStakeMaxAge - nStakeMinAge after a coin matures
+ * and every stake resets it, so the size of staking outputs decides both
+ * the yield and the minter's work:
+ *
+ * - A large output stakes soon after it matures and then sits out the
+ *   whole minimum age again; coins spend most of their time earning
+ *   nothing.
+ * - Many small outputs keep the coins earning, but each one is a kernel
+ *   probe every second, and almost none of those probes ever hit.
+ *
+ * Treating each probe as a Bernoulli trial with p = target / 2^256 per
+ * coin-day, an output of value v matured for s seconds hits at rate
+ * c * s with c = v * p / COIN-day, until the weight caps. The expected
+ * stake cycle (minimum age + time to a hit) then has a closed form, and
+ * so does the yield of an output relative to the small-output limit
+ * (GetStakeEfficiency). ChooseStakeOutputSize picks the largest output
+ * that still earns a given share of that limit.
+ *
+ * The policy applies the size at coinstake time, as BlackCoin's split
+ * and combine thresholds do: an oversized coinstake output is split into
+ * target-sized outputs, and small eligible outputs are folded into the
+ * coinstake. Outputs that rarely stake can also be consolidated
+ * periodically.
+ *
+ * SimulateStaking plays a wallet forward under a policy (or none) with
+ * per-output hit times drawn from the same hazard, and PlanStakeOutputs
+ * turns the comparison into a dry-run report without touching the wallet.
+ */
+
+namespace Africoin {
+
+class CWalletCoinStore;
+
+struct CWalletCoin;
+
+/**
+ * @struct CStakeOutputPolicy
+ * @brief How coinstake outputs are sized and small outputs merged
+ */
+struct CStakeOutputPolicy {
+    CAmount nTargetSize;            //!< Size outputs are split to and merged up to
+    CAmount nSplitThreshold;        //!< Split a coinstake output above this
+    CAmount nCombineThreshold;      //!< Merge eligible outputs below this
+    unsigned int nMaxCombineInputs; //!< Inputs per coinstake or consolidation
+    int64_t nConsolidateInterval;   //!< Seconds between consolidations (0: only at coinstake time)
+
+    CStakeOutputPolicy()
+        : nTargetSize(0), nSplitThreshold(0), nCombineThreshold(0), nMaxCombineInputs(50),
+          nConsolidateInterval(0) {}
+
+    /** Split above twice the target, merge below half of it */
+    explicit CStakeOutputPolicy(CAmount nTargetSizeIn);
+};
+
+/**
+ * @struct CStakeSimParams
+ * @brief Network conditions and horizon of a staking simulation
+ */
+struct CStakeSimParams {
+    uint64_t nSeed;
+    unsigned int nBits;     //!< PoS target, held constant
+    uint32_t nStartTime;
+    int64_t nDuration;      //!< Seconds simulated
+    CAmount nReward;        //!< Added to each coinstake
+    int64_t nMinAge;
+    int64_t nMaxAge;
+
+    CStakeSimParams()
+        : nSeed(1), nBits(0), nStartTime(0), nDuration(365 * 24 * 60 * 60), nReward(0),
+          nMinAge(PeerCoin::nStakeMinAge), nMaxAge(PeerCoin::nStakeMaxAge) {}
+};
+
+/**
+ * @struct CStakeSimResult
+ * @brief What a wallet did over a simulation
+ */
+struct CStakeSimResult {
+    uint64_t nBlocks;           //!< Stakes found
+    double nAvgOutputs;         //!< Time-averaged output count
+    double nProbes;             //!< Kernel probes (eligible output-seconds)
+    size_t nFinalOutputs;
+    CAmount nFinalBalance;
+    uint64_t nSplits;           //!< Coinstakes that split their output
+    uint64_t nCombined;         //!< Outputs folded into coinstakes
+    uint64_t nConsolidated;     //!< Outputs merged by consolidations
+
+    CStakeSimResult()
+        : nBlocks(0), nAvgOutputs(0), nProbes(0), nFinalOutputs(0), nFinalBalance(0), nSplits(0), nCombined(0),
+          nConsolidated(0) {}
+
+    double GetProbesPerBlock() const { return nBlocks ? nProbes / nBlocks : 0; }
+};
+
+/**
+ * @struct CStakeMerge
+ * @brief One planned consolidation transaction
+ */
+struct CStakeMerge {
+    std::vector<COutPoint> vInputs;
+    CAmount nValue;
+
+    CStakeMerge() : nValue(0) {}
+};
+
+/**
+ * @struct CStakeOutputPlan
+ * @brief Dry-run result of PlanStakeOutputs
+ */
+struct CStakeOutputPlan {
+    CStakeOutputPolicy policy;
+    double nEfficiency;                  //!< Of an output of nTargetSize
+    std::vector<CStakeMerge> vMerges;    //!< Consolidations to send now
+    std::vector<COutPoint> vSplits;      //!< Outputs to split when they next stake
+    CStakeSimResult current;             //!< Simulated with no policy
+    CStakeSimResult planned;             //!< Simulated with the policy
+
+    CStakeOutputPlan() : nEfficiency(0) {}
+};
+
+/** @brief Kernel hit probability per probe per coin-day of weight for nBits */
+double GetStakeProbability(unsigned int nBits);
+
+/**
+ * @brief Expected seconds from an output's creation until it stakes
+ *
+ * Minimum age plus the mean time to the first hit under a hazard that
+ * grows linearly with coin age and is flat after the weight cap.
+ */
+double GetExpectedStakeCycle(CAmount nValue, unsigned int nBits, int64_t nMinAge = PeerCoin::nStakeMinAge,
+                             int64_t nMaxAge = PeerCoin::nStakeMaxAge);
+
+/**
+ * @brief Yield of an output of nValue relative to the small-output limit
+ *
+ * 1 for outputs so small they always reach the weight cap, falling
+ * towards 0 as outputs grow and spend more of their life below the
+ * minimum age.
+ */
+double GetStakeEfficiency(CAmount nValue, unsigned int nBits, int64_t nMinAge = PeerCoin::nStakeMinAge,
+                          int64_t nMaxAge = PeerCoin::nStakeMaxAge);
+
+/** @brief Largest output size whose efficiency is at least nMinEfficiency (at least 1 coin) */
+CAmount ChooseStakeOutputSize(unsigned int nBits, double nMinEfficiency, int64_t nMinAge = PeerCoin::nStakeMinAge,
+                              int64_t nMaxAge = PeerCoin::nStakeMaxAge);
+
+/** @brief Coinstake output values for a staked total under the policy */
+std::vector<CAmount> SplitCoinstakeOutput(CAmount nValue, const CStakeOutputPolicy& policy);
+
+/**
+ * @brief Eligible outputs to fold into a coinstake
+ *
+ * Largest first among outputs below the combine threshold, while the
+ * coinstake stays within the target size.
+ */
+std::vector<COutPoint> SelectCombineInputs(const std::vector<CWalletCoin>& vEligible, const COutPoint& kernel,
+                                           CAmount nKernelValue, const CStakeOutputPolicy& policy);
+
+/**
+ * @brief Play the wallet's coins forward
+ *
+ * @param vCoins   Unspent outputs at params.nStartTime
+ * @param ppolicy  Output policy, or nullptr to stake each output back unchanged
+ */
+CStakeSimResult SimulateStaking(const std::vector<CWalletCoin>& vCoins, const CStakeOutputPolicy* ppolicy,
+                                const CStakeSimParams& params);
+
+/**
+ * @brief Plan output sizing for a wallet without changing it
+ *
+ * Chooses the target size for nMinEfficiency, raised if needed so the
+ * balance fits in nMaxOutputs outputs (0: no limit), groups eligible
+ * small outputs into consolidations, lists outputs to split at their
+ * next stake, and simulates the wallet with and without the policy.
+ */
+CStakeOutputPlan PlanStakeOutputs(const CWalletCoinStore& store, const CStakeSimParams& params,
+                                  double nMinEfficiency = 0.9, size_t nMaxOutputs = 0);
+
+/** @brief Human-readable dry-run report */
+std::string FormatStakeOutputPlan(const CStakeOutputPlan& plan, const CStakeSimParams& params);
+
+} // namespace Africoin
+
+#endif // AFRICOIN_WALLET_STAKING_H
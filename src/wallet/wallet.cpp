@@ -1 +1,193 @@
-// wallet.cpp: Africoin wallet core implementation.
\ No newline at end of file
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * @file wallet.cpp
+ * @brief Africoin wallet core implementation
+ */
+
+#include "wallet/wallet.h"
+
+#include <assert.h>
+#include <algorithm>
+
+namespace Africoin {
+
+static const int64_t COIN_DAY = COIN * 24 * 60 * 60;
+
+CWalletCoinStore::CWalletCoinStore(int64_t nMinAgeIn, int64_t nMaxAgeIn)
+    : nMinAge(nMinAgeIn), nMaxAge(nMaxAgeIn), nTimeNow(0), nBalance(0), nEligibleBalance(0), nGrowingValue(0),
+      nCappedValue(0)
+{
+    assert(nMinAge >= 0 && nMaxAge >= nMinAge);
+}
+
+bool CWalletCoinStore::AddCoin(const CWalletCoin& coin)
+{
+    if (mapEligiblePos.count(coin.outpoint) || mapImmature.count(coin.outpoint))
+        return false;
+
+    nBalance += coin.nValue;
+    if (GetMaturity(coin) <= nTimeNow) {
+        AddEligible(coin);
+    } else {
+        mapImmature.emplace(coin.outpoint, coin);
+        queueMaturity.emplace(GetMaturity(coin), coin.outpoint);
+    }
+    return true;
+}
+
+bool CWalletCoinStore::SpendCoin(const COutPoint& outpoint)
+{
+    auto itImmature = mapImmature.find(outpoint);
+    if (itImmature != mapImmature.end()) {
+        // Its queueMaturity entry goes stale and is skipped when popped
+        nBalance -= itImmature->second.nValue;
+        mapImmature.erase(itImmature);
+        return true;
+    }
+
+    auto itPos = mapEligiblePos.find(outpoint);
+    if (itPos == mapEligiblePos.end())
+        return false;
+
+    uint32_t nPos = itPos->second.nPos;
+    const CWalletCoin coin = vEligible[nPos];
+    nBalance -= coin.nValue;
+    nEligibleBalance -= coin.nValue;
+    if (itPos->second.fCapped)
+        nCappedValue -= coin.nValue;
+    else
+        StopGrowing(coin);  // Its queueCap entry goes stale
+
+    // Swap with the last record to keep the vector dense
+    mapEligiblePos.erase(itPos);
+    if (nPos + 1 != vEligible.size()) {
+        vEligible[nPos] = vEligible.back();
+        mapEligiblePos[vEligible[nPos].outpoint].nPos = nPos;
+    }
+    vEligible.pop_back();
+    return true;
+}
+
+void CWalletCoinStore::AdvanceTime(uint32_t nNow)
+{
+    if (nNow <= nTimeNow)
+        return;
+    nTimeNow = nNow;
+
+    while (!queueMaturity.empty() && queueMaturity.top().first <= nTimeNow) {
+        auto it = mapImmature.find(queueMaturity.top().second);
+        queueMaturity.pop();
+        if (it == mapImmature.end())
+            continue;
+        CWalletCoin coin = it->second;
+        mapImmature.erase(it);
+        AddEligible(coin);
+    }
+
+    while (!queueCap.empty() && queueCap.top().first <= nTimeNow) {
+        auto it = mapEligiblePos.find(queueCap.top().second);
+        queueCap.pop();
+        // Spent, or spent and added back with a newer entry that already capped it
+        if (it == mapEligiblePos.end() || it->second.fCapped)
+            continue;
+        const CWalletCoin& coin = vEligible[it->second.nPos];
+        StopGrowing(coin);
+        nCappedValue += coin.nValue;
+        it->second.fCapped = true;
+    }
+}
+
+void CWalletCoinStore::AddEligible(const CWalletCoin& coin)
+{
+    bool fCapped = GetCapTime(coin) <= nTimeNow;
+    mapEligiblePos.emplace(coin.outpoint, EligiblePos{(uint32_t)vEligible.size(), fCapped});
+    vEligible.push_back(coin);
+    nEligibleBalance += coin.nValue;
+
+    if (fCapped) {
+        nCappedValue += coin.nValue;
+    } else {
+        StartGrowing(coin);
+        queueCap.emplace(GetCapTime(coin), coin.outpoint);
+    }
+}
+
+void CWalletCoinStore::StartGrowing(const CWalletCoin& coin)
+{
+    nGrowingValue += coin.nValue;
+    bnGrowingStart += arith_uint256(coin.nValue) * arith_uint256(GetMaturity(coin));
+}
+
+void CWalletCoinStore::StopGrowing(const CWalletCoin& coin)
+{
+    nGrowingValue -= coin.nValue;
+    bnGrowingStart -= arith_uint256(coin.nValue) * arith_uint256(GetMaturity(coin));
+}
+
+uint64_t CWalletCoinStore::GetStakeWeight(uint32_t nNow)
+{
+    AdvanceTime(nNow);
+
+    // Every growing coin has matured, so nTimeNow * sum(v) >= sum(v * maturity)
+    arith_uint256 bnWeight = arith_uint256(nTimeNow) * arith_uint256(nGrowingValue);
+    bnWeight -= bnGrowingStart;
+    bnWeight += arith_uint256(nCappedValue) * arith_uint256(nMaxAge - nMinAge);
+    return (bnWeight / arith_uint256(COIN_DAY)).GetLow64();
+}
+
+CStakingInfo CWalletCoinStore::GetStakingInfo(uint32_t nNow)
+{
+    CStakingInfo info;
+    info.nStakeWeight = GetStakeWeight(nNow);
+    info.nBalance = nBalance;
+    info.nEligibleBalance = nEligibleBalance;
+    info.nImmatureBalance = nBalance - nEligibleBalance;
+    info.nEligibleCoins = vEligible.size();
+    info.nImmatureCoins = mapImmature.size();
+
+    while (!queueMaturity.empty() && !mapImmature.count(queueMaturity.top().second))
+        queueMaturity.pop();
+    info.nNextMaturity = queueMaturity.empty() ? 0 : queueMaturity.top().first;
+    return info;
+}
+
+std::vector<CWalletCoin> CWalletCoinStore::GetCoins() const
+{
+    std::vector<CWalletCoin> vCoins(vEligible);
+    vCoins.reserve(vEligible.size() + mapImmature.size());
+    for (const auto& item : mapImmature)
+        vCoins.push_back(item.second);
+    return vCoins;
+}
+
+CStakingInfo CWalletCoinStore::GetStakingInfoByScan(uint32_t nNow) const
+{
+    CStakingInfo info;
+    arith_uint256 bnWeight;
+    auto account = [&](const CWalletCoin& coin) {
+        info.nBalance += coin.nValue;
+        uint32_t nMaturity = GetMaturity(coin);
+        if (nMaturity > nNow) {
+            info.nImmatureBalance += coin.nValue;
+            info.nImmatureCoins++;
+            if (info.nNextMaturity == 0 || nMaturity < info.nNextMaturity)
+                info.nNextMaturity = nMaturity;
+            return;
+        }
+        int64_t nTimeWeight = std::min((int64_t)nNow - coin.nTime - nMinAge, nMaxAge - nMinAge);
+        info.nEligibleBalance += coin.nValue;
+        info.nEligibleCoins++;
+        bnWeight += arith_uint256(coin.nValue) * arith_uint256(nTimeWeight);
+    };
+    for (const CWalletCoin& coin : vEligible)
+        account(coin);
+    for (const auto& item : mapImmature)
+        account(item.second);
+    info.nStakeWeight = (bnWeight / arith_uint256(COIN_DAY)).GetLow64();
+    return info;
+}
+
+} // namespace Africoin
@@ -0,0 +1,168 @@
+// Copyright (c) 2025 Africoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef AFRICOIN_WALLET_WALLET_H
+#define AFRICOIN_WALLET_WALLET_H
+
+#include "amount.h"
+#include "arith_uint256.h"
+#include "primitives/transaction.h"
+#include "security/kernel.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file wallet.h
+ * @brief Wallet coin store organised for staking
+ *
+ * Railway wallets hold 100k+ small outputs, and the staking loop, the
+ * balance RPCs and getstakinginfo all used to walk every one of them.
+ *
+ * The store keeps:
+ *
+ * - Eligible coins (at least the minimum stake age old) in one contiguous
+ *   vector of compact records, which is all the minter iterates.
+ * - Immature coins in a side map, with a queue ordered by the time each
+ *   one reaches the minimum age.
+ * - Running totals: balances, and the stake weight split into coins
+ *   whose time weight is still growing and coins that have reached the
+ *   cap. For growing coins sum(v * (t - nTime - nMinAge)) is
+ *   t * sum(v) - sum(v * (nTime + nMinAge)), so both sums are kept and
+ *   the weight at any t is O(1).
+ *
+ * AdvanceTime moves coins between the sets as they mature and as their
+ * weight caps, popping each coin off a queue once. Every query is O(1)
+ * after that.
+ *
+ * Not thread safe: callers hold the wallet lock.
+ */
+
+namespace Africoin {
+
+/**
+ * @struct CWalletCoin
+ * @brief What staking needs to know about one wallet output
+ */
+struct CWalletCoin {
+    CAmount nValue;
+    uint32_t nTime;          //!< txPrev.nTime, where coin age starts
+    COutPoint outpoint;
+    uint32_t nBlockOffset;   //!< Offset of txPrev in its block (kernel nTxPrevOffset)
+
+    CWalletCoin() : nValue(0), nTime(0), nBlockOffset(0) {}
+    CWalletCoin(const COutPoint& outpointIn, CAmount nValueIn, uint32_t nTimeIn, uint32_t nBlockOffsetIn)
+        : nValue(nValueIn), nTime(nTimeIn), outpoint(outpointIn), nBlockOffset(nBlockOffsetIn) {}
+};
+
+/**
+ * @struct CStakingInfo
+ * @brief Totals behind getstakinginfo and getbalance
+ */
+struct CStakingInfo {
+    CAmount nBalance;
+    CAmount nEligibleBalance;   //!< Coins at least the minimum stake age old
+    CAmount nImmatureBalance;
+    size_t nEligibleCoins;
+    size_t nImmatureCoins;
+    uint64_t nStakeWeight;      //!< Coin-days of time weight over all eligible coins
+    uint32_t nNextMaturity;     //!< When the next immature coin becomes eligible (0: none)
+
+    CStakingInfo()
+        : nBalance(0), nEligibleBalance(0), nImmatureBalance(0), nEligibleCoins(0), nImmatureCoins(0),
+          nStakeWeight(0), nNextMaturity(0) {}
+};
+
+/**
+ * @class CWalletCoinStore
+ * @brief Unspent wallet outputs, split by stake maturity, with running totals
+ */
+class CWalletCoinStore {
+public:
+    /**
+     * @param nMinAgeIn  Minimum stake age (RAILWAY_MIN_STAKE_AGE for railway nodes)
+     * @param nMaxAgeIn  Age at which the time weight stops growing
+     */
+    CWalletCoinStore(int64_t nMinAgeIn = PeerCoin::nStakeMinAge, int64_t nMaxAgeIn = PeerCoin::nStakeMaxAge);
+
+    /** @brief Add an unspent output; false if already present */
+    bool AddCoin(const CWalletCoin& coin);
+
+    /** @brief Remove a spent output; false if unknown */
+    bool SpendCoin(const COutPoint& outpoint);
+
+    /**
+     * @brief Move coins that matured or capped by nNow
+     *
+     * Time only moves forward; an earlier nNow is ignored.
+     */
+    void AdvanceTime(uint32_t nNow);
+
+    /** @brief Totals as of nNow (advances time first) */
+    CStakingInfo GetStakingInfo(uint32_t nNow);
+
+    /** @brief Coin-days of time weight of all eligible coins at nNow (advances time first) */
+    uint64_t GetStakeWeight(uint32_t nNow);
+
+    /** @brief The same totals by walking every coin, for tests and benchmarks */
+    CStakingInfo GetStakingInfoByScan(uint32_t nNow) const;
+
+    /** Eligible coins as of the last AdvanceTime, in no particular order */
+    const std::vector<CWalletCoin>& GetEligibleCoins() const { return vEligible; }
+
+    /** @brief Every unspent coin, eligible first */
+    std::vector<CWalletCoin> GetCoins() const;
+
+    CAmount GetBalance() const { return nBalance; }
+    size_t GetCoinCount() const { return vEligible.size() + mapImmature.size(); }
+
+private:
+    struct OutPointHasher {
+        size_t operator()(const COutPoint& outpoint) const { return outpoint.hash.GetCheapHash() ^ outpoint.n; }
+    };
+
+    /** Coin by the time it next changes set; the earliest is on top */
+    typedef std::pair<uint32_t, COutPoint> TimedCoin;
+    struct LaterFirst {
+        bool operator()(const TimedCoin& a, const TimedCoin& b) const { return a.first > b.first; }
+    };
+    typedef std::priority_queue<TimedCoin, std::vector<TimedCoin>, LaterFirst> TimedQueue;
+
+    struct EligiblePos {
+        uint32_t nPos;       //!< Index into vEligible
+        bool fCapped;        //!< Time weight has reached the cap
+    };
+
+    uint32_t GetMaturity(const CWalletCoin& coin) const { return ClampTime((int64_t)coin.nTime + nMinAge); }
+    uint32_t GetCapTime(const CWalletCoin& coin) const { return ClampTime((int64_t)coin.nTime + nMaxAge); }
+    static uint32_t ClampTime(int64_t nTime) { return nTime > 0xffffffff ? 0xffffffff : (uint32_t)nTime; }
+
+    void AddEligible(const CWalletCoin& coin);
+    void StartGrowing(const CWalletCoin& coin);
+    void StopGrowing(const CWalletCoin& coin);
+
+    const int64_t nMinAge;
+    const int64_t nMaxAge;
+    uint32_t nTimeNow;
+
+    std::vector<CWalletCoin> vEligible;
+    std::unordered_map<COutPoint, EligiblePos, OutPointHasher> mapEligiblePos;
+    std::unordered_map<COutPoint, CWalletCoin, OutPointHasher> mapImmature;
+    TimedQueue queueMaturity;     //!< Immature coins by maturity (stale entries skipped)
+    TimedQueue queueCap;          //!< Growing coins by the time their weight caps (stale entries skipped)
+
+    CAmount nBalance;
+    CAmount nEligibleBalance;
+    CAmount nGrowingValue;        //!< sum(v) over eligible coins whose weight still grows
+    arith_uint256 bnGrowingStart; //!< sum(v * (nTime + nMinAge)) over the same coins
+    CAmount nCappedValue;         //!< sum(v) over eligible coins at the weight cap
+};
+
+} // namespace Africoin
+
+#endif // AFRICOIN_WALLET_WALLET_H